@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Previous representation: one frame index per millisecond of the cycle
+struct PerMillisecondTimeline
+{
+    std::vector<std::uint32_t> timeToFrameIndex;
+
+    explicit PerMillisecondTimeline(const tmx::render::TileAnimationInfo& animation)
+    {
+        timeToFrameIndex.resize(animation.totalDuration);
+        std::uint32_t currentTime = 0;
+        for (std::uint32_t frameIdx = 0; frameIdx < animation.frames.size(); ++frameIdx)
+        {
+            for (std::uint32_t t = 0; t < animation.frames[frameIdx].duration; ++t)
+            {
+                timeToFrameIndex[currentTime + t] = frameIdx;
+            }
+            currentTime += animation.frames[frameIdx].duration;
+        }
+    }
+
+    [[nodiscard]] auto getFrameIndexAtTime(std::uint32_t timeInCycle) const -> std::uint32_t
+    {
+        return timeInCycle < timeToFrameIndex.size() ? timeToFrameIndex[timeInCycle] : 0;
+    }
+};
+
+struct Scenario
+{
+    std::string name;
+    std::vector<std::uint32_t> durations;
+};
+
+template <typename Lookup>
+auto measure(const Lookup& lookup, const std::vector<std::uint32_t>& times) -> std::pair<double, std::uint64_t>
+{
+    constexpr int repeats = 20;
+    std::uint64_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (const std::uint32_t t : times)
+        {
+            checksum += lookup.getFrameIndexAtTime(t);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return {ns / (static_cast<double>(times.size()) * repeats), checksum};
+}
+
+int main()
+{
+    const std::vector<Scenario> scenarios = {
+        {"6 frames x 150ms", {150, 150, 150, 150, 150, 150}},
+        {"door 600/150ms", {600, 150, 150, 600, 150, 150}},
+        {"60s ambient, 12 frames", std::vector<std::uint32_t>(12, 5000)},
+        {"60s irregular, 8 frames", {7919, 7907, 7901, 7883, 7879, 7877, 7873, 5781}},
+    };
+
+    constexpr std::size_t lookups = 1 << 20;
+    std::mt19937 rng(42);
+
+    std::cout << std::left << std::setw(26) << "scenario"
+        << std::right << std::setw(14) << "per-ms bytes" << std::setw(14) << "compact bytes"
+        << std::setw(14) << "per-ms ns" << std::setw(14) << "compact ns" << std::setw(10) << "mode" << std::endl;
+
+    for (const auto& scenario : scenarios)
+    {
+        tmx::render::TileAnimationInfo animation{};
+        for (std::uint32_t i = 0; i < scenario.durations.size(); ++i)
+        {
+            animation.frames.push_back({i, 0, 0, scenario.durations[i]});
+        }
+        animation.buildTimeline();
+        const PerMillisecondTimeline legacy(animation);
+
+        std::uniform_int_distribution<std::uint32_t> dist(0, animation.totalDuration - 1);
+        std::vector<std::uint32_t> times(lookups);
+        for (auto& t : times)
+        {
+            t = dist(rng);
+        }
+
+        const auto [legacyNs, legacySum] = measure(legacy, times);
+        const auto [compactNs, compactSum] = measure(animation, times);
+        if (legacySum != compactSum)
+        {
+            std::cerr << scenario.name << ": checksum mismatch" << std::endl;
+            return 1;
+        }
+
+        const std::size_t legacyBytes = legacy.timeToFrameIndex.size() * sizeof(std::uint32_t);
+        const std::size_t compactBytes = animation.timeline.size() * sizeof(std::uint16_t) +
+            animation.frameEndTimes.size() * sizeof(std::uint32_t);
+
+        std::cout << std::left << std::setw(26) << scenario.name
+            << std::right << std::setw(14) << legacyBytes << std::setw(14) << compactBytes
+            << std::fixed << std::setprecision(2)
+            << std::setw(14) << legacyNs << std::setw(14) << compactNs
+            << std::setw(10) << (animation.timeline.empty() ? "search" : "table") << std::endl;
+    }
+
+    return 0;
+}
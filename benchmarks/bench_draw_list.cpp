@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Synthetic orthogonal map: `layers` full layers of size x size tiles and one group of `objects` tile objects
+auto makeMap(std::uint32_t size, std::uint32_t layers, std::uint32_t objects) -> tmx::map::Map
+{
+    tmx::map::Map map{};
+    map.width = size;
+    map.height = size;
+    map.tilewidth = 16;
+    map.tileheight = 16;
+
+    tmx::map::Tileset tileset{};
+    tileset.firstgid = 1;
+    tileset.name = "synthetic";
+    tileset.tilewidth = 16;
+    tileset.tileheight = 16;
+    tileset.columns = 32;
+    tileset.tilecount = 1024;
+    map.tilesets.push_back(tileset);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<std::uint32_t> gid(1, tileset.tilecount);
+    for (std::uint32_t l = 0; l < layers; ++l)
+    {
+        tmx::map::Layer layer{};
+        layer.name = "layer" + std::to_string(l);
+        layer.width = size;
+        layer.height = size;
+        layer.data.resize(static_cast<std::size_t>(size) * size);
+        for (auto& cell : layer.data)
+            cell = gid(rng);
+        map.layers.push_back(std::move(layer));
+    }
+
+    tmx::map::ObjectGroup group{};
+    group.name = "actors";
+    std::uniform_real_distribution<float> position(0.0f, static_cast<float>(size * 16));
+    for (std::uint32_t i = 0; i < objects; ++i)
+    {
+        tmx::map::Object object{};
+        object.id = i + 1;
+        object.x = position(rng);
+        object.y = position(rng);
+        object.width = 16;
+        object.height = 16;
+        object.gid = gid(rng);
+        group.objects.push_back(object);
+    }
+    map.objectgroups.push_back(std::move(group));
+    return map;
+}
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t size = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 512;
+    const std::uint32_t objectCount = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 10000;
+    constexpr int passes = 5;
+
+    const auto map = makeMap(size, 2, objectCount);
+    auto renderData = tmx::render::createRenderData(map, "", {.tileStorage = tmx::render::TileStorage::Packed});
+    std::cout << "Map: " << size << "x" << size << " tiles, 2 layers, " << objectCount << " tile objects" << std::endl;
+
+    // Full build with the radix sort, and the same items sorted by std::sort on their keys
+    tmx::render::DrawList list(renderData);
+    const double radixMs = timeMs([&]
+    {
+        for (int p = 0; p < passes; ++p)
+            list.build();
+    }) / passes;
+
+    const std::vector<tmx::render::DrawItem> built(list.items().begin(), list.items().end());
+    std::vector<tmx::render::DrawItem> items;
+    std::mt19937 rng(9);
+    double comparisonMs = 0.0;
+    for (int p = 0; p < passes; ++p)
+    {
+        items = built;
+        std::ranges::shuffle(items, rng);
+        comparisonMs += timeMs([&]
+        {
+            std::ranges::sort(items, [](const auto& a, const auto& b)
+            {
+                return a.key != b.key ? a.key < b.key : a.source != b.source ? a.source < b.source : a.index < b.index;
+            });
+        });
+    }
+    comparisonMs /= passes;
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "build (radix sort)     " << std::setw(9) << radixMs << " ms  (" << built.size() << " items)" << std::endl
+        << "std::sort of the items " << std::setw(9) << comparisonMs << " ms" << std::endl;
+
+    // Moving a few objects per frame: incremental update vs rebuilding the list
+    auto& objects = renderData.objectGroups.front().objects;
+    std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+    for (const std::uint32_t movedCount : {1u, 16u, 256u})
+    {
+        std::vector<tmx::render::ObjectRef> moved;
+        for (std::uint32_t i = 0; i < movedCount; ++i)
+            moved.push_back({0, static_cast<std::uint32_t>(rng() % objects.size())});
+
+        constexpr int frames = 20;
+        const auto move = [&]
+        {
+            for (const auto& ref : moved)
+            {
+                objects[ref.objectIndex].x += step(rng);
+                objects[ref.objectIndex].y += step(rng);
+            }
+        };
+        const double updateMs = timeMs([&]
+        {
+            for (int f = 0; f < frames; ++f)
+            {
+                move();
+                list.update(moved);
+            }
+        }) / frames;
+        const double rebuildMs = timeMs([&]
+        {
+            for (int f = 0; f < frames; ++f)
+            {
+                move();
+                list.build();
+            }
+        }) / frames;
+
+        std::cout << "moved=" << std::setw(4) << movedCount << "  update=" << std::setw(9) << std::setprecision(3)
+            << updateMs << " ms  rebuild=" << std::setw(9) << rebuildMs << " ms  speedup=" << std::setprecision(1)
+            << rebuildMs / updateMs << "x" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t objectCount = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 100000;
+    const std::uint32_t passes = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 100;
+
+    // Objects as a game map carries them: named, typed, with a couple of properties and some polygons
+    tmx::map::Map map{};
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(0.0f, 4096.0f);
+    for (std::uint32_t g = 0; g < 4; ++g)
+    {
+        tmx::map::ObjectGroup group;
+        group.name = "group" + std::to_string(g);
+        for (std::uint32_t i = g; i < objectCount; i += 4)
+        {
+            tmx::map::Object object{};
+            object.id = i + 1;
+            object.name = "entity_" + std::to_string(i);
+            object.type = i % 3 == 0 ? "enemy" : "pickup";
+            object.x = position(rng);
+            object.y = position(rng);
+            object.width = object.height = 16.0f;
+            object.properties.properties.push_back({"health", "100", "int"});
+            object.properties.properties.push_back({"spawnGroup", "wave_" + std::to_string(i % 8), "string"});
+            if (i % 10 == 0)
+            {
+                object.shape = tmx::map::ObjectShape::Polygon;
+                object.firstPoint = static_cast<std::uint32_t>(map.points.size());
+                object.pointCount = 4;
+                map.points.insert(map.points.end(), {{0, 0}, {16, 0}, {16, 16}, {0, 16}});
+            }
+            group.objects.push_back(std::move(object));
+        }
+        map.objectgroups.push_back(std::move(group));
+    }
+
+    tmx::map::ObjectTable table;
+    const double buildMs = timeMs([&] { table = tmx::map::ObjectTable::fromMap(map); });
+    std::cout << objectCount << " objects (" << sizeof(tmx::map::Object) << " bytes each inline), " << passes
+        << " passes; table built in " << std::fixed << std::setprecision(2) << buildMs << " ms" << std::endl;
+
+    // Read positions: records vs field arrays vs views over the field arrays
+    double aosSum = 0.0, soaSum = 0.0, viewSum = 0.0;
+    const double aosMs = timeMs([&]
+    {
+        for (std::uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (const auto& group : map.objectgroups)
+            {
+                for (const auto& object : group.objects)
+                    aosSum += object.x + object.y;
+            }
+        }
+    });
+    const double soaMs = timeMs([&]
+    {
+        const auto xs = table.xs();
+        const auto ys = std::as_const(table).ys();
+        for (std::uint32_t pass = 0; pass < passes; ++pass)
+        {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < xs.size(); ++i)
+                sum += xs[i] + ys[i];
+            soaSum += sum;
+        }
+    });
+    const double viewMs = timeMs([&]
+    {
+        for (std::uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (const auto object : std::as_const(table))
+                viewSum += object.x() + object.y();
+        }
+    });
+
+    // Move every object: the per-frame update of a simulation
+    const double aosMoveMs = timeMs([&]
+    {
+        for (std::uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (auto& group : map.objectgroups)
+            {
+                for (auto& object : group.objects)
+                {
+                    object.x += 0.5f;
+                    object.y -= 0.25f;
+                }
+            }
+        }
+    });
+    const double soaMoveMs = timeMs([&]
+    {
+        const auto xs = table.xs();
+        const auto ys = table.ys();
+        for (std::uint32_t pass = 0; pass < passes; ++pass)
+        {
+            for (auto& x : xs)
+                x += 0.5f;
+            for (auto& y : ys)
+                y -= 0.25f;
+        }
+    });
+
+    std::cout << std::setprecision(2)
+        << "read  (records)     " << std::setw(9) << aosMs << " ms  (sum " << std::setprecision(0) << aosSum << ")"
+        << std::endl << std::setprecision(2)
+        << "read  (field array) " << std::setw(9) << soaMs << " ms  (" << std::setprecision(1) << aosMs / soaMs
+        << "x, sum " << std::setprecision(0) << soaSum << ")" << std::endl << std::setprecision(2)
+        << "read  (views)       " << std::setw(9) << viewMs << " ms  (" << std::setprecision(1) << aosMs / viewMs
+        << "x, sum " << std::setprecision(0) << viewSum << ")" << std::endl << std::setprecision(2)
+        << "move  (records)     " << std::setw(9) << aosMoveMs << " ms" << std::endl
+        << "move  (field array) " << std::setw(9) << soaMoveMs << " ms  (" << std::setprecision(1)
+        << aosMoveMs / soaMoveMs << "x)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Synthetic orthogonal map: an open floor layer and a "Walls" layer of random wall segments and scattered blocks
+auto makeMap(std::uint32_t size, double density) -> tmx::map::Map
+{
+    tmx::map::Map map{};
+    map.width = size;
+    map.height = size;
+    map.tilewidth = 16;
+    map.tileheight = 16;
+
+    tmx::map::Tileset tileset{};
+    tileset.firstgid = 1;
+    tileset.name = "synthetic";
+    tileset.tilewidth = 16;
+    tileset.tileheight = 16;
+    tileset.columns = 2;
+    tileset.tilecount = 2;
+    map.tilesets.push_back(tileset);
+
+    const std::size_t cells = static_cast<std::size_t>(size) * size;
+    tmx::map::Layer floor{};
+    floor.name = "Floor";
+    floor.width = size;
+    floor.height = size;
+    floor.data.assign(cells, 1);
+    map.layers.push_back(std::move(floor));
+
+    tmx::map::Layer walls{};
+    walls.name = "Walls";
+    walls.width = size;
+    walls.height = size;
+    walls.data.assign(cells, 0);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::uint32_t> cell(0, size - 1);
+    std::uniform_int_distribution<std::uint32_t> length(4, 48);
+    std::bernoulli_distribution vertical(0.5);
+    std::size_t blocked = 0;
+    while (static_cast<double>(blocked) < density * static_cast<double>(cells))
+    {
+        // Half of the walls are segments, the other half single blocks
+        const std::uint32_t x = cell(rng), y = cell(rng);
+        const std::uint32_t n = blocked % 2 == 0 ? length(rng) : 1;
+        const bool down = vertical(rng);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const std::uint32_t wx = down ? x : x + i, wy = down ? y + i : y;
+            if (wx >= size || wy >= size)
+                break;
+            auto& gid = walls.data[static_cast<std::size_t>(wy) * size + wx];
+            blocked += gid == 0 ? 1 : 0;
+            gid = 2;
+        }
+    }
+    map.layers.push_back(std::move(walls));
+    return map;
+}
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t size = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 1024;
+    const std::uint32_t queryCount = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 100;
+    constexpr double density = 0.1;
+
+    const auto map = makeMap(size, density);
+    std::cout << "Map: " << size << "x" << size << " tiles, " << density * 100 << "% walls, " << queryCount
+        << " queries" << std::endl;
+
+    tmx::nav::NavGrid grid;
+    const double bakeMs = timeMs([&]
+    {
+        grid = tmx::nav::NavGrid::fromMap(map, [](const tmx::map::Layer& layer) { return layer.name == "Walls"; });
+    });
+    std::cout << std::fixed << std::setprecision(2) << "bake grid " << std::setw(9) << bakeMs << " ms  ("
+        << grid.rows().count() << " walkable cells)" << std::endl;
+
+    // Random walkable endpoints
+    std::vector<tmx::nav::PathRequest> requests;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<std::int32_t> coordinate(0, static_cast<std::int32_t>(size) - 1);
+    while (requests.size() < queryCount)
+    {
+        const tmx::nav::GridPoint start{coordinate(rng), coordinate(rng)}, goal{coordinate(rng), coordinate(rng)};
+        if (grid.isWalkable(start.x, start.y) && grid.isWalkable(goal.x, goal.y))
+            requests.push_back({start, goal});
+    }
+
+    tmx::nav::Pathfinder pathfinder(grid);
+    std::vector<tmx::nav::GridPoint> path;
+    for (const auto algorithm : {tmx::nav::PathAlgorithm::AStar, tmx::nav::PathAlgorithm::JumpPoint})
+    {
+        std::uint64_t expanded = 0;
+        std::uint32_t found = 0;
+        const double ms = timeMs([&]
+        {
+            for (const auto& [start, goal] : requests)
+            {
+                found += pathfinder.findPath(start, goal, path, algorithm).found ? 1 : 0;
+                expanded += pathfinder.expandedCount();
+            }
+        });
+        std::cout << (algorithm == tmx::nav::PathAlgorithm::AStar ? "A*        " : "JPS       ") << std::setw(9)
+            << ms / queryCount << " ms/path  (" << found << " found, " << expanded / queryCount
+            << " cells expanded per path)" << std::endl;
+    }
+
+    // All agents in one call, paths stored back to back
+    tmx::nav::PathBatch batch;
+    const double batchMs = timeMs([&] { pathfinder.findPaths(requests, batch); });
+    std::cout << "JPS batch " << std::setw(9) << batchMs << " ms total  (" << batch.points.size() << " path cells)"
+        << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::int32_t size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    const std::uint32_t rayCount = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 200000;
+    constexpr std::uint32_t tileSize = 16;
+
+    // Synthetic infinite-style layer centred on the origin, 5% scattered solid cells
+    tmx::map::BitGrid solid({-size / 2, -size / 2, size - size / 2, size - size / 2});
+    std::mt19937 rng(7);
+    std::bernoulli_distribution wall(0.05);
+    for (std::int32_t y = solid.bounds().minY; y < solid.bounds().maxY; ++y)
+    {
+        for (std::int32_t x = solid.bounds().minX; x < solid.bounds().maxX; ++x)
+            solid.set(x, y, wall(rng));
+    }
+    const tmx::map::CollisionQuery query(std::move(solid), tileSize, tileSize);
+    std::cout << "Map: " << size << "x" << size << " tiles, 5% solid, " << rayCount << " rays of up to 64 tiles"
+        << std::endl;
+
+    const float half = static_cast<float>(size / 2 * tileSize);
+    std::uniform_real_distribution<float> position(-half, half);
+    std::uniform_real_distribution<float> offset(-64.0f * tileSize, 64.0f * tileSize);
+    std::vector<tmx::map::Ray> rays(rayCount);
+    for (auto& ray : rays)
+        ray = {position(rng), position(rng), offset(rng), offset(rng)};
+
+    // Single raycasts vs the batched lanes
+    std::vector<tmx::map::RayHit> hits(rayCount);
+    std::uint32_t singleHits = 0;
+    const double singleMs = timeMs([&]
+    {
+        for (std::uint32_t i = 0; i < rayCount; ++i)
+        {
+            hits[i] = query.raycast(rays[i]);
+            singleHits += hits[i].hit ? 1 : 0;
+        }
+    });
+    const double batchMs = timeMs([&] { query.raycast(rays, hits); });
+    std::uint32_t batchHits = 0;
+    for (const auto& hit : hits)
+        batchHits += hit.hit ? 1 : 0;
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "raycast (single)  " << std::setw(9) << singleMs << " ms  (" << singleHits << " hits)" << std::endl
+        << "raycast (batched) " << std::setw(9) << batchMs << " ms  (" << batchHits << " hits, "
+        << std::setprecision(1) << singleMs / batchMs << "x)" << std::endl;
+
+    // Character-sized boxes moving up to two tiles per call
+    std::uniform_real_distribution<float> velocity(-32.0f, 32.0f);
+    std::vector<tmx::map::CollisionBox> boxes(rayCount / 4);
+    for (auto& box : boxes)
+    {
+        const float x = position(rng), y = position(rng);
+        box = {x, y, x + 12.0f, y + 28.0f};
+    }
+    std::uint32_t blocked = 0;
+    const double moveMs = timeMs([&]
+    {
+        for (auto& box : boxes)
+        {
+            const auto moved = query.move(box, velocity(rng), velocity(rng));
+            box = {box.minX + moved.dx, box.minY + moved.dy, box.maxX + moved.dx, box.maxY + moved.dy};
+            blocked += moved.blockedX || moved.blockedY ? 1 : 0;
+        }
+    });
+    std::cout << std::setprecision(2) << "move              " << std::setw(9) << moveMs << " ms  (" << boxes.size()
+        << " boxes, " << blocked << " blocked)" << std::endl;
+
+    return 0;
+}
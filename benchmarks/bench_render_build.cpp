@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Synthetic orthogonal map: `layers` layers of size x size tiles with about a quarter of the cells empty
+auto makeMap(std::uint32_t size, std::uint32_t layers) -> tmx::map::Map
+{
+    tmx::map::Map map{};
+    map.width = size;
+    map.height = size;
+    map.tilewidth = 16;
+    map.tileheight = 16;
+
+    tmx::map::Tileset tileset{};
+    tileset.firstgid = 1;
+    tileset.name = "synthetic";
+    tileset.tilewidth = 16;
+    tileset.tileheight = 16;
+    tileset.columns = 32;
+    tileset.tilecount = 1024;
+    for (std::uint32_t id = 0; id < 8; ++id)
+    {
+        tmx::map::Tile tile{};
+        tile.id = id;
+        tile.animation.frames = {{id, 100}, {id + 8, 100}, {id + 16, 100}};
+        tileset.tiles.push_back(tile);
+    }
+    map.tilesets.push_back(tileset);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<std::uint32_t> gid(0, tileset.tilecount * 4 / 3);
+    for (std::uint32_t l = 0; l < layers; ++l)
+    {
+        tmx::map::Layer layer{};
+        layer.name = "layer" + std::to_string(l);
+        layer.width = size;
+        layer.height = size;
+        layer.data.resize(static_cast<std::size_t>(size) * size);
+        for (auto& cell : layer.data)
+        {
+            const std::uint32_t value = gid(rng);
+            cell = value <= tileset.tilecount ? value : 0;
+        }
+        map.layers.push_back(std::move(layer));
+    }
+    return map;
+}
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t size = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 2048;
+    const std::uint32_t layerCount = argc > 2 ? static_cast<std::uint32_t>(std::atoi(argv[2])) : 4;
+    const std::uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    constexpr int passes = 3;
+
+    std::cout << "Map: " << size << "x" << size << " tiles, " << layerCount << " layers, " << hardwareThreads
+        << " hardware threads" << std::endl;
+    const auto map = makeMap(size, layerCount);
+
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed})
+    {
+        double serialMs = 0.0;
+        for (std::uint32_t threads = 1; threads <= hardwareThreads; threads *= 2)
+        {
+            std::size_t tileCount = 0;
+            const double ms = timeMs([&]
+            {
+                for (int p = 0; p < passes; ++p)
+                {
+                    const auto renderData = tmx::render::createRenderData(
+                        map, "", {.tileStorage = storage, .threadCount = threads});
+                    tileCount = 0;
+                    for (const auto& layer : renderData.layers)
+                    {
+                        tileCount += layer.tiles.size() + layer.packedTiles.size();
+                    }
+                }
+            }) / passes;
+            serialMs = threads == 1 ? ms : serialMs;
+
+            std::cout << std::left << std::setw(8) << (storage == tmx::render::TileStorage::Full ? "full" : "packed")
+                << std::right << " threads=" << std::setw(3) << threads
+                << "  build=" << std::fixed << std::setprecision(2) << std::setw(9) << ms << " ms"
+                << "  speedup=" << std::setprecision(2) << serialMs / ms << "x"
+                << "  (" << tileCount << " tiles)" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <tmx/tmx.hpp>
+
+// Synthetic orthogonal map: `layers` fully populated layers of size x size tiles
+auto makeMap(std::uint32_t size, std::uint32_t layers) -> tmx::map::Map
+{
+    tmx::map::Map map{};
+    map.width = size;
+    map.height = size;
+    map.tilewidth = 16;
+    map.tileheight = 16;
+
+    tmx::map::Tileset tileset{};
+    tileset.firstgid = 1;
+    tileset.name = "synthetic";
+    tileset.tilewidth = 16;
+    tileset.tileheight = 16;
+    tileset.columns = 32;
+    tileset.tilecount = 1024;
+    for (std::uint32_t id = 0; id < 8; ++id)
+    {
+        tmx::map::Tile tile{};
+        tile.id = id;
+        tile.animation.frames = {{id, 100}, {id + 8, 100}, {id + 16, 100}};
+        tileset.tiles.push_back(tile);
+    }
+    map.tilesets.push_back(tileset);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::uint32_t> gid(1, tileset.tilecount);
+    for (std::uint32_t l = 0; l < layers; ++l)
+    {
+        tmx::map::Layer layer{};
+        layer.name = "layer" + std::to_string(l);
+        layer.width = size;
+        layer.height = size;
+        layer.data.resize(static_cast<std::size_t>(size) * size);
+        for (auto& cell : layer.data)
+        {
+            cell = gid(rng);
+        }
+        map.layers.push_back(std::move(layer));
+    }
+    return map;
+}
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t size = argc > 1 ? static_cast<std::uint32_t>(std::atoi(argv[1])) : 1024;
+    constexpr std::uint32_t layerCount = 4;
+    constexpr int passes = 5;
+
+    std::cout << "Map: " << size << "x" << size << " tiles, " << layerCount << " layers" << std::endl;
+    const auto map = makeMap(size, layerCount);
+
+    // Full TileRenderInfo records
+    {
+        const auto renderData = tmx::render::createRenderData(map);
+        std::size_t bytes = 0;
+        for (const auto& layer : renderData.layers)
+        {
+            bytes += layer.tiles.size() * sizeof(tmx::render::TileRenderInfo);
+        }
+
+        // Touch what a renderer needs: source and destination rectangles
+        std::uint64_t checksum = 0;
+        const double ms = timeMs([&]
+        {
+            for (int p = 0; p < passes; ++p)
+            {
+                for (const auto& layer : renderData.layers)
+                {
+                    for (const auto& tile : layer.tiles)
+                    {
+                        checksum += tile.srcX + tile.srcY + tile.srcW + tile.srcH +
+                            static_cast<std::uint32_t>(tile.destX + tile.destY) + tile.destW + tile.destH;
+                    }
+                }
+            }
+        });
+        std::cout << std::left << std::setw(10) << "full" << std::right
+            << " sizeof=" << std::setw(3) << sizeof(tmx::render::TileRenderInfo)
+            << "  memory=" << std::setw(8) << bytes / (1024 * 1024) << " MiB"
+            << "  iterate=" << std::fixed << std::setprecision(2) << ms / passes << " ms/pass"
+            << "  (checksum " << checksum << ")" << std::endl;
+    }
+
+    // Packed 16-byte records, sizes from tileset and map
+    {
+        const auto renderData = tmx::render::createRenderData(
+            map, "", {.tileStorage = tmx::render::TileStorage::Packed});
+        std::size_t bytes = 0;
+        for (const auto& layer : renderData.layers)
+        {
+            bytes += layer.packedTiles.size() * sizeof(tmx::render::PackedTileRenderInfo);
+        }
+
+        std::uint64_t checksum = 0;
+        const double ms = timeMs([&]
+        {
+            for (int p = 0; p < passes; ++p)
+            {
+                for (const auto& layer : renderData.layers)
+                {
+                    for (const auto& tile : layer.packedTiles)
+                    {
+                        const auto& tileset = renderData.tilesets[tile.tilesetIndex];
+                        checksum += tileset.srcXOf(tile.tileId()) + tileset.srcYOf(tile.tileId()) +
+                            tileset.tileWidth + tileset.tileHeight +
+                            static_cast<std::uint32_t>(tile.destX + tile.destY) +
+                            renderData.tileWidth + renderData.tileHeight;
+                    }
+                }
+            }
+        });
+        std::cout << std::left << std::setw(10) << "packed" << std::right
+            << " sizeof=" << std::setw(3) << sizeof(tmx::render::PackedTileRenderInfo)
+            << "  memory=" << std::setw(8) << bytes / (1024 * 1024) << " MiB"
+            << "  iterate=" << std::fixed << std::setprecision(2) << ms / passes << " ms/pass"
+            << "  (checksum " << checksum << ")" << std::endl;
+    }
+
+    return 0;
+}
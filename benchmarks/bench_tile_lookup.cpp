@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Synthetic infinite layer: chunks x chunks Tiled chunks of 16x16 tiles centred on the origin, about half filled
+auto makeLayer(std::int32_t chunks) -> tmx::map::Layer
+{
+    tmx::map::Layer layer{};
+    layer.name = "synthetic";
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<std::uint32_t> gid(0, 64);
+    for (std::int32_t cy = -chunks / 2; cy < chunks - chunks / 2; ++cy)
+    {
+        for (std::int32_t cx = -chunks / 2; cx < chunks - chunks / 2; ++cx)
+        {
+            tmx::map::Chunk chunk{};
+            chunk.x = cx * 16;
+            chunk.y = cy * 16;
+            chunk.width = 16;
+            chunk.height = 16;
+            chunk.data.resize(256);
+            for (auto& cell : chunk.data)
+            {
+                const std::uint32_t value = gid(rng);
+                cell = value > 32 ? value - 32 : 0;
+            }
+            layer.chunks.push_back(std::move(chunk));
+        }
+    }
+    return layer;
+}
+
+// What gameplay code has to do without the store: scan the chunk list for the one containing the cell
+auto scanChunks(const tmx::map::Layer& layer, std::int32_t x, std::int32_t y) -> std::uint32_t
+{
+    for (const auto& chunk : layer.chunks)
+    {
+        if (x >= chunk.x && y >= chunk.y && x < chunk.x + static_cast<std::int32_t>(chunk.width) &&
+            y < chunk.y + static_cast<std::int32_t>(chunk.height))
+        {
+            return chunk.data[static_cast<std::size_t>(y - chunk.y) * chunk.width + static_cast<std::size_t>(x - chunk.x)];
+        }
+    }
+    return 0;
+}
+
+template <typename Fn>
+auto timeMs(Fn&& fn) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* name, std::size_t queries, double ms, std::uint64_t checksum)
+{
+    std::cout << std::left << std::setw(12) << name << std::right
+        << " " << std::fixed << std::setprecision(2) << std::setw(10) << ms << " ms"
+        << "  " << std::setw(8) << std::setprecision(1) << static_cast<double>(queries) / (ms * 1000.0) << " M lookups/s"
+        << "  (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::int32_t chunks = argc > 1 ? std::atoi(argv[1]) : 64;
+    const std::int32_t extent = chunks * 16;
+
+    std::cout << "Layer: " << chunks << "x" << chunks << " chunks (" << extent << "x" << extent << " tiles)" << std::endl;
+    const auto layer = makeLayer(chunks);
+
+    tmx::map::TileStore store;
+    const double buildMs = timeMs([&] { store = tmx::map::TileStore::fromLayer(layer); });
+    std::cout << "TileStore::fromLayer: " << std::fixed << std::setprecision(2) << buildMs << " ms, "
+        << store.chunkCount() << " chunks" << std::endl;
+
+    // Random probes, a quarter of them outside the layer
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::int32_t> coordinate(-extent * 5 / 8, extent * 5 / 8);
+    std::vector<std::pair<std::int32_t, std::int32_t>> probes(1u << 20);
+    for (auto& probe : probes)
+    {
+        probe = {coordinate(rng), coordinate(rng)};
+    }
+
+    // The linear scan is far slower; sample it on a prefix of the probes
+    const std::size_t scanQueries = std::min<std::size_t>(probes.size(), 20000000 / layer.chunks.size() + 1);
+    std::uint64_t scanSum = 0;
+    const double scanMs = timeMs([&]
+    {
+        for (std::size_t i = 0; i < scanQueries; ++i)
+        {
+            scanSum += scanChunks(layer, probes[i].first, probes[i].second);
+        }
+    });
+    report("chunk scan", scanQueries, scanMs, scanSum);
+
+    constexpr int passes = 10;
+    std::uint64_t storeSum = 0;
+    const double storeMs = timeMs([&]
+    {
+        for (int p = 0; p < passes; ++p)
+        {
+            for (const auto& [x, y] : probes)
+            {
+                storeSum += store.tileAt(x, y);
+            }
+        }
+    });
+    report("TileStore", probes.size() * passes, storeMs, storeSum / passes);
+
+    std::uint64_t prefixSum = 0;
+    for (std::size_t i = 0; i < scanQueries; ++i)
+    {
+        prefixSum += store.tileAt(probes[i].first, probes[i].second);
+    }
+    if (prefixSum != scanSum)
+    {
+        std::cerr << "Mismatch between chunk scan and TileStore" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -6,7 +6,12 @@ include(Modules/FindBase64)
 include(Modules/Findlibzstd)
 include(Modules/FindZLIB)
 
+find_package(Threads REQUIRED)
+
 if (BUILD_TMX_EXAMPLES)
     include(Modules/FindSDL3)
+endif ()
+
+if (BUILD_TMX_EXAMPLES OR BUILD_TMX_RASTER)
     include(Modules/FindSTB)
 endif ()
\ No newline at end of file
@@ -84,8 +84,11 @@ int main(int argc, char* argv[])
     // Load tileset textures
     auto tilesetTextures = tmx::sdl3::loadTilesetTextures(renderer, renderData);
 
-    // Initialize animation state manager
-    tmx::sdl3::AnimationStateManager animationStates;
+    // Initialize the animation clock shared by all animated tiles
+    tmx::render::AnimationClock animationClock(renderData);
+
+    // Geometry buffers reused every frame for batched drawing
+    tmx::sdl3::GeometryCache geometry;
 
     std::cout << "Rendering animated map... Press ESC to quit." << std::endl;
 
@@ -101,6 +104,9 @@ int main(int argc, char* argv[])
         const uint32_t deltaTime = currentTime - lastTime;
         lastTime = currentTime;
 
+        // Advance every animation once per frame
+        animationClock.tick(deltaTime);
+
         // Handle events
         while (SDL_PollEvent(&event))
         {
@@ -122,7 +128,7 @@ int main(int argc, char* argv[])
         SDL_RenderClear(renderer);
 
         // Render map using common rendering function
-        tmx::sdl3::renderMap(renderer, renderData, tilesetTextures, animationStates, deltaTime);
+        tmx::sdl3::renderMap(renderer, renderData, tilesetTextures, animationClock, geometry);
 
         // Present
         SDL_RenderPresent(renderer);
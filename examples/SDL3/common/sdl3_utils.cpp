@@ -6,17 +6,6 @@
 
 namespace tmx::sdl3 {
 
-void AnimationStateManager::update(uint32_t deltaTime) {
-    for (auto& [key, state] : states_) {
-        state.elapsedTime += deltaTime;
-    }
-}
-
-AnimationState& AnimationStateManager::getState(uint32_t tilesetIndex, uint32_t animationIndex) {
-    uint64_t key = (static_cast<uint64_t>(tilesetIndex) << 32) | animationIndex;
-    return states_[key];
-}
-
 bool initSDL() {
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "Failed to initialize SDL3: " << SDL_GetError() << std::endl;
@@ -127,100 +116,154 @@ void cleanup(
     SDL_Quit();
 }
 
-void renderLayer(
-    SDL_Renderer* renderer,
-    const tmx::render::LayerRenderData& layer,
-    const tmx::render::MapRenderData& renderData,
-    const std::vector<SDL_Texture*>& tilesetTextures,
-    AnimationStateManager& animationStates,
-    uint32_t deltaTime
-) {
-    if (!layer.visible) {
-        return;
+namespace {
+
+// Grow the cached buffers to the measured size; they never shrink, so steady-state frames do not allocate
+tmx::render::GeometryBuffers reserveGeometry(GeometryCache& geometry, const tmx::render::GeometryCounts& counts) {
+    if (geometry.vertices.size() < counts.vertexCount) {
+        geometry.vertices.resize(counts.vertexCount);
+    }
+    if (geometry.indices.size() < counts.indexCount) {
+        geometry.indices.resize(counts.indexCount);
+    }
+    if (geometry.batches.size() < counts.batchCount) {
+        geometry.batches.resize(counts.batchCount);
     }
+    return {geometry.vertices, geometry.indices, geometry.batches};
+}
 
-    for (const auto& tile : layer.tiles) {
-        // Get the tileset texture
-        if (tile.tilesetIndex >= tilesetTextures.size()) {
-            continue;
-        }
+void bindGeometry(GeometryCache& geometry, const tmx::render::MapRenderData& renderData) {
+    if (geometry.emitter.renderData() != &renderData) {
+        geometry.emitter.reset(renderData);
+    }
+}
 
-        SDL_Texture* texture = tilesetTextures[tile.tilesetIndex];
-        if (!texture) {
+void drawBatches(
+    SDL_Renderer* renderer,
+    const GeometryCache& geometry,
+    std::size_t batchCount,
+    const std::vector<SDL_Texture*>& tilesetTextures
+) {
+    constexpr int stride = sizeof(tmx::render::GeometryVertex);
+    for (std::size_t i = 0; i < batchCount; ++i) {
+        const auto& batch = geometry.batches[i];
+        if (batch.tilesetIndex >= tilesetTextures.size() || !tilesetTextures[batch.tilesetIndex]) {
             continue;
         }
 
-        SDL_FRect srcRect;
-        SDL_FRect destRect;
-
-        if (tile.isAnimated && tile.animationIndex != static_cast<uint32_t>(-1)) {
-            // Get animation info
-            const auto& tilesetInfo = renderData.tilesets[tile.tilesetIndex];
-            if (tile.animationIndex >= tilesetInfo.animations.size()) {
-                continue;
-            }
-
-            const auto& animation = tilesetInfo.animations[tile.animationIndex];
-
-            // Get or create animation state
-            auto& state = animationStates.getState(tile.tilesetIndex, tile.animationIndex);
-
-            // Update animation
-            state.elapsedTime += deltaTime;
-
-            // Use flattened lookup to get current frame index - O(1) instead of O(n)
-            const uint32_t timeInCycle = state.elapsedTime % animation.totalDuration;
-            const uint32_t frameIndex = animation.getFrameIndexAtTime(timeInCycle);
-
-            // Use the current animation frame
-            const auto& frame = animation.frames[frameIndex];
-            srcRect = {
-                static_cast<float>(frame.srcX),
-                static_cast<float>(frame.srcY),
-                static_cast<float>(tile.srcW),
-                static_cast<float>(tile.srcH)
-            };
-        } else {
-            // Static tile - use pre-calculated source rect
-            srcRect = {
-                static_cast<float>(tile.srcX),
-                static_cast<float>(tile.srcY),
-                static_cast<float>(tile.srcW),
-                static_cast<float>(tile.srcH)
-            };
-        }
+        // Position, color and texture coordinates are read in place from the interleaved vertices
+        const auto* vertices = geometry.vertices.data() + batch.firstVertex;
+        SDL_RenderGeometryRaw(
+            renderer,
+            tilesetTextures[batch.tilesetIndex],
+            &vertices->x, stride,
+            reinterpret_cast<const SDL_FColor*>(&vertices->r), stride,
+            &vertices->u, stride,
+            static_cast<int>(batch.vertexCount),
+            geometry.indices.data() + batch.firstIndex,
+            static_cast<int>(batch.indexCount),
+            sizeof(std::uint32_t)
+        );
+    }
+}
 
-        // Destination is always the same
-        destRect = {
-            static_cast<float>(tile.destX),
-            static_cast<float>(tile.destY),
-            static_cast<float>(tile.destW),
-            static_cast<float>(tile.destH)
-        };
-
-        // Apply opacity if not fully opaque
-        if (tile.opacity < 1.0f) {
-            SDL_SetTextureAlphaModFloat(texture, tile.opacity);
-        }
+// Emit one layer (or streamed chunk) and draw it with one call per tileset
+void drawLayer(
+    SDL_Renderer* renderer,
+    const tmx::render::LayerRenderData& layer,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::GeometryOptions& options,
+    GeometryCache& geometry
+) {
+    const auto counts = geometry.emitter.measure(layer);
+    const auto written = geometry.emitter.emit(layer, reserveGeometry(geometry, counts), options);
+    if (!written) {
+        std::cerr << "Failed to emit layer '" << layer.name << "': " << written.error() << std::endl;
+        return;
+    }
+    drawBatches(renderer, geometry, written->batchCount, tilesetTextures);
+}
 
-        SDL_RenderTexture(renderer, texture, &srcRect, &destRect);
+} // namespace
 
-        // Reset opacity
-        if (tile.opacity < 1.0f) {
-            SDL_SetTextureAlphaModFloat(texture, 1.0f);
-        }
+void renderLayer(
+    SDL_Renderer* renderer,
+    const tmx::render::LayerRenderData& layer,
+    const tmx::render::MapRenderData& renderData,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::AnimationClock& animationClock,
+    GeometryCache& geometry
+) {
+    if (!layer.visible) {
+        return;
     }
+
+    bindGeometry(geometry, renderData);
+    tmx::render::GeometryOptions options;
+    options.animationClock = &animationClock;
+    drawLayer(renderer, layer, tilesetTextures, options, geometry);
 }
 
 void renderMap(
     SDL_Renderer* renderer,
     const tmx::render::MapRenderData& renderData,
     const std::vector<SDL_Texture*>& tilesetTextures,
-    AnimationStateManager& animationStates,
-    uint32_t deltaTime
+    const tmx::render::AnimationClock& animationClock,
+    GeometryCache& geometry
 ) {
     for (const auto& layer : renderData.layers) {
-        renderLayer(renderer, layer, renderData, tilesetTextures, animationStates, deltaTime);
+        renderLayer(renderer, layer, renderData, tilesetTextures, animationClock, geometry);
+    }
+}
+
+void renderView(
+    SDL_Renderer* renderer,
+    const tmx::render::MapRenderData& renderData,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::AnimationClock& animationClock,
+    const tmx::render::ViewRect& view,
+    std::vector<tmx::render::ChunkRange>& visibleChunks,
+    GeometryCache& geometry
+) {
+    // Only the chunks overlapping the view are emitted, however large the map is
+    renderData.query(view, visibleChunks);
+    bindGeometry(geometry, renderData);
+
+    tmx::render::GeometryOptions options;
+    options.originX = view.x;
+    options.originY = view.y;
+    options.animationClock = &animationClock;
+
+    const auto counts = geometry.emitter.measure(visibleChunks);
+    const auto written = geometry.emitter.emit(visibleChunks, reserveGeometry(geometry, counts), options);
+    if (!written) {
+        std::cerr << "Failed to emit view: " << written.error() << std::endl;
+        return;
+    }
+    drawBatches(renderer, geometry, written->batchCount, tilesetTextures);
+}
+
+void renderStreamedView(
+    SDL_Renderer* renderer,
+    const tmx::render::ChunkStreamer& streamer,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::AnimationClock& animationClock,
+    const tmx::render::ViewRect& view,
+    std::vector<const tmx::render::StreamedChunk*>& visibleChunks,
+    GeometryCache& geometry
+) {
+    streamer.visibleChunks(view, visibleChunks);
+    bindGeometry(geometry, streamer.renderData());
+
+    tmx::render::GeometryOptions options;
+    options.originX = view.x;
+    options.originY = view.y;
+    options.animationClock = &animationClock;
+
+    for (const auto* chunk : visibleChunks) {
+        if (chunk->layer.visible) {
+            drawLayer(renderer, chunk->layer, tilesetTextures, options, geometry);
+        }
     }
 }
 
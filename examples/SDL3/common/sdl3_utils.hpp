@@ -4,33 +4,9 @@
 #include <tmx/tmx.hpp>
 #include <vector>
 #include <string>
-#include <unordered_map>
 
 namespace tmx::sdl3 {
 
-/// @brief Animation state tracker for a tile animation
-struct AnimationState {
-    uint32_t currentFrame = 0;
-    uint32_t elapsedTime = 0;
-};
-
-/// @brief Animation state manager for all animations in a map
-class AnimationStateManager {
-public:
-    /// @brief Update all animation states
-    /// @param deltaTime Time elapsed since last update in milliseconds
-    void update(uint32_t deltaTime);
-
-    /// @brief Get or create animation state for a given tile
-    /// @param tilesetIndex Index of the tileset
-    /// @param animationIndex Index of the animation in the tileset
-    /// @return Reference to the animation state
-    AnimationState& getState(uint32_t tilesetIndex, uint32_t animationIndex);
-
-private:
-    std::unordered_map<uint64_t, AnimationState> states_;
-};
-
 /// @brief Initialize SDL3 subsystems
 /// @return true on success, false on failure
 bool initSDL();
@@ -65,34 +41,78 @@ std::vector<SDL_Texture*> loadTilesetTextures(
     const tmx::render::MapRenderData& renderData
 );
 
-/// @brief Render a single layer with animation support
+/// @brief Geometry buffers reused across frames, so batched drawing does not allocate once they have grown
+struct GeometryCache {
+    tmx::render::GeometryEmitter emitter;
+    std::vector<tmx::render::GeometryVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::vector<tmx::render::GeometryBatch> batches;
+};
+
+/// @brief Render a single layer with animation support, one draw call per tileset
 /// @param renderer SDL renderer
-/// @param layer Layer render data
-/// @param renderData Full map render data (for animation info)
+/// @param layer Layer render data (any tmx::render::TileStorage)
+/// @param renderData Full map render data the layer belongs to
 /// @param tilesetTextures Vector of loaded tileset textures
-/// @param animationStates Animation state manager
-/// @param deltaTime Time elapsed since last frame (for animation update)
+/// @param animationClock Animation clock holding the current frame of every animation
+/// @param geometry Geometry buffers reused across frames
 void renderLayer(
     SDL_Renderer* renderer,
     const tmx::render::LayerRenderData& layer,
     const tmx::render::MapRenderData& renderData,
     const std::vector<SDL_Texture*>& tilesetTextures,
-    AnimationStateManager& animationStates,
-    uint32_t deltaTime
+    const tmx::render::AnimationClock& animationClock,
+    GeometryCache& geometry
 );
 
-/// @brief Render all layers of a map with animation support
+/// @brief Render all layers of a map with animation support, one draw call per tileset and layer
 /// @param renderer SDL renderer
 /// @param renderData Map render data
 /// @param tilesetTextures Vector of loaded tileset textures
-/// @param animationStates Animation state manager
-/// @param deltaTime Time elapsed since last frame (for animation update)
+/// @param animationClock Animation clock holding the current frame of every animation
+/// @param geometry Geometry buffers reused across frames
 void renderMap(
     SDL_Renderer* renderer,
     const tmx::render::MapRenderData& renderData,
     const std::vector<SDL_Texture*>& tilesetTextures,
-    AnimationStateManager& animationStates,
-    uint32_t deltaTime
+    const tmx::render::AnimationClock& animationClock,
+    GeometryCache& geometry
+);
+
+/// @brief Render the part of a map covered by a view, skipping chunks outside of it
+/// @param renderer SDL renderer
+/// @param renderData Map render data
+/// @param tilesetTextures Vector of loaded tileset textures
+/// @param animationClock Animation clock holding the current frame of every animation
+/// @param view Visible part of the map in map pixels; its top-left corner is drawn at the window origin
+/// @param visibleChunks Scratch buffer for the chunk query, reused across frames to avoid allocations
+/// @param geometry Geometry buffers reused across frames
+void renderView(
+    SDL_Renderer* renderer,
+    const tmx::render::MapRenderData& renderData,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::AnimationClock& animationClock,
+    const tmx::render::ViewRect& view,
+    std::vector<tmx::render::ChunkRange>& visibleChunks,
+    GeometryCache& geometry
+);
+
+/// @brief Render the loaded chunks of a streamed map overlapping a view
+/// @param renderer SDL renderer
+/// @param streamer Chunk streamer, updated with the same view beforehand
+/// @param tilesetTextures Vector of loaded tileset textures
+/// @param animationClock Animation clock holding the current frame of every animation
+/// @param view Visible part of the map in map pixels; its top-left corner is drawn at the window origin
+/// @param visibleChunks Scratch buffer for the visible chunks, reused across frames to avoid allocations
+/// @param geometry Geometry buffers reused across frames
+void renderStreamedView(
+    SDL_Renderer* renderer,
+    const tmx::render::ChunkStreamer& streamer,
+    const std::vector<SDL_Texture*>& tilesetTextures,
+    const tmx::render::AnimationClock& animationClock,
+    const tmx::render::ViewRect& view,
+    std::vector<const tmx::render::StreamedChunk*>& visibleChunks,
+    GeometryCache& geometry
 );
 
 /// @brief Cleanup SDL resources
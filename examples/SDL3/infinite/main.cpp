@@ -3,90 +3,102 @@
 #include <iostream>
 #include <tmx/tmx.hpp>
 #include <filesystem>
+#include <memory>
+#include <string_view>
 #include "../common/sdl3_utils.hpp"
 
 int main(int argc, char* argv[])
 {
     std::cout << "TMX Parser SDL3 Infinite Map Rendering Example" << std::endl;
 
-    // Parse the infinite TMX file
+    // With --stream, chunks are loaded in the background around the camera instead of all up front
+    const bool streaming = argc > 1 && std::string_view(argv[1]) == "--stream";
+
     std::filesystem::path assetDir = ASSET_DIR;
-    auto result = tmx::Parser::parseFromFile(assetDir / "infinite/Interior1.tmx");
+    const auto mapPath = assetDir / "infinite/Interior1.tmx";
+
+    tmx::render::MapRenderData fullRenderData;
+    std::unique_ptr<tmx::render::ChunkStreamer> streamer;
+    tmx::render::RenderBounds mapBounds;
 
-    if (!result)
+    if (streaming)
     {
-        std::cerr << "Failed to parse TMX file: " << result.error() << std::endl;
-        return 1;
-    }
+        // Index the chunks once; tile data is decoded on demand
+        auto streamResult = tmx::render::ChunkStreamer::open(mapPath, (assetDir / "infinite").string());
+        if (!streamResult)
+        {
+            std::cerr << "Failed to index TMX file: " << streamResult.error() << std::endl;
+            return 1;
+        }
+        streamer = std::move(*streamResult);
 
-    const auto& map = *result;
+        size_t totalChunks = 0;
+        const auto tileWidth = static_cast<std::int32_t>(streamer->renderData().tileWidth);
+        const auto tileHeight = static_cast<std::int32_t>(streamer->renderData().tileHeight);
+        for (const auto& layer : streamer->chunkIndex())
+        {
+            totalChunks += layer.chunks.size();
+            for (const auto& chunk : layer.chunks)
+            {
+                mapBounds.merge({chunk.x * tileWidth, chunk.y * tileHeight,
+                                 (chunk.x + static_cast<std::int32_t>(chunk.width)) * tileWidth,
+                                 (chunk.y + static_cast<std::int32_t>(chunk.height)) * tileHeight});
+            }
+        }
+        std::cout << "Streaming infinite TMX map:" << std::endl;
+        std::cout << "  Indexed chunks: " << totalChunks << std::endl;
+    }
+    else
+    {
+        // Parse the infinite TMX file
+        auto result = tmx::Parser::parseFromFile(mapPath);
 
-    std::cout << "Successfully parsed infinite TMX map:" << std::endl;
-    std::cout << "  Infinite: " << (map.infinite ? "YES" : "NO") << std::endl;
-    std::cout << "  Size: " << map.width << "x" << map.height << " (tiles)" << std::endl;
-    std::cout << "  Tile size: " << map.tilewidth << "x" << map.tileheight << " (pixels)" << std::endl;
+        if (!result)
+        {
+            std::cerr << "Failed to parse TMX file: " << result.error() << std::endl;
+            return 1;
+        }
 
-    // Create render data (pre-calculate all tile positions from chunks)
-    std::cout << "Preparing render data..." << std::endl;
-    auto renderData = tmx::render::createRenderData(map, (assetDir / "infinite").string());
+        const auto& map = *result;
 
-    std::cout << "  Tilesets: " << renderData.tilesets.size() << std::endl;
-    std::cout << "  Layers: " << renderData.layers.size() << std::endl;
+        std::cout << "Successfully parsed infinite TMX map:" << std::endl;
+        std::cout << "  Infinite: " << (map.infinite ? "YES" : "NO") << std::endl;
+        std::cout << "  Size: " << map.width << "x" << map.height << " (tiles)" << std::endl;
+        std::cout << "  Tile size: " << map.tilewidth << "x" << map.tileheight << " (pixels)" << std::endl;
 
-    // Count chunks in layers
-    size_t totalChunks = 0;
-    for (const auto& layer : map.layers)
-    {
-        totalChunks += layer.chunks.size();
-    }
-    std::cout << "  Total chunks: " << totalChunks << std::endl;
+        // Create render data (pre-calculate all tile positions from chunks)
+        std::cout << "Preparing render data..." << std::endl;
+        fullRenderData = tmx::render::createRenderData(map, (assetDir / "infinite").string());
 
-    size_t totalTiles = 0;
-    for (const auto& layer : renderData.layers)
-    {
-        totalTiles += layer.tiles.size();
-    }
-    std::cout << "  Renderable tiles: " << totalTiles << std::endl;
+        std::cout << "  Tilesets: " << fullRenderData.tilesets.size() << std::endl;
+        std::cout << "  Layers: " << fullRenderData.layers.size() << std::endl;
 
-    // Calculate the bounding box of all tiles for window size
-    int minX = 0, minY = 0, maxX = 0, maxY = 0;
-    bool first = true;
+        // Count chunks in layers
+        size_t totalChunks = 0;
+        for (const auto& layer : map.layers)
+        {
+            totalChunks += layer.chunks.size();
+        }
+        std::cout << "  Total chunks: " << totalChunks << std::endl;
 
-    for (const auto& layer : renderData.layers)
-    {
-        for (const auto& tile : layer.tiles)
+        size_t totalTiles = 0;
+        size_t spatialChunks = 0;
+        for (const auto& layer : fullRenderData.layers)
         {
-            int tileX = static_cast<int>(tile.destX);
-            int tileY = static_cast<int>(tile.destY);
-            int tileRight = tileX + static_cast<int>(tile.destW);
-            int tileBottom = tileY + static_cast<int>(tile.destH);
+            totalTiles += layer.tiles.size();
+            spatialChunks += layer.chunks.size();
 
-            if (first)
-            {
-                minX = tileX;
-                minY = tileY;
-                maxX = tileRight;
-                maxY = tileBottom;
-                first = false;
-            }
-            else
-            {
-                minX = std::min(minX, tileX);
-                minY = std::min(minY, tileY);
-                maxX = std::max(maxX, tileRight);
-                maxY = std::max(maxY, tileBottom);
-            }
+            // Bounding box of all tiles, precomputed per layer
+            mapBounds.merge(layer.bounds);
         }
+        std::cout << "  Renderable tiles: " << totalTiles << std::endl;
+        std::cout << "  Spatial chunks: " << spatialChunks << " (" << fullRenderData.chunkSize << "x"
+            << fullRenderData.chunkSize << " tiles)" << std::endl;
     }
 
-    const int mapPixelWidth = maxX - minX;
-    const int mapPixelHeight = maxY - minY;
-    const int offsetX = -minX;
-    const int offsetY = -minY;
-
-    std::cout << "  Map bounds: " << minX << "," << minY << " to " << maxX << "," << maxY << std::endl;
-    std::cout << "  Map pixel size: " << mapPixelWidth << "x" << mapPixelHeight << std::endl;
-    std::cout << "  Render offset: " << offsetX << "," << offsetY << std::endl;
+    const auto& renderData = streamer ? streamer->renderData() : fullRenderData;
+    std::cout << "  Map bounds: " << mapBounds.minX << "," << mapBounds.minY << " to " << mapBounds.maxX << ","
+        << mapBounds.maxY << std::endl;
 
     // Initialize SDL3
     if (!tmx::sdl3::initSDL())
@@ -94,23 +106,10 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Create window and renderer - scale down if map is too large
-    constexpr int maxWindowWidth = 1280;
-    constexpr int maxWindowHeight = 720;
-
-    float scale = 1.0f;
-    int windowWidth = mapPixelWidth;
-    int windowHeight = mapPixelHeight;
-
-    if (windowWidth > maxWindowWidth || windowHeight > maxWindowHeight)
-    {
-        float scaleX = static_cast<float>(maxWindowWidth) / windowWidth;
-        float scaleY = static_cast<float>(maxWindowHeight) / windowHeight;
-        scale = std::min(scaleX, scaleY);
-        windowWidth = static_cast<int>(windowWidth * scale);
-        windowHeight = static_cast<int>(windowHeight * scale);
-        std::cout << "  Scaling to fit window: " << scale << "x" << std::endl;
-    }
+    // The window shows a fixed-size view of the world at 2x zoom; only chunks inside the view are drawn
+    constexpr int windowWidth = 960;
+    constexpr int windowHeight = 640;
+    constexpr float zoom = 2.0f;
 
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
@@ -126,24 +125,23 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Set render scale if needed
-    if (scale != 1.0f)
-    {
-        SDL_SetRenderScale(renderer, scale, scale);
-    }
+    SDL_SetRenderScale(renderer, zoom, zoom);
 
     // Load tileset textures
     auto tilesetTextures = tmx::sdl3::loadTilesetTextures(renderer, renderData);
 
     std::cout << "Rendering infinite map... Press ESC to quit, Arrow keys to pan." << std::endl;
 
-    // Camera position for panning
-    float cameraX = 0.0f;
-    float cameraY = 0.0f;
-    const float panSpeed = 10.0f;
+    // Camera position for panning, starting at the top-left corner of the map
+    float cameraX = static_cast<float>(mapBounds.minX);
+    float cameraY = static_cast<float>(mapBounds.minY);
+    const float panSpeed = 4.0f;
+    std::vector<tmx::render::ChunkRange> visibleChunks;
+    std::vector<const tmx::render::StreamedChunk*> streamedChunks;
+    tmx::sdl3::GeometryCache geometry;
 
-    // Animation state manager
-    tmx::sdl3::AnimationStateManager animationStates;
+    // Animation clock shared by all animated tiles
+    tmx::render::AnimationClock animationClock(renderData);
 
     // Main loop
     bool running = true;
@@ -158,7 +156,7 @@ int main(int argc, char* argv[])
         lastTime = currentTime;
 
         // Update animations
-        animationStates.update(deltaTime);
+        animationClock.tick(deltaTime);
 
         // Handle events
         while (SDL_PollEvent(&event))
@@ -199,76 +197,17 @@ int main(int argc, char* argv[])
         SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
         SDL_RenderClear(renderer);
 
-        // Render tiles using pre-calculated render data
-        for (const auto& layer : renderData.layers)
+        // Render the tiles of the chunks overlapping the camera
+        const tmx::render::ViewRect view = {cameraX, cameraY, windowWidth / zoom, windowHeight / zoom};
+        if (streamer)
         {
-            if (!layer.visible)
-                continue;
-
-            for (const auto& tile : layer.tiles)
-            {
-                // Get the tileset texture
-                if (tile.tilesetIndex >= tilesetTextures.size())
-                    continue;
-
-                SDL_Texture* texture = tilesetTextures[tile.tilesetIndex];
-                if (!texture)
-                    continue;
-
-                // Apply camera offset and map offset
-                SDL_FRect srcRect = {
-                    static_cast<float>(tile.srcX),
-                    static_cast<float>(tile.srcY),
-                    static_cast<float>(tile.srcW),
-                    static_cast<float>(tile.srcH)
-                };
-
-                SDL_FRect destRect = {
-                    static_cast<float>(tile.destX) + offsetX - cameraX,
-                    static_cast<float>(tile.destY) + offsetY - cameraY,
-                    static_cast<float>(tile.destW),
-                    static_cast<float>(tile.destH)
-                };
-
-                // Handle animations
-                if (tile.isAnimated && tile.animationIndex != static_cast<uint32_t>(-1))
-                {
-                    const auto& tilesetInfo = renderData.tilesets[tile.tilesetIndex];
-                    if (tile.animationIndex < tilesetInfo.animations.size())
-                    {
-                        const auto& animation = tilesetInfo.animations[tile.animationIndex];
-                        auto& animState = animationStates.getState(tile.tilesetIndex, tile.animationIndex);
-
-                        // Get current frame using helper method
-                        if (animation.totalDuration > 0)
-                        {
-                            uint32_t timeInCycle = animState.elapsedTime % animation.totalDuration;
-                            uint32_t currentFrameIndex = animation.getFrameIndexAtTime(timeInCycle);
-
-                            if (currentFrameIndex < animation.frames.size())
-                            {
-                                const auto& frame = animation.frames[currentFrameIndex];
-                                srcRect.x = static_cast<float>(frame.srcX);
-                                srcRect.y = static_cast<float>(frame.srcY);
-                            }
-                        }
-                    }
-                }
-
-                // Apply opacity if not fully opaque
-                if (tile.opacity < 1.0f)
-                {
-                    SDL_SetTextureAlphaModFloat(texture, tile.opacity);
-                }
-
-                SDL_RenderTexture(renderer, texture, &srcRect, &destRect);
-
-                // Reset opacity
-                if (tile.opacity < 1.0f)
-                {
-                    SDL_SetTextureAlphaModFloat(texture, 1.0f);
-                }
-            }
+            // Chunks still loading simply appear a few frames later
+            streamer->update(view);
+            tmx::sdl3::renderStreamedView(renderer, *streamer, tilesetTextures, animationClock, view, streamedChunks, geometry);
+        }
+        else
+        {
+            tmx::sdl3::renderView(renderer, renderData, tilesetTextures, animationClock, view, visibleChunks, geometry);
         }
 
         // Present
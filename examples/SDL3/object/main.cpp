@@ -70,8 +70,11 @@ int main(int argc, char* argv[])
     // Load tileset textures
     auto tilesetTextures = tmx::sdl3::loadTilesetTextures(renderer, renderData);
 
-    // Initialize animation state manager
-    tmx::sdl3::AnimationStateManager animationStates;
+    // Initialize the animation clock shared by all animated tiles
+    tmx::render::AnimationClock animationClock(renderData);
+
+    // Geometry buffers reused every frame for batched drawing
+    tmx::sdl3::GeometryCache geometry;
 
     std::cout << "Rendering map with objects... Press ESC to quit." << std::endl;
 
@@ -87,6 +90,9 @@ int main(int argc, char* argv[])
         const uint32_t deltaTime = currentTime - lastTime;
         lastTime = currentTime;
 
+        // Advance every animation once per frame
+        animationClock.tick(deltaTime);
+
         // Handle events
         while (SDL_PollEvent(&event))
         {
@@ -108,7 +114,7 @@ int main(int argc, char* argv[])
         SDL_RenderClear(renderer);
 
         // Render map layers using common rendering function
-        tmx::sdl3::renderMap(renderer, renderData, tilesetTextures, animationStates, deltaTime);
+        tmx::sdl3::renderMap(renderer, renderData, tilesetTextures, animationClock, geometry);
 
         // Render objects
         for (const auto& objectGroup : renderData.objectGroups)
@@ -186,28 +192,29 @@ int main(int argc, char* argv[])
                 case tmx::map::ObjectShape::Polygon:
                 case tmx::map::ObjectShape::Polyline:
                 {
-                    if (object.points.size() >= 2)
+                    const auto points = renderData.objectPoints(object);
+                    if (points.size() >= 2)
                     {
-                        for (size_t i = 0; i < object.points.size() - 1; ++i)
+                        for (size_t i = 0; i < points.size() - 1; ++i)
                         {
                             SDL_RenderLine(
                                 renderer,
-                                object.x + object.points[i].x,
-                                object.y + object.points[i].y,
-                                object.x + object.points[i + 1].x,
-                                object.y + object.points[i + 1].y
+                                object.x + points[i].x,
+                                object.y + points[i].y,
+                                object.x + points[i + 1].x,
+                                object.y + points[i + 1].y
                             );
                         }
                         
                         // Close the polygon
-                        if (object.shape == tmx::map::ObjectShape::Polygon && object.points.size() > 2)
+                        if (object.shape == tmx::map::ObjectShape::Polygon && points.size() > 2)
                         {
                             SDL_RenderLine(
                                 renderer,
-                                object.x + object.points.back().x,
-                                object.y + object.points.back().y,
-                                object.x + object.points[0].x,
-                                object.y + object.points[0].y
+                                object.x + points.back().x,
+                                object.y + points.back().y,
+                                object.x + points[0].x,
+                                object.y + points[0].y
                             );
                         }
                     }
@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <tmx/tmx.hpp>
+#include <tmx/Raster.hpp>
+
+// Headless map preview: draws a map into a PNG without a window or GPU
+// Usage: tmxparser_raster_example [map.tmx] [output.png] [scale] [time_ms]
+int main(int argc, char* argv[])
+{
+    const std::string mapPath = argc > 1 ? argv[1] : std::string(ASSET_DIR) + "object/island.tmx";
+    const std::string outputPath = argc > 2 ? argv[2] : "thumbnail.png";
+
+    auto result = tmx::Parser::parseFromFile(mapPath);
+    if (!result)
+    {
+        std::cerr << "Failed to parse TMX file: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Tileset images are resolved relative to the map
+    const auto renderData =
+        tmx::render::createRenderData(*result, std::filesystem::path(mapPath).parent_path().string());
+    tmx::raster::Rasterizer rasterizer(renderData);
+    if (auto loaded = rasterizer.loadTilesetImages(); !loaded)
+    {
+        std::cerr << "Failed to load tilesets: " << loaded.error() << std::endl;
+        return 1;
+    }
+
+    tmx::raster::RasterOptions options;
+    options.scale = argc > 3 ? std::strtof(argv[3], nullptr) : 0.5f;
+    options.time = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+    options.threadCount = 0;
+
+    const auto image = rasterizer.render(options);
+    if (!image)
+    {
+        std::cerr << "Failed to render map: " << image.error() << std::endl;
+        return 1;
+    }
+    if (auto written = tmx::raster::writePng(*image, outputPath); !written)
+    {
+        std::cerr << written.error() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << image->width << "x" << image->height << " preview to " << outputPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief Current source position of an animation, published once per tick
+    struct AnimationFrameSource
+    {
+        std::uint32_t srcX, srcY; // Source position of the current frame in the tileset (pixels)
+    };
+
+    /// @brief Shared clock that advances every tile animation of a map in one pass per tick
+    /// All tiles referencing the same animation show the same frame, so the frame is resolved once per
+    /// animation instead of once per tile. Time is kept in fixed point so that replaying the same sequence
+    /// of ticks, pauses and time scales always yields the same frames.
+    class AnimationClock
+    {
+    public:
+        AnimationClock() = default;
+
+        /// @brief Create a clock bound to the animations of the given render data
+        /// @param renderData Render data whose animations are advanced; must outlive the clock
+        explicit AnimationClock(const MapRenderData& renderData);
+
+        /// @brief Bind the clock to render data and rewind it to time zero
+        /// @param renderData Render data whose animations are advanced; must outlive the clock
+        void reset(const MapRenderData& renderData);
+
+        /// @brief Advance the clock and update the current frame of every animation whose frame changed
+        /// @param deltaTime Wall time elapsed since the last tick in milliseconds (ignored while paused)
+        void tick(std::uint32_t deltaTime);
+
+        /// @brief Jump to an absolute animation time, e.g. when seeking in a replay
+        /// @param time Animation time in milliseconds
+        void setTime(std::uint64_t time);
+
+        /// @brief Current animation time in milliseconds
+        [[nodiscard]] auto time() const -> std::uint64_t;
+
+        void setPaused(bool paused) { m_paused = paused; }
+        [[nodiscard]] auto isPaused() const -> bool { return m_paused; }
+
+        /// @brief Largest time scale the 16.16 fixed-point scale can hold
+        static constexpr float MAX_TIME_SCALE = 65535.0f;
+
+        /// @brief Set the global time scale (1.0 = real time); clamped to [0, MAX_TIME_SCALE], NaN stops the clock
+        void setTimeScale(float scale);
+        [[nodiscard]] auto timeScale() const -> float;
+
+        /// @brief Current frame source positions of a tileset, indexed by TileRenderInfo::animationIndex
+        [[nodiscard]] auto frames(std::uint32_t tilesetIndex) const -> std::span<const AnimationFrameSource>
+        {
+            return {m_frames.data() + m_tilesetOffsets[tilesetIndex],
+                    m_tilesetOffsets[tilesetIndex + 1] - m_tilesetOffsets[tilesetIndex]};
+        }
+
+        /// @brief Current frame source position of one animation
+        [[nodiscard]] auto frame(std::uint32_t tilesetIndex, std::uint32_t animationIndex) const
+            -> const AnimationFrameSource&
+        {
+            return m_frames[m_tilesetOffsets[tilesetIndex] + animationIndex];
+        }
+
+        /// @brief Animations whose frame changed during the last tick, reset or setTime
+        /// Combine with LayerRenderData::findAnimatedGroup to patch only the affected tiles
+        [[nodiscard]] auto changedAnimations() const -> std::span<const AnimationRef> { return m_changed; }
+
+        /// @brief Animation time in milliseconds at which the next frame change happens
+        /// @return The time, or std::nullopt if no animation will ever change frame
+        [[nodiscard]] auto nextChangeTime() const -> std::optional<std::uint64_t>;
+
+        /// @brief Wall time until the next frame change, taking pause and time scale into account
+        /// @return Milliseconds to wait, or std::nullopt if no frame change is pending (paused, zero scale, or static)
+        [[nodiscard]] auto timeUntilNextChange() const -> std::optional<std::uint64_t>;
+
+        /// @brief Current frame index (into TileAnimationInfo::frames) of one animation
+        [[nodiscard]] auto frameIndex(std::uint32_t tilesetIndex, std::uint32_t animationIndex) const
+            -> std::uint32_t
+        {
+            return m_frameIndices[m_tilesetOffsets[tilesetIndex] + animationIndex];
+        }
+
+    private:
+        static constexpr std::uint32_t FIXED_SHIFT = 16; // Fractional bits of time and time scale
+        static constexpr std::uint32_t FIXED_ONE = 1u << FIXED_SHIFT;
+
+        static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+        void update(bool force);
+
+        std::vector<const TileAnimationInfo*> m_animations; // Flattened over all tilesets
+        std::vector<AnimationRef> m_refs; // Tileset and animation index of each flattened animation
+        std::vector<std::uint32_t> m_tilesetOffsets{0}; // Start of each tileset in the flat arrays (+ end sentinel)
+        std::vector<AnimationFrameSource> m_frames;
+        std::vector<std::uint32_t> m_frameIndices;
+        std::vector<std::uint64_t> m_nextChanges; // Animation time (ms) of each animation's next frame change
+        std::vector<AnimationRef> m_changed;
+        std::uint64_t m_nextChangeTime = NEVER;
+        std::uint64_t m_time = 0; // Animation time in 1/65536 ms
+        std::uint32_t m_timeScale = FIXED_ONE; // Time scale in 1/65536 units
+        bool m_paused = false;
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "TileStore.hpp"
+
+namespace tmx::map
+{
+    /// @brief One bit per cell over a rectangle of tile coordinates, e.g. which cells are solid or walkable
+    /// Each row is stored as 64-bit words holding cell originX + i in bit i % 64 of word i / 64. Cells outside the
+    /// rectangle read as 0, so scans may run past the edges. Infinite maps use their chunk coordinates directly:
+    /// the origin may be negative.
+    class BitGrid
+    {
+    public:
+        BitGrid() = default;
+
+        /// @brief Create a grid of cleared cells
+        /// @param bounds Rectangle of tile coordinates covered by the grid
+        explicit BitGrid(const TileBounds& bounds);
+
+        [[nodiscard]] auto get(const std::int32_t x, const std::int32_t y) const -> bool
+        {
+            if (!m_bounds.contains(x, y))
+                return false;
+            const auto column = static_cast<std::uint32_t>(x - m_bounds.minX);
+            return (m_words[rowOffset(y) + (column >> 6)] >> (column & 63)) & 1;
+        }
+
+        /// @brief Set or clear a cell; cells outside the grid are ignored
+        void set(std::int32_t x, std::int32_t y, bool value);
+
+        /// @brief 64 consecutive cells of a row: bit i holds cell (x + i, y)
+        [[nodiscard]] auto word(const std::int32_t x, const std::int32_t y) const -> std::uint64_t
+        {
+            if (y < m_bounds.minY || y >= m_bounds.maxY)
+                return 0;
+            const std::int64_t column = static_cast<std::int64_t>(x) - m_bounds.minX;
+            const std::int64_t index = column >> 6; // Rounds down for negative columns
+            const auto shift = static_cast<std::uint32_t>(column & 63);
+            const std::size_t row = rowOffset(y);
+            const std::uint64_t low = wordAt(row, index) >> shift;
+            return shift == 0 ? low : low | (wordAt(row, index + 1) << (64 - shift));
+        }
+
+        /// @brief The same cells with x and y swapped, so columns can be scanned as rows
+        [[nodiscard]] auto transposed() const -> BitGrid;
+
+        /// @brief The same rectangle with every cell flipped
+        [[nodiscard]] auto inverted() const -> BitGrid;
+
+        /// @brief Number of set cells
+        [[nodiscard]] auto count() const -> std::size_t;
+
+        [[nodiscard]] auto bounds() const -> const TileBounds& { return m_bounds; }
+        [[nodiscard]] auto width() const -> std::uint32_t { return static_cast<std::uint32_t>(m_bounds.maxX - m_bounds.minX); }
+        [[nodiscard]] auto height() const -> std::uint32_t { return static_cast<std::uint32_t>(m_bounds.maxY - m_bounds.minY); }
+        [[nodiscard]] auto wordsPerRow() const -> std::uint32_t { return m_wordsPerRow; }
+
+        /// @brief Words of one row, with the bits past the right edge cleared
+        [[nodiscard]] auto row(const std::int32_t y) const -> std::span<const std::uint64_t>
+        {
+            return {m_words.data() + rowOffset(y), m_wordsPerRow};
+        }
+
+    private:
+        [[nodiscard]] auto rowOffset(const std::int32_t y) const -> std::size_t
+        {
+            return static_cast<std::size_t>(y - m_bounds.minY) * m_wordsPerRow;
+        }
+
+        [[nodiscard]] auto wordAt(const std::size_t row, const std::int64_t index) const -> std::uint64_t
+        {
+            return index < 0 || index >= m_wordsPerRow ? 0 : m_words[row + static_cast<std::size_t>(index)];
+        }
+
+        TileBounds m_bounds;
+        std::uint32_t m_wordsPerRow = 0;
+        std::vector<std::uint64_t> m_words; // Row-major
+    };
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <tl/expected.hpp>
+#include "Map.hpp"
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief Location of one <chunk> element in a TMX file
+    struct ChunkIndexEntry
+    {
+        std::int32_t x, y; // Position of the chunk in tiles
+        std::uint32_t width, height; // Size of the chunk in tiles
+        std::uint64_t offset; // Byte offset of the chunk's encoded text in the file
+        std::uint64_t length; // Byte length of the chunk's encoded text
+    };
+
+    /// @brief Chunks of one tile layer, as found by a single scan of the file
+    struct LayerChunkIndex
+    {
+        std::string encoding; // Encoding of the layer's <data> element
+        std::string compression; // Compression of the layer's <data> element
+        std::vector<ChunkIndexEntry> chunks; // Sorted by y, then x; empty for finite layers
+        std::uint32_t maxChunkWidth = 0; // Largest chunk size, bounds the search for chunks overlapping a view
+        std::uint32_t maxChunkHeight = 0;
+    };
+
+    /// @brief Options controlling which chunks a ChunkStreamer keeps in memory
+    struct ChunkStreamOptions
+    {
+        float loadRadius = 256.0f; // Chunks within this many pixels of the view are loaded ahead of time
+        float evictRadius = 1024.0f; // Chunks farther than this many pixels from the view are always evicted
+        std::size_t memoryBudget = 64u * 1024u * 1024u; // Bytes of chunk render data kept before evicting LRU chunks
+        RenderBuildOptions buildOptions{}; // Storage and spatial chunk size of streamed layers
+    };
+
+    /// @brief Render data of one loaded chunk
+    struct StreamedChunk
+    {
+        std::uint32_t layerIndex; // Index into MapRenderData::layers
+        std::uint32_t chunkIndex; // Index into LayerChunkIndex::chunks
+        LayerRenderData layer; // Tiles of this chunk only; visit with MapRenderData::forEachTile
+        std::size_t memoryUsage = 0; // Bytes used by the chunk's render data
+        std::uint64_t lastUsed = 0; // Update in which the chunk was last within the load radius
+    };
+
+    /// @brief Streams the chunks of an infinite map around a moving view
+    /// The file is scanned once to index the byte range of every chunk; tilesets, layer attributes and object
+    /// groups are parsed as usual. Chunks are then decoded and turned into render data on a background thread as
+    /// the view moves, so memory stays proportional to the area around the view instead of the whole world.
+    /// Views are mapped to chunks as on an orthogonal map; streamed tiles are still placed by the map's projection.
+    class ChunkStreamer
+    {
+    public:
+        /// @brief Index a TMX file and start the loader thread
+        /// @param path Path of the TMX file; it is kept open and must not change while streaming
+        /// @param assetBasePath Optional base path for resolving relative tileset image paths
+        /// @param options Load and eviction radii, memory budget and build options
+        /// @return The streamer, or an error if the file cannot be read or parsed
+        static auto open(const std::filesystem::path& path, const std::string& assetBasePath = "",
+                         const ChunkStreamOptions& options = {}) -> tl::expected<std::unique_ptr<ChunkStreamer>, std::string>;
+
+        ~ChunkStreamer();
+
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        auto operator=(const ChunkStreamer&) -> ChunkStreamer& = delete;
+
+        /// @brief The parsed map without chunk data (tilesets, layer attributes, finite layers and object groups)
+        [[nodiscard]] auto map() const -> const map::Map& { return m_map; }
+
+        /// @brief Render data of the map; chunked layers are empty, their tiles live in the streamed chunks
+        [[nodiscard]] auto renderData() const -> const MapRenderData& { return m_renderData; }
+
+        /// @brief Chunk index of every layer, parallel to map().layers
+        [[nodiscard]] auto chunkIndex() const -> std::span<const LayerChunkIndex> { return m_index; }
+
+        /// @brief Move the view: adopt finished chunks, queue missing ones by distance and evict far ones
+        /// Call once per frame from the thread that renders.
+        /// @param view Visible part of the map in pixels
+        void update(const ViewRect& view);
+
+        /// @brief Block until every queued chunk has been loaded, then adopt them
+        void waitUntilIdle();
+
+        /// @brief Loaded chunks overlapping a view, in layer order
+        /// @param view Visible part of the map in pixels
+        /// @param chunks Receives the chunks; cleared first so it can be reused every frame
+        void visibleChunks(const ViewRect& view, std::vector<const StreamedChunk*>& chunks) const;
+
+        /// @brief Number of loaded chunks
+        [[nodiscard]] auto residentCount() const -> std::size_t { return m_resident.size(); }
+
+        /// @brief Bytes of render data held by loaded chunks
+        [[nodiscard]] auto memoryUsage() const -> std::size_t { return m_memoryUsage; }
+
+        /// @brief Number of chunks queued or being loaded
+        [[nodiscard]] auto pendingCount() const -> std::size_t;
+
+        /// @brief First error met while loading a chunk, or an empty string
+        [[nodiscard]] auto error() const -> std::string;
+
+    private:
+        static constexpr std::uint64_t NONE = ~std::uint64_t{0};
+
+        struct LoadRequest
+        {
+            std::uint32_t layerIndex;
+            std::uint32_t chunkIndex;
+        };
+
+        ChunkStreamer() = default;
+
+        static auto key(std::uint32_t layerIndex, std::uint32_t chunkIndex) -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(layerIndex) << 32) | chunkIndex;
+        }
+
+        // The view in a layer's own coordinates, for layers with an offset or parallax, grown by margin pixels
+        [[nodiscard]] auto layerRect(std::uint32_t layerIndex, const ViewRect& view, float margin) const -> ViewRect;
+
+        template <typename Callback>
+        void forEachChunkIn(std::uint32_t layerIndex, const ViewRect& rect, Callback&& callback) const;
+
+        void run(std::stop_token stopToken);
+        auto load(const LoadRequest& request) -> tl::expected<StreamedChunk, std::string>;
+        void adoptLoaded(); // Requires m_mutex
+        void evict(const ViewRect& view);
+
+        map::Map m_map;
+        MapRenderData m_renderData;
+        std::vector<LayerChunkIndex> m_index;
+        ChunkStreamOptions m_options;
+        std::ifstream m_file; // Only read by the loader thread
+
+        std::unordered_map<std::uint64_t, StreamedChunk> m_resident;
+        std::size_t m_memoryUsage = 0;
+        std::uint64_t m_updateCount = 0;
+
+        mutable std::mutex m_mutex; // Guards everything below
+        std::condition_variable_any m_wakeLoader;
+        std::condition_variable m_idle;
+        std::deque<LoadRequest> m_queue; // Closest chunks first
+        std::vector<StreamedChunk> m_loaded; // Finished chunks waiting to be adopted by update
+        std::uint64_t m_inFlight = NONE; // Key of the chunk being loaded
+        std::string m_error;
+
+        std::jthread m_loader; // Declared last so it stops before the state it uses is destroyed
+    };
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "BitGrid.hpp"
+#include "Map.hpp"
+
+namespace tmx::map
+{
+    /// @brief Solid rectangle in tile coordinates
+    struct CollisionRect
+    {
+        std::int32_t x, y; // Top-left cell
+        std::int32_t width, height; // Size in tiles
+    };
+
+    /// @brief Solid rectangle in pixels, ready for a physics broadphase
+    struct CollisionBox
+    {
+        float minX, minY;
+        float maxX, maxY;
+    };
+
+    /// @brief Options for bakeCollision
+    struct CollisionOptions
+    {
+        std::string solidProperty = "solid"; // Tiles whose bool property of this name is true are solid on any layer;
+                                             // empty to rely on solid layers only
+        bool includeHidden = false; // Whether invisible layers contribute solid tiles
+        bool solidShapes = false; // Whether tiles with collision shapes (Tileset::shapes) are solid on any layer
+    };
+
+    /// @brief Solid cells of a map merged into few non-overlapping rectangles
+    struct CollisionMap
+    {
+        std::vector<CollisionRect> rects; // Ordered by top row, then left column
+        std::uint32_t tileWidth = 0, tileHeight = 0; // Map tile size (pixels)
+        std::size_t solidTileCount = 0; // Number of solid cells covered by rects
+        TileBounds bounds; // Bounds of the solid cells
+
+        /// @brief Rectangles in pixels, for orthogonal maps
+        [[nodiscard]] auto boxes() const -> std::vector<CollisionBox>
+        {
+            std::vector<CollisionBox> result;
+            result.reserve(rects.size());
+            const auto w = static_cast<float>(tileWidth);
+            const auto h = static_cast<float>(tileHeight);
+            for (const auto& rect : rects)
+            {
+                result.push_back({static_cast<float>(rect.x) * w, static_cast<float>(rect.y) * h,
+                                  static_cast<float>(rect.x + rect.width) * w,
+                                  static_cast<float>(rect.y + rect.height) * h});
+            }
+            return result;
+        }
+    };
+
+    /// @brief Cells covered by the layers of a map: the union of finite layer sizes and infinite chunks, or the map
+    /// size if no layer has tiles
+    [[nodiscard]] auto layerBounds(const Map& map) -> TileBounds;
+
+    /// @brief Cells covered by one layer: its finite size, or the union of its chunks (empty if it has no tiles)
+    [[nodiscard]] auto layerBounds(const Layer& layer) -> TileBounds;
+
+    /// @brief Solid cells of a map as a bitmap over layerBounds
+    /// A cell is solid if a layer marked in solidLayers has a tile there, or if the tile of any layer has the solid
+    /// property.
+    /// @param map Parsed map
+    /// @param solidLayers One flag per map layer; non-zero if every tile of the layer is solid. May be shorter than
+    ///                    the layer list.
+    /// @param options Solid property and layer visibility
+    [[nodiscard]] auto bakeSolidity(const Map& map, std::span<const std::uint8_t> solidLayers,
+                                    const CollisionOptions& options = {}) -> BitGrid;
+
+    /// @brief Cells of one layer that hold a tile, as a bitmap over the layer's own bounds
+    /// Infinite layers keep their chunk coordinates, so the bitmap origin may be negative.
+    [[nodiscard]] auto bakeSolidity(const Layer& layer) -> BitGrid;
+
+    /// @brief Merge the solid cells of a map into axis-aligned rectangles with greedy meshing
+    /// Solid cells are those of bakeSolidity; finite data and infinite chunks are handled alike. Starting from the
+    /// top-left, each free solid cell grows a rectangle as far right as possible, then down for as long as the whole
+    /// row below is solid. Rows are scanned 64 cells at a time.
+    /// @param map Parsed map
+    /// @param solidLayers One flag per map layer; non-zero if every tile of the layer is solid
+    /// @param options Solid property and layer visibility
+    [[nodiscard]] auto bakeCollision(const Map& map, std::span<const std::uint8_t> solidLayers,
+                                     const CollisionOptions& options = {}) -> CollisionMap;
+
+    /// @brief Merge the cells of tiles with the solid property into rectangles
+    [[nodiscard]] inline auto bakeCollision(const Map& map, const CollisionOptions& options = {}) -> CollisionMap
+    {
+        return bakeCollision(map, std::span<const std::uint8_t>{}, options);
+    }
+
+    /// @brief Merge the cells of solid layers, and of tiles with the solid property, into rectangles
+    /// @param isSolidLayer Callable invoked with each const Layer&; returns true if every tile of it is solid
+    template <typename LayerPredicate>
+        requires std::predicate<LayerPredicate&, const Layer&>
+    [[nodiscard]] auto bakeCollision(const Map& map, LayerPredicate&& isSolidLayer, const CollisionOptions& options = {})
+        -> CollisionMap
+    {
+        std::vector<std::uint8_t> solidLayers(map.layers.size(), 0);
+        for (std::size_t i = 0; i < map.layers.size(); ++i)
+            solidLayers[i] = isSolidLayer(map.layers[i]) ? 1 : 0;
+        return bakeCollision(map, std::span<const std::uint8_t>(solidLayers), options);
+    }
+}
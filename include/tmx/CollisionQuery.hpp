@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include "BitGrid.hpp"
+#include "CollisionBaker.hpp"
+
+namespace tmx::map
+{
+    /// @brief Segment from (x, y) to (x + dx, y + dy), in pixels
+    struct Ray
+    {
+        float x, y;
+        float dx, dy;
+    };
+
+    /// @brief First solid cell along a ray
+    struct RayHit
+    {
+        bool hit = false;
+        float fraction = 1.0f; // Where the ray enters the cell, from 0 at its start to 1 at its end
+        std::int32_t tileX = 0, tileY = 0; // Cell that was hit
+        std::int32_t normalX = 0, normalY = 0; // Side of the cell that was entered; 0, 0 if the ray starts inside it
+    };
+
+    /// @brief First solid cell touched by a moving box
+    struct SweepHit
+    {
+        bool hit = false;
+        float fraction = 1.0f; // Part of the move made before touching the cell
+        std::int32_t tileX = 0, tileY = 0;
+        std::int32_t normalX = 0, normalY = 0; // Side of the cell that was touched
+    };
+
+    /// @brief Movement left to a box after sliding along the solid cells in its way
+    struct MoveResult
+    {
+        float dx = 0.0f, dy = 0.0f; // Movement actually made
+        bool blockedX = false, blockedY = false; // Whether a wall stopped the horizontal or vertical movement
+    };
+
+    /// @brief Ray and box queries against the solid cells of a tile layer or map
+    /// Solid cells are kept as a bitmap, in tile coordinates that may be negative for infinite maps; positions are
+    /// in pixels, with tile (x, y) covering [x * tileWidth, (x + 1) * tileWidth) horizontally. Queries are const
+    /// and may run on several threads at once.
+    class CollisionQuery
+    {
+    public:
+        /// @brief Distance in pixels within which boxes count as touching a cell rather than overlapping it
+        static constexpr float CONTACT_EPSILON = 1.0f / 1024.0f;
+
+        CollisionQuery() = default;
+
+        /// @param solid Solid cells
+        /// @param tileWidth Cell width in pixels
+        /// @param tileHeight Cell height in pixels
+        CollisionQuery(BitGrid solid, std::uint32_t tileWidth, std::uint32_t tileHeight);
+
+        /// @brief Query the cells of a layer that hold a tile, with the map's tile size
+        [[nodiscard]] static auto fromLayer(const Map& map, const Layer& layer) -> CollisionQuery
+        {
+            return {bakeSolidity(layer), map.tilewidth, map.tileheight};
+        }
+
+        /// @brief Query the solid cells of a map, as defined by bakeSolidity
+        [[nodiscard]] static auto fromMap(const Map& map, std::span<const std::uint8_t> solidLayers,
+                                          const CollisionOptions& options = {}) -> CollisionQuery
+        {
+            return {bakeSolidity(map, solidLayers, options), map.tilewidth, map.tileheight};
+        }
+
+        /// @brief Whether the cell holding a pixel is solid
+        [[nodiscard]] auto isSolidAt(float x, float y) const -> bool;
+
+        /// @brief Find the first solid cell along a ray by stepping through the cells it crosses (DDA)
+        [[nodiscard]] auto raycast(const Ray& ray) const -> RayHit;
+
+        /// @brief Cast many rays, four at a time with SSE2 where available; results match single raycasts exactly
+        /// @param hits Receives one result per ray; only the first min(rays.size(), hits.size()) rays are cast
+        void raycast(std::span<const Ray> rays, std::span<RayHit> hits) const;
+
+        /// @brief Whether the segment between two points crosses no solid cell
+        [[nodiscard]] auto lineOfSight(const float x0, const float y0, const float x1, const float y1) const -> bool
+        {
+            return !raycast({x0, y0, x1 - x0, y1 - y0}).hit;
+        }
+
+        /// @brief Find the first solid cell a box touches while moving in a straight line
+        /// Cells the box already overlaps are ignored, so boxes that start inside a wall can leave it.
+        [[nodiscard]] auto sweep(const CollisionBox& box, float dx, float dy) const -> SweepHit;
+
+        /// @brief Move a box as far as it goes, sliding along walls, as a character controller would
+        /// The box sweeps until it touches a wall, drops the part of the movement going into it, and sweeps on with
+        /// the rest, at most once per axis.
+        [[nodiscard]] auto move(const CollisionBox& box, float dx, float dy) const -> MoveResult;
+
+        [[nodiscard]] auto solid() const -> const BitGrid& { return m_solid; }
+        [[nodiscard]] auto tileWidth() const -> float { return m_tileWidth; }
+        [[nodiscard]] auto tileHeight() const -> float { return m_tileHeight; }
+
+    private:
+        BitGrid m_solid;
+        float m_tileWidth = 1.0f, m_tileHeight = 1.0f;
+    };
+}
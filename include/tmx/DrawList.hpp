@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief What a draw list source holds
+    enum class DrawSourceKind : std::uint8_t
+    {
+        TileLayer, // Tiles of one of MapRenderData::layers
+        ObjectGroup // Tile objects of one of MapRenderData::objectGroups
+    };
+
+    /// @brief A tile layer or object group drawn through a DrawList
+    struct DrawSource
+    {
+        DrawSourceKind kind;
+        std::uint32_t index; // Index into MapRenderData::layers or MapRenderData::objectGroups
+        std::uint32_t band = 0; // Sources of one band are depth-sorted together; bands are drawn in increasing order
+    };
+
+    /// @brief One tile or tile object of a draw list
+    struct DrawItem
+    {
+        std::uint64_t key; // Band (8 bits), depth (32 bits) and horizontal position (24 bits), compared as one integer
+        std::uint32_t source; // Index into DrawList::sources
+        std::uint32_t index; // Index into the layer's tiles, packedTiles or gids, or into the group's objects
+    };
+
+    /// @brief Tiles and tile objects of several layers merged into one list in drawing order
+    /// Within a band, items are ordered by the bottom edge of their tile (the anchor of tile objects, projected to the
+    /// screen), top to bottom for the map's "down" render orders and bottom to top for the "up" ones, then by x
+    /// following the render order's horizontal direction, then by source and index. Object groups with
+    /// map::DrawOrder::Index are drawn after the depth-sorted items of their band, in group order. Items are sorted
+    /// with an LSD radix sort on their keys.
+    class DrawList
+    {
+    public:
+        static constexpr std::uint32_t MAX_BAND = 255;
+
+        DrawList() = default;
+
+        /// @brief Create an empty list for the given render data
+        /// @param renderData Render data whose layers and objects are drawn; must outlive the list
+        explicit DrawList(const MapRenderData& renderData);
+
+        /// @brief Bind the list to other render data and drop every item
+        /// @param renderData Render data whose layers and objects are drawn; must outlive the list
+        void reset(const MapRenderData& renderData);
+
+        /// @brief Render data the list is bound to, or nullptr
+        [[nodiscard]] auto renderData() const -> const MapRenderData* { return m_renderData; }
+
+        /// @brief Every tile layer in a band of its own, in layer order, with every object group in the band of the
+        /// last tile layer, so objects interleave with the topmost layer (e.g. walls and trees) only
+        [[nodiscard]] static auto defaultSources(const MapRenderData& renderData) -> std::vector<DrawSource>;
+
+        /// @brief Collect and sort the tiles of visible layers and the tile objects of visible object groups
+        /// Invisible objects are kept, so toggling ObjectRenderInfo::visible needs no rebuild. Build again after
+        /// editing tiles, adding or removing objects, or changing layer visibility.
+        /// @param sources Layers and object groups to draw, each listed once; bands above MAX_BAND are clamped
+        void build(std::span<const DrawSource> sources);
+
+        /// @brief Collect and sort the items of defaultSources
+        void build();
+
+        /// @brief Move objects whose position changed to their new place in the list
+        /// A few objects are moved one by one with a binary search and a rotation of the items between their old
+        /// and new places; when many move, the list is sorted again from scratch. Either way the result is the same
+        /// as build(). Objects not in the list are ignored.
+        /// @param moved Objects whose ObjectRenderInfo::x or y changed since the last build or update
+        void update(std::span<const ObjectRef> moved);
+
+        /// @brief Items in drawing order
+        [[nodiscard]] auto items() const -> std::span<const DrawItem> { return m_items; }
+
+        /// @brief Sources of the last build
+        [[nodiscard]] auto sources() const -> std::span<const DrawSource> { return m_sources; }
+
+        /// @brief Visit every item in drawing order
+        /// @param visitor Callable invoked with a const TileRenderInfo& per tile and a const ObjectRenderInfo& per
+        ///                tile object
+        template <typename Visitor>
+        void forEachItem(Visitor&& visitor) const
+        {
+            if (!m_renderData)
+                return;
+
+            const MapRenderData& renderData = *m_renderData;
+            withProjection(renderData.projection, [&](const auto& grid)
+            {
+                for (const DrawItem& item : m_items)
+                {
+                    const DrawSource& source = m_sources[item.source];
+                    if (source.kind == DrawSourceKind::ObjectGroup)
+                    {
+                        visitor(renderData.objectGroups[source.index].objects[item.index]);
+                    }
+                    else
+                    {
+                        const TileRenderInfo tile = tileOf(renderData.layers[source.index], item.index, grid);
+                        visitor(tile);
+                    }
+                }
+            });
+        }
+
+    private:
+        static constexpr std::uint64_t NOT_LISTED = ~0ull;
+        static constexpr std::uint32_t NO_SOURCE = 0xFFFFFFFFu;
+
+        // Full record of the tile an item refers to
+        template <typename Projection>
+        auto tileOf(const LayerRenderData& layer, const std::uint32_t index, const Projection& grid) const
+            -> TileRenderInfo
+        {
+            if (layer.storage == TileStorage::Full)
+                return layer.tiles[index];
+            if (layer.storage == TileStorage::Packed)
+                return m_renderData->unpack(layer.packedTiles[index], layer.opacity);
+
+            // Blocks are stored in the order of their offsets
+            const auto block = std::ranges::upper_bound(layer.tileBlocks, index, {}, &TileBlock::offset) - 1;
+            const std::uint32_t cell = index - block->offset;
+            const ScreenPoint dest = grid.toScreen(block->x + static_cast<std::int32_t>(cell % block->width),
+                                                   block->y + static_cast<std::int32_t>(cell / block->width));
+            return m_renderData->makeTile(*m_renderData->gidInfo(layer.gids[index]), dest, layer.gids[index],
+                                          layer.opacity);
+        }
+
+        [[nodiscard]] auto sortKey(std::uint32_t band, std::int32_t depth, std::int32_t x) const -> std::uint64_t;
+        [[nodiscard]] auto objectKey(const DrawSource& source, const ObjectRenderInfo& object) const -> std::uint64_t;
+        void collect();
+        void radixSort();
+
+        const MapRenderData* m_renderData = nullptr;
+        std::vector<DrawSource> m_sources;
+        std::vector<DrawItem> m_items;
+        std::vector<DrawItem> m_scratch; // Second buffer of the radix sort, kept to avoid allocating per sort
+        std::vector<std::uint32_t> m_groupSources; // Source of every object group, or NO_SOURCE
+        std::vector<std::uint32_t> m_objectKeyOffsets; // First entry of every object group in m_objectKeys
+        std::vector<std::uint64_t> m_objectKeys; // Current key of every object, or NOT_LISTED
+    };
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <tl/expected.hpp>
+#include "AnimationClock.hpp"
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief Interleaved vertex of a tile quad: position, texture coordinates, color
+    struct GeometryVertex
+    {
+        float x, y; // Position in pixels, relative to GeometryOptions::originX/originY and the layer's offset/parallax
+        float u, v; // Texture coordinates in the tileset image (0-1, or pixels when not normalized)
+        float r, g, b, a; // Vertex color: the layer tint; alpha carries the layer opacity
+    };
+
+    /// @brief Consecutive vertices and indices drawn with one tileset texture
+    struct GeometryBatch
+    {
+        static constexpr std::uint32_t NO_LAYER = 0xFFFFFFFFu;
+
+        std::uint32_t layerIndex; // Index into MapRenderData::layers for query results, NO_LAYER for a single layer
+        std::uint32_t tilesetIndex; // Tileset whose texture the batch is drawn with
+        std::uint32_t firstVertex, vertexCount; // Range of GeometryBuffers::vertices
+        std::uint32_t firstIndex, indexCount; // Range of GeometryBuffers::indices; indices are relative to firstVertex
+    };
+
+    /// @brief Number of vertices, indices and batches written, or needed, by a GeometryEmitter
+    struct GeometryCounts
+    {
+        std::size_t vertexCount = 0;
+        std::size_t indexCount = 0;
+        std::size_t batchCount = 0;
+    };
+
+    /// @brief Caller-owned output arrays of a GeometryEmitter
+    struct GeometryBuffers
+    {
+        std::span<GeometryVertex> vertices;
+        std::span<std::uint32_t> indices;
+        std::span<GeometryBatch> batches;
+    };
+
+    /// @brief Options controlling the emitted geometry
+    struct GeometryOptions
+    {
+        float originX = 0.0f, originY = 0.0f; // Map position emitted at (0, 0), e.g. the top-left corner of the view
+        const AnimationClock* animationClock = nullptr; // Current frame of animated tiles; nullptr uses the base tile
+        bool normalizedUv = true; // Divide texture coordinates by the tileset image size (when known)
+    };
+
+    /// @brief Turns tiles into indexed quads, one batch per tileset and layer, for one draw call per batch
+    /// Quads follow the layer order within a batch. Vertices are top-left, top-right, bottom-right, bottom-left;
+    /// flip flags only permute the texture coordinates, as Tiled applies them (diagonal flip first).
+    class GeometryEmitter
+    {
+    public:
+        GeometryEmitter() = default;
+
+        /// @brief Create an emitter for the layers of the given render data
+        /// @param renderData Render data whose layers are emitted; must outlive the emitter
+        explicit GeometryEmitter(const MapRenderData& renderData);
+
+        /// @brief Bind the emitter to other render data
+        /// @param renderData Render data whose layers are emitted; must outlive the emitter
+        void reset(const MapRenderData& renderData);
+
+        /// @brief Render data the emitter is bound to, or nullptr
+        [[nodiscard]] auto renderData() const -> const MapRenderData* { return m_renderData; }
+
+        /// @brief Sizes the buffers need to hold the geometry of a layer
+        /// @param layer Layer of the bound render data, or a streamed chunk built against it
+        [[nodiscard]] auto measure(const LayerRenderData& layer) -> GeometryCounts;
+
+        /// @brief Sizes the buffers need to hold the geometry of the visible layers of a query result
+        /// @param ranges Chunk ranges returned by MapRenderData::query
+        [[nodiscard]] auto measure(std::span<const ChunkRange> ranges) -> GeometryCounts;
+
+        /// @brief Write the geometry of a layer into caller-provided buffers
+        /// @param layer Layer of the bound render data, or a streamed chunk built against it
+        /// @param buffers Output arrays, written from their start
+        /// @param options Origin, animation clock and texture coordinate mode
+        /// @return The counts written, or an error if the buffers are too small (nothing is written then)
+        auto emit(const LayerRenderData& layer, const GeometryBuffers& buffers, const GeometryOptions& options = {})
+            -> tl::expected<GeometryCounts, std::string>;
+
+        /// @brief Write the geometry of the visible layers of a query result into caller-provided buffers
+        /// @param ranges Chunk ranges returned by MapRenderData::query
+        /// @param buffers Output arrays, written from their start
+        /// @param options Origin, animation clock and texture coordinate mode
+        /// @return The counts written, or an error if the buffers are too small (nothing is written then)
+        auto emit(std::span<const ChunkRange> ranges, const GeometryBuffers& buffers, const GeometryOptions& options = {})
+            -> tl::expected<GeometryCounts, std::string>;
+
+    private:
+        struct Cursor
+        {
+            std::uint32_t batch; // Batch of the tileset in the current layer
+            std::uint32_t vertex; // Next vertex to write
+        };
+
+        template <typename VisitGroup>
+        void forEachRangeGroup(std::span<const ChunkRange> ranges, VisitGroup& visitGroup) const;
+
+        template <typename ForEachGroup>
+        auto count(ForEachGroup&& forEachGroup) -> GeometryCounts;
+
+        template <typename ForEachGroup>
+        auto write(ForEachGroup&& forEachGroup, const GeometryBuffers& buffers, const GeometryOptions& options)
+            -> tl::expected<GeometryCounts, std::string>;
+
+        const MapRenderData* m_renderData = nullptr;
+        std::vector<std::uint32_t> m_tileCounts; // Tiles per tileset of every emitted layer, from the last count
+        std::vector<Cursor> m_cursors; // Write position per tileset of the layer being written
+    };
+}
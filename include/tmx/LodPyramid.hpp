@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <tl/expected.hpp>
+#include "Raster.hpp"
+
+namespace tmx::raster
+{
+    /// @brief Options controlling the levels of a LodPyramid
+    struct LodOptions
+    {
+        std::uint32_t levelCount = 4; // Level k holds the map at 1/2^(k+1) of its resolution (0 is treated as 1)
+        std::uint64_t time = 0; // Animation time baked into the images, in milliseconds
+        bool drawObjects = false; // Bake tile objects too; objects are not tracked by dirty regions
+        std::uint32_t threadCount = 1; // Threads drawing each chunk; 0 uses every hardware thread
+    };
+
+    /// @brief Pre-baked images of one spatial chunk of the map, one per level
+    struct LodChunk
+    {
+        std::int32_t chunkX, chunkY; // Chunk coordinates, as in render::SpatialChunk
+        render::RenderBounds bounds; // Map pixels covered by the chunk square
+        std::vector<Image> levels; // levels[k] is the chunk at LodPyramid::levelScale(k), straight alpha
+    };
+
+    /// @brief Mip pyramid of composed chunk images, for drawing zoomed-out views without visiting every tile
+    /// Each chunk-sized square of the map that tiles are drawn into, layer offsets included, is drawn once at full
+    /// resolution with a Rasterizer, then halved repeatedly with a 2x2 box filter in premultiplied alpha. Below
+    /// LodPyramid::levelForZoom's threshold a renderer draws one image per visible chunk instead of its tiles. Edits
+    /// are applied per chunk with update().
+    /// Chunk squares follow the orthogonal grid; other orientations are not supported.
+    class LodPyramid
+    {
+    public:
+        LodPyramid() = default;
+
+        /// @brief Create an empty pyramid drawing with the given rasterizer
+        /// @param rasterizer Rasterizer bound to the render data and its tileset images; must outlive the pyramid
+        /// @param options Level count, baked animation time and threads
+        explicit LodPyramid(const Rasterizer& rasterizer, const LodOptions& options = {});
+
+        /// @brief Bind the pyramid to another rasterizer and drop every chunk image
+        void reset(const Rasterizer& rasterizer, const LodOptions& options = {});
+
+        /// @brief Draw every chunk of every layer
+        /// @return Nothing, or the error of the first chunk that could not be drawn
+        auto build() -> tl::expected<void, std::string>;
+
+        /// @brief Redraw only the chunks touched by edits, e.g. MapRenderData::dirtyRegions
+        /// Chunks no layer has any more are dropped; new chunks are added. The regions are not cleared.
+        /// @param regions Edited chunks; several regions of the same chunk redraw it once
+        /// @return The number of chunks redrawn or dropped, or the error of the first chunk that could not be drawn
+        auto update(std::span<const render::DirtyRegion> regions) -> tl::expected<std::size_t, std::string>;
+
+        [[nodiscard]] auto levelCount() const -> std::uint32_t { return m_options.levelCount; }
+
+        /// @brief Output pixels per map pixel of a level
+        [[nodiscard]] static auto levelScale(std::uint32_t level) -> float
+        {
+            return 1.0f / static_cast<float>(2u << level);
+        }
+
+        /// @brief Level to draw at a zoom, the smallest one that is not magnified
+        /// @param zoom Output pixels per map pixel
+        /// @return The level, or std::nullopt above half resolution, where tiles should be drawn instead
+        [[nodiscard]] auto levelForZoom(float zoom) const -> std::optional<std::uint32_t>;
+
+        /// @brief Images of one chunk
+        /// @return The chunk, or nullptr if no layer has tiles in it
+        [[nodiscard]] auto chunk(std::int32_t chunkX, std::int32_t chunkY) const -> const LodChunk*;
+
+        /// @brief Every chunk of the pyramid, in no particular order
+        [[nodiscard]] auto chunks() const -> std::span<const LodChunk> { return m_chunks; }
+
+        /// @brief Find the chunks overlapping a view rectangle
+        /// @param viewRect Visible part of the map in pixels
+        /// @param visible Receives the overlapping chunks; cleared first so it can be reused every frame
+        void query(const render::ViewRect& viewRect, std::vector<const LodChunk*>& visible) const;
+
+    private:
+        auto buildChunk(LodChunk& chunk) const -> tl::expected<void, std::string>;
+
+        const Rasterizer* m_rasterizer = nullptr;
+        LodOptions m_options;
+        std::vector<LodChunk> m_chunks;
+        std::unordered_map<std::uint64_t, std::uint32_t> m_index; // Chunk key to index into m_chunks
+    };
+}
@@ -5,9 +5,19 @@
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include <span>
 
 namespace tmx::map
 {
+    // Flip flags stored in the highest bits of a global tile ID
+    constexpr std::uint32_t FLIPPED_HORIZONTALLY_FLAG = 0x80000000u;
+    constexpr std::uint32_t FLIPPED_VERTICALLY_FLAG = 0x40000000u;
+    constexpr std::uint32_t FLIPPED_DIAGONALLY_FLAG = 0x20000000u;
+    constexpr std::uint32_t ROTATED_HEXAGONAL_120_FLAG = 0x10000000u;
+    constexpr std::uint32_t GID_FLAGS_MASK = 0xF0000000u;
+    constexpr std::uint32_t GID_MASK = ~GID_FLAGS_MASK;
+    constexpr std::uint32_t GID_FLAGS_SHIFT = 28;
+
     enum class Orientation
     {
         Orthogonal,
@@ -24,6 +34,27 @@ namespace tmx::map
         LeftUp
     };
 
+    // Order in which the objects of an object group are drawn
+    enum class DrawOrder
+    {
+        TopDown, // Sorted by y
+        Index // In the order they appear in the group
+    };
+
+    // Axis along which every other row or column is shifted (staggered and hexagonal maps)
+    enum class StaggerAxis
+    {
+        X,
+        Y
+    };
+
+    // Whether the odd or the even rows or columns are shifted (staggered and hexagonal maps)
+    enum class StaggerIndex
+    {
+        Odd,
+        Even
+    };
+
     struct Color
     {
         std::uint8_t r{}, g{}, b{}, a = 255;
@@ -36,6 +67,9 @@ namespace tmx::map
         }
 
         static auto fromString(const std::string& hex) -> tl::expected<Color, std::string>;
+
+        /// @brief Parse a color the way Tiled writes layer tints: #RRGGBB or #AARRGGBB
+        static auto fromArgbString(const std::string& hex) -> tl::expected<Color, std::string>;
     };
 
     struct Property
@@ -66,6 +100,37 @@ namespace tmx::map
         std::vector<Frame> frames;
     };
 
+    enum class ObjectShape
+    {
+        Rectangle,  // Default shape (has width and height)
+        Ellipse,    // Ellipse shape (has width and height)
+        Point,      // Point shape (no width/height)
+        Polygon,    // Polygon shape (has points)
+        Polyline,   // Polyline shape (has points)
+        Text        // Text object
+    };
+
+    struct Point
+    {
+        float x, y;
+    };
+
+    struct Object
+    {
+        std::uint32_t id;
+        std::string name;
+        std::string type;
+        float x, y;           // Position in pixels
+        float width, height;  // Size in pixels (for rectangle/ellipse)
+        float rotation = 0.0f; // Rotation in degrees
+        bool visible = true;
+        ObjectShape shape = ObjectShape::Rectangle;
+        std::uint32_t firstPoint = 0; // First polygon or polyline point in Map::points, or Tileset::shapePoints
+        std::uint32_t pointCount = 0; // Number of polygon or polyline points, relative to (x, y)
+        std::uint32_t gid = 0;     // Global tile ID for tile objects
+        Properties properties;
+    };
+
     struct Tile
     {
         std::uint32_t id;          // Local ID within the tileset
@@ -87,6 +152,29 @@ namespace tmx::map
         std::uint32_t imageheight;
         Properties properties;
         std::vector<Tile> tiles; // Tiles with animations or properties
+
+        // Collision shapes of the tiles (<objectgroup> inside <tile>), shared by every cell showing the tile
+        std::vector<Object> shapes; // Grouped by tile in local ID order; positions relative to the tile's top-left
+        std::vector<Point> shapePoints; // Points of polygon and polyline shapes, back to back
+        std::vector<std::uint32_t> shapeOffsets; // shapeOffsets[id] is the first shape of local tile id; one past
+                                                 // the highest tile with shapes, empty if no tile has any
+
+        /// @brief Collision shapes of a tile
+        /// @param localId Tile ID within this tileset
+        [[nodiscard]] auto tileShapes(const std::uint32_t localId) const -> std::span<const Object>
+        {
+            if (localId + 1 >= shapeOffsets.size())
+                return {};
+            return {shapes.data() + shapeOffsets[localId], shapeOffsets[localId + 1] - shapeOffsets[localId]};
+        }
+
+        /// @brief Polygon or polyline points of a collision shape of this tileset
+        [[nodiscard]] auto shapePointsOf(const Object& shape) const -> std::span<const Point>
+        {
+            if (shape.firstPoint > shapePoints.size() || shape.pointCount > shapePoints.size() - shape.firstPoint)
+                return {};
+            return {shapePoints.data() + shape.firstPoint, shape.pointCount};
+        }
     };
 
     struct Chunk
@@ -104,46 +192,67 @@ namespace tmx::map
         std::vector<Chunk> chunks; // For infinite maps
         bool visible = true;
         float opacity = 1.0f;
+        float offsetx = 0.0f, offsety = 0.0f; // Rendering offset (pixels)
+        float parallaxx = 1.0f, parallaxy = 1.0f; // Fraction of the camera movement the layer scrolls by
+        Color tintcolor{255, 255, 255, 255}; // Multiplies the colors of the layer's tiles and images
+        std::int32_t group = -1; // Index into Map::groups of the enclosing <group>, -1 at the top level
         Properties properties;
     };
 
-    enum class ObjectShape
-    {
-        Rectangle,  // Default shape (has width and height)
-        Ellipse,    // Ellipse shape (has width and height)
-        Point,      // Point shape (no width/height)
-        Polygon,    // Polygon shape (has points)
-        Polyline,   // Polyline shape (has points)
-        Text        // Text object
-    };
-
-    struct Point
+    struct ObjectGroup
     {
-        float x, y;
+        std::string name;
+        bool visible = true;
+        float opacity = 1.0f;
+        DrawOrder draworder = DrawOrder::TopDown;
+        float offsetx = 0.0f, offsety = 0.0f; // Rendering offset (pixels)
+        float parallaxx = 1.0f, parallaxy = 1.0f; // Fraction of the camera movement the layer scrolls by
+        Color tintcolor{255, 255, 255, 255}; // Multiplies the colors of the layer's tiles and images
+        std::int32_t group = -1; // Index into Map::groups of the enclosing <group>, -1 at the top level
+        Properties properties;
+        std::vector<Object> objects;
     };
 
-    struct Object
+    struct ImageLayer
     {
-        std::uint32_t id;
         std::string name;
-        std::string type;
-        float x, y;           // Position in pixels
-        float width, height;  // Size in pixels (for rectangle/ellipse)
-        float rotation = 0.0f; // Rotation in degrees
+        std::string image; // Image path relative to the map file
+        std::uint32_t imagewidth = 0, imageheight = 0;
+        bool repeatx = false, repeaty = false; // Whether the image tiles along each axis
         bool visible = true;
-        ObjectShape shape = ObjectShape::Rectangle;
-        std::vector<Point> points; // For polygon and polyline
-        std::uint32_t gid = 0;     // Global tile ID for tile objects
+        float opacity = 1.0f;
+        float offsetx = 0.0f, offsety = 0.0f; // Rendering offset (pixels)
+        float parallaxx = 1.0f, parallaxy = 1.0f; // Fraction of the camera movement the layer scrolls by
+        Color tintcolor{255, 255, 255, 255}; // Multiplies the colors of the layer's tiles and images
+        std::int32_t group = -1; // Index into Map::groups of the enclosing <group>, -1 at the top level
         Properties properties;
     };
 
-    struct ObjectGroup
+    // A <group> layer; its attributes apply on top of those of every layer inside it
+    struct Group
     {
         std::string name;
         bool visible = true;
         float opacity = 1.0f;
+        float offsetx = 0.0f, offsety = 0.0f; // Rendering offset (pixels)
+        float parallaxx = 1.0f, parallaxy = 1.0f; // Fraction of the camera movement the layer scrolls by
+        Color tintcolor{255, 255, 255, 255}; // Multiplies the tints of the layers inside
+        std::int32_t group = -1; // Index into Map::groups of the parent group, -1 at the top level
         Properties properties;
-        std::vector<Object> objects;
+    };
+
+    enum class LayerKind
+    {
+        Tile, // Map::layers
+        Object, // Map::objectgroups
+        Image // Map::imagelayers
+    };
+
+    // One layer of the map in document order
+    struct LayerRef
+    {
+        LayerKind kind;
+        std::uint32_t index; // Into the vector of its kind
     };
 
     struct Map
@@ -154,6 +263,9 @@ namespace tmx::map
         RenderOrder renderorder = RenderOrder::RightDown;
         std::uint32_t width, height;
         std::uint32_t tilewidth, tileheight;
+        StaggerAxis staggeraxis = StaggerAxis::Y; // Staggered and hexagonal maps only
+        StaggerIndex staggerindex = StaggerIndex::Odd; // Staggered and hexagonal maps only
+        std::uint32_t hexsidelength = 0; // Length of the flat side of a hexagon tile (pixels), hexagonal maps only
         bool infinite = false;
         Color backgroundcolor;
         std::uint32_t nextlayerid = 1;
@@ -162,6 +274,27 @@ namespace tmx::map
         std::vector<Tileset> tilesets;
         std::vector<Layer> layers;
         std::vector<ObjectGroup> objectgroups;
+        std::vector<ImageLayer> imagelayers;
+        std::vector<Group> groups; // Every <group>, parents before their children
+        std::vector<LayerRef> layerOrder; // Tile, object and image layers in drawing order, groups flattened
         Properties properties;
+        std::vector<Point> points; // Points of every polygon and polyline object, back to back
+
+        /// @brief Polygon or polyline points of an object of this map; empty for other shapes
+        [[nodiscard]] auto objectPoints(const Object& object) const -> std::span<const Point>
+        {
+            if (object.firstPoint > points.size() || object.pointCount > points.size() - object.firstPoint)
+                return {};
+            return {points.data() + object.firstPoint, object.pointCount};
+        }
+
+        /// @brief Tileset a GID belongs to: the last one whose firstgid is not above it
+        /// @param gid Global tile ID, flip flags are ignored
+        /// @return The tileset, or nullptr for empty cells and GIDs below every tileset
+        [[nodiscard]] auto tilesetOf(std::uint32_t gid) const -> const Tileset*;
+
+        /// @brief Collision shapes of the tile shown by a GID, shared by every cell showing it
+        /// @param gid Global tile ID, flip flags are ignored
+        [[nodiscard]] auto tileShapes(std::uint32_t gid) const -> std::span<const Object>;
     };
 }
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include "BitGrid.hpp"
+#include "CollisionBaker.hpp"
+
+namespace tmx::nav
+{
+    /// @brief Cost of a straight step; diagonal steps cost DIAGONAL_COST, about sqrt(2) times as much
+    constexpr std::uint32_t STRAIGHT_COST = 10;
+    constexpr std::uint32_t DIAGONAL_COST = 14;
+
+    /// @brief Tile coordinates of a cell
+    struct GridPoint
+    {
+        std::int32_t x, y;
+
+        [[nodiscard]] auto operator==(const GridPoint&) const -> bool = default;
+    };
+
+    enum class PathAlgorithm
+    {
+        AStar, // Expands every cell it reaches
+        JumpPoint // Jump Point Search: expands only cells where the path may turn, found by scanning 64 cells at a time
+    };
+
+    /// @brief One path to find in a batch
+    struct PathRequest
+    {
+        GridPoint start, goal;
+    };
+
+    /// @brief Outcome of a path search
+    struct PathResult
+    {
+        bool found = false;
+        std::uint32_t cost = 0; // In STRAIGHT_COST and DIAGONAL_COST units
+        std::uint32_t first = 0; // First cell of the path in the output points
+        std::uint32_t count = 0; // Number of cells, start and goal included; 0 if no path was found
+    };
+
+    /// @brief Paths of a batch, stored back to back
+    struct PathBatch
+    {
+        std::vector<GridPoint> points;
+        std::vector<PathResult> results; // One per request, in request order
+
+        [[nodiscard]] auto path(const std::size_t request) const -> std::span<const GridPoint>
+        {
+            return {points.data() + results[request].first, results[request].count};
+        }
+    };
+
+    /// @brief Walkable cells of a map for 8-connected movement
+    /// Cells are stored one bit each, row by row and again column by column, so searches scan 64 cells at a time
+    /// in all four directions. Cells outside the grid are blocked.
+    class NavGrid
+    {
+    public:
+        NavGrid() = default;
+
+        /// @brief Grid of the given walkable cells
+        explicit NavGrid(map::BitGrid walkable);
+
+        /// @brief Cells of a solidity bitmap that are not solid
+        [[nodiscard]] static auto fromSolidity(const map::BitGrid& solid) -> NavGrid;
+
+        /// @brief Cells of the map's layers that are not solid, as defined by map::bakeSolidity
+        [[nodiscard]] static auto fromMap(const map::Map& map, std::span<const std::uint8_t> blockingLayers,
+                                          const map::CollisionOptions& options = {}) -> NavGrid
+        {
+            return fromSolidity(map::bakeSolidity(map, blockingLayers, options));
+        }
+
+        /// @brief Cells of the map's layers that are not solid
+        /// @param isBlockingLayer Callable invoked with each const map::Layer&; returns true if every tile of it blocks
+        ///                        movement
+        template <typename LayerPredicate>
+            requires std::predicate<LayerPredicate&, const map::Layer&>
+        [[nodiscard]] static auto fromMap(const map::Map& map, LayerPredicate&& isBlockingLayer,
+                                          const map::CollisionOptions& options = {}) -> NavGrid
+        {
+            std::vector<std::uint8_t> blocking(map.layers.size(), 0);
+            for (std::size_t i = 0; i < map.layers.size(); ++i)
+                blocking[i] = isBlockingLayer(map.layers[i]) ? 1 : 0;
+            return fromMap(map, std::span<const std::uint8_t>(blocking), options);
+        }
+
+        [[nodiscard]] auto isWalkable(const std::int32_t x, const std::int32_t y) const -> bool
+        {
+            return m_rows.get(x, y);
+        }
+
+        /// @brief Open or block a cell inside the grid, e.g. for doors; Pathfinders of the grid see the change
+        void setWalkable(std::int32_t x, std::int32_t y, bool walkable);
+
+        /// @brief Walkable cells by row
+        [[nodiscard]] auto rows() const -> const map::BitGrid& { return m_rows; }
+
+        /// @brief Walkable cells by column: bit (y, x) is cell (x, y)
+        [[nodiscard]] auto columns() const -> const map::BitGrid& { return m_columns; }
+
+        [[nodiscard]] auto bounds() const -> const map::TileBounds& { return m_rows.bounds(); }
+
+    private:
+        map::BitGrid m_rows;
+        map::BitGrid m_columns;
+    };
+
+    /// @brief Shortest paths over a NavGrid with A* or Jump Point Search
+    /// Diagonal steps may not cut corners: both cells beside them must be walkable. Search state is sized to the
+    /// grid once, and reset between searches by bumping a generation counter, so searches allocate nothing except
+    /// when the open list or the output grows beyond any earlier size. A Pathfinder is not thread-safe; give each
+    /// thread its own.
+    class Pathfinder
+    {
+    public:
+        /// @param grid Grid to search; must outlive the pathfinder and keep its bounds
+        explicit Pathfinder(const NavGrid& grid);
+
+        /// @brief Find a shortest path
+        /// @param path Receives every cell from start to goal; cleared first
+        /// @return The cost of the path, whether one was found, and its place in path
+        auto findPath(GridPoint start, GridPoint goal, std::vector<GridPoint>& path,
+                      PathAlgorithm algorithm = PathAlgorithm::JumpPoint) -> PathResult;
+
+        /// @brief Find a shortest path for each request
+        /// @param batch Receives all paths back to back, and one result per request; cleared first
+        void findPaths(std::span<const PathRequest> requests, PathBatch& batch,
+                       PathAlgorithm algorithm = PathAlgorithm::JumpPoint);
+
+        /// @brief Number of cells expanded by the last search, a measure of its work
+        [[nodiscard]] auto expandedCount() const -> std::uint32_t { return m_expanded; }
+
+    private:
+        static constexpr std::uint32_t NO_CELL = 0xFFFFFFFFu;
+        static constexpr std::int32_t NO_JUMP = std::numeric_limits<std::int32_t>::min(); // Also used for "the goal is not on this line"
+
+        struct OpenEntry
+        {
+            std::uint32_t f; // Cost so far plus the estimate to the goal
+            std::uint32_t g; // Cost so far
+            std::uint32_t cell;
+        };
+
+        [[nodiscard]] auto cellIndex(const GridPoint& point) const -> std::uint32_t
+        {
+            const auto& bounds = m_grid->bounds();
+            return static_cast<std::uint32_t>(point.y - bounds.minY) * m_width +
+                static_cast<std::uint32_t>(point.x - bounds.minX);
+        }
+
+        [[nodiscard]] auto pointOf(const std::uint32_t cell) const -> GridPoint
+        {
+            const auto& bounds = m_grid->bounds();
+            return {bounds.minX + static_cast<std::int32_t>(cell % m_width),
+                    bounds.minY + static_cast<std::int32_t>(cell / m_width)};
+        }
+
+        [[nodiscard]] auto walkable(const std::int32_t x, const std::int32_t y) const -> bool
+        {
+            return m_grid->isWalkable(x, y);
+        }
+
+        // Search from start to goal; returns the cost, or NO_CELL
+        template <bool JUMP>
+        auto search(GridPoint start, GridPoint goal) -> std::uint32_t;
+
+        // Relax the edge from cell (whose cost is g) to target
+        void push(std::uint32_t cell, std::uint32_t g, GridPoint target, GridPoint goal);
+
+        // Jump point reached by a straight scan along a row of lines from position on, or NO_JUMP
+        [[nodiscard]] auto scan(const map::BitGrid& lines, std::int32_t line, std::int32_t position, std::int32_t step,
+                                std::int32_t goalPosition) const -> std::int32_t;
+        [[nodiscard]] auto jump(GridPoint from, std::int32_t dx, std::int32_t dy, GridPoint goal) const
+            -> std::optional<GridPoint>;
+
+        // Append the path ending at goal, start included, to points
+        void appendPath(GridPoint goal, std::vector<GridPoint>& points) const;
+
+        const NavGrid* m_grid;
+        std::uint32_t m_width;
+        std::uint32_t m_generation = 0;
+        std::uint32_t m_expanded = 0;
+        std::vector<std::uint32_t> m_g; // Best known cost per cell
+        std::vector<std::uint32_t> m_parent; // Previous cell on the best known path
+        std::vector<std::uint32_t> m_seen; // Generation in which m_g and m_parent were set
+        std::vector<std::uint32_t> m_closed; // Generation in which the cell was expanded
+        std::vector<OpenEntry> m_open; // Binary heap, kept between searches
+    };
+}
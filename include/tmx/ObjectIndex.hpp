@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "RenderData.hpp"
+#include "ShapeGeometry.hpp"
+
+namespace tmx::render
+{
+    /// @brief Uniform grid over the objects of every object group, for finding the objects in a region
+    /// Every object is listed in the grid cells its bounding box overlaps; objects spanning many cells are kept in a
+    /// separate list tested by every query instead. Objects outside the grid, e.g. after moving, are filed under the
+    /// nearest border cells, so queries stay exact without regrowing the grid. Queries test bounding boxes only and
+    /// report each object once, in no particular order; they do not allocate once their output has grown.
+    class ObjectIndex
+    {
+    public:
+        static constexpr std::uint32_t MAX_CELLS = 1u << 20; // Larger grids get coarser cells
+        static constexpr std::uint32_t MAX_OBJECT_CELLS = 64; // Objects spanning more cells go to the large list
+
+        ObjectIndex() = default;
+
+        /// @brief Index every object of the render data
+        /// @param renderData Render data whose objects are indexed; must outlive the index
+        /// @param cellSize Grid cell edge length in pixels, or 0 for four times the larger tile dimension
+        explicit ObjectIndex(const MapRenderData& renderData, float cellSize = 0.0f);
+
+        /// @brief Index the objects of other render data, or of the same render data after objects were added or
+        /// removed
+        /// @param renderData Render data whose objects are indexed; must outlive the index
+        /// @param cellSize Grid cell edge length in pixels, or 0 for four times the larger tile dimension
+        void build(const MapRenderData& renderData, float cellSize = 0.0f);
+
+        /// @brief Refile objects whose position, size, rotation or points changed
+        /// Objects that stay within the same cells only get their bounds updated. Invalid references are ignored.
+        /// @param moved Objects changed since the last build or update
+        void update(std::span<const ObjectRef> moved);
+
+        /// @brief Find the objects whose bounding box overlaps a rectangle (edges included)
+        /// @param rect Region in pixels
+        /// @param found Receives the objects; cleared first so it can be reused without allocating
+        void queryRect(const ViewRect& rect, std::vector<ObjectRef>& found) const;
+
+        /// @brief Find the objects whose bounding box contains a point (edges included)
+        /// @param found Receives the objects; cleared first so it can be reused without allocating
+        void queryPoint(float x, float y, std::vector<ObjectRef>& found) const;
+
+        /// @brief Find the objects whose bounding box comes within radius of a point
+        /// @param found Receives the objects; cleared first so it can be reused without allocating
+        void queryRadius(float x, float y, float radius, std::vector<ObjectRef>& found) const;
+
+        [[nodiscard]] auto queryRect(const ViewRect& rect) const -> std::vector<ObjectRef>
+        {
+            std::vector<ObjectRef> found;
+            queryRect(rect, found);
+            return found;
+        }
+
+        [[nodiscard]] auto queryPoint(const float x, const float y) const -> std::vector<ObjectRef>
+        {
+            std::vector<ObjectRef> found;
+            queryPoint(x, y, found);
+            return found;
+        }
+
+        [[nodiscard]] auto queryRadius(const float x, const float y, const float radius) const -> std::vector<ObjectRef>
+        {
+            std::vector<ObjectRef> found;
+            queryRadius(x, y, radius, found);
+            return found;
+        }
+
+        /// @brief Bounds of an object as of the last build or update
+        [[nodiscard]] auto bounds(const ObjectRef& ref) const -> const ObjectBounds&
+        {
+            return m_entries[m_groupOffsets[ref.objectGroupIndex] + ref.objectIndex].bounds;
+        }
+
+        [[nodiscard]] auto cellSize() const -> float { return m_cellSize; }
+        [[nodiscard]] auto objectCount() const -> std::size_t { return m_entries.size(); }
+
+        /// @brief Number of objects too large for the grid, tested by every query
+        [[nodiscard]] auto largeObjectCount() const -> std::size_t { return m_large.size(); }
+
+    private:
+        static constexpr std::int32_t LARGE = -1; // Entry::cells.minX of objects in the large list
+
+        struct Entry
+        {
+            ObjectBounds bounds;
+            CellRect cells; // Grid cells listing the object, with inclusive maximum edges
+            ObjectRef ref;
+        };
+
+        // Grid cells overlapping a box, clamped to the grid
+        [[nodiscard]] auto cellsOf(const ObjectBounds& bounds) const -> CellRect;
+        void insert(std::uint32_t slot);
+        void remove(std::uint32_t slot);
+
+        // Visit each object whose cells meet a cell range once: in the first cell of the overlap of both ranges
+        template <typename Test>
+        void collect(const CellRect& range, Test&& test, std::vector<ObjectRef>& found) const
+        {
+            found.clear();
+            for (std::int32_t y = range.minY; y <= range.maxY; ++y)
+            {
+                for (std::int32_t x = range.minX; x <= range.maxX; ++x)
+                {
+                    for (const std::uint32_t slot : m_cells[static_cast<std::size_t>(y) * m_columns + x])
+                    {
+                        const CellRect& cells = m_entries[slot].cells;
+                        if (x == std::max(cells.minX, range.minX) && y == std::max(cells.minY, range.minY) &&
+                            test(m_entries[slot].bounds))
+                            found.push_back(m_entries[slot].ref);
+                    }
+                }
+            }
+            for (const std::uint32_t slot : m_large)
+            {
+                if (test(m_entries[slot].bounds))
+                    found.push_back(m_entries[slot].ref);
+            }
+        }
+
+        const MapRenderData* m_renderData = nullptr;
+        float m_cellSize = 1.0f;
+        float m_originX = 0.0f, m_originY = 0.0f; // Top-left corner of the grid (pixels)
+        std::int32_t m_columns = 0, m_rows = 0;
+        std::vector<std::vector<std::uint32_t>> m_cells; // Row-major; object slots listed in every cell
+        std::vector<std::uint32_t> m_large; // Slots of objects spanning more than MAX_OBJECT_CELLS cells
+        std::vector<Entry> m_entries; // Per object slot
+        std::vector<std::uint32_t> m_groupOffsets; // First slot of every object group, plus the total
+    };
+}
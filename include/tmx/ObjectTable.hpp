@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Map.hpp"
+
+namespace tmx::map
+{
+    /// @brief The objects of every object group of a map, one array per field (structure of arrays)
+    /// Fields read every frame (id, position, size, rotation, gid, shape, visibility) each live in a contiguous
+    /// array, so a loop over positions touches positions only; names, types, properties and points sit out of line.
+    /// Objects of a group are contiguous and groups follow Map::objectgroups. Views give per-object access.
+    class ObjectTable
+    {
+    public:
+        /// @brief Fields rarely touched in per-frame loops
+        struct ColdFields
+        {
+            std::string name;
+            std::string type;
+            std::uint32_t firstPoint = 0, pointCount = 0; // Polygon or polyline points, in the table's point pool
+            Properties properties;
+        };
+
+        /// @brief One object of the table, with the fields of map::Object as accessors
+        /// Views hold a pointer to the table and an index; they are invalidated by append and clear.
+        template <bool Const>
+        class BasicView
+        {
+            using Table = std::conditional_t<Const, const ObjectTable, ObjectTable>;
+            template <typename T>
+            using Ref = std::conditional_t<Const, const T&, T&>;
+
+        public:
+            BasicView(Table& table, const std::uint32_t index) : m_table(&table), m_index(index) {}
+
+            operator BasicView<true>() const { return {*m_table, m_index}; }
+
+            [[nodiscard]] auto index() const -> std::uint32_t { return m_index; }
+
+            [[nodiscard]] auto id() const -> Ref<std::uint32_t> { return m_table->m_ids[m_index]; }
+            [[nodiscard]] auto x() const -> Ref<float> { return m_table->m_x[m_index]; }
+            [[nodiscard]] auto y() const -> Ref<float> { return m_table->m_y[m_index]; }
+            [[nodiscard]] auto width() const -> Ref<float> { return m_table->m_widths[m_index]; }
+            [[nodiscard]] auto height() const -> Ref<float> { return m_table->m_heights[m_index]; }
+            [[nodiscard]] auto rotation() const -> Ref<float> { return m_table->m_rotations[m_index]; }
+            [[nodiscard]] auto gid() const -> Ref<std::uint32_t> { return m_table->m_gids[m_index]; }
+            [[nodiscard]] auto shape() const -> Ref<ObjectShape> { return m_table->m_shapes[m_index]; }
+            [[nodiscard]] auto visible() const -> bool { return m_table->m_visible[m_index] != 0; }
+
+            void setVisible(const bool visible) const requires (!Const)
+            {
+                m_table->m_visible[m_index] = visible ? 1 : 0;
+            }
+
+            [[nodiscard]] auto name() const -> Ref<std::string> { return m_table->m_cold[m_index].name; }
+            [[nodiscard]] auto type() const -> Ref<std::string> { return m_table->m_cold[m_index].type; }
+            [[nodiscard]] auto properties() const -> Ref<Properties> { return m_table->m_cold[m_index].properties; }
+            [[nodiscard]] auto points() const -> std::span<const Point> { return m_table->points(m_index); }
+
+            /// @brief Copy the object out as a map::Object; its points are indexed into the table's point pool
+            [[nodiscard]] auto toObject() const -> Object { return m_table->toObject(m_index); }
+
+        private:
+            Table* m_table;
+            std::uint32_t m_index;
+        };
+
+        using View = BasicView<false>;
+        using ConstView = BasicView<true>;
+
+        /// @brief Iterator yielding views by value
+        template <bool Const>
+        class BasicIterator
+        {
+            using Table = std::conditional_t<Const, const ObjectTable, ObjectTable>;
+
+        public:
+            using value_type = BasicView<Const>;
+            using difference_type = std::ptrdiff_t;
+
+            BasicIterator() : m_table(nullptr), m_index(0) {}
+            BasicIterator(Table& table, const std::uint32_t index) : m_table(&table), m_index(index) {}
+
+            auto operator*() const -> BasicView<Const> { return {*m_table, m_index}; }
+
+            auto operator++() -> BasicIterator&
+            {
+                ++m_index;
+                return *this;
+            }
+
+            auto operator++(int) -> BasicIterator
+            {
+                auto previous = *this;
+                ++m_index;
+                return previous;
+            }
+
+            auto operator==(const BasicIterator& other) const -> bool { return m_index == other.m_index; }
+
+        private:
+            Table* m_table;
+            std::uint32_t m_index;
+        };
+
+        using Iterator = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
+        ObjectTable() = default;
+
+        /// @brief Copy the objects of every object group of a map
+        [[nodiscard]] static auto fromMap(const Map& map) -> ObjectTable;
+
+        /// @brief Start a new object group; objects appended afterwards belong to it
+        void addGroup();
+
+        /// @brief Append an object to the last group, starting the first group if there is none
+        /// @param points Polygon or polyline points of the object, copied into the table's point pool
+        /// @return Index of the object
+        auto append(const Object& object, std::span<const Point> points = {}) -> std::uint32_t;
+
+        /// @brief Reserve room for a number of objects and points
+        void reserve(std::size_t objectCount, std::size_t pointCount = 0);
+
+        /// @brief Remove every object and group
+        void clear();
+
+        [[nodiscard]] auto size() const -> std::uint32_t { return static_cast<std::uint32_t>(m_ids.size()); }
+        [[nodiscard]] auto empty() const -> bool { return m_ids.empty(); }
+
+        [[nodiscard]] auto operator[](const std::uint32_t index) -> View { return {*this, index}; }
+        [[nodiscard]] auto operator[](const std::uint32_t index) const -> ConstView { return {*this, index}; }
+
+        [[nodiscard]] auto begin() -> Iterator { return {*this, 0}; }
+        [[nodiscard]] auto end() -> Iterator { return {*this, size()}; }
+        [[nodiscard]] auto begin() const -> ConstIterator { return {*this, 0}; }
+        [[nodiscard]] auto end() const -> ConstIterator { return {*this, size()}; }
+
+        [[nodiscard]] auto groupCount() const -> std::uint32_t
+        {
+            return m_groupStarts.empty() ? 0 : static_cast<std::uint32_t>(m_groupStarts.size() - 1);
+        }
+
+        /// @brief Index of the first object of a group
+        [[nodiscard]] auto groupBegin(const std::uint32_t group) const -> std::uint32_t { return m_groupStarts[group]; }
+
+        /// @brief Index one past the last object of a group
+        [[nodiscard]] auto groupEnd(const std::uint32_t group) const -> std::uint32_t
+        {
+            return m_groupStarts[group + 1];
+        }
+
+        /// @brief Views of the objects of a group
+        [[nodiscard]] auto group(const std::uint32_t group) -> std::ranges::subrange<Iterator>
+        {
+            return {Iterator(*this, groupBegin(group)), Iterator(*this, groupEnd(group))};
+        }
+
+        [[nodiscard]] auto group(const std::uint32_t group) const -> std::ranges::subrange<ConstIterator>
+        {
+            return {ConstIterator(*this, groupBegin(group)), ConstIterator(*this, groupEnd(group))};
+        }
+
+        /// @brief Points of a polygon or polyline object, relative to its position
+        [[nodiscard]] auto points(const std::uint32_t index) const -> std::span<const Point>
+        {
+            const auto& cold = m_cold[index];
+            return {m_points.data() + cold.firstPoint, cold.pointCount};
+        }
+
+        [[nodiscard]] auto pointPool() const -> std::span<const Point> { return m_points; }
+
+        /// @brief Copy an object out as a map::Object
+        [[nodiscard]] auto toObject(std::uint32_t index) const -> Object;
+
+        // Hot fields, one entry per object, for loops over a single field
+        [[nodiscard]] auto ids() const -> std::span<const std::uint32_t> { return m_ids; }
+        [[nodiscard]] auto xs() -> std::span<float> { return m_x; }
+        [[nodiscard]] auto xs() const -> std::span<const float> { return m_x; }
+        [[nodiscard]] auto ys() -> std::span<float> { return m_y; }
+        [[nodiscard]] auto ys() const -> std::span<const float> { return m_y; }
+        [[nodiscard]] auto widths() -> std::span<float> { return m_widths; }
+        [[nodiscard]] auto widths() const -> std::span<const float> { return m_widths; }
+        [[nodiscard]] auto heights() -> std::span<float> { return m_heights; }
+        [[nodiscard]] auto heights() const -> std::span<const float> { return m_heights; }
+        [[nodiscard]] auto rotations() -> std::span<float> { return m_rotations; }
+        [[nodiscard]] auto rotations() const -> std::span<const float> { return m_rotations; }
+        [[nodiscard]] auto gids() const -> std::span<const std::uint32_t> { return m_gids; }
+        [[nodiscard]] auto shapes() const -> std::span<const ObjectShape> { return m_shapes; }
+        [[nodiscard]] auto visibility() const -> std::span<const std::uint8_t> { return m_visible; } // 1 if visible
+
+        /// @brief Cold fields of an object
+        [[nodiscard]] auto cold(const std::uint32_t index) const -> const ColdFields& { return m_cold[index]; }
+
+    private:
+        std::vector<std::uint32_t> m_ids;
+        std::vector<float> m_x, m_y;
+        std::vector<float> m_widths, m_heights;
+        std::vector<float> m_rotations;
+        std::vector<std::uint32_t> m_gids;
+        std::vector<ObjectShape> m_shapes;
+        std::vector<std::uint8_t> m_visible;
+
+        std::vector<ColdFields> m_cold;
+        std::vector<Point> m_points;
+        std::vector<std::uint32_t> m_groupStarts; // First object of each group, then the object count
+    };
+}
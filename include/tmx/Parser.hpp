@@ -2,6 +2,7 @@
 
 #include <tl/expected.hpp>
 #include <string>
+#include <string_view>
 #include <filesystem>
 #include <pugixml.hpp>
 #include "Map.hpp"
@@ -11,20 +12,41 @@ namespace tmx {
 class Parser {
 public:
     static auto parseFromFile(const std::filesystem::path& path) -> tl::expected<map::Map, std::string>;
-    static auto parseFromString(const std::string& xml) -> tl::expected<map::Map, std::string>;
-    
+    static auto parseFromString(const std::string& xml, const std::filesystem::path& basePath = "") -> tl::expected<map::Map, std::string>;
+
+    /// @brief Decode the text of a <data> or <chunk> element into GIDs
+    /// @param text Element text (CSV or base64)
+    /// @param encoding "csv" or "base64"
+    /// @param compression "", "zlib", "gzip" or "zstd" (base64 only)
+    /// @param width Width of the decoded area in tiles, used to size the decompression buffer
+    /// @param height Height of the decoded area in tiles
+    static auto decodeTileData(std::string_view text, std::string_view encoding, std::string_view compression,
+                               std::uint32_t width, std::uint32_t height) -> tl::expected<std::vector<std::uint32_t>, std::string>;
+
+    /// @brief Parse the points attribute of a <polygon> or <polyline> element ("x,y x,y ...")
+    /// @param text Attribute value; pairs are separated by whitespace
+    /// @param points Pool the points are appended to; left unchanged on error
+    /// @return Number of points appended
+    static auto parsePoints(std::string_view text, std::vector<map::Point>& points) -> tl::expected<std::uint32_t, std::string>;
+
 private:
     static auto parseMap(const pugi::xml_node& mapNode, const std::filesystem::path& basePath = "") -> tl::expected<map::Map, std::string>;
     static auto parseTileset(const pugi::xml_node& tilesetNode, const std::filesystem::path& basePath = "") -> tl::expected<map::Tileset, std::string>;
     static auto parseTilesetFile(const std::filesystem::path& path, std::uint32_t firstgid) -> tl::expected<map::Tileset, std::string>;
-    static auto parseTile(const pugi::xml_node& tileNode) -> tl::expected<map::Tile, std::string>;
+    static auto parseTiles(const pugi::xml_node& tilesetNode, map::Tileset& tileset) -> tl::expected<void, std::string>;
+    static auto parseTile(const pugi::xml_node& tileNode, std::vector<map::Object>& shapes, std::vector<map::Point>& points)
+        -> tl::expected<map::Tile, std::string>;
     static auto parseAnimation(const pugi::xml_node& animationNode) -> tl::expected<map::Animation, std::string>;
+    static auto parseLayers(const pugi::xml_node& parentNode, map::Map& map, std::int32_t group) -> tl::expected<void, std::string>;
     static auto parseLayer(const pugi::xml_node& layerNode) -> tl::expected<map::Layer, std::string>;
-    static auto parseObjectGroup(const pugi::xml_node& objectGroupNode) -> tl::expected<map::ObjectGroup, std::string>;
-    static auto parseObject(const pugi::xml_node& objectNode) -> tl::expected<map::Object, std::string>;
+    static auto parseObjectGroup(const pugi::xml_node& objectGroupNode, std::vector<map::Point>& points) -> tl::expected<map::ObjectGroup, std::string>;
+    static auto parseObject(const pugi::xml_node& objectNode, std::vector<map::Point>& points) -> tl::expected<map::Object, std::string>;
     static auto parseProperties(const pugi::xml_node& propertiesNode) -> map::Properties;
     static auto parseOrientation(const std::string& str) -> map::Orientation;
     static auto parseRenderOrder(const std::string& str) -> map::RenderOrder;
+    static auto parseDrawOrder(const std::string& str) -> map::DrawOrder;
+    static auto parseStaggerAxis(const std::string& str) -> map::StaggerAxis;
+    static auto parseStaggerIndex(const std::string& str) -> map::StaggerIndex;
     static auto parseData(const pugi::xml_node& dataNode, std::uint32_t width, std::uint32_t height) 
         -> tl::expected<std::vector<std::uint32_t>, std::string>;
     static auto parseChunk(const pugi::xml_node& chunkNode) -> tl::expected<map::Chunk, std::string>;
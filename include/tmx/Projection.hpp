@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "Map.hpp"
+
+namespace tmx::render
+{
+    /// @brief Pixel position on screen
+    struct ScreenPoint
+    {
+        std::int32_t x, y;
+    };
+
+    /// @brief Tile coordinates of a cell
+    struct CellPoint
+    {
+        std::int32_t x, y;
+    };
+
+    /// @brief Rectangle of cells in tile coordinates, with exclusive maximum edges
+    struct CellRect
+    {
+        std::int32_t minX, minY, maxX, maxY;
+    };
+
+    /// @brief Map parameters that decide where cells are drawn, taken from the map once by MapRenderData::fromMap
+    struct ProjectionParams
+    {
+        map::Orientation orientation = map::Orientation::Orthogonal;
+        std::int32_t tileWidth = 1, tileHeight = 1; // Map tile size (pixels)
+        std::int32_t mapHeight = 0; // Map height in tiles; isometric maps put the left corner of row mapHeight-1 at x=0
+        map::StaggerAxis staggerAxis = map::StaggerAxis::Y;
+        map::StaggerIndex staggerIndex = map::StaggerIndex::Odd;
+        std::int32_t hexSideLength = 0; // Hexagonal maps only
+
+        [[nodiscard]] static auto fromMap(const map::Map& map) -> ProjectionParams
+        {
+            return {map.orientation,
+                    static_cast<std::int32_t>(map.tilewidth),
+                    static_cast<std::int32_t>(map.tileheight),
+                    static_cast<std::int32_t>(map.height),
+                    map.staggeraxis,
+                    map.staggerindex,
+                    static_cast<std::int32_t>(map.hexsidelength)};
+        }
+    };
+
+    /// @brief Integer division rounding towards negative infinity
+    constexpr auto floorDiv(const std::int32_t value, const std::int32_t divisor) -> std::int32_t
+    {
+        const std::int32_t quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    /// @brief Cell coordinate from a floating-point bound, clamped so later arithmetic cannot overflow
+    inline auto floorCell(const double value) -> std::int32_t
+    {
+        return static_cast<std::int32_t>(std::clamp(std::floor(value), -1.0e9, 1.0e9));
+    }
+
+    // Projection policies: each maps a cell to the top-left corner of its tile-sized bounding box on screen, maps such
+    // corners back to their cell exactly, and bounds the cells a screen rectangle may touch. Code templated on a
+    // policy resolves the orientation once, through withProjection, instead of once per tile.
+
+    /// @brief Square grid: cell (x, y) at (x * tileWidth, y * tileHeight)
+    struct OrthogonalProjection
+    {
+        std::int32_t tileWidth, tileHeight;
+
+        constexpr explicit OrthogonalProjection(const ProjectionParams& params)
+            : tileWidth(std::max(params.tileWidth, 1)), tileHeight(std::max(params.tileHeight, 1))
+        {
+        }
+
+        [[nodiscard]] constexpr auto toScreen(const std::int32_t x, const std::int32_t y) const -> ScreenPoint
+        {
+            return {x * tileWidth, y * tileHeight};
+        }
+
+        [[nodiscard]] constexpr auto toCell(const ScreenPoint& point) const -> CellPoint
+        {
+            return {floorDiv(point.x, tileWidth), floorDiv(point.y, tileHeight)};
+        }
+
+        /// @brief Screen position of a point in object coordinates, which Tiled stores in screen pixels here
+        [[nodiscard]] constexpr auto objectToScreen(const float x, const float y) const -> map::Point
+        {
+            return {x, y};
+        }
+
+        /// @brief Cells whose bounding box may overlap a screen rectangle (a superset)
+        [[nodiscard]] auto cellsOverlapping(const float left, const float top, const float right, const float bottom) const
+            -> CellRect
+        {
+            return {floorCell(left / tileWidth), floorCell(top / tileHeight),
+                    floorCell(right / tileWidth) + 1, floorCell(bottom / tileHeight) + 1};
+        }
+
+        /// @brief Size of a width x height map on screen
+        [[nodiscard]] constexpr auto mapSize(const std::int32_t width, const std::int32_t height) const -> ScreenPoint
+        {
+            return {width * tileWidth, height * tileHeight};
+        }
+    };
+
+    /// @brief Diamond grid: x runs down-right and y down-left, with cell (0, 0) at the top corner
+    struct IsometricProjection
+    {
+        std::int32_t halfWidth, halfHeight; // Half the tile size: the step between neighbouring cells
+        std::int32_t originX; // Left edge of cell (0, 0)
+
+        constexpr explicit IsometricProjection(const ProjectionParams& params)
+            : halfWidth(std::max(params.tileWidth / 2, 1)), halfHeight(std::max(params.tileHeight / 2, 1)),
+              originX((params.mapHeight - 1) * halfWidth)
+        {
+        }
+
+        [[nodiscard]] constexpr auto toScreen(const std::int32_t x, const std::int32_t y) const -> ScreenPoint
+        {
+            return {originX + (x - y) * halfWidth, (x + y) * halfHeight};
+        }
+
+        [[nodiscard]] constexpr auto toCell(const ScreenPoint& point) const -> CellPoint
+        {
+            const std::int32_t difference = floorDiv(point.x - originX, halfWidth); // x - y
+            const std::int32_t sum = floorDiv(point.y, halfHeight); // x + y
+            return {floorDiv(sum + difference, 2), floorDiv(sum - difference, 2)};
+        }
+
+        /// @brief Screen position of a point in object coordinates, where both axes run along the cell axes in units
+        /// of tileHeight pixels
+        [[nodiscard]] constexpr auto objectToScreen(const float x, const float y) const -> map::Point
+        {
+            const float tileX = x / static_cast<float>(2 * halfHeight);
+            const float tileY = y / static_cast<float>(2 * halfHeight);
+            return {static_cast<float>(originX + halfWidth) + (tileX - tileY) * static_cast<float>(halfWidth),
+                    (tileX + tileY) * static_cast<float>(halfHeight)};
+        }
+
+        [[nodiscard]] auto cellsOverlapping(const float left, const float top, const float right, const float bottom) const
+            -> CellRect
+        {
+            // Bound x - y and x + y by the columns and rows of the rectangle, then x and y by those
+            const std::int32_t minDifference = floorCell((left - originX) / halfWidth) - 3;
+            const std::int32_t maxDifference = floorCell((right - originX) / halfWidth) + 1;
+            const std::int32_t minSum = floorCell(top / halfHeight) - 3;
+            const std::int32_t maxSum = floorCell(bottom / halfHeight) + 1;
+            return {floorDiv(minSum + minDifference, 2), floorDiv(minSum - maxDifference, 2),
+                    floorDiv(maxSum + maxDifference, 2) + 1,
+                    floorDiv(maxSum - minDifference, 2) + 1};
+        }
+
+        [[nodiscard]] constexpr auto mapSize(const std::int32_t width, const std::int32_t height) const -> ScreenPoint
+        {
+            return {(width + height) * halfWidth, (width + height) * halfHeight};
+        }
+    };
+
+    /// @brief Staggered and hexagonal grids: every other column (StaggerAxis::X) or row (StaggerAxis::Y) is shifted
+    /// by half a cell. Staggered maps are hexagonal maps whose hexagons have no flat side.
+    template <map::StaggerAxis Axis>
+    struct HexagonalProjection
+    {
+        static constexpr bool STAGGER_X = Axis == map::StaggerAxis::X;
+
+        std::int32_t stride; // Distance between neighbouring cells along the stagger axis
+        std::int32_t pitch; // Distance between neighbouring cells across the stagger axis
+        std::int32_t shift; // Offset of the shifted cells across the stagger axis
+        std::int32_t sideOffset; // Part of the tile along the stagger axis beside the flat side
+        std::int32_t staggerEven; // 1 if even columns or rows are shifted
+
+        constexpr explicit HexagonalProjection(const ProjectionParams& params)
+        {
+            // Like Tiled, odd tile sizes are rounded down to even ones
+            const std::int32_t along = (STAGGER_X ? params.tileWidth : params.tileHeight) & ~1;
+            const std::int32_t across = (STAGGER_X ? params.tileHeight : params.tileWidth) & ~1;
+            const std::int32_t sideLength = params.orientation == map::Orientation::Hexagonal ? params.hexSideLength : 0;
+            sideOffset = std::max((along - sideLength) / 2, 0);
+            stride = std::max(sideOffset + sideLength, 1);
+            pitch = std::max(across, 1);
+            shift = across / 2;
+            staggerEven = params.staggerIndex == map::StaggerIndex::Even ? 1 : 0;
+        }
+
+        [[nodiscard]] constexpr auto isShifted(const std::int32_t index) const -> std::int32_t
+        {
+            return (index & 1) ^ staggerEven;
+        }
+
+        [[nodiscard]] constexpr auto toScreen(const std::int32_t x, const std::int32_t y) const -> ScreenPoint
+        {
+            if constexpr (STAGGER_X)
+                return {x * stride, y * pitch + shift * isShifted(x)};
+            else
+                return {x * pitch + shift * isShifted(y), y * stride};
+        }
+
+        [[nodiscard]] constexpr auto toCell(const ScreenPoint& point) const -> CellPoint
+        {
+            if constexpr (STAGGER_X)
+            {
+                const std::int32_t x = floorDiv(point.x, stride);
+                return {x, floorDiv(point.y - shift * isShifted(x), pitch)};
+            }
+            else
+            {
+                const std::int32_t y = floorDiv(point.y, stride);
+                return {floorDiv(point.x - shift * isShifted(y), pitch), y};
+            }
+        }
+
+        [[nodiscard]] constexpr auto objectToScreen(const float x, const float y) const -> map::Point
+        {
+            return {x, y};
+        }
+
+        [[nodiscard]] auto cellsOverlapping(const float left, const float top, const float right, const float bottom) const
+            -> CellRect
+        {
+            // A tile reaches one stride plus the side offset along the axis and one pitch across it past its corner
+            const float minAlong = STAGGER_X ? left : top;
+            const float maxAlong = STAGGER_X ? right : bottom;
+            const float minAcross = STAGGER_X ? top : left;
+            const float maxAcross = STAGGER_X ? bottom : right;
+            const std::int32_t firstAlong = floorCell(minAlong / stride) - 3 - sideOffset / stride;
+            const std::int32_t lastAlong = floorCell(maxAlong / stride) + 1;
+            const std::int32_t firstAcross = floorCell((minAcross - shift) / pitch) - 2;
+            const std::int32_t lastAcross = floorCell(maxAcross / pitch) + 1;
+            if constexpr (STAGGER_X)
+                return {firstAlong, firstAcross, lastAlong, lastAcross};
+            else
+                return {firstAcross, firstAlong, lastAcross, lastAlong};
+        }
+
+        [[nodiscard]] constexpr auto mapSize(const std::int32_t width, const std::int32_t height) const -> ScreenPoint
+        {
+            const std::int32_t along = STAGGER_X ? width : height;
+            const std::int32_t across = STAGGER_X ? height : width;
+            const std::int32_t alongSize = along * stride + sideOffset;
+            const std::int32_t acrossSize = across * pitch + (along > 1 ? shift : 0);
+            if constexpr (STAGGER_X)
+                return {alongSize, acrossSize};
+            else
+                return {acrossSize, alongSize};
+        }
+    };
+
+    /// @brief Call fn with the projection policy of the parameters' orientation
+    /// This is the only place the orientation is tested; fn is instantiated once per policy.
+    /// @return Whatever fn returns, which must not depend on the policy type
+    template <typename Fn>
+    decltype(auto) withProjection(const ProjectionParams& params, Fn&& fn)
+    {
+        if (params.orientation == map::Orientation::Isometric)
+            return fn(IsometricProjection(params));
+        if (params.orientation == map::Orientation::Staggered || params.orientation == map::Orientation::Hexagonal)
+        {
+            if (params.staggerAxis == map::StaggerAxis::X)
+                return fn(HexagonalProjection<map::StaggerAxis::X>(params));
+            return fn(HexagonalProjection<map::StaggerAxis::Y>(params));
+        }
+        return fn(OrthogonalProjection(params));
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <tl/expected.hpp>
+#include "RenderData.hpp"
+#include "TextureAtlas.hpp"
+
+namespace tmx::raster
+{
+    /// @brief Largest width or height, in pixels, of an image drawn by Rasterizer::render
+    constexpr std::uint32_t MAX_IMAGE_SIZE = 16384;
+
+    /// @brief 8-bit RGBA image with straight (non-premultiplied) alpha, rows stored top to bottom without padding
+    struct Image
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::vector<std::uint8_t> pixels; // width * height * 4 bytes
+
+        [[nodiscard]] auto isEmpty() const -> bool { return width == 0 || height == 0; }
+
+        /// @brief The four channels of one pixel
+        [[nodiscard]] auto pixel(std::uint32_t x, std::uint32_t y) const -> const std::uint8_t*
+        {
+            return pixels.data() + (static_cast<std::size_t>(y) * width + x) * 4;
+        }
+    };
+
+    /// @brief Options controlling what Rasterizer::render draws
+    struct RasterOptions
+    {
+        std::optional<render::ViewRect> region; // Part of the map to draw in map pixels; defaults to the whole map
+        float scale = 1.0f; // Output pixels per map pixel, e.g. 0.25 for a minimap (nearest-neighbour sampling)
+        std::uint64_t time = 0; // Animation time in milliseconds; animated tiles show their frame at this time
+        bool drawObjects = true; // Draw the tile objects of visible object groups on top of the tile layers
+        std::uint32_t background = 0x00000000; // Canvas color as 0xRRGGBBAA (transparent by default)
+        std::uint32_t threadCount = 1; // Threads drawing row bands; 0 uses every hardware thread. Output never depends on it
+    };
+
+    /// @brief Load an image file (PNG, JPEG, BMP, TGA, ...) as RGBA
+    /// @param path Path to the image file
+    /// @return The image, or an error message if it cannot be read
+    auto loadImage(const std::string& path) -> tl::expected<Image, std::string>;
+
+    /// @brief Write an image as PNG
+    /// @param image Image to write
+    /// @param path Destination file
+    /// @return Nothing, or an error message if the file cannot be written
+    auto writePng(const Image& image, const std::string& path) -> tl::expected<void, std::string>;
+
+    /// @brief Draw the pages of a texture atlas from the images of its source tilesets
+    /// Each tile is copied to its slot and its edge pixels are repeated outwards by the atlas extrusion; the padding
+    /// stays transparent. Source tiles reaching past their image are transparent there.
+    /// @param renderData Render data rewritten by render::packAtlas, whose tilesets are the pages
+    /// @param atlas Layout returned by render::packAtlas
+    /// @return One straight-alpha image per page, e.g. for Rasterizer::setTilesetImage or a GPU upload, or an error
+    ///         if a source image cannot be read
+    auto composeAtlas(const render::MapRenderData& renderData, const render::TextureAtlas& atlas)
+        -> tl::expected<std::vector<Image>, std::string>;
+
+    /// @brief Map pixels part of a tile layer covers in the images of Rasterizer::render
+    /// @param layer Layer of the render data
+    /// @param bounds Pixel bounds in the layer's coordinates, e.g. LayerRenderData::bounds or a chunk's bounds
+    /// @return The bounds moved by the layer's offset and rounded outwards
+    [[nodiscard]] auto drawnBounds(const render::LayerRenderData& layer, const render::RenderBounds& bounds)
+        -> render::RenderBounds;
+
+    /// @brief Composite premultiplied pixels over a premultiplied row ("source over")
+    /// Four pixels are blended per step with SSE2 where available; the scalar path gives bit-identical results.
+    /// @param dst Destination RGBA pixels, premultiplied
+    /// @param src Source RGBA pixels, premultiplied
+    /// @param count Number of pixels
+    /// @param opacity Source opacity in 1/256 steps (256 is opaque)
+    void blendRow(std::uint8_t* dst, const std::uint8_t* src, std::size_t count, std::uint32_t opacity);
+
+    /// @brief Draws render data into RGBA images on the CPU, e.g. for map previews on machines without a GPU
+    /// Visible tile layers are drawn in order with their opacity, then the tile objects of visible object groups.
+    /// Layers and object groups are moved by their offsets; parallax is resolved for a camera at the map origin, so
+    /// every region of the map is drawn consistently.
+    /// The image is split into bands of rows drawn in parallel; each band only visits the chunks it overlaps.
+    class Rasterizer
+    {
+    public:
+        Rasterizer() = default;
+
+        /// @brief Create a rasterizer for the given render data, without tileset images
+        /// @param renderData Render data to draw; must outlive the rasterizer
+        explicit Rasterizer(const render::MapRenderData& renderData);
+
+        /// @brief Bind the rasterizer to other render data and drop the tileset images
+        /// @param renderData Render data to draw; must outlive the rasterizer
+        void reset(const render::MapRenderData& renderData);
+
+        /// @brief Render data the rasterizer is bound to, or nullptr
+        [[nodiscard]] auto renderData() const -> const render::MapRenderData* { return m_renderData; }
+
+        /// @brief Load the image of every tileset from TilesetRenderInfo::imagePath
+        /// @return Nothing, or an error naming the first image that could not be loaded
+        auto loadTilesetImages() -> tl::expected<void, std::string>;
+
+        /// @brief Use an image already in memory for a tileset
+        /// @param tilesetIndex Index into MapRenderData::tilesets
+        /// @param image Tileset image with straight alpha
+        /// @return false if the tileset does not exist
+        auto setTilesetImage(std::uint32_t tilesetIndex, const Image& image) -> bool;
+
+        /// @brief Draw the map; tiles of tilesets without an image are skipped
+        /// @param options Region, scale, animation time and threads
+        /// @return The image, or an error for an empty region, a non-positive scale or an image over MAX_IMAGE_SIZE
+        [[nodiscard]] auto render(const RasterOptions& options = {}) const -> tl::expected<Image, std::string>;
+
+    private:
+        const render::MapRenderData* m_renderData = nullptr;
+        std::vector<Image> m_tilesetImages; // Premultiplied copies indexed like MapRenderData::tilesets; empty if missing
+    };
+}
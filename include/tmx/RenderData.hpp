@@ -1,12 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 #include <string>
 #include "Map.hpp"
+#include "Projection.hpp"
 
 namespace tmx::render
 {
+    // Flip flags of a rendered tile: the GID flag bits shifted down by map::GID_FLAGS_SHIFT
+    constexpr std::uint8_t TILE_FLIP_HORIZONTAL = 0x8;
+    constexpr std::uint8_t TILE_FLIP_VERTICAL = 0x4;
+    constexpr std::uint8_t TILE_FLIP_DIAGONAL = 0x2;
+    constexpr std::uint8_t TILE_ROTATE_HEXAGONAL_120 = 0x1;
+
     /// @brief Pre-calculated tile information for efficient rendering
     /// This structure eliminates the need for runtime calculations during rendering
     struct TileRenderInfo
@@ -14,14 +24,193 @@ namespace tmx::render
         std::uint32_t tileId; // Tile ID after subtracting firstgid
         std::uint32_t srcX, srcY; // Source position in tileset (pixels)
         std::uint32_t srcW, srcH; // Source dimensions in tileset (pixels)
-        std::int32_t destX, destY; // Destination position on screen (pixels) - can be negative for infinite maps
+        std::int32_t destX, destY; // Top-left corner of the cell's bounding box on screen (pixels), may be negative
         std::uint32_t destW, destH; // Destination dimensions on screen (pixels)
         std::uint32_t tilesetIndex; // Which tileset this tile belongs to
         float opacity; // Layer opacity (0.0 - 1.0)
         bool isAnimated; // Whether this tile has animation
+        std::uint8_t flipFlags; // TILE_FLIP_* bits
         std::uint32_t animationIndex; // Index into TilesetRenderInfo::animations (-1 if not animated)
     };
 
+    /// @brief Compact 16-byte tile record holding only the data that varies per tile
+    /// Source and destination sizes come from TilesetRenderInfo and MapRenderData, opacity from the layer,
+    /// and the source position from TilesetRenderInfo::srcXOf/srcYOf (or AnimationClock for animated tiles).
+    struct PackedTileRenderInfo
+    {
+        static constexpr std::uint16_t NO_ANIMATION = 0xFFFF;
+
+        std::int32_t destX, destY; // Destination position on screen (pixels)
+        std::uint32_t tileIdAndFlags; // Tile ID (low 28 bits) and TILE_FLIP_* bits (high 4 bits)
+        std::uint16_t tilesetIndex; // Which tileset this tile belongs to
+        std::uint16_t animationIndex; // Index into TilesetRenderInfo::animations, or NO_ANIMATION
+
+        [[nodiscard]] auto tileId() const -> std::uint32_t { return tileIdAndFlags & map::GID_MASK; }
+        [[nodiscard]] auto flipFlags() const -> std::uint8_t
+        {
+            return static_cast<std::uint8_t>(tileIdAndFlags >> map::GID_FLAGS_SHIFT);
+        }
+        [[nodiscard]] auto isAnimated() const -> bool { return animationIndex != NO_ANIMATION; }
+    };
+
+    static_assert(sizeof(PackedTileRenderInfo) == 16);
+
+    /// @brief Render information shared by every cell using the same GID
+    struct GidRenderInfo
+    {
+        static constexpr std::uint16_t NO_TILESET = 0xFFFF;
+
+        std::uint32_t tileId; // Tile ID after subtracting firstgid
+        std::uint32_t srcX, srcY; // Source position in tileset (pixels)
+        std::uint16_t tilesetIndex; // Which tileset this GID belongs to, or NO_TILESET
+        std::uint16_t animationIndex; // Index into TilesetRenderInfo::animations, or PackedTileRenderInfo::NO_ANIMATION
+    };
+
+    /// @brief Rectangular block of raw GIDs in LayerRenderData::gids (the whole layer, or one infinite-map chunk)
+    struct TileBlock
+    {
+        std::int32_t x, y; // Position of the block in tiles
+        std::uint32_t width, height; // Size of the block in tiles
+        std::uint32_t offset; // Index of the block's first GID in LayerRenderData::gids
+    };
+
+    /// @brief How MapRenderData::fromMap stores the tiles of each layer
+    enum class TileStorage
+    {
+        Full, // LayerRenderData::tiles with fully expanded TileRenderInfo records
+        Packed, // LayerRenderData::packedTiles with 16-byte PackedTileRenderInfo records
+        Indexed // LayerRenderData::gids with the raw GIDs, resolved through MapRenderData::gidTable when visited
+    };
+
+    /// @brief Default edge length, in tiles, of the spatial chunks layers are bucketed into
+    constexpr std::uint32_t DEFAULT_CHUNK_SIZE = 32;
+
+    /// @brief Options controlling how render data is built
+    struct RenderBuildOptions
+    {
+        TileStorage tileStorage = TileStorage::Full;
+        std::uint32_t chunkSize = DEFAULT_CHUNK_SIZE; // Edge length of spatial chunks in tiles (0 is treated as 1)
+        std::uint32_t threadCount = 1; // Threads building layers; 0 uses every hardware thread. Output never depends on it
+        bool mergeDuplicateTilesets = true; // Tilesets with the same image path and grid share one TilesetRenderInfo
+        bool hashTilesetImages = false; // Also merge tilesets whose image files have identical bytes (reads the files)
+    };
+
+    /// @brief Axis-aligned rectangle in map pixels, e.g. the part of the world covered by the camera
+    struct ViewRect
+    {
+        float x, y; // Top-left corner (pixels)
+        float width, height; // Size (pixels)
+    };
+
+    /// @brief Placement and tint of a layer with the offsets, parallax factors and tints of its groups folded in
+    struct LayerTransform
+    {
+        float offsetX = 0.0f, offsetY = 0.0f; // Added to every position of the layer (pixels)
+        float parallaxX = 1.0f, parallaxY = 1.0f; // Fraction of the camera movement the layer scrolls by
+        map::Color tint{255, 255, 255, 255}; // Multiplied with every pixel of the layer
+
+        /// @brief The part of the layer shown by a camera, in the layer's own coordinates
+        /// @param view Visible part of the map in pixels, as for a layer without offset or parallax
+        [[nodiscard]] auto toLayer(const ViewRect& view) const -> ViewRect
+        {
+            return {view.x * parallaxX - offsetX, view.y * parallaxY - offsetY, view.width, view.height};
+        }
+
+        [[nodiscard]] auto isIdentity() const -> bool
+        {
+            return offsetX == 0.0f && offsetY == 0.0f && parallaxX == 1.0f && parallaxY == 1.0f &&
+                tint.r == 255 && tint.g == 255 && tint.b == 255 && tint.a == 255;
+        }
+    };
+
+    /// @brief Axis-aligned bounding box of an object in pixels, with inclusive edges
+    struct ObjectBounds
+    {
+        float minX = 0.0f, minY = 0.0f;
+        float maxX = 0.0f, maxY = 0.0f;
+
+        [[nodiscard]] auto intersects(const ViewRect& rect) const -> bool
+        {
+            return minX <= rect.x + rect.width && rect.x <= maxX && minY <= rect.y + rect.height && rect.y <= maxY;
+        }
+
+        [[nodiscard]] auto contains(const float x, const float y) const -> bool
+        {
+            return x >= minX && x <= maxX && y >= minY && y <= maxY;
+        }
+
+        /// @brief Whether the box reaches within radius of a point
+        [[nodiscard]] auto intersectsCircle(const float x, const float y, const float radius) const -> bool
+        {
+            const float dx = x < minX ? minX - x : x > maxX ? x - maxX : 0.0f;
+            const float dy = y < minY ? minY - y : y > maxY ? y - maxY : 0.0f;
+            return dx * dx + dy * dy <= radius * radius;
+        }
+    };
+
+    /// @brief Triangle of a polygon, as indices into the polygon's points
+    struct ShapeTriangle
+    {
+        std::uint32_t a, b, c;
+    };
+
+    /// @brief Pixel bounding box, with exclusive maximum edges
+    struct RenderBounds
+    {
+        std::int32_t minX = 0, minY = 0;
+        std::int32_t maxX = 0, maxY = 0;
+
+        [[nodiscard]] auto isEmpty() const -> bool { return minX >= maxX || minY >= maxY; }
+
+        [[nodiscard]] auto intersects(const ViewRect& rect) const -> bool
+        {
+            return !isEmpty() && static_cast<float>(minX) < rect.x + rect.width && rect.x < static_cast<float>(maxX) &&
+                static_cast<float>(minY) < rect.y + rect.height && rect.y < static_cast<float>(maxY);
+        }
+
+        /// @brief Grow the box to include another one
+        void merge(const RenderBounds& other)
+        {
+            if (other.isEmpty())
+                return;
+            if (isEmpty())
+            {
+                *this = other;
+                return;
+            }
+            minX = std::min(minX, other.minX);
+            minY = std::min(minY, other.minY);
+            maxX = std::max(maxX, other.maxX);
+            maxY = std::max(maxY, other.maxY);
+        }
+    };
+
+    /// @brief Fixed-size square of a layer's tiles, used to cull tiles outside the view
+    /// Tiles of a chunk are stored contiguously, in row-major order within the chunk.
+    struct SpatialChunk
+    {
+        std::int32_t chunkX, chunkY; // Chunk coordinates (tile coordinates divided by the chunk size, rounded down)
+        RenderBounds bounds; // Bounding box of the chunk's non-empty tiles
+        std::uint32_t first; // First index into tiles, packedTiles, or tileBlocks (TileStorage::Indexed)
+        std::uint32_t count; // Number of tiles (or tile blocks) in the chunk
+    };
+
+    /// @brief Consecutive chunks of one layer overlapping a view, as returned by MapRenderData::query
+    struct ChunkRange
+    {
+        std::uint32_t layerIndex; // Index into MapRenderData::layers
+        std::uint32_t first; // First index into LayerRenderData::chunks
+        std::uint32_t count; // Number of chunks
+    };
+
+    /// @brief Edited part of a spatial chunk, for renderers that keep per-chunk GPU buffers
+    struct DirtyRegion
+    {
+        std::uint32_t layerIndex; // Index into MapRenderData::layers
+        std::int32_t chunkX, chunkY; // Chunk coordinates of the edited chunk
+        RenderBounds bounds; // Pixel bounds of the edited cells (the chunk itself may have been removed)
+    };
+
     /// @brief Pre-calculated animation frame information
     struct AnimationFrameInfo
     {
@@ -33,29 +222,88 @@ namespace tmx::render
     /// @brief Animation data for a specific tile
     struct TileAnimationInfo
     {
+        /// @brief Upper bound on quantized timeline entries before falling back to prefix-sum search
+        static constexpr std::uint32_t MAX_TIMELINE_ENTRIES = 1024;
+
         std::uint32_t baseTileId; // The base tile ID that has this animation
         std::vector<AnimationFrameInfo> frames;
         std::uint32_t totalDuration; // Total animation duration in milliseconds
-        std::vector<std::uint32_t> timeToFrameIndex; // Flattened time-to-frame lookup (one entry per millisecond)
+        std::uint32_t timeQuantum = 1; // GCD of all frame durations in milliseconds
+        std::vector<std::uint16_t> timeline; // Frame index per time quantum (empty if the cycle is too irregular)
+        std::vector<std::uint32_t> frameEndTimes; // Prefix sums of frame durations (end time of each frame)
+
+        /// @brief Build the compact time-to-frame lookup from frames
+        /// Uses a GCD-quantized table when it is small, otherwise only the prefix sums are kept
+        void buildTimeline();
 
         /// @brief Get the frame index for a given time in the animation cycle
         /// @param timeInCycle Time in milliseconds within the animation cycle (0 to totalDuration-1)
         /// @return Frame index
         [[nodiscard]] inline auto getFrameIndexAtTime(std::uint32_t timeInCycle) const -> std::uint32_t
         {
-            if (timeToFrameIndex.empty() || timeInCycle >= timeToFrameIndex.size())
+            if (timeInCycle >= totalDuration)
                 return 0;
-            return timeToFrameIndex[timeInCycle];
+            if (!timeline.empty())
+                return timeline[timeInCycle / timeQuantum];
+
+            // Branchless lower bound: first frame whose end time is past timeInCycle
+            const std::uint32_t* base = frameEndTimes.data();
+            std::size_t count = frameEndTimes.size();
+            while (count > 1)
+            {
+                const std::size_t half = count / 2;
+                base = base[half] <= timeInCycle ? base + half : base;
+                count -= half;
+            }
+            return static_cast<std::uint32_t>(base - frameEndTimes.data()) + (*base <= timeInCycle ? 1u : 0u);
         }
     };
 
+    /// @brief Identifies one animation of a tileset
+    struct AnimationRef
+    {
+        std::uint32_t tilesetIndex; // Index into MapRenderData::tilesets
+        std::uint32_t animationIndex; // Index into TilesetRenderInfo::animations
+    };
+
+    /// @brief Animated tiles of a layer that share the same animation
+    struct AnimatedTileGroup
+    {
+        AnimationRef animation;
+        std::uint32_t first; // Offset into LayerRenderData::animatedTileIndices
+        std::uint32_t count; // Number of tiles in this group
+    };
+
     /// @brief Pre-calculated layer rendering information
     struct LayerRenderData
     {
         std::string name;
-        bool visible;
-        float opacity;
-        std::vector<TileRenderInfo> tiles; // Only non-empty tiles
+        bool visible; // False if the layer or any group containing it is hidden
+        float opacity; // Layer opacity multiplied by the opacities of its groups
+        LayerTransform transform; // Offsets, parallax and tint of the layer and its groups
+        TileStorage storage = TileStorage::Full; // Which of tiles, packedTiles or gids holds the layer's tiles
+        std::vector<TileRenderInfo> tiles; // Only non-empty tiles (TileStorage::Full)
+        std::vector<PackedTileRenderInfo> packedTiles; // Only non-empty tiles (TileStorage::Packed)
+        std::vector<std::uint32_t> gids; // Raw GIDs including empty cells (TileStorage::Indexed)
+        std::vector<TileBlock> tileBlocks; // Blocks of gids, one per spatial chunk (TileStorage::Indexed)
+        std::vector<SpatialChunk> chunks; // Non-empty spatial chunks sorted by chunkY, then chunkX
+        RenderBounds bounds; // Bounding box of all tiles of the layer
+        std::vector<AnimatedTileGroup> animatedGroups; // Sorted by tileset index, then animation index
+        std::vector<std::uint32_t> animatedTileIndices; // Indices into tiles or packedTiles, grouped by animatedGroups
+
+        /// @brief Rebuild animatedGroups and animatedTileIndices from tiles or packedTiles
+        /// Indexed layers have no per-tile records and are not grouped; resolve animation through gidTable instead
+        void indexAnimatedTiles();
+
+        /// @brief Indices into tiles (or packedTiles) of all tiles in an animated group
+        [[nodiscard]] auto animatedTilesOf(const AnimatedTileGroup& group) const -> std::span<const std::uint32_t>
+        {
+            return {animatedTileIndices.data() + group.first, group.count};
+        }
+
+        /// @brief Find the group of tiles using an animation
+        /// @return The group, or nullptr if no tile of this layer uses the animation
+        [[nodiscard]] auto findAnimatedGroup(const AnimationRef& animation) const -> const AnimatedTileGroup*;
     };
 
     /// @brief Pre-calculated object rendering information
@@ -69,13 +317,19 @@ namespace tmx::render
         float rotation; // Rotation in degrees
         bool visible;
         map::ObjectShape shape;
-        std::vector<map::Point> points; // For polygon/polyline
         std::uint32_t gid; // For tile objects
 
+        // Shape geometry of polygons and polylines, in the pools of MapRenderData
+        std::uint32_t firstPoint = 0, pointCount = 0; // Points relative to (x, y), in MapRenderData::points
+        std::uint32_t firstTriangle = 0, triangleCount = 0; // Polygon triangles, in MapRenderData::triangles
+        float length = 0.0f; // Polyline length or polygon perimeter (pixels)
+        ObjectBounds bounds; // Bounding box when the render data was built; see objectBounds after moving the object
+
         // Pre-calculated tile rendering info for tile objects (gid != 0)
         std::uint32_t tilesetIndex = static_cast<std::uint32_t>(-1);
         std::uint32_t srcX = 0, srcY = 0;
         std::uint32_t srcW = 0, srcH = 0;
+        std::uint8_t flipFlags = 0; // TILE_FLIP_* bits
     };
 
     /// @brief Pre-calculated object group rendering information
@@ -85,51 +339,333 @@ namespace tmx::render
         bool visible;
         float opacity;
         std::vector<ObjectRenderInfo> objects;
+        map::DrawOrder drawOrder = map::DrawOrder::TopDown;
+        LayerTransform transform{}; // Offsets, parallax and tint of the group and its parent groups
+    };
+
+    /// @brief Pre-calculated image layer rendering information
+    struct ImageLayerRenderData
+    {
+        std::string name;
+        std::string imagePath;
+        std::uint32_t imageWidth = 0, imageHeight = 0;
+        bool repeatX = false, repeatY = false; // Whether the image tiles across the view
+        bool visible = true; // False if the layer or any group containing it is hidden
+        float opacity = 1.0f; // Layer opacity multiplied by the opacities of its groups
+        LayerTransform transform;
+    };
+
+    /// @brief A group layer with its effective visibility, opacity and transform
+    /// Parents come before their children, so one forward pass folds every group into its parent.
+    struct GroupRenderData
+    {
+        std::string name;
+        bool visible = true; // False if the group or any group containing it is hidden
+        float opacity = 1.0f; // Group opacity multiplied by the opacities of its parents
+        LayerTransform transform;
+        std::int32_t parent = -1; // Index into MapRenderData::groups, or -1 at the top level
+    };
+
+    /// @brief Identifies one object of the render data
+    struct ObjectRef
+    {
+        std::uint32_t objectGroupIndex; // Index into MapRenderData::objectGroups
+        std::uint32_t objectIndex; // Index into ObjectGroupRenderData::objects
     };
 
     /// @brief Tileset information for texture loading
+    /// Map tilesets declared more than once share one TilesetRenderInfo (see RenderBuildOptions::mergeDuplicateTilesets);
+    /// the GID table resolves the GIDs of every copy to it.
     struct TilesetRenderInfo
     {
         std::string name;
         std::string imagePath;
         std::uint32_t imageWidth;
         std::uint32_t imageHeight;
-        std::uint32_t firstgid;
+        std::uint32_t firstgid; // First GID of the first map tileset using this render tileset
         std::uint32_t tileWidth;
         std::uint32_t tileHeight;
         std::uint32_t columns;
         std::uint32_t tileCount;
+        std::uint32_t margin = 0; // Pixels between the image edge and the first tile
+        std::uint32_t spacing = 0; // Pixels between neighbouring tiles
         std::vector<TileAnimationInfo> animations; // Animation data for tiles in this tileset
+
+        /// @brief Source X position of a tile in the tileset image (pixels)
+        /// Image-collection tilesets (columns == 0) have one image per tile, so their tiles start at the margin
+        [[nodiscard]] auto srcXOf(std::uint32_t tileId) const -> std::uint32_t
+        {
+            return columns == 0 ? margin : margin + (tileId % columns) * (tileWidth + spacing);
+        }
+
+        /// @brief Source Y position of a tile in the tileset image (pixels)
+        [[nodiscard]] auto srcYOf(std::uint32_t tileId) const -> std::uint32_t
+        {
+            return columns == 0 ? margin : margin + (tileId / columns) * (tileHeight + spacing);
+        }
     };
 
     /// @brief Complete rendering data for a map
-    /// All tile coordinates and positions are pre-calculated for maximum performance
+    /// All tile coordinates and positions are pre-calculated for maximum performance. Destinations follow the map's
+    /// orientation (see Projection.hpp); chunks and dirty regions stay in tile coordinates.
     struct MapRenderData
     {
         std::uint32_t mapWidth; // Map width in tiles
         std::uint32_t mapHeight; // Map height in tiles
         std::uint32_t tileWidth; // Tile width in pixels
         std::uint32_t tileHeight; // Tile height in pixels
-        std::uint32_t pixelWidth; // Total map width in pixels
-        std::uint32_t pixelHeight; // Total map height in pixels
+        std::uint32_t pixelWidth; // Width of the map's mapWidth x mapHeight cells on screen in pixels
+        std::uint32_t pixelHeight; // Height of the map's mapWidth x mapHeight cells on screen in pixels
+        ProjectionParams projection; // Orientation and grid parameters placing cells on screen
+        map::RenderOrder renderOrder = map::RenderOrder::RightDown; // Order tiles overlapping each other are drawn in
 
         std::vector<TilesetRenderInfo> tilesets;
+        std::vector<GidRenderInfo> gidTable; // Indexed by GID (flip flags stripped); built once per map
+        std::uint32_t chunkSize; // Edge length of LayerRenderData::chunks in tiles
+        bool infinite = false; // Whether layers may extend beyond mapWidth x mapHeight
         std::vector<LayerRenderData> layers;
         std::vector<ObjectGroupRenderData> objectGroups;
+        std::vector<ImageLayerRenderData> imageLayers;
+        std::vector<GroupRenderData> groups; // Already folded: layers read their effective values from here
+        std::vector<map::LayerRef> layerOrder; // Tile, object and image layers in drawing order
+        std::vector<map::Point> points; // Polygon and polyline points of every object, back to back
+        std::vector<float> pointDistances; // Parallel to points: path length from the object's first point (pixels)
+        std::vector<ShapeTriangle> triangles; // Polygon triangulations of every object, back to back
+        std::vector<ObjectRenderInfo> tileShapes; // Collision shapes of tiles, grouped by GID; relative to the tile
+        std::vector<std::uint32_t> gidShapeOffsets; // Indexed by GID: first entry of tileShapes; empty if none
+        std::vector<DirtyRegion> dirtyRegions; // One entry per chunk edited since the renderer last cleared it
 
         /// @brief Create render data from a parsed TMX map
         /// @param map The parsed TMX map
         /// @param assetBasePath Optional base path for resolving relative tileset image paths
+        /// @param options Build options such as the tile storage layout
         /// @return MapRenderData with pre-calculated rendering information
-        static auto fromMap(const map::Map& map, const std::string& assetBasePath = "") -> MapRenderData;
+        static auto fromMap(const map::Map& map, const std::string& assetBasePath = "",
+                            const RenderBuildOptions& options = {}) -> MapRenderData;
+
+        /// @brief Build the render data of one layer against the tilesets, GID table and chunk size of this map
+        /// fromMap calls this for every layer; it can also build layers loaded later, e.g. streamed chunks.
+        /// With several threads, finite layers are split into rows of spatial chunks and infinite layers into their
+        /// map chunks; tiles are counted per band first so every band writes straight into its final slots.
+        /// @param layer Parsed layer (finite data or chunks)
+        /// @param options Build options; the chunk size of this render data is used instead of options.chunkSize
+        [[nodiscard]] auto buildLayer(const map::Layer& layer, const RenderBuildOptions& options = {}) const
+            -> LayerRenderData;
+
+        /// @brief Replace the tile in one cell of a layer
+        /// Only the cell's spatial chunk is rewritten and its animation links patched; adding or removing a tile
+        /// of a Full or Packed layer also shifts the layer's later tiles. The edit is recorded in dirtyRegions.
+        /// @param layerIndex Index into layers
+        /// @param x Tile column of the cell
+        /// @param y Tile row of the cell
+        /// @param gid Global tile ID including flip flags; 0 or a GID outside every tileset clears the cell
+        /// @return false if the layer does not exist or the cell lies outside a finite map
+        auto setTile(std::uint32_t layerIndex, std::int32_t x, std::int32_t y, std::uint32_t gid) -> bool;
+
+        /// @brief Remove the tile in one cell of a layer
+        /// @return false if the layer does not exist or the cell lies outside a finite map
+        auto clearTile(std::uint32_t layerIndex, std::int32_t x, std::int32_t y) -> bool
+        {
+            return setTile(layerIndex, x, y, 0);
+        }
+
+        /// @brief Set every cell of a rectangle of a layer to the same tile, rewriting each chunk once
+        /// @param layerIndex Index into layers
+        /// @param x Tile column of the rectangle's left edge
+        /// @param y Tile row of the rectangle's top edge
+        /// @param width Width of the rectangle in tiles
+        /// @param height Height of the rectangle in tiles
+        /// @param gid Global tile ID including flip flags; 0 clears the rectangle
+        /// @return false if the layer does not exist or the rectangle lies outside a finite map
+        auto fillRect(std::uint32_t layerIndex, std::int32_t x, std::int32_t y, std::uint32_t width,
+                      std::uint32_t height, std::uint32_t gid) -> bool;
+
+        /// @brief Expand a packed tile into a full TileRenderInfo (static source position)
+        [[nodiscard]] auto unpack(const PackedTileRenderInfo& tile, float opacity) const -> TileRenderInfo;
+
+        /// @brief Build the full TileRenderInfo of a GID drawn at a destination
+        /// @param info Entry of gidTable for the GID
+        /// @param dest Top-left corner of the cell's bounding box on screen
+        /// @param rawGid Global tile ID including flip flags
+        /// @param opacity Layer opacity
+        [[nodiscard]] auto makeTile(const GidRenderInfo& info, const ScreenPoint& dest, std::uint32_t rawGid,
+                                    float opacity) const -> TileRenderInfo;
+
+        /// @brief Look up the shared render information of a GID
+        /// @param gid Global tile ID, flip flags are ignored
+        /// @return The entry, or nullptr for empty cells and GIDs outside every tileset
+        [[nodiscard]] auto gidInfo(std::uint32_t gid) const -> const GidRenderInfo*
+        {
+            const std::uint32_t index = gid & map::GID_MASK;
+            if (index == 0 || index >= gidTable.size() || gidTable[index].tilesetIndex == GidRenderInfo::NO_TILESET)
+                return nullptr;
+            return &gidTable[index];
+        }
+
+        /// @brief Collision shapes of the tile shown by a GID, positioned relative to the tile's top-left corner
+        /// Every cell showing the GID shares these entries; their points and triangles live in the pools below.
+        /// @param gid Global tile ID, flip flags are ignored
+        [[nodiscard]] auto gidShapes(const std::uint32_t gid) const -> std::span<const ObjectRenderInfo>
+        {
+            const std::uint32_t index = gid & map::GID_MASK;
+            if (index + 1 >= gidShapeOffsets.size())
+                return {};
+            return {tileShapes.data() + gidShapeOffsets[index], gidShapeOffsets[index + 1] - gidShapeOffsets[index]};
+        }
+
+        /// @brief Polygon or polyline points of an object, relative to its position
+        [[nodiscard]] auto objectPoints(const ObjectRenderInfo& object) const -> std::span<const map::Point>
+        {
+            if (object.firstPoint > points.size() || object.pointCount > points.size() - object.firstPoint)
+                return {};
+            return {points.data() + object.firstPoint, object.pointCount};
+        }
+
+        /// @brief Triangles covering a polygon object, as indices into its objectPoints
+        [[nodiscard]] auto objectTriangles(const ObjectRenderInfo& object) const -> std::span<const ShapeTriangle>
+        {
+            if (object.firstTriangle > triangles.size() || object.triangleCount > triangles.size() - object.firstTriangle)
+                return {};
+            return {triangles.data() + object.firstTriangle, object.triangleCount};
+        }
+
+        /// @brief Point at a distance along the outline of a polygon or polyline object, for path following
+        /// Polylines clamp the distance to [0, length]; polygons wrap around. The object's rotation is applied.
+        /// @return Position in pixels
+        [[nodiscard]] auto pointAlongPath(const ObjectRenderInfo& object, float distance) const -> map::Point;
+
+        /// @brief Find the chunks overlapping a view rectangle
+        /// Work is proportional to the number of chunk rows and overlapping chunks, not to the size of the map.
+        /// Layers with an offset or parallax are searched with the view moved into their coordinates.
+        /// @param viewRect Visible part of the map in pixels
+        /// @param ranges Receives the overlapping chunk ranges in layer order; cleared first so it can be reused
+        ///               every frame without allocating
+        void query(const ViewRect& viewRect, std::vector<ChunkRange>& ranges) const;
+
+        /// @brief Find the chunks overlapping a view rectangle
+        /// @param viewRect Visible part of the map in pixels
+        /// @return The overlapping chunk ranges in layer order
+        [[nodiscard]] auto query(const ViewRect& viewRect) const -> std::vector<ChunkRange>
+        {
+            std::vector<ChunkRange> ranges;
+            query(viewRect, ranges);
+            return ranges;
+        }
+
+        /// @brief Append the chunks of one layer overlapping a rectangle given in the layer's own coordinates
+        /// Unlike query, the layer's offset and parallax are not applied, for callers that place layers themselves.
+        /// @param layerIndex Index into layers
+        /// @param layerRect Rectangle in the layer's coordinates (pixels)
+        /// @param ranges Receives the overlapping chunk ranges of the layer; not cleared
+        void queryLayer(std::uint32_t layerIndex, const ViewRect& layerRect, std::vector<ChunkRange>& ranges) const;
+
+        /// @brief Visit every non-empty tile of a layer as a TileRenderInfo, whatever its storage
+        /// Indexed layers are expanded on the fly, so memory stays proportional to the number of unique tiles.
+        /// @param layer Layer of this render data
+        /// @param visitor Callable invoked with a const TileRenderInfo& per tile, in layer order
+        template <typename Visitor>
+        void forEachTile(const LayerRenderData& layer, Visitor&& visitor) const
+        {
+            for (const auto& chunk : layer.chunks)
+                forEachTile(layer, chunk, visitor);
+        }
+
+        /// @brief Visit the non-empty tiles of one spatial chunk of a layer
+        /// @param layer Layer of this render data
+        /// @param chunk Chunk of the layer
+        /// @param visitor Callable invoked with a const TileRenderInfo& per tile, in row-major order
+        template <typename Visitor>
+        void forEachTile(const LayerRenderData& layer, const SpatialChunk& chunk, Visitor&& visitor) const
+        {
+            const std::uint32_t end = chunk.first + chunk.count;
+            switch (layer.storage)
+            {
+            case TileStorage::Full:
+                for (std::uint32_t i = chunk.first; i < end; ++i)
+                    visitor(layer.tiles[i]);
+                break;
+            case TileStorage::Packed:
+                for (std::uint32_t i = chunk.first; i < end; ++i)
+                    visitor(unpack(layer.packedTiles[i], layer.opacity));
+                break;
+            case TileStorage::Indexed:
+                withProjection(projection, [&](const auto& grid)
+                {
+                    for (std::uint32_t i = chunk.first; i < end; ++i)
+                        forEachTileOfBlock(layer, layer.tileBlocks[i], grid, visitor);
+                });
+                break;
+            }
+        }
+
+        /// @brief Visit the tiles of every chunk range returned by query
+        /// @param ranges Chunk ranges of this render data
+        /// @param visitor Callable invoked with the LayerRenderData and a const TileRenderInfo& per tile
+        template <typename Visitor>
+        void forEachTile(std::span<const ChunkRange> ranges, Visitor&& visitor) const
+        {
+            for (const auto& range : ranges)
+            {
+                const auto& layer = layers[range.layerIndex];
+                for (std::uint32_t i = range.first; i < range.first + range.count; ++i)
+                {
+                    forEachTile(layer, layer.chunks[i], [&](const TileRenderInfo& tile) { visitor(layer, tile); });
+                }
+            }
+        }
+
+    private:
+        [[nodiscard]] auto makePackedTile(const GidRenderInfo& info, const ScreenPoint& dest,
+                                          std::uint32_t rawGid) const -> PackedTileRenderInfo;
+
+        [[nodiscard]] auto cellsOf(const ViewRect& view) const -> CellRect;
+        void queryChunks(std::uint32_t layerIdx, const ViewRect& view, const CellRect& cells,
+                         std::vector<ChunkRange>& ranges) const;
+
+        template <typename Tile, typename Projection>
+        void emitTiles(const map::Layer& layer, LayerRenderData& layerData, std::vector<Tile>& tiles,
+                       std::uint32_t threadCount, const Projection& grid) const;
+
+        void editChunk(std::uint32_t layerIndex, std::int32_t chunkX, std::int32_t chunkY, const CellRect& cells,
+                       std::uint32_t gid);
+        template <typename Tile, typename Projection>
+        auto spliceChunk(LayerRenderData& layer, std::vector<Tile>& tiles, std::int32_t chunkX, std::int32_t chunkY,
+                         const CellRect& cells, std::uint32_t gid, const Projection& grid) const -> bool;
+        template <typename Projection>
+        auto editIndexedChunk(LayerRenderData& layer, std::int32_t chunkX, std::int32_t chunkY, const CellRect& cells,
+                              std::uint32_t gid, const Projection& grid) const -> bool;
+
+        template <typename Projection, typename Visitor>
+        void forEachTileOfBlock(const LayerRenderData& layer, const TileBlock& block, const Projection& grid,
+                                Visitor& visitor) const
+        {
+            const std::uint32_t* row = layer.gids.data() + block.offset;
+            for (std::uint32_t y = 0; y < block.height; ++y, row += block.width)
+            {
+                for (std::uint32_t x = 0; x < block.width; ++x)
+                {
+                    const GidRenderInfo* info = gidInfo(row[x]);
+                    if (!info)
+                        continue;
+
+                    const TileRenderInfo tile = makeTile(*info,
+                                                         grid.toScreen(block.x + static_cast<std::int32_t>(x),
+                                                                       block.y + static_cast<std::int32_t>(y)),
+                                                         row[x], layer.opacity);
+                    visitor(tile);
+                }
+            }
+        }
     };
 
     /// @brief Helper function to create render data from a map
     /// @param map The parsed TMX map
     /// @param assetBasePath Optional base path for resolving relative tileset image paths
+    /// @param options Build options such as the tile storage layout
     /// @return MapRenderData with pre-calculated rendering information
-    inline auto createRenderData(const map::Map& map, const std::string& assetBasePath = "") -> MapRenderData
+    inline auto createRenderData(const map::Map& map, const std::string& assetBasePath = "",
+                                 const RenderBuildOptions& options = {}) -> MapRenderData
     {
-        return MapRenderData::fromMap(map, assetBasePath);
+        return MapRenderData::fromMap(map, assetBasePath, options);
     }
 }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief Bounding box of an object as Tiled draws it
+    /// Rectangles, ellipses and text hang down-right from (x, y), tile objects up-right from it, and polygon points
+    /// are relative to it; all of them are rotated clockwise about (x, y). Rotated ellipses get their exact bounds.
+    /// Tile objects without a size take the size of their tile.
+    /// @param points Polygon or polyline points of the object (MapRenderData::objectPoints); unused for other shapes
+    [[nodiscard]] auto objectBounds(const ObjectRenderInfo& object, std::span<const map::Point> points = {})
+        -> ObjectBounds;
+
+    /// @brief Split a polygon into triangles by ear clipping
+    /// Either winding and concave outlines are handled; triangles keep the winding of the outline, and collinear
+    /// points add no triangle. Self-intersecting outlines still get triangles, which may then overlap.
+    /// @param polygon Outline points
+    /// @param triangles Receives the triangles as indices into polygon; appended to
+    /// @return Number of triangles appended, at most polygon.size() - 2
+    auto triangulatePolygon(std::span<const map::Point> polygon, std::vector<ShapeTriangle>& triangles)
+        -> std::uint32_t;
+
+    /// @brief Path length from the first point of an outline to each of its points
+    /// @param distances Receives one distance per point, starting at 0; appended to
+    /// @param closed Whether the path returns from the last point to the first, as polygons do
+    /// @return Length of the whole path, closing edge included
+    auto measurePath(std::span<const map::Point> points, bool closed, std::vector<float>& distances) -> float;
+
+    /// @brief Point at a distance along a path measured by measurePath
+    /// Open paths clamp the distance to [0, length]; closed paths wrap around.
+    /// @return The point, in the coordinates of points
+    [[nodiscard]] auto pointAlongPath(std::span<const map::Point> points, std::span<const float> distances, float length,
+                                      bool closed, float distance) -> map::Point;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <tl/expected.hpp>
+#include "RenderData.hpp"
+
+namespace tmx::render
+{
+    /// @brief Options controlling how tiles are packed into atlas pages
+    struct AtlasOptions
+    {
+        bool usedTilesOnly = false; // Pack only tiles drawn by the layers and tile objects, plus their animation frames
+        std::uint32_t padding = 1; // Transparent pixels between tiles and along the page edges
+        std::uint32_t extrusion = 1; // Edge pixels repeated around each tile, against bleeding under linear filtering
+        std::uint32_t maxPageSize = 4096; // Maximum width and height of a page (pixels)
+    };
+
+    /// @brief Position of a source tile in the atlas
+    struct AtlasSlot
+    {
+        static constexpr std::uint32_t NO_PAGE = 0xFFFFFFFF;
+
+        std::uint32_t page = NO_PAGE; // Index into MapRenderData::tilesets, or NO_PAGE if the tile was not packed
+        std::uint32_t slot = 0; // Tile ID within the page
+    };
+
+    /// @brief Source tile of one atlas slot
+    struct AtlasTile
+    {
+        std::uint32_t tilesetIndex; // Index into TextureAtlas::sourceTilesets
+        std::uint32_t tileId; // Tile ID within the source tileset
+    };
+
+    /// @brief Tiles of one atlas page, whose grid is described by the page's TilesetRenderInfo
+    struct AtlasPage
+    {
+        std::vector<AtlasTile> tiles; // Source tile of every slot, indexed by tile ID within the page
+    };
+
+    /// @brief Result of packAtlas: where every packed tile came from and where it went
+    struct TextureAtlas
+    {
+        std::vector<TilesetRenderInfo> sourceTilesets; // Tilesets replaced by the pages, with their image paths
+        std::vector<AtlasPage> pages; // pages[i] holds the tiles of MapRenderData::tilesets[i]
+        std::vector<std::vector<AtlasSlot>> slots; // slots[tilesetIndex][tileId] for every source tile
+        std::uint32_t padding = 0;
+        std::uint32_t extrusion = 0;
+
+        /// @brief Find where a tile of a source tileset was packed
+        /// @return The slot, or std::nullopt if the tile was not packed
+        [[nodiscard]] auto find(std::uint32_t tilesetIndex, std::uint32_t tileId) const -> std::optional<AtlasSlot>
+        {
+            if (tilesetIndex >= slots.size() || tileId >= slots[tilesetIndex].size() ||
+                slots[tilesetIndex][tileId].page == AtlasSlot::NO_PAGE)
+                return std::nullopt;
+            return slots[tilesetIndex][tileId];
+        }
+    };
+
+    /// @brief Pack the tiles of every tileset into a few atlas pages and point the render data at them
+    /// Tiles of the same size share a page; each page is laid out as a tileset grid whose margin and spacing hold the
+    /// padding and extrusion, so TilesetRenderInfo::srcXOf/srcYOf keep working. The pages replace
+    /// MapRenderData::tilesets, and the tile ID, source position, tileset and animation index of every tile,
+    /// animation frame, GID table entry and tile object are rewritten to match. GIDs and destinations are unchanged.
+    /// The animated tiles of every layer are regrouped; animation clocks and emitters must be reset afterwards.
+    /// All frames of an animation are kept on the page of its base tile. With AtlasOptions::usedTilesOnly, GIDs left
+    /// out resolve to no tileset, so tiles of layers built or edited later must be in use already.
+    /// @param renderData Render data to rewrite; unchanged on error
+    /// @param options Padding, extrusion and page size
+    /// @return The atlas layout, whose pages' images tmx::raster::composeAtlas can draw, or an error if a tile or
+    ///         animation does not fit on a page
+    auto packAtlas(MapRenderData& renderData, const AtlasOptions& options = {}) -> tl::expected<TextureAtlas, std::string>;
+}
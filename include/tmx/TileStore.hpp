@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Map.hpp"
+
+namespace tmx::map
+{
+    /// @brief Tile-space bounding box with exclusive maximum edges
+    struct TileBounds
+    {
+        std::int32_t minX = 0, minY = 0;
+        std::int32_t maxX = 0, maxY = 0;
+
+        [[nodiscard]] auto isEmpty() const -> bool { return minX >= maxX || minY >= maxY; }
+
+        [[nodiscard]] auto contains(std::int32_t x, std::int32_t y) const -> bool
+        {
+            return x >= minX && x < maxX && y >= minY && y < maxY;
+        }
+    };
+
+    /// @brief Sparse tile grid for O(1) random access to the GIDs of a layer
+    /// Cells live in fixed-size square chunks stored back to back in one arena; an open-addressing hash table maps
+    /// chunk coordinates to their arena slot. Finite and infinite layers use the same representation, and
+    /// coordinates may be negative.
+    class TileStore
+    {
+    public:
+        static constexpr std::uint32_t DEFAULT_CHUNK_SHIFT = 4; // 16x16-tile chunks, the Tiled default
+
+        /// @brief Create an empty store
+        /// @param chunkShift Chunk edge length as a power of two (1 << chunkShift tiles)
+        explicit TileStore(std::uint32_t chunkShift = DEFAULT_CHUNK_SHIFT);
+
+        /// @brief Build a store holding the finite data or chunks of a layer
+        /// @param layer Parsed layer
+        /// @param chunkShift Chunk edge length as a power of two (1 << chunkShift tiles)
+        [[nodiscard]] static auto fromLayer(const Layer& layer, std::uint32_t chunkShift = DEFAULT_CHUNK_SHIFT)
+            -> TileStore;
+
+        /// @brief GID at tile coordinates, including flip flags
+        /// @return The GID, or 0 for empty cells and cells outside every chunk
+        [[nodiscard]] auto tileAt(std::int32_t x, std::int32_t y) const -> std::uint32_t
+        {
+            if (!m_bounds.contains(x, y))
+                return 0;
+            const std::uint32_t slot = findSlot(chunkKey(x >> m_chunkShift, y >> m_chunkShift));
+            if (slot == NO_SLOT)
+                return 0;
+            return m_cells[(static_cast<std::size_t>(slot) << (2 * m_chunkShift)) + cellIndex(x, y)];
+        }
+
+        /// @brief Set the GID at tile coordinates, allocating its chunk on first use
+        /// Setting 0 never allocates. Spans returned by chunkAt are invalidated when a chunk is allocated.
+        void setTile(std::int32_t x, std::int32_t y, std::uint32_t gid);
+
+        /// @brief Cells of the chunk at chunk coordinates, row-major
+        /// @return The cells, or an empty span if the chunk does not exist
+        [[nodiscard]] auto chunkAt(std::int32_t chunkX, std::int32_t chunkY) const -> std::span<const std::uint32_t>;
+
+        /// @brief Visit every allocated chunk
+        /// @param visitor Callable invoked with (chunkX, chunkY, std::span<const std::uint32_t> cells)
+        template <typename Visitor>
+        void forEachChunk(Visitor&& visitor) const
+        {
+            const std::size_t area = chunkArea();
+            for (std::uint32_t slot = 0; slot < m_chunkCoords.size(); ++slot)
+            {
+                visitor(m_chunkCoords[slot].x, m_chunkCoords[slot].y,
+                        std::span<const std::uint32_t>(m_cells.data() + slot * area, area));
+            }
+        }
+
+        /// @brief Bounds of every cell ever set to a non-empty GID (not shrunk when cells are cleared)
+        [[nodiscard]] auto bounds() const -> const TileBounds& { return m_bounds; }
+
+        [[nodiscard]] auto chunkShift() const -> std::uint32_t { return m_chunkShift; }
+        [[nodiscard]] auto chunkSize() const -> std::uint32_t { return 1u << m_chunkShift; }
+        [[nodiscard]] auto chunkCount() const -> std::size_t { return m_chunkCoords.size(); }
+
+        /// @brief Reserve arena and hash table space for a number of chunks
+        void reserve(std::size_t chunkCount);
+
+        /// @brief Remove every chunk and reset the bounds
+        void clear();
+
+    private:
+        static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+        struct Bucket
+        {
+            std::uint64_t key;
+            std::uint32_t slot; // Index of the chunk in the arena, or NO_SLOT for an empty bucket
+        };
+
+        struct ChunkCoord
+        {
+            std::int32_t x, y;
+        };
+
+        static auto chunkKey(std::int32_t chunkX, std::int32_t chunkY) -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkY)) << 32) |
+                static_cast<std::uint32_t>(chunkX);
+        }
+
+        [[nodiscard]] auto bucketOf(std::uint64_t key) const -> std::size_t
+        {
+            // Fibonacci hashing spreads neighbouring chunk coordinates over the table
+            return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> m_hashShift);
+        }
+
+        [[nodiscard]] auto findSlot(std::uint64_t key) const -> std::uint32_t
+        {
+            const std::size_t mask = m_buckets.size() - 1;
+            for (std::size_t i = bucketOf(key);; i = (i + 1) & mask)
+            {
+                const Bucket& bucket = m_buckets[i];
+                if (bucket.slot == NO_SLOT || bucket.key == key)
+                    return bucket.slot;
+            }
+        }
+
+        [[nodiscard]] auto cellIndex(std::int32_t x, std::int32_t y) const -> std::size_t
+        {
+            const std::uint32_t mask = (1u << m_chunkShift) - 1;
+            return ((static_cast<std::uint32_t>(y) & mask) << m_chunkShift) | (static_cast<std::uint32_t>(x) & mask);
+        }
+
+        [[nodiscard]] auto chunkArea() const -> std::size_t { return std::size_t{1} << (2 * m_chunkShift); }
+
+        auto insertChunk(std::int32_t chunkX, std::int32_t chunkY) -> std::uint32_t;
+        void rehash(std::size_t bucketCount);
+
+        std::uint32_t m_chunkShift;
+        std::uint32_t m_hashShift; // 64 - log2(bucket count)
+        std::vector<Bucket> m_buckets; // Power-of-two size, at most half full
+        std::vector<ChunkCoord> m_chunkCoords; // Chunk coordinates per arena slot
+        std::vector<std::uint32_t> m_cells; // Arena: chunkArea() cells per slot
+        TileBounds m_bounds;
+    };
+}
@@ -2,4 +2,18 @@
 
 #include "Map.hpp"
 #include "Parser.hpp"
-#include "RenderData.hpp"
\ No newline at end of file
+#include "Projection.hpp"
+#include "RenderData.hpp"
+#include "AnimationClock.hpp"
+#include "ChunkStreamer.hpp"
+#include "DrawList.hpp"
+#include "ObjectIndex.hpp"
+#include "ObjectTable.hpp"
+#include "ShapeGeometry.hpp"
+#include "GeometryEmitter.hpp"
+#include "TextureAtlas.hpp"
+#include "TileStore.hpp"
+#include "BitGrid.hpp"
+#include "CollisionBaker.hpp"
+#include "CollisionQuery.hpp"
+#include "Navigation.hpp"
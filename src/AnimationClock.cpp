@@ -0,0 +1,128 @@
+#include <tmx/AnimationClock.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace tmx::render
+{
+    AnimationClock::AnimationClock(const MapRenderData& renderData)
+    {
+        reset(renderData);
+    }
+
+    void AnimationClock::reset(const MapRenderData& renderData)
+    {
+        m_animations.clear();
+        m_refs.clear();
+        m_tilesetOffsets.assign(1, 0);
+
+        for (std::uint32_t tilesetIdx = 0; tilesetIdx < renderData.tilesets.size(); ++tilesetIdx)
+        {
+            const auto& animations = renderData.tilesets[tilesetIdx].animations;
+            for (std::uint32_t animIdx = 0; animIdx < animations.size(); ++animIdx)
+            {
+                m_animations.push_back(&animations[animIdx]);
+                m_refs.push_back({tilesetIdx, animIdx});
+            }
+            m_tilesetOffsets.push_back(static_cast<std::uint32_t>(m_animations.size()));
+        }
+
+        m_frames.assign(m_animations.size(), AnimationFrameSource{});
+        m_frameIndices.assign(m_animations.size(), 0);
+        m_nextChanges.assign(m_animations.size(), 0);
+        m_time = 0;
+        update(true);
+    }
+
+    void AnimationClock::tick(std::uint32_t deltaTime)
+    {
+        if (!m_paused)
+        {
+            m_time += static_cast<std::uint64_t>(deltaTime) * m_timeScale;
+        }
+        update(false);
+    }
+
+    void AnimationClock::setTime(std::uint64_t time)
+    {
+        m_time = time << FIXED_SHIFT;
+        update(true);
+    }
+
+    auto AnimationClock::time() const -> std::uint64_t
+    {
+        return m_time >> FIXED_SHIFT;
+    }
+
+    void AnimationClock::setTimeScale(float scale)
+    {
+        // Quantize once so that accumulated time does not depend on float rounding per tick
+        const float clamped = scale > 0.0f ? std::min(scale, MAX_TIME_SCALE) : 0.0f;
+        m_timeScale = static_cast<std::uint32_t>(std::lround(clamped * FIXED_ONE));
+    }
+
+    auto AnimationClock::timeScale() const -> float
+    {
+        return static_cast<float>(m_timeScale) / FIXED_ONE;
+    }
+
+    auto AnimationClock::nextChangeTime() const -> std::optional<std::uint64_t>
+    {
+        if (m_nextChangeTime == NEVER)
+            return std::nullopt;
+        return m_nextChangeTime;
+    }
+
+    auto AnimationClock::timeUntilNextChange() const -> std::optional<std::uint64_t>
+    {
+        if (m_paused || m_timeScale == 0 || m_nextChangeTime == NEVER)
+            return std::nullopt;
+
+        // Round up so that sleeping for the returned time always reaches the change
+        const std::uint64_t remaining = (m_nextChangeTime << FIXED_SHIFT) - m_time;
+        return (remaining + m_timeScale - 1) / m_timeScale;
+    }
+
+    void AnimationClock::update(bool force)
+    {
+        const std::uint64_t now = time();
+        m_changed.clear();
+        m_nextChangeTime = NEVER;
+
+        for (std::size_t i = 0; i < m_animations.size(); ++i)
+        {
+            const auto& animation = *m_animations[i];
+            if (animation.totalDuration == 0)
+            {
+                // A cycle without duration never advances; it shows its first frame for good
+                if (force && !animation.frames.empty())
+                {
+                    m_frameIndices[i] = 0;
+                    m_frames[i] = {animation.frames[0].srcX, animation.frames[0].srcY};
+                    m_changed.push_back(m_refs[i]);
+                }
+                continue;
+            }
+
+            // Frames are constant until the precomputed change time, so most ticks skip the lookup
+            if (force || now >= m_nextChanges[i])
+            {
+                const auto timeInCycle = static_cast<std::uint32_t>(now % animation.totalDuration);
+                const std::uint32_t frameIdx = animation.getFrameIndexAtTime(timeInCycle);
+                if (force || frameIdx != m_frameIndices[i])
+                {
+                    const auto& frame = animation.frames[frameIdx];
+                    m_frameIndices[i] = frameIdx;
+                    m_frames[i] = {frame.srcX, frame.srcY};
+                    m_changed.push_back(m_refs[i]);
+                }
+
+                // Single-frame animations never change
+                m_nextChanges[i] = animation.frames.size() > 1
+                                       ? now - timeInCycle + animation.frameEndTimes[frameIdx]
+                                       : NEVER;
+            }
+
+            m_nextChangeTime = std::min(m_nextChangeTime, m_nextChanges[i]);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include <tmx/BitGrid.hpp>
+
+namespace tmx::map
+{
+    BitGrid::BitGrid(const TileBounds& bounds)
+    {
+        if (bounds.isEmpty())
+            return;
+        m_bounds = bounds;
+        m_wordsPerRow = (width() + 63) / 64;
+        m_words.assign(static_cast<std::size_t>(m_wordsPerRow) * height(), 0);
+    }
+
+    void BitGrid::set(const std::int32_t x, const std::int32_t y, const bool value)
+    {
+        if (!m_bounds.contains(x, y))
+            return;
+        const auto column = static_cast<std::uint32_t>(x - m_bounds.minX);
+        std::uint64_t& word = m_words[rowOffset(y) + (column >> 6)];
+        const std::uint64_t bit = std::uint64_t{1} << (column & 63);
+        word = value ? word | bit : word & ~bit;
+    }
+
+    auto BitGrid::transposed() const -> BitGrid
+    {
+        BitGrid result({m_bounds.minY, m_bounds.minX, m_bounds.maxY, m_bounds.maxX});
+        for (std::int32_t y = m_bounds.minY; y < m_bounds.maxY; ++y)
+        {
+            const auto words = row(y);
+            for (std::uint32_t i = 0; i < words.size(); ++i)
+            {
+                // Visit only the set bits of each word
+                for (std::uint64_t bits = words[i]; bits != 0; bits &= bits - 1)
+                {
+                    const std::int32_t x = m_bounds.minX + static_cast<std::int32_t>(i * 64 + std::countr_zero(bits));
+                    result.set(y, x, true);
+                }
+            }
+        }
+        return result;
+    }
+
+    auto BitGrid::inverted() const -> BitGrid
+    {
+        BitGrid result = *this;
+        const std::uint32_t tailBits = width() % 64;
+        const std::uint64_t tailMask = tailBits == 0 ? ~std::uint64_t{0} : (std::uint64_t{1} << tailBits) - 1;
+        for (std::size_t i = 0; i < result.m_words.size(); ++i)
+        {
+            // Bits past the right edge stay clear
+            const bool last = i % m_wordsPerRow == m_wordsPerRow - 1;
+            result.m_words[i] = ~result.m_words[i] & (last ? tailMask : ~std::uint64_t{0});
+        }
+        return result;
+    }
+
+    auto BitGrid::count() const -> std::size_t
+    {
+        std::size_t total = 0;
+        for (const std::uint64_t word : m_words)
+            total += static_cast<std::size_t>(std::popcount(word));
+        return total;
+    }
+}
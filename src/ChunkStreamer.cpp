@@ -0,0 +1,543 @@
+#include <tmx/ChunkStreamer.hpp>
+#include <tmx/Parser.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <string_view>
+
+namespace tmx::render
+{
+    namespace
+    {
+        constexpr std::size_t SCAN_BLOCK_SIZE = 1u << 20;
+
+        // Value of an attribute in the text of a start tag, or an empty view
+        auto attributeOf(std::string_view tag, std::string_view name) -> std::string_view
+        {
+            std::size_t pos = 0;
+            while ((pos = tag.find(name, pos)) != std::string_view::npos)
+            {
+                const std::size_t after = pos + name.size();
+                const bool startsWord = pos > 0 && std::isspace(static_cast<unsigned char>(tag[pos - 1]));
+                std::size_t eq = after;
+                while (eq < tag.size() && std::isspace(static_cast<unsigned char>(tag[eq])))
+                    ++eq;
+                if (startsWord && eq + 1 < tag.size() && tag[eq] == '=')
+                {
+                    std::size_t quote = eq + 1;
+                    while (quote < tag.size() && std::isspace(static_cast<unsigned char>(tag[quote])))
+                        ++quote;
+                    if (quote < tag.size() && (tag[quote] == '"' || tag[quote] == '\''))
+                    {
+                        const std::size_t end = tag.find(tag[quote], quote + 1);
+                        if (end != std::string_view::npos)
+                            return tag.substr(quote + 1, end - quote - 1);
+                    }
+                }
+                pos = after;
+            }
+            return {};
+        }
+
+        auto intAttributeOf(std::string_view tag, std::string_view name) -> std::int64_t
+        {
+            const std::string value(attributeOf(tag, name));
+            return value.empty() ? 0 : std::strtoll(value.c_str(), nullptr, 10);
+        }
+
+        // Element name of a start or end tag ("<layer ...>" -> "layer")
+        auto tagName(std::string_view tag) -> std::string_view
+        {
+            std::size_t begin = tag[1] == '/' ? 2 : 1;
+            std::size_t end = begin;
+            while (end < tag.size() && !std::isspace(static_cast<unsigned char>(tag[end])) && tag[end] != '>' &&
+                   tag[end] != '/')
+                ++end;
+            return tag.substr(begin, end - begin);
+        }
+
+        struct ScanResult
+        {
+            std::string skeleton; // The document with the <data> elements of chunked layers removed
+            std::vector<LayerChunkIndex> layers;
+        };
+
+        // Single pass over the file: index chunk byte ranges and keep everything else for the regular parser.
+        // The file is read in blocks, so memory stays bounded by the block size plus the skeleton.
+        auto scanChunks(std::ifstream& file) -> tl::expected<ScanResult, std::string>
+        {
+            ScanResult result;
+            std::vector<std::string> openElements;
+            std::string buffer;
+            std::uint64_t bufferOffset = 0; // File offset of buffer[0]
+            std::size_t pos = 0;
+            bool endOfFile = false;
+
+            std::size_t dataStart = 0; // Skeleton size before the current layer's <data> tag
+            bool inChunkedData = false;
+            bool inChunk = false;
+            ChunkIndexEntry chunk{};
+
+            auto refill = [&]()
+            {
+                buffer.erase(0, pos);
+                bufferOffset += pos;
+                pos = 0;
+                const std::size_t kept = buffer.size();
+                buffer.resize(kept + SCAN_BLOCK_SIZE);
+                file.read(buffer.data() + kept, static_cast<std::streamsize>(SCAN_BLOCK_SIZE));
+                buffer.resize(kept + static_cast<std::size_t>(file.gcount()));
+                endOfFile = file.gcount() == 0;
+            };
+
+            while (true)
+            {
+                const std::size_t open = buffer.find('<', pos);
+                if (open == std::string::npos)
+                {
+                    if (!inChunk)
+                        result.skeleton.append(buffer, pos);
+                    pos = buffer.size();
+                    refill();
+                    if (endOfFile)
+                        break;
+                    continue;
+                }
+
+                // Find the end of the markup, respecting quoted attribute values and comments
+                std::size_t close = std::string::npos;
+                if (buffer.compare(open, 4, "<!--") == 0)
+                {
+                    const std::size_t end = buffer.find("-->", open + 4);
+                    close = end == std::string::npos ? end : end + 2;
+                }
+                else if (buffer.compare(open, 9, "<![CDATA[") == 0)
+                {
+                    const std::size_t end = buffer.find("]]>", open + 9);
+                    close = end == std::string::npos ? end : end + 2;
+                }
+                else
+                {
+                    char quote = 0;
+                    for (std::size_t i = open + 1; i < buffer.size(); ++i)
+                    {
+                        if (quote)
+                            quote = buffer[i] == quote ? 0 : quote;
+                        else if (buffer[i] == '"' || buffer[i] == '\'')
+                            quote = buffer[i];
+                        else if (buffer[i] == '>')
+                        {
+                            close = i;
+                            break;
+                        }
+                    }
+                }
+
+                if (close == std::string::npos)
+                {
+                    // Markup continues in the next block
+                    if (!inChunk)
+                        result.skeleton.append(buffer, pos, open - pos);
+                    pos = open;
+                    refill();
+                    if (endOfFile)
+                        return tl::make_unexpected("Unterminated markup at byte " + std::to_string(bufferOffset));
+                    continue;
+                }
+
+                const std::string_view tag(buffer.data() + open, close + 1 - open);
+                const std::uint64_t tagOffset = bufferOffset + open;
+                const std::size_t textStart = pos;
+                pos = close + 1;
+                if (inChunk)
+                {
+                    // Chunk text is only indexed, never copied
+                    if (!tag.starts_with("</chunk"))
+                        continue;
+
+                    chunk.length = tagOffset - chunk.offset;
+                    auto& layer = result.layers.back();
+                    layer.chunks.push_back(chunk);
+                    layer.maxChunkWidth = std::max(layer.maxChunkWidth, chunk.width);
+                    layer.maxChunkHeight = std::max(layer.maxChunkHeight, chunk.height);
+                    inChunk = false;
+                }
+                else
+                {
+                    result.skeleton.append(buffer, textStart, open - textStart);
+                    result.skeleton.append(tag);
+                }
+
+                if (tag.starts_with("<?") || tag.starts_with("<!"))
+                    continue;
+
+                const std::string_view name = tagName(tag);
+                const bool isEnd = tag[1] == '/';
+                const bool selfClosing = !isEnd && tag[tag.size() - 2] == '/';
+                const std::size_t depth = openElements.size();
+                const std::string_view parent = depth > 0 ? std::string_view(openElements[depth - 1]) : "";
+
+                // Layers sit in the map or, at any depth, in group layers; the parser numbers them in the same order
+                if (!isEnd && name == "layer" && (parent == "map" || parent == "group"))
+                {
+                    result.layers.emplace_back();
+                }
+                else if (!isEnd && name == "data" && parent == "layer")
+                {
+                    result.layers.back().encoding = attributeOf(tag, "encoding");
+                    result.layers.back().compression = attributeOf(tag, "compression");
+                    dataStart = result.skeleton.size() - tag.size();
+                }
+                else if (!isEnd && name == "chunk" && parent == "data" && depth >= 2 && openElements[depth - 2] == "layer")
+                {
+                    inChunkedData = true;
+                    chunk = {static_cast<std::int32_t>(intAttributeOf(tag, "x")),
+                             static_cast<std::int32_t>(intAttributeOf(tag, "y")),
+                             static_cast<std::uint32_t>(intAttributeOf(tag, "width")),
+                             static_cast<std::uint32_t>(intAttributeOf(tag, "height")),
+                             tagOffset + tag.size(), 0};
+                    inChunk = !selfClosing;
+                    if (selfClosing)
+                        result.layers.back().chunks.push_back(chunk);
+                }
+                else if (isEnd && name == "data" && inChunkedData)
+                {
+                    // Chunk data is loaded on demand; the parser sees a layer without <data>
+                    result.skeleton.resize(dataStart);
+                    inChunkedData = false;
+                }
+
+                if (isEnd)
+                {
+                    if (openElements.empty() || openElements.back() != name)
+                        return tl::make_unexpected("Mismatched end tag at byte " + std::to_string(tagOffset));
+                    openElements.pop_back();
+                }
+                else if (!selfClosing)
+                {
+                    openElements.emplace_back(name);
+                }
+            }
+
+            if (!openElements.empty())
+                return tl::make_unexpected("Unexpected end of file inside <" + openElements.back() + ">");
+
+            for (auto& layer : result.layers)
+            {
+                std::ranges::stable_sort(layer.chunks, [](const ChunkIndexEntry& a, const ChunkIndexEntry& b)
+                {
+                    return a.y != b.y ? a.y < b.y : a.x < b.x;
+                });
+            }
+            return result;
+        }
+
+        auto memoryUsageOf(const LayerRenderData& layer) -> std::size_t
+        {
+            return layer.tiles.capacity() * sizeof(TileRenderInfo) +
+                layer.packedTiles.capacity() * sizeof(PackedTileRenderInfo) +
+                layer.gids.capacity() * sizeof(std::uint32_t) + layer.tileBlocks.capacity() * sizeof(TileBlock) +
+                layer.chunks.capacity() * sizeof(SpatialChunk) +
+                layer.animatedGroups.capacity() * sizeof(AnimatedTileGroup) +
+                layer.animatedTileIndices.capacity() * sizeof(std::uint32_t) + sizeof(StreamedChunk);
+        }
+    }
+
+    auto ChunkStreamer::open(const std::filesystem::path& path, const std::string& assetBasePath,
+                             const ChunkStreamOptions& options) -> tl::expected<std::unique_ptr<ChunkStreamer>, std::string>
+    {
+        std::unique_ptr<ChunkStreamer> streamer(new ChunkStreamer());
+        streamer->m_options = options;
+        streamer->m_file.open(path, std::ios::binary);
+        if (!streamer->m_file.is_open())
+        {
+            return tl::make_unexpected("Cannot open file: " + path.string());
+        }
+
+        auto scanResult = scanChunks(streamer->m_file);
+        if (!scanResult)
+        {
+            return tl::make_unexpected("Failed to index " + path.string() + ": " + scanResult.error());
+        }
+        streamer->m_file.clear();
+
+        auto mapResult = Parser::parseFromString(scanResult->skeleton, path.parent_path());
+        if (!mapResult)
+        {
+            return tl::make_unexpected(mapResult.error());
+        }
+        if (mapResult->layers.size() != scanResult->layers.size())
+        {
+            return tl::make_unexpected("Chunk index does not match the layers of " + path.string());
+        }
+
+        streamer->m_map = std::move(*mapResult);
+        streamer->m_index = std::move(scanResult->layers);
+        streamer->m_renderData = MapRenderData::fromMap(streamer->m_map, assetBasePath, options.buildOptions);
+        streamer->m_loader = std::jthread([raw = streamer.get()](std::stop_token stopToken) { raw->run(stopToken); });
+        return streamer;
+    }
+
+    ChunkStreamer::~ChunkStreamer()
+    {
+        m_loader.request_stop();
+        m_wakeLoader.notify_all();
+    }
+
+    auto ChunkStreamer::layerRect(const std::uint32_t layerIndex, const ViewRect& view, const float margin) const
+        -> ViewRect
+    {
+        const ViewRect rect = m_renderData.layers[layerIndex].transform.toLayer(view);
+        return {rect.x - margin, rect.y - margin, rect.width + 2.0f * margin, rect.height + 2.0f * margin};
+    }
+
+    template <typename Callback>
+    void ChunkStreamer::forEachChunkIn(const std::uint32_t layerIndex, const ViewRect& rect, Callback&& callback) const
+    {
+        const auto& layer = m_index[layerIndex];
+        if (layer.chunks.empty() || rect.width < 0.0f || rect.height < 0.0f)
+            return;
+
+        // Tile rectangle covered by the view (inclusive)
+        const float tileWidth = static_cast<float>(std::max(m_renderData.tileWidth, 1u));
+        const float tileHeight = static_cast<float>(std::max(m_renderData.tileHeight, 1u));
+        const auto left = static_cast<std::int64_t>(std::floor(rect.x / tileWidth));
+        const auto top = static_cast<std::int64_t>(std::floor(rect.y / tileHeight));
+        const auto right = static_cast<std::int64_t>(std::floor((rect.x + rect.width) / tileWidth));
+        const auto bottom = static_cast<std::int64_t>(std::floor((rect.y + rect.height) / tileHeight));
+
+        // Chunks are sorted by row: skip rows above the view, then binary search the first column of each row
+        const auto begin = layer.chunks.begin();
+        auto row = std::ranges::lower_bound(layer.chunks, top - layer.maxChunkHeight + 1, {},
+                                            [](const ChunkIndexEntry& entry) { return static_cast<std::int64_t>(entry.y); });
+        while (row != layer.chunks.end() && row->y <= bottom)
+        {
+            const std::int32_t rowY = row->y;
+            const auto rowEnd = std::find_if(row, layer.chunks.end(), [rowY](const auto& entry) { return entry.y != rowY; });
+            auto it = std::lower_bound(row, rowEnd, left - layer.maxChunkWidth + 1,
+                                       [](const ChunkIndexEntry& entry, std::int64_t x) { return entry.x < x; });
+            for (; it != rowEnd && it->x <= right; ++it)
+            {
+                if (it->x + static_cast<std::int64_t>(it->width) > left &&
+                    it->y + static_cast<std::int64_t>(it->height) > top)
+                {
+                    callback(static_cast<std::uint32_t>(it - begin));
+                }
+            }
+            row = rowEnd;
+        }
+    }
+
+    void ChunkStreamer::update(const ViewRect& view)
+    {
+        ++m_updateCount;
+        const float radius = std::max(m_options.loadRadius, 0.0f);
+
+        std::vector<std::pair<float, LoadRequest>> missing;
+        {
+            std::lock_guard lock(m_mutex);
+            adoptLoaded();
+
+            for (std::uint32_t layerIdx = 0; layerIdx < m_index.size(); ++layerIdx)
+            {
+                // Distances are measured in the layer, where its chunks are
+                const ViewRect loadRect = layerRect(layerIdx, view, radius);
+                const float centerX = loadRect.x + loadRect.width * 0.5f;
+                const float centerY = loadRect.y + loadRect.height * 0.5f;
+                forEachChunkIn(layerIdx, loadRect, [&](const std::uint32_t chunkIdx)
+                {
+                    const std::uint64_t chunkKey = key(layerIdx, chunkIdx);
+                    if (const auto it = m_resident.find(chunkKey); it != m_resident.end())
+                    {
+                        it->second.lastUsed = m_updateCount;
+                        return;
+                    }
+                    if (chunkKey == m_inFlight)
+                        return;
+
+                    const auto& entry = m_index[layerIdx].chunks[chunkIdx];
+                    const float dx = (static_cast<float>(entry.x) + entry.width * 0.5f) * m_renderData.tileWidth - centerX;
+                    const float dy = (static_cast<float>(entry.y) + entry.height * 0.5f) * m_renderData.tileHeight - centerY;
+                    missing.push_back({dx * dx + dy * dy, {layerIdx, chunkIdx}});
+                });
+            }
+
+            // Replace the queue: chunks that left the load radius before being started are dropped
+            std::ranges::stable_sort(missing, {}, &std::pair<float, LoadRequest>::first);
+            m_queue.clear();
+            for (const auto& [distance, request] : missing)
+                m_queue.push_back(request);
+        }
+        m_wakeLoader.notify_one();
+
+        evict(view);
+    }
+
+    void ChunkStreamer::waitUntilIdle()
+    {
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_queue.empty() && m_inFlight == NONE; });
+        adoptLoaded();
+    }
+
+    void ChunkStreamer::visibleChunks(const ViewRect& view, std::vector<const StreamedChunk*>& chunks) const
+    {
+        chunks.clear();
+        for (std::uint32_t layerIdx = 0; layerIdx < m_index.size(); ++layerIdx)
+        {
+            forEachChunkIn(layerIdx, layerRect(layerIdx, view, 0.0f), [&](const std::uint32_t chunkIdx)
+            {
+                if (const auto it = m_resident.find(key(layerIdx, chunkIdx)); it != m_resident.end())
+                    chunks.push_back(&it->second);
+            });
+        }
+    }
+
+    auto ChunkStreamer::pendingCount() const -> std::size_t
+    {
+        std::lock_guard lock(m_mutex);
+        return m_queue.size() + (m_inFlight != NONE ? 1 : 0) + m_loaded.size();
+    }
+
+    auto ChunkStreamer::error() const -> std::string
+    {
+        std::lock_guard lock(m_mutex);
+        return m_error;
+    }
+
+    void ChunkStreamer::run(std::stop_token stopToken)
+    {
+        std::unique_lock lock(m_mutex);
+        while (true)
+        {
+            if (!m_wakeLoader.wait(lock, stopToken, [this] { return !m_queue.empty(); }))
+                return;
+
+            const LoadRequest request = m_queue.front();
+            m_queue.pop_front();
+            m_inFlight = key(request.layerIndex, request.chunkIndex);
+
+            lock.unlock();
+            auto chunk = load(request);
+            lock.lock();
+
+            if (chunk)
+            {
+                m_loaded.push_back(std::move(*chunk));
+            }
+            else
+            {
+                if (m_error.empty())
+                    m_error = chunk.error();
+
+                // Keep an empty chunk so that a broken chunk is not requested again every frame
+                StreamedChunk empty{request.layerIndex, request.chunkIndex, {}, 0, 0};
+                empty.layer.name = m_map.layers[request.layerIndex].name;
+                m_loaded.push_back(std::move(empty));
+            }
+            m_inFlight = NONE;
+            if (m_queue.empty())
+                m_idle.notify_all();
+        }
+    }
+
+    auto ChunkStreamer::load(const LoadRequest& request) -> tl::expected<StreamedChunk, std::string>
+    {
+        const auto& layerIndex = m_index[request.layerIndex];
+        const auto& entry = layerIndex.chunks[request.chunkIndex];
+
+        std::string text(entry.length, '\0');
+        m_file.seekg(static_cast<std::streamoff>(entry.offset));
+        m_file.read(text.data(), static_cast<std::streamsize>(text.size()));
+        if (static_cast<std::uint64_t>(m_file.gcount()) != entry.length)
+        {
+            m_file.clear();
+            return tl::make_unexpected("Failed to read chunk at byte " + std::to_string(entry.offset));
+        }
+
+        const std::string_view encoding = layerIndex.encoding.empty() ? "csv" : std::string_view(layerIndex.encoding);
+        auto data = Parser::decodeTileData(text, encoding, layerIndex.compression, entry.width, entry.height);
+        if (!data)
+        {
+            return tl::make_unexpected("Failed to decode chunk at byte " + std::to_string(entry.offset) + ": " +
+                                       data.error());
+        }
+
+        // Build the chunk as a one-chunk layer against the shared tilesets and GID table
+        const auto& source = m_map.layers[request.layerIndex];
+        map::Layer layer;
+        layer.name = source.name;
+        layer.visible = source.visible;
+        layer.opacity = source.opacity;
+        layer.offsetx = source.offsetx;
+        layer.offsety = source.offsety;
+        layer.parallaxx = source.parallaxx;
+        layer.parallaxy = source.parallaxy;
+        layer.tintcolor = source.tintcolor;
+        layer.group = source.group;
+        layer.chunks.push_back({entry.x, entry.y, entry.width, entry.height, std::move(*data)});
+
+        StreamedChunk chunk{request.layerIndex, request.chunkIndex, m_renderData.buildLayer(layer, m_options.buildOptions), 0, 0};
+        chunk.memoryUsage = memoryUsageOf(chunk.layer);
+        return chunk;
+    }
+
+    void ChunkStreamer::adoptLoaded()
+    {
+        for (auto& chunk : m_loaded)
+        {
+            chunk.lastUsed = m_updateCount;
+            const auto [it, inserted] = m_resident.try_emplace(key(chunk.layerIndex, chunk.chunkIndex), std::move(chunk));
+            if (inserted)
+                m_memoryUsage += it->second.memoryUsage;
+        }
+        m_loaded.clear();
+    }
+
+    void ChunkStreamer::evict(const ViewRect& view)
+    {
+        const float radius = std::max(m_options.evictRadius, m_options.loadRadius);
+        const float tileWidth = static_cast<float>(m_renderData.tileWidth);
+        const float tileHeight = static_cast<float>(m_renderData.tileHeight);
+        auto outsideRadius = [&](const StreamedChunk& chunk)
+        {
+            // Measured in the chunk's layer, like the load radius, so parallax layers do not reload what they drop
+            const ViewRect rect = layerRect(chunk.layerIndex, view, radius);
+            const auto& entry = m_index[chunk.layerIndex].chunks[chunk.chunkIndex];
+            const float left = static_cast<float>(entry.x) * tileWidth;
+            const float top = static_cast<float>(entry.y) * tileHeight;
+            return left + entry.width * tileWidth <= rect.x || left >= rect.x + rect.width ||
+                top + entry.height * tileHeight <= rect.y || top >= rect.y + rect.height;
+        };
+
+        // Far chunks are always dropped
+        std::erase_if(m_resident, [&](const auto& item)
+        {
+            if (!outsideRadius(item.second))
+                return false;
+            m_memoryUsage -= item.second.memoryUsage;
+            return true;
+        });
+
+        if (m_memoryUsage <= m_options.memoryBudget)
+            return;
+
+        // Over budget: drop the least recently needed chunks, never those needed by the current view
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> candidates;
+        for (const auto& [chunkKey, chunk] : m_resident)
+        {
+            if (chunk.lastUsed < m_updateCount)
+                candidates.emplace_back(chunk.lastUsed, chunkKey);
+        }
+        std::ranges::sort(candidates);
+        for (const auto& [lastUsed, chunkKey] : candidates)
+        {
+            if (m_memoryUsage <= m_options.memoryBudget)
+                break;
+            const auto it = m_resident.find(chunkKey);
+            m_memoryUsage -= it->second.memoryUsage;
+            m_resident.erase(it);
+        }
+    }
+}
@@ -0,0 +1,203 @@
+#include <tmx/CollisionBaker.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace tmx::map
+{
+    namespace
+    {
+        // Visit the cells of a layer as (x, y, gid), whether it stores finite data or infinite chunks
+        template <typename Visitor>
+        void forEachCell(const Layer& layer, Visitor&& visitor)
+        {
+            if (!layer.data.empty())
+            {
+                if (layer.width == 0)
+                    return;
+                for (std::uint32_t i = 0; i < layer.data.size() && i < layer.width * layer.height; ++i)
+                {
+                    if (layer.data[i] != 0)
+                        visitor(static_cast<std::int32_t>(i % layer.width), static_cast<std::int32_t>(i / layer.width),
+                                layer.data[i]);
+                }
+                return;
+            }
+
+            for (const auto& chunk : layer.chunks)
+            {
+                for (std::uint32_t i = 0; i < chunk.data.size() && i < chunk.width * chunk.height; ++i)
+                {
+                    if (chunk.data[i] != 0)
+                        visitor(chunk.x + static_cast<std::int32_t>(i % chunk.width),
+                                chunk.y + static_cast<std::int32_t>(i / chunk.width), chunk.data[i]);
+                }
+            }
+        }
+
+        // One flag per GID (flip flags stripped): whether the tile has the solid property or, if asked, a
+        // collision shape
+        auto solidGids(const Map& map, const CollisionOptions& options) -> std::vector<std::uint8_t>
+        {
+            std::vector<std::uint8_t> solid;
+            const auto mark = [&solid](const std::uint32_t gid)
+            {
+                if (gid >= solid.size())
+                    solid.resize(gid + 1, 0);
+                solid[gid] = 1;
+            };
+
+            for (const auto& tileset : map.tilesets)
+            {
+                if (!options.solidProperty.empty())
+                {
+                    for (const auto& tile : tileset.tiles)
+                    {
+                        if (tile.properties.getBool(options.solidProperty))
+                            mark(tileset.firstgid + tile.id);
+                    }
+                }
+                if (options.solidShapes)
+                {
+                    for (std::uint32_t id = 0; id + 1 < tileset.shapeOffsets.size(); ++id)
+                    {
+                        if (!tileset.tileShapes(id).empty())
+                            mark(tileset.firstgid + id);
+                    }
+                }
+            }
+            return solid;
+        }
+
+        // Smallest rectangle holding both; empty rectangles are ignored
+        auto unite(const TileBounds& a, const TileBounds& b) -> TileBounds
+        {
+            if (a.isEmpty())
+                return b;
+            if (b.isEmpty())
+                return a;
+            return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+        }
+
+        // Number of set cells of a row from x on, stopping at the first clear one
+        auto runLength(const BitGrid& grid, const std::int32_t x, const std::int32_t y) -> std::int32_t
+        {
+            std::int32_t length = 0;
+            for (;;)
+            {
+                const auto ones = static_cast<std::int32_t>(std::countr_one(grid.word(x + length, y)));
+                length += ones;
+                if (ones < 64)
+                    return length;
+            }
+        }
+
+        // Whether cells x to x + length - 1 of a row are all set
+        auto isRunSet(const BitGrid& grid, const std::int32_t x, const std::int32_t y, const std::int32_t length) -> bool
+        {
+            for (std::int32_t offset = 0; offset < length; offset += 64)
+            {
+                const std::int32_t count = std::min(length - offset, 64);
+                const std::uint64_t mask = count == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+                if ((grid.word(x + offset, y) & mask) != mask)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    auto layerBounds(const Map& map) -> TileBounds
+    {
+        TileBounds bounds;
+        for (const auto& layer : map.layers)
+            bounds = unite(bounds, layerBounds(layer));
+        if (bounds.isEmpty())
+            bounds = {0, 0, static_cast<std::int32_t>(map.width), static_cast<std::int32_t>(map.height)};
+        return bounds;
+    }
+
+    auto layerBounds(const Layer& layer) -> TileBounds
+    {
+        TileBounds bounds;
+        if (!layer.data.empty())
+            bounds = {0, 0, static_cast<std::int32_t>(layer.width), static_cast<std::int32_t>(layer.height)};
+        for (const auto& chunk : layer.chunks)
+        {
+            bounds = unite(bounds, {chunk.x, chunk.y, chunk.x + static_cast<std::int32_t>(chunk.width),
+                                    chunk.y + static_cast<std::int32_t>(chunk.height)});
+        }
+        return bounds;
+    }
+
+    auto bakeSolidity(const Map& map, std::span<const std::uint8_t> solidLayers, const CollisionOptions& options)
+        -> BitGrid
+    {
+        BitGrid grid(layerBounds(map));
+        const std::vector<std::uint8_t> solidGid = solidGids(map, options);
+        for (std::size_t layerIdx = 0; layerIdx < map.layers.size(); ++layerIdx)
+        {
+            const Layer& layer = map.layers[layerIdx];
+            const bool solidLayer = layerIdx < solidLayers.size() && solidLayers[layerIdx] != 0;
+            if ((!layer.visible && !options.includeHidden) || (!solidLayer && solidGid.empty()))
+                continue;
+
+            forEachCell(layer, [&](const std::int32_t x, const std::int32_t y, const std::uint32_t gid)
+            {
+                const std::uint32_t id = gid & GID_MASK;
+                if (solidLayer || (id < solidGid.size() && solidGid[id] != 0))
+                    grid.set(x, y, true);
+            });
+        }
+        return grid;
+    }
+
+    auto bakeSolidity(const Layer& layer) -> BitGrid
+    {
+        BitGrid grid(layerBounds(layer));
+        forEachCell(layer, [&](const std::int32_t x, const std::int32_t y, std::uint32_t) { grid.set(x, y, true); });
+        return grid;
+    }
+
+    auto bakeCollision(const Map& map, std::span<const std::uint8_t> solidLayers, const CollisionOptions& options)
+        -> CollisionMap
+    {
+        CollisionMap result;
+        result.tileWidth = map.tilewidth;
+        result.tileHeight = map.tileheight;
+
+        // Greedy meshing: each free solid cell grows right, then down by whole rows; covered cells are cleared
+        BitGrid grid = bakeSolidity(map, solidLayers, options);
+        const TileBounds& area = grid.bounds();
+        for (std::int32_t y = area.minY; y < area.maxY; ++y)
+        {
+            for (std::int32_t x = area.minX; x < area.maxX;)
+            {
+                const std::uint64_t word = grid.word(x, y);
+                if (word == 0)
+                {
+                    x += 64;
+                    continue;
+                }
+                x += std::countr_zero(word);
+
+                const std::int32_t width = runLength(grid, x, y);
+                std::int32_t height = 1;
+                while (y + height < area.maxY && isRunSet(grid, x, y + height, width))
+                    ++height;
+                for (std::int32_t row = y; row < y + height; ++row)
+                {
+                    for (std::int32_t column = x; column < x + width; ++column)
+                        grid.set(column, row, false);
+                }
+
+                result.rects.push_back({x, y, width, height});
+                result.solidTileCount += static_cast<std::size_t>(width) * height;
+                result.bounds = result.rects.size() == 1
+                    ? TileBounds{x, y, x + width, y + height}
+                    : TileBounds{std::min(result.bounds.minX, x), std::min(result.bounds.minY, y),
+                                 std::max(result.bounds.maxX, x + width), std::max(result.bounds.maxY, y + height)};
+                x += width;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,328 @@
+#include <tmx/CollisionQuery.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TMX_QUERY_SSE2 1
+#endif
+
+namespace tmx::map
+{
+    namespace
+    {
+        constexpr float INF = std::numeric_limits<float>::infinity();
+
+        // DDA state of a ray, in tile units: tMax is the ray fraction at which the next column or row is entered,
+        // tDelta the fraction needed to cross a whole cell
+        struct RayWalk
+        {
+            float tMaxX, tMaxY;
+            float tDeltaX, tDeltaY;
+            std::int32_t cellX, cellY;
+            std::int32_t stepX, stepY;
+        };
+
+        auto cellOf(const float position) -> std::int32_t
+        {
+            return static_cast<std::int32_t>(std::floor(position));
+        }
+
+        // Whether a ray walking from this cell can no longer enter the grid
+        auto leftGrid(const TileBounds& bounds, const std::int32_t cellX, const std::int32_t cellY,
+                      const std::int32_t stepX, const std::int32_t stepY) -> bool
+        {
+            return (cellX < bounds.minX && stepX <= 0) || (cellX >= bounds.maxX && stepX >= 0) ||
+                (cellY < bounds.minY && stepY <= 0) || (cellY >= bounds.maxY && stepY >= 0);
+        }
+
+        // Result of entering a cell at fraction t, through a column (alongX) or row boundary; false to keep walking
+        auto enterCell(const BitGrid& solid, const std::int32_t cellX, const std::int32_t cellY, const std::int32_t stepX,
+                       const std::int32_t stepY, const float t, const bool alongX, RayHit& hit) -> bool
+        {
+            if (t > 1.0f || leftGrid(solid.bounds(), cellX, cellY, stepX, stepY))
+                return true;
+            if (!solid.get(cellX, cellY))
+                return false;
+            hit = {true, t, cellX, cellY, alongX ? -stepX : 0, alongX ? 0 : -stepY};
+            return true;
+        }
+
+        // Entry and exit fractions of a box moving by d along one axis over a cell's extent [c0, c1]
+        // Boxes within CONTACT_EPSILON of the cell touch it; overlapping by less than that still counts as touching.
+        auto axisTimes(const float b0, const float b1, const float c0, const float c1, const float d)
+            -> std::array<float, 2>
+        {
+            constexpr float EPSILON = CollisionQuery::CONTACT_EPSILON;
+            if (d == 0.0f)
+                return b1 - c0 > EPSILON && c1 - b0 > EPSILON ? std::array{-INF, INF} : std::array{INF, -INF};
+            const float gap = d > 0.0f ? c0 - b1 : b0 - c1;
+            const float speed = std::abs(d);
+            const float enter = (gap > -EPSILON ? std::max(gap, 0.0f) : gap) / speed;
+            const float exit = (d > 0.0f ? c1 - b0 : b1 - c0) / speed;
+            return {enter, exit};
+        }
+
+        // Set up the walk of a ray; false if the result is already known and stored in hit
+        auto startRay(const BitGrid& solid, const float tileWidth, const float tileHeight, const Ray& ray, RayWalk& walk,
+                      RayHit& hit) -> bool
+        {
+            hit = {};
+            const float x = ray.x / tileWidth, y = ray.y / tileHeight;
+            const float dx = ray.dx / tileWidth, dy = ray.dy / tileHeight;
+            walk.cellX = cellOf(x);
+            walk.cellY = cellOf(y);
+            walk.stepX = (dx > 0.0f) - (dx < 0.0f);
+            walk.stepY = (dy > 0.0f) - (dy < 0.0f);
+            if (solid.get(walk.cellX, walk.cellY))
+            {
+                hit = {true, 0.0f, walk.cellX, walk.cellY, 0, 0};
+                return false;
+            }
+            // An empty grid has no cells to walk, whichever way the ray points
+            if (solid.bounds().isEmpty() || leftGrid(solid.bounds(), walk.cellX, walk.cellY, walk.stepX, walk.stepY))
+                return false;
+
+            walk.tDeltaX = dx != 0.0f ? 1.0f / std::abs(dx) : INF;
+            walk.tDeltaY = dy != 0.0f ? 1.0f / std::abs(dy) : INF;
+            walk.tMaxX = dx > 0.0f ? (static_cast<float>(walk.cellX + 1) - x) / dx
+                : dx < 0.0f ? (x - static_cast<float>(walk.cellX)) / -dx : INF;
+            walk.tMaxY = dy > 0.0f ? (static_cast<float>(walk.cellY + 1) - y) / dy
+                : dy < 0.0f ? (y - static_cast<float>(walk.cellY)) / -dy : INF;
+            return true;
+        }
+    }
+
+    CollisionQuery::CollisionQuery(BitGrid solid, const std::uint32_t tileWidth, const std::uint32_t tileHeight)
+        : m_solid(std::move(solid)),
+          m_tileWidth(tileWidth != 0 ? static_cast<float>(tileWidth) : 1.0f),
+          m_tileHeight(tileHeight != 0 ? static_cast<float>(tileHeight) : 1.0f)
+    {
+    }
+
+    auto CollisionQuery::isSolidAt(const float x, const float y) const -> bool
+    {
+        return m_solid.get(cellOf(x / m_tileWidth), cellOf(y / m_tileHeight));
+    }
+
+    auto CollisionQuery::raycast(const Ray& ray) const -> RayHit
+    {
+        RayHit hit;
+        RayWalk walk{};
+        if (!startRay(m_solid, m_tileWidth, m_tileHeight, ray, walk, hit))
+            return hit;
+
+        for (;;)
+        {
+            const bool alongX = walk.tMaxX < walk.tMaxY;
+            const float t = alongX ? walk.tMaxX : walk.tMaxY;
+            if (alongX)
+            {
+                walk.cellX += walk.stepX;
+                walk.tMaxX += walk.tDeltaX;
+            }
+            else
+            {
+                walk.cellY += walk.stepY;
+                walk.tMaxY += walk.tDeltaY;
+            }
+            if (enterCell(m_solid, walk.cellX, walk.cellY, walk.stepX, walk.stepY, t, alongX, hit))
+                return hit;
+        }
+    }
+
+    void CollisionQuery::raycast(std::span<const Ray> rays, std::span<RayHit> hits) const
+    {
+        const std::size_t count = std::min(rays.size(), hits.size());
+#ifdef TMX_QUERY_SSE2
+        // Four rays walk side by side, one per lane; a lane whose ray is done takes the next one
+        alignas(16) std::array<float, 4> tMaxX{}, tMaxY{}, tDeltaX{}, tDeltaY{}, t{};
+        alignas(16) std::array<std::int32_t, 4> cellX{}, cellY{}, stepX{}, stepY{}, alongX{};
+        std::array<std::size_t, 4> rayOf{};
+        constexpr std::size_t IDLE = ~std::size_t{0};
+        std::size_t next = 0;
+        std::size_t busy = 0;
+
+        const auto refill = [&](const std::size_t lane)
+        {
+            for (; next < count; ++next)
+            {
+                RayWalk walk{};
+                if (!startRay(m_solid, m_tileWidth, m_tileHeight, rays[next], walk, hits[next]))
+                    continue;
+                tMaxX[lane] = walk.tMaxX;
+                tMaxY[lane] = walk.tMaxY;
+                tDeltaX[lane] = walk.tDeltaX;
+                tDeltaY[lane] = walk.tDeltaY;
+                cellX[lane] = walk.cellX;
+                cellY[lane] = walk.cellY;
+                stepX[lane] = walk.stepX;
+                stepY[lane] = walk.stepY;
+                rayOf[lane] = next++;
+                ++busy;
+                return;
+            }
+            // Idle lanes never step
+            rayOf[lane] = IDLE;
+            tMaxX[lane] = tMaxY[lane] = INF;
+            tDeltaX[lane] = tDeltaY[lane] = 0.0f;
+            stepX[lane] = stepY[lane] = 0;
+        };
+        for (std::size_t lane = 0; lane < 4; ++lane)
+            refill(lane);
+
+        const TileBounds& bounds = m_solid.bounds();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i minX = _mm_set1_epi32(bounds.minX), maxX = _mm_set1_epi32(bounds.maxX);
+        const __m128i minY = _mm_set1_epi32(bounds.minY), maxY = _mm_set1_epi32(bounds.maxY);
+        const __m128i wordsPerRow = _mm_set1_epi32(static_cast<std::int32_t>(m_solid.wordsPerRow()));
+        const std::uint64_t* words = busy > 0 ? m_solid.row(bounds.minY).data() : nullptr;
+        alignas(16) std::array<std::int32_t, 4> wordIndex{}, bitIndex{};
+        const auto load = [](const std::array<std::int32_t, 4>& lanes)
+        {
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes.data()));
+        };
+        const auto store = [](std::array<std::int32_t, 4>& lanes, const __m128i value)
+        {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), value);
+        };
+        while (busy > 0)
+        {
+            // Same steps as the scalar walk: advance along the axis whose boundary comes first
+            const __m128 farX = _mm_load_ps(tMaxX.data());
+            const __m128 farY = _mm_load_ps(tMaxY.data());
+            const __m128 stepsX = _mm_cmplt_ps(farX, farY);
+            const __m128i stepsXi = _mm_castps_si128(stepsX);
+            const __m128 enter = _mm_or_ps(_mm_and_ps(stepsX, farX), _mm_andnot_ps(stepsX, farY));
+            _mm_store_ps(t.data(), enter);
+            _mm_store_ps(tMaxX.data(), _mm_add_ps(farX, _mm_and_ps(stepsX, _mm_load_ps(tDeltaX.data()))));
+            _mm_store_ps(tMaxY.data(), _mm_add_ps(farY, _mm_andnot_ps(stepsX, _mm_load_ps(tDeltaY.data()))));
+            const __m128i dirX = load(stepX), dirY = load(stepY);
+            const __m128i cx = _mm_add_epi32(load(cellX), _mm_and_si128(stepsXi, dirX));
+            const __m128i cy = _mm_add_epi32(load(cellY), _mm_andnot_si128(stepsXi, dirY));
+            store(cellX, cx);
+            store(cellY, cy);
+            store(alongX, stepsXi);
+
+            // Lanes past their end or walking away from the grid are done, as in enterCell
+            const __m128i left = _mm_or_si128(
+                _mm_or_si128(_mm_andnot_si128(_mm_cmpgt_epi32(dirX, zero), _mm_cmplt_epi32(cx, minX)),
+                             _mm_andnot_si128(_mm_or_si128(_mm_cmplt_epi32(dirX, zero), _mm_cmplt_epi32(cx, maxX)),
+                                              _mm_set1_epi32(-1))),
+                _mm_or_si128(_mm_andnot_si128(_mm_cmpgt_epi32(dirY, zero), _mm_cmplt_epi32(cy, minY)),
+                             _mm_andnot_si128(_mm_or_si128(_mm_cmplt_epi32(dirY, zero), _mm_cmplt_epi32(cy, maxY)),
+                                              _mm_set1_epi32(-1))));
+            int done = _mm_movemask_ps(_mm_or_ps(_mm_cmpgt_ps(enter, one), _mm_castsi128_ps(left)));
+
+            // Word index and bit of each lane's cell, computed side by side; only the loads stay scalar, SSE2 has no
+            // gather. Lanes outside the grid read bit 0 of word 0 and discard it.
+            const __m128i inside = _mm_andnot_si128(
+                _mm_or_si128(_mm_cmplt_epi32(cx, minX), _mm_cmplt_epi32(cy, minY)),
+                _mm_and_si128(_mm_cmplt_epi32(cx, maxX), _mm_cmplt_epi32(cy, maxY)));
+            const int insideLanes = _mm_movemask_ps(_mm_castsi128_ps(inside));
+            const __m128i column = _mm_and_si128(_mm_sub_epi32(cx, minX), inside);
+            const __m128i rowIndex = _mm_and_si128(_mm_sub_epi32(cy, minY), inside);
+            const __m128i evenRows = _mm_mul_epu32(rowIndex, wordsPerRow);
+            const __m128i oddRows = _mm_mul_epu32(_mm_srli_si128(rowIndex, 4), wordsPerRow);
+            const __m128i rowStart = _mm_unpacklo_epi32(_mm_shuffle_epi32(evenRows, 0x08), _mm_shuffle_epi32(oddRows, 0x08));
+            store(wordIndex, _mm_add_epi32(rowStart, _mm_srli_epi32(column, 6)));
+            store(bitIndex, _mm_and_si128(column, _mm_set1_epi32(63)));
+            int solidLanes = 0;
+            for (std::size_t lane = 0; lane < 4; ++lane)
+                solidLanes |= static_cast<int>((words[static_cast<std::uint32_t>(wordIndex[lane])] >> bitIndex[lane]) & 1) << lane;
+            done |= solidLanes & insideLanes;
+            for (std::size_t lane = 0; lane < 4; ++lane)
+            {
+                if ((done >> lane & 1) == 0 || rayOf[lane] == IDLE)
+                    continue;
+                enterCell(m_solid, cellX[lane], cellY[lane], stepX[lane], stepY[lane], t[lane], alongX[lane] != 0,
+                          hits[rayOf[lane]]);
+                --busy;
+                refill(lane);
+            }
+        }
+#else
+        for (std::size_t i = 0; i < count; ++i)
+            hits[i] = raycast(rays[i]);
+#endif
+    }
+
+    auto CollisionQuery::sweep(const CollisionBox& box, const float dx, const float dy) const -> SweepHit
+    {
+        SweepHit result;
+        const TileBounds& bounds = m_solid.bounds();
+        if (bounds.isEmpty() || (dx == 0.0f && dy == 0.0f))
+            return result;
+
+        // Cells under the box's path, touching ones included
+        const std::int32_t firstX = std::max(cellOf((std::min(box.minX, box.minX + dx) - CONTACT_EPSILON) / m_tileWidth), bounds.minX);
+        const std::int32_t lastX = std::min(cellOf((std::max(box.maxX, box.maxX + dx) + CONTACT_EPSILON) / m_tileWidth), bounds.maxX - 1);
+        const std::int32_t firstY = std::max(cellOf((std::min(box.minY, box.minY + dy) - CONTACT_EPSILON) / m_tileHeight), bounds.minY);
+        const std::int32_t lastY = std::min(cellOf((std::max(box.maxY, box.maxY + dy) + CONTACT_EPSILON) / m_tileHeight), bounds.maxY - 1);
+
+        for (std::int32_t y = firstY; y <= lastY; ++y)
+        {
+            const float cellMinY = static_cast<float>(y) * m_tileHeight;
+            const auto [enterY, exitY] = axisTimes(box.minY, box.maxY, cellMinY, cellMinY + m_tileHeight, dy);
+            if (enterY > 1.0f || enterY >= exitY)
+                continue;
+            for (std::int32_t x = firstX; x <= lastX; x += 64)
+            {
+                // Only the solid cells of the row are tested
+                const std::int32_t cells = std::min(lastX - x + 1, 64);
+                const std::uint64_t mask = cells == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << cells) - 1;
+                for (std::uint64_t bits = m_solid.word(x, y) & mask; bits != 0; bits &= bits - 1)
+                {
+                    const std::int32_t cellX = x + std::countr_zero(bits);
+                    const float cellMinX = static_cast<float>(cellX) * m_tileWidth;
+                    const auto [enterX, exitX] = axisTimes(box.minX, box.maxX, cellMinX, cellMinX + m_tileWidth, dx);
+                    const float enter = std::max(enterX, enterY);
+                    if (enter < 0.0f || enter > 1.0f || enter >= std::min(exitX, exitY) ||
+                        (result.hit && enter >= result.fraction))
+                        continue;
+
+                    // The later axis is the side touched; corners count as floors and ceilings
+                    const bool sideX = enterX > enterY;
+                    result = {true, enter, cellX, y, sideX ? (dx > 0.0f ? -1 : 1) : 0, sideX ? 0 : (dy > 0.0f ? -1 : 1)};
+                }
+            }
+        }
+        return result;
+    }
+
+    auto CollisionQuery::move(const CollisionBox& box, const float dx, const float dy) const -> MoveResult
+    {
+        MoveResult result;
+        CollisionBox current = box;
+        float restX = dx, restY = dy;
+        // Each wall stops one axis, so after two walls nothing is left to move
+        for (int pass = 0; pass < 3 && (restX != 0.0f || restY != 0.0f); ++pass)
+        {
+            const SweepHit hit = sweep(current, restX, restY);
+            const float stepX = restX * hit.fraction, stepY = restY * hit.fraction;
+            current = {current.minX + stepX, current.minY + stepY, current.maxX + stepX, current.maxY + stepY};
+            result.dx += stepX;
+            result.dy += stepY;
+            if (!hit.hit)
+                break;
+
+            restX -= stepX;
+            restY -= stepY;
+            if (hit.normalX != 0)
+            {
+                restX = 0.0f;
+                result.blockedX = true;
+            }
+            else
+            {
+                restY = 0.0f;
+                result.blockedY = true;
+            }
+        }
+        return result;
+    }
+}
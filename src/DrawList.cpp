@@ -0,0 +1,275 @@
+#include <tmx/DrawList.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace tmx::render
+{
+    namespace
+    {
+        // Order of a sorted list: key, then source and index, which is the order items are collected in
+        auto itemLess(const DrawItem& a, const DrawItem& b) -> bool
+        {
+            return a.key != b.key ? a.key < b.key : a.source != b.source ? a.source < b.source : a.index < b.index;
+        }
+
+        // Whole-pixel coordinate of an object
+        auto objectCoordinate(const float value) -> std::int32_t
+        {
+            return static_cast<std::int32_t>(std::clamp(std::floor(static_cast<double>(value)), -2147483648.0, 2147483647.0));
+        }
+    }
+
+    DrawList::DrawList(const MapRenderData& renderData)
+    {
+        reset(renderData);
+    }
+
+    void DrawList::reset(const MapRenderData& renderData)
+    {
+        m_renderData = &renderData;
+        m_sources.clear();
+        m_items.clear();
+        m_groupSources.clear();
+        m_objectKeyOffsets.clear();
+        m_objectKeys.clear();
+    }
+
+    auto DrawList::defaultSources(const MapRenderData& renderData) -> std::vector<DrawSource>
+    {
+        std::vector<DrawSource> sources;
+        sources.reserve(renderData.layers.size() + renderData.objectGroups.size());
+        for (std::uint32_t layerIdx = 0; layerIdx < renderData.layers.size(); ++layerIdx)
+            sources.push_back({DrawSourceKind::TileLayer, layerIdx, std::min(layerIdx, MAX_BAND)});
+
+        const auto objectBand = static_cast<std::uint32_t>(
+            std::min<std::size_t>(std::max<std::size_t>(renderData.layers.size(), 1) - 1, MAX_BAND));
+        for (std::uint32_t groupIdx = 0; groupIdx < renderData.objectGroups.size(); ++groupIdx)
+            sources.push_back({DrawSourceKind::ObjectGroup, groupIdx, objectBand});
+        return sources;
+    }
+
+    void DrawList::build()
+    {
+        if (m_renderData)
+            build(defaultSources(*m_renderData));
+    }
+
+    void DrawList::build(std::span<const DrawSource> sources)
+    {
+        m_sources.clear();
+        m_items.clear();
+        if (!m_renderData)
+            return;
+
+        // Keep the first listing of every existing layer and group
+        const auto& renderData = *m_renderData;
+        std::vector<bool> layerListed(renderData.layers.size(), false);
+        m_groupSources.assign(renderData.objectGroups.size(), NO_SOURCE);
+        for (DrawSource source : sources)
+        {
+            source.band = std::min(source.band, MAX_BAND);
+            if (source.kind == DrawSourceKind::TileLayer)
+            {
+                if (source.index >= renderData.layers.size() || layerListed[source.index])
+                    continue;
+                layerListed[source.index] = true;
+            }
+            else
+            {
+                if (source.index >= renderData.objectGroups.size() || m_groupSources[source.index] != NO_SOURCE)
+                    continue;
+                m_groupSources[source.index] = static_cast<std::uint32_t>(m_sources.size());
+            }
+            m_sources.push_back(source);
+        }
+
+        collect();
+        radixSort();
+    }
+
+    void DrawList::update(std::span<const ObjectRef> moved)
+    {
+        if (!m_renderData)
+            return;
+
+        // Every rotation moves the items between an object's old and new place, so past a few objects one
+        // linear-time sort of the whole list is cheaper
+        if (moved.size() * 32 > m_items.size())
+        {
+            m_items.clear();
+            collect();
+            radixSort();
+            return;
+        }
+
+        for (const ObjectRef& ref : moved)
+        {
+            if (ref.objectGroupIndex >= m_groupSources.size() ||
+                ref.objectIndex >= m_objectKeyOffsets[ref.objectGroupIndex + 1] - m_objectKeyOffsets[ref.objectGroupIndex])
+                continue;
+
+            const std::size_t slot = m_objectKeyOffsets[ref.objectGroupIndex] + ref.objectIndex;
+            const std::uint32_t source = m_groupSources[ref.objectGroupIndex];
+            if (m_objectKeys[slot] == NOT_LISTED)
+                continue;
+
+            const DrawItem old{m_objectKeys[slot], source, ref.objectIndex};
+            const DrawItem updated{
+                objectKey(m_sources[source], m_renderData->objectGroups[ref.objectGroupIndex].objects[ref.objectIndex]),
+                source, ref.objectIndex};
+            if (updated.key == old.key)
+                continue;
+
+            const auto from = std::lower_bound(m_items.begin(), m_items.end(), old, itemLess);
+            const auto to = std::lower_bound(m_items.begin(), m_items.end(), updated, itemLess);
+            if (to > from)
+            {
+                std::rotate(from, from + 1, to);
+                *(to - 1) = updated;
+            }
+            else
+            {
+                std::rotate(to, from, from + 1);
+                *to = updated;
+            }
+            m_objectKeys[slot] = updated.key;
+        }
+    }
+
+    auto DrawList::sortKey(const std::uint32_t band, const std::int32_t depth, const std::int32_t x) const
+        -> std::uint64_t
+    {
+        const map::RenderOrder order = m_renderData->renderOrder;
+        const bool up = order == map::RenderOrder::RightUp || order == map::RenderOrder::LeftUp;
+        const bool left = order == map::RenderOrder::LeftDown || order == map::RenderOrder::LeftUp;
+
+        // Signed values become unsigned ones of the same order; the largest depth is left to index-ordered groups
+        std::uint32_t depthBits = static_cast<std::uint32_t>(depth) ^ 0x80000000u;
+        depthBits = std::min(up ? ~depthBits : depthBits, 0xFFFFFFFEu);
+        auto column = static_cast<std::uint32_t>(std::clamp<std::int64_t>(std::int64_t{x} + 0x800000, 0, 0xFFFFFF));
+        if (left)
+            column = 0xFFFFFF - column;
+        return (static_cast<std::uint64_t>(band) << 56) | (static_cast<std::uint64_t>(depthBits) << 24) | column;
+    }
+
+    auto DrawList::objectKey(const DrawSource& source, const ObjectRenderInfo& object) const -> std::uint64_t
+    {
+        if (m_renderData->objectGroups[source.index].drawOrder == map::DrawOrder::Index)
+            return (static_cast<std::uint64_t>(source.band) << 56) | (0xFFFFFFFFull << 24);
+
+        // Tile objects are anchored at the bottom of their image, in object coordinates that only isometric maps
+        // do not store in screen pixels
+        const map::Point anchor = withProjection(m_renderData->projection, [&](const auto& grid)
+        {
+            return grid.objectToScreen(object.x, object.y);
+        });
+        return sortKey(source.band, objectCoordinate(anchor.y), objectCoordinate(anchor.x));
+    }
+
+    void DrawList::collect()
+    {
+        const auto& renderData = *m_renderData;
+        m_objectKeyOffsets.assign(renderData.objectGroups.size() + 1, 0);
+        for (std::size_t groupIdx = 0; groupIdx < renderData.objectGroups.size(); ++groupIdx)
+        {
+            m_objectKeyOffsets[groupIdx + 1] = m_objectKeyOffsets[groupIdx] +
+                static_cast<std::uint32_t>(renderData.objectGroups[groupIdx].objects.size());
+        }
+        m_objectKeys.assign(m_objectKeyOffsets.back(), NOT_LISTED);
+
+        // Items are appended by source, then by index, which is the tie-break order of the sort
+        const auto tileHeight = static_cast<std::int32_t>(renderData.tileHeight);
+        for (std::uint32_t sourceIdx = 0; sourceIdx < m_sources.size(); ++sourceIdx)
+        {
+            const DrawSource& source = m_sources[sourceIdx];
+            if (source.kind == DrawSourceKind::ObjectGroup)
+            {
+                const auto& group = renderData.objectGroups[source.index];
+                if (!group.visible)
+                    continue;
+                for (std::uint32_t i = 0; i < group.objects.size(); ++i)
+                {
+                    if (group.objects[i].tilesetIndex >= renderData.tilesets.size())
+                        continue; // Only tile objects are drawn
+                    const std::uint64_t key = objectKey(source, group.objects[i]);
+                    m_objectKeys[m_objectKeyOffsets[source.index] + i] = key;
+                    m_items.push_back({key, sourceIdx, i});
+                }
+                continue;
+            }
+
+            // Tiles are ordered by their bottom edge
+            const auto& layer = renderData.layers[source.index];
+            if (!layer.visible)
+                continue;
+            if (layer.storage == TileStorage::Full)
+            {
+                for (std::uint32_t i = 0; i < layer.tiles.size(); ++i)
+                {
+                    const auto& tile = layer.tiles[i];
+                    m_items.push_back({sortKey(source.band, tile.destY + tileHeight, tile.destX), sourceIdx, i});
+                }
+            }
+            else if (layer.storage == TileStorage::Packed)
+            {
+                for (std::uint32_t i = 0; i < layer.packedTiles.size(); ++i)
+                {
+                    const auto& tile = layer.packedTiles[i];
+                    m_items.push_back({sortKey(source.band, tile.destY + tileHeight, tile.destX), sourceIdx, i});
+                }
+            }
+            else
+            {
+                withProjection(renderData.projection, [&](const auto& grid)
+                {
+                    for (const auto& block : layer.tileBlocks)
+                    {
+                        for (std::uint32_t cell = 0; cell < block.width * block.height; ++cell)
+                        {
+                            if (!renderData.gidInfo(layer.gids[block.offset + cell]))
+                                continue;
+                            const ScreenPoint dest = grid.toScreen(block.x + static_cast<std::int32_t>(cell % block.width),
+                                                                   block.y + static_cast<std::int32_t>(cell / block.width));
+                            m_items.push_back({sortKey(source.band, dest.y + tileHeight, dest.x), sourceIdx,
+                                               block.offset + cell});
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    void DrawList::radixSort()
+    {
+        // One histogram per key byte, all counted in a single pass
+        const std::size_t count = m_items.size();
+        std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+        for (const DrawItem& item : m_items)
+        {
+            for (std::size_t digit = 0; digit < 8; ++digit)
+                ++histograms[digit][(item.key >> (digit * 8)) & 0xFF];
+        }
+
+        // Stable counting passes from the lowest byte up; bytes shared by every key are skipped
+        m_scratch.resize(count);
+        for (std::size_t digit = 0; digit < 8 && count > 0; ++digit)
+        {
+            auto& histogram = histograms[digit];
+            const std::size_t shift = digit * 8;
+            if (histogram[(m_items[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            std::uint32_t offset = 0;
+            for (auto& bucket : histogram)
+            {
+                const std::uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+            for (const DrawItem& item : m_items)
+                m_scratch[histogram[(item.key >> shift) & 0xFF]++] = item;
+            m_items.swap(m_scratch);
+        }
+    }
+}
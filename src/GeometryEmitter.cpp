@@ -0,0 +1,226 @@
+#include <tmx/GeometryEmitter.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace tmx::render
+{
+    namespace
+    {
+        // Quad corners in vertex order: top-left, top-right, bottom-right, bottom-left
+        constexpr float CORNER_S[4] = {0.0f, 1.0f, 1.0f, 0.0f};
+        constexpr float CORNER_T[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+        constexpr std::uint32_t QUAD_INDICES[6] = {0, 1, 2, 0, 2, 3};
+
+        // Origin and vertex color of the quads of one layer, from its offset, parallax and tint
+        struct LayerPlacement
+        {
+            float originX, originY; // Layer position emitted at (0, 0)
+            float r, g, b, a; // Tint; alpha is multiplied with the tile opacity
+        };
+
+        auto placeLayer(const LayerRenderData& layer, const GeometryOptions& options) -> LayerPlacement
+        {
+            const auto& transform = layer.transform;
+            const ViewRect origin = transform.toLayer({options.originX, options.originY, 0.0f, 0.0f});
+            return {origin.x, origin.y, transform.tint.r / 255.0f, transform.tint.g / 255.0f,
+                    transform.tint.b / 255.0f, transform.tint.a / 255.0f};
+        }
+
+        void writeQuad(GeometryVertex* vertices, const TileRenderInfo& tile, const TilesetRenderInfo& tileset,
+                       const LayerPlacement& placement, const GeometryOptions& options)
+        {
+            std::uint32_t srcX = tile.srcX;
+            std::uint32_t srcY = tile.srcY;
+            if (tile.isAnimated && options.animationClock)
+            {
+                const auto& frame = options.animationClock->frame(tile.tilesetIndex, tile.animationIndex);
+                srcX = frame.srcX;
+                srcY = frame.srcY;
+            }
+
+            const float uScale = options.normalizedUv && tileset.imageWidth > 0 ? 1.0f / static_cast<float>(tileset.imageWidth) : 1.0f;
+            const float vScale = options.normalizedUv && tileset.imageHeight > 0 ? 1.0f / static_cast<float>(tileset.imageHeight) : 1.0f;
+            const float left = static_cast<float>(tile.destX) - placement.originX;
+            const float top = static_cast<float>(tile.destY) - placement.originY;
+
+            for (int corner = 0; corner < 4; ++corner)
+            {
+                // Map the destination corner back to the source: undo the vertical, horizontal, then diagonal flip
+                float s = CORNER_S[corner];
+                float t = CORNER_T[corner];
+                if (tile.flipFlags & TILE_FLIP_VERTICAL)
+                    t = 1.0f - t;
+                if (tile.flipFlags & TILE_FLIP_HORIZONTAL)
+                    s = 1.0f - s;
+                if (tile.flipFlags & TILE_FLIP_DIAGONAL)
+                    std::swap(s, t);
+
+                vertices[corner] = {
+                    left + CORNER_S[corner] * static_cast<float>(tile.destW),
+                    top + CORNER_T[corner] * static_cast<float>(tile.destH),
+                    (static_cast<float>(srcX) + s * static_cast<float>(tile.srcW)) * uScale,
+                    (static_cast<float>(srcY) + t * static_cast<float>(tile.srcH)) * vScale,
+                    placement.r, placement.g, placement.b, tile.opacity * placement.a
+                };
+            }
+        }
+    }
+
+    GeometryEmitter::GeometryEmitter(const MapRenderData& renderData)
+    {
+        reset(renderData);
+    }
+
+    void GeometryEmitter::reset(const MapRenderData& renderData)
+    {
+        m_renderData = &renderData;
+        m_tileCounts.clear();
+        m_cursors.assign(renderData.tilesets.size(), {0, 0});
+    }
+
+    template <typename VisitGroup>
+    void GeometryEmitter::forEachRangeGroup(std::span<const ChunkRange> ranges, VisitGroup& visitGroup) const
+    {
+        // Ranges of the same layer are consecutive; each visible layer becomes one group of batches
+        for (std::size_t first = 0; first < ranges.size();)
+        {
+            const std::uint32_t layerIndex = ranges[first].layerIndex;
+            std::size_t last = first;
+            while (last < ranges.size() && ranges[last].layerIndex == layerIndex)
+                ++last;
+
+            const auto& layer = m_renderData->layers[layerIndex];
+            if (layer.visible)
+            {
+                visitGroup(layerIndex, layer, [&](auto&& visitor)
+                {
+                    for (std::size_t r = first; r < last; ++r)
+                    {
+                        for (std::uint32_t c = ranges[r].first; c < ranges[r].first + ranges[r].count; ++c)
+                            m_renderData->forEachTile(layer, layer.chunks[c], visitor);
+                    }
+                });
+            }
+            first = last;
+        }
+    }
+
+    template <typename ForEachGroup>
+    auto GeometryEmitter::count(ForEachGroup&& forEachGroup) -> GeometryCounts
+    {
+        GeometryCounts counts;
+        m_tileCounts.clear();
+        if (!m_renderData)
+            return counts;
+
+        const std::size_t tilesetCount = m_renderData->tilesets.size();
+        forEachGroup([&](std::uint32_t, const LayerRenderData&, auto&& forEachTile)
+        {
+            const std::size_t base = m_tileCounts.size();
+            m_tileCounts.resize(base + tilesetCount, 0);
+            forEachTile([&](const TileRenderInfo& tile)
+            {
+                if (tile.tilesetIndex < tilesetCount)
+                    ++m_tileCounts[base + tile.tilesetIndex];
+            });
+
+            for (std::size_t t = 0; t < tilesetCount; ++t)
+            {
+                const std::size_t tiles = m_tileCounts[base + t];
+                counts.vertexCount += tiles * 4;
+                counts.indexCount += tiles * 6;
+                counts.batchCount += tiles > 0 ? 1 : 0;
+            }
+        });
+        return counts;
+    }
+
+    template <typename ForEachGroup>
+    auto GeometryEmitter::write(ForEachGroup&& forEachGroup, const GeometryBuffers& buffers,
+                                const GeometryOptions& options) -> tl::expected<GeometryCounts, std::string>
+    {
+        // Counting first gives every batch its final range, so tiles are written in one pass without sorting
+        const GeometryCounts counts = count(forEachGroup);
+        if (counts.vertexCount > buffers.vertices.size() || counts.indexCount > buffers.indices.size() ||
+            counts.batchCount > buffers.batches.size())
+        {
+            return tl::make_unexpected("Geometry buffers too small: need " + std::to_string(counts.vertexCount) +
+                                       " vertices, " + std::to_string(counts.indexCount) + " indices and " +
+                                       std::to_string(counts.batchCount) + " batches");
+        }
+        if (!m_renderData)
+            return counts;
+
+        const std::size_t tilesetCount = m_renderData->tilesets.size();
+        m_cursors.resize(tilesetCount);
+        std::size_t group = 0;
+        std::uint32_t vertex = 0, index = 0, batch = 0;
+        forEachGroup([&](const std::uint32_t layerIndex, const LayerRenderData& layer, auto&& forEachTile)
+        {
+            const LayerPlacement placement = placeLayer(layer, options);
+            const std::uint32_t* tileCounts = m_tileCounts.data() + group++ * tilesetCount;
+            for (std::uint32_t t = 0; t < tilesetCount; ++t)
+            {
+                if (tileCounts[t] == 0)
+                    continue;
+                buffers.batches[batch] = {layerIndex, t, vertex, tileCounts[t] * 4, index, tileCounts[t] * 6};
+                m_cursors[t] = {batch, vertex};
+                vertex += tileCounts[t] * 4;
+                index += tileCounts[t] * 6;
+                ++batch;
+            }
+
+            forEachTile([&](const TileRenderInfo& tile)
+            {
+                if (tile.tilesetIndex >= tilesetCount)
+                    return;
+
+                Cursor& cursor = m_cursors[tile.tilesetIndex];
+                const GeometryBatch& tileBatch = buffers.batches[cursor.batch];
+                writeQuad(&buffers.vertices[cursor.vertex], tile, m_renderData->tilesets[tile.tilesetIndex], placement,
+                          options);
+
+                const std::uint32_t local = cursor.vertex - tileBatch.firstVertex;
+                std::uint32_t* quadIndices = &buffers.indices[tileBatch.firstIndex + local / 4 * 6];
+                for (int i = 0; i < 6; ++i)
+                    quadIndices[i] = local + QUAD_INDICES[i];
+                cursor.vertex += 4;
+            });
+        });
+        return counts;
+    }
+
+    auto GeometryEmitter::measure(const LayerRenderData& layer) -> GeometryCounts
+    {
+        return count([&](auto&& visitGroup)
+        {
+            visitGroup(GeometryBatch::NO_LAYER, layer, [&](auto&& visitor) { m_renderData->forEachTile(layer, visitor); });
+        });
+    }
+
+    auto GeometryEmitter::measure(std::span<const ChunkRange> ranges) -> GeometryCounts
+    {
+        return count([&](auto&& visitGroup)
+        {
+            forEachRangeGroup(ranges, visitGroup);
+        });
+    }
+
+    auto GeometryEmitter::emit(const LayerRenderData& layer, const GeometryBuffers& buffers, const GeometryOptions& options)
+        -> tl::expected<GeometryCounts, std::string>
+    {
+        return write([&](auto&& visitGroup)
+        {
+            visitGroup(GeometryBatch::NO_LAYER, layer, [&](auto&& visitor) { m_renderData->forEachTile(layer, visitor); });
+        }, buffers, options);
+    }
+
+    auto GeometryEmitter::emit(std::span<const ChunkRange> ranges, const GeometryBuffers& buffers,
+                               const GeometryOptions& options) -> tl::expected<GeometryCounts, std::string>
+    {
+        return write([&](auto&& visitGroup)
+        {
+            forEachRangeGroup(ranges, visitGroup);
+        }, buffers, options);
+    }
+}
@@ -0,0 +1,322 @@
+#include <tmx/LodPyramid.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace tmx::raster
+{
+    namespace
+    {
+        constexpr std::uint32_t MAX_LEVELS = 16;
+
+        auto chunkKey(const std::int32_t chunkX, const std::int32_t chunkY) -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkY)) << 32) |
+                static_cast<std::uint32_t>(chunkX);
+        }
+
+        auto floorDiv(const std::int64_t value, const std::int64_t divisor) -> std::int64_t
+        {
+            const std::int64_t quotient = value / divisor;
+            return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+        }
+
+        // Keys of the chunk squares overlapping a pixel box
+        template <typename Fn>
+        void forEachSquare(const render::RenderBounds& bounds, const std::int64_t chunkWidth,
+                           const std::int64_t chunkHeight, Fn&& fn)
+        {
+            if (bounds.isEmpty())
+                return;
+            for (std::int64_t cy = floorDiv(bounds.minY, chunkHeight); cy <= floorDiv(bounds.maxY - 1, chunkHeight); ++cy)
+            {
+                for (std::int64_t cx = floorDiv(bounds.minX, chunkWidth); cx <= floorDiv(bounds.maxX - 1, chunkWidth); ++cx)
+                    fn(chunkKey(static_cast<std::int32_t>(cx), static_cast<std::int32_t>(cy)));
+            }
+        }
+
+        // Whether any layer draws into a chunk square, wherever its offset moves it
+        auto hasContent(const render::MapRenderData& renderData, const render::RenderBounds& square,
+                        std::vector<render::ChunkRange>& ranges) -> bool
+        {
+            ranges.clear();
+            for (std::uint32_t layerIdx = 0; layerIdx < renderData.layers.size() && ranges.empty(); ++layerIdx)
+            {
+                const auto& transform = renderData.layers[layerIdx].transform;
+                renderData.queryLayer(layerIdx, {static_cast<float>(square.minX) - transform.offsetX,
+                                                 static_cast<float>(square.minY) - transform.offsetY,
+                                                 static_cast<float>(square.maxX - square.minX),
+                                                 static_cast<float>(square.maxY - square.minY)}, ranges);
+            }
+            return !ranges.empty();
+        }
+
+        // Straight alpha to premultiplied, 16 bits per channel so the box filter keeps its precision
+        auto premultiplied(const Image& image) -> std::vector<std::uint16_t>
+        {
+            std::vector<std::uint16_t> pixels(image.pixels.size());
+            for (std::size_t i = 0; i < image.pixels.size(); i += 4)
+            {
+                const std::uint32_t alpha = image.pixels[i + 3];
+                for (std::size_t c = 0; c < 3; ++c)
+                    pixels[i + c] = static_cast<std::uint16_t>((image.pixels[i + c] * alpha * 257u + 127) / 255);
+                pixels[i + 3] = static_cast<std::uint16_t>(alpha * 257u);
+            }
+            return pixels;
+        }
+
+        // Average 2x2 blocks; an odd last row or column is averaged with itself
+        auto halve(const std::vector<std::uint16_t>& pixels, const std::uint32_t width, const std::uint32_t height,
+                   std::uint32_t& halfWidth, std::uint32_t& halfHeight) -> std::vector<std::uint16_t>
+        {
+            halfWidth = std::max((width + 1) / 2, 1u);
+            halfHeight = std::max((height + 1) / 2, 1u);
+            std::vector<std::uint16_t> half(static_cast<std::size_t>(halfWidth) * halfHeight * 4);
+            for (std::uint32_t y = 0; y < halfHeight; ++y)
+            {
+                const std::size_t row0 = static_cast<std::size_t>(std::min(2 * y, height - 1)) * width;
+                const std::size_t row1 = static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * width;
+                for (std::uint32_t x = 0; x < halfWidth; ++x)
+                {
+                    const std::size_t x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        const std::uint32_t sum = pixels[(row0 + x0) * 4 + c] + pixels[(row0 + x1) * 4 + c] +
+                            pixels[(row1 + x0) * 4 + c] + pixels[(row1 + x1) * 4 + c];
+                        half[(static_cast<std::size_t>(y) * halfWidth + x) * 4 + c] = static_cast<std::uint16_t>((sum + 2) / 4);
+                    }
+                }
+            }
+            return half;
+        }
+
+        auto straight(const std::vector<std::uint16_t>& pixels, const std::uint32_t width, const std::uint32_t height)
+            -> Image
+        {
+            Image image;
+            image.width = width;
+            image.height = height;
+            image.pixels.resize(pixels.size());
+            for (std::size_t i = 0; i < pixels.size(); i += 4)
+            {
+                const std::uint32_t alpha = pixels[i + 3];
+                image.pixels[i + 3] = static_cast<std::uint8_t>((alpha + 128) / 257);
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    image.pixels[i + c] = alpha == 0 ? 0 : static_cast<std::uint8_t>(
+                        std::min<std::uint32_t>((pixels[i + c] * 255u + alpha / 2) / alpha, 255));
+                }
+            }
+            return image;
+        }
+    }
+
+    LodPyramid::LodPyramid(const Rasterizer& rasterizer, const LodOptions& options)
+    {
+        reset(rasterizer, options);
+    }
+
+    void LodPyramid::reset(const Rasterizer& rasterizer, const LodOptions& options)
+    {
+        m_rasterizer = &rasterizer;
+        m_options = options;
+        m_options.levelCount = std::clamp(options.levelCount, 1u, MAX_LEVELS);
+        m_chunks.clear();
+        m_index.clear();
+    }
+
+    auto LodPyramid::build() -> tl::expected<void, std::string>
+    {
+        m_chunks.clear();
+        m_index.clear();
+        if (!m_rasterizer || !m_rasterizer->renderData())
+            return tl::make_unexpected("LOD pyramid is not bound to a rasterizer with render data");
+
+        // Layers drawn at an offset reach into the squares next to their own chunks
+        const auto& renderData = *m_rasterizer->renderData();
+        const std::int64_t chunkWidth = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileWidth;
+        const std::int64_t chunkHeight = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileHeight;
+        if (chunkWidth == 0 || chunkHeight == 0)
+            return {};
+        for (const auto& layer : renderData.layers)
+        {
+            for (const auto& spatialChunk : layer.chunks)
+            {
+                forEachSquare(drawnBounds(layer, spatialChunk.bounds), chunkWidth, chunkHeight,
+                              [&](const std::uint64_t key)
+                {
+                    if (m_index.try_emplace(key, static_cast<std::uint32_t>(m_chunks.size())).second)
+                    {
+                        m_chunks.push_back({static_cast<std::int32_t>(static_cast<std::uint32_t>(key)),
+                                            static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32)), {}, {}});
+                    }
+                });
+            }
+        }
+
+        for (auto& chunk : m_chunks)
+        {
+            if (auto built = buildChunk(chunk); !built)
+                return built;
+        }
+        return {};
+    }
+
+    auto LodPyramid::update(std::span<const render::DirtyRegion> regions) -> tl::expected<std::size_t, std::string>
+    {
+        if (!m_rasterizer || !m_rasterizer->renderData())
+            return tl::make_unexpected("LOD pyramid is not bound to a rasterizer with render data");
+
+        const auto& renderData = *m_rasterizer->renderData();
+        const std::int64_t chunkWidth = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileWidth;
+        const std::int64_t chunkHeight = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileHeight;
+        if (chunkWidth == 0 || chunkHeight == 0)
+            return 0;
+
+        // Edited cells are redrawn in every square their layer's offset moves them into
+        std::vector<std::uint64_t> keys;
+        keys.reserve(regions.size());
+        for (const auto& region : regions)
+        {
+            if (region.layerIndex >= renderData.layers.size() || region.bounds.isEmpty())
+            {
+                keys.push_back(chunkKey(region.chunkX, region.chunkY));
+                continue;
+            }
+            forEachSquare(drawnBounds(renderData.layers[region.layerIndex], region.bounds), chunkWidth, chunkHeight,
+                          [&](const std::uint64_t key) { keys.push_back(key); });
+        }
+        std::ranges::sort(keys);
+        const auto duplicates = std::ranges::unique(keys);
+        keys.erase(duplicates.begin(), duplicates.end());
+
+        std::size_t changed = 0;
+        std::vector<render::ChunkRange> ranges;
+        for (const std::uint64_t key : keys)
+        {
+            const auto chunkX = static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+            const auto chunkY = static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32));
+            const auto it = m_index.find(key);
+            const render::RenderBounds square{static_cast<std::int32_t>(chunkX * chunkWidth),
+                                              static_cast<std::int32_t>(chunkY * chunkHeight),
+                                              static_cast<std::int32_t>((chunkX + 1) * chunkWidth),
+                                              static_cast<std::int32_t>((chunkY + 1) * chunkHeight)};
+            if (!hasContent(renderData, square, ranges))
+            {
+                if (it == m_index.end())
+                    continue;
+
+                // Swap the last chunk into the freed slot
+                const std::uint32_t slot = it->second;
+                m_index.erase(it);
+                if (slot + 1 != m_chunks.size())
+                {
+                    m_chunks[slot] = std::move(m_chunks.back());
+                    m_index[chunkKey(m_chunks[slot].chunkX, m_chunks[slot].chunkY)] = slot;
+                }
+                m_chunks.pop_back();
+                ++changed;
+                continue;
+            }
+
+            if (it == m_index.end())
+            {
+                m_index.emplace(key, static_cast<std::uint32_t>(m_chunks.size()));
+                m_chunks.push_back({chunkX, chunkY, {}, {}});
+            }
+            if (auto built = buildChunk(m_chunks[m_index.at(key)]); !built)
+                return tl::make_unexpected(built.error());
+            ++changed;
+        }
+        return changed;
+    }
+
+    auto LodPyramid::levelForZoom(const float zoom) const -> std::optional<std::uint32_t>
+    {
+        if (!(zoom > 0.0f) || zoom > levelScale(0))
+            return std::nullopt;
+
+        // Level k is the right one for zooms in (scale(k + 1), scale(k)]
+        const auto level = static_cast<std::int32_t>(std::floor(std::log2(1.0f / zoom))) - 1;
+        return static_cast<std::uint32_t>(std::clamp<std::int32_t>(level, 0, static_cast<std::int32_t>(levelCount()) - 1));
+    }
+
+    auto LodPyramid::chunk(const std::int32_t chunkX, const std::int32_t chunkY) const -> const LodChunk*
+    {
+        const auto it = m_index.find(chunkKey(chunkX, chunkY));
+        return it == m_index.end() ? nullptr : &m_chunks[it->second];
+    }
+
+    void LodPyramid::query(const render::ViewRect& viewRect, std::vector<const LodChunk*>& visible) const
+    {
+        visible.clear();
+        if (!m_rasterizer || !m_rasterizer->renderData())
+            return;
+
+        const auto& renderData = *m_rasterizer->renderData();
+        const std::int64_t chunkWidth = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileWidth;
+        const std::int64_t chunkHeight = static_cast<std::int64_t>(renderData.chunkSize) * renderData.tileHeight;
+        if (chunkWidth == 0 || chunkHeight == 0)
+            return;
+
+        const std::int64_t minX = floorDiv(static_cast<std::int64_t>(std::floor(viewRect.x)), chunkWidth);
+        const std::int64_t minY = floorDiv(static_cast<std::int64_t>(std::floor(viewRect.y)), chunkHeight);
+        const std::int64_t maxX = floorDiv(static_cast<std::int64_t>(std::ceil(viewRect.x + viewRect.width)) - 1, chunkWidth);
+        const std::int64_t maxY = floorDiv(static_cast<std::int64_t>(std::ceil(viewRect.y + viewRect.height)) - 1, chunkHeight);
+
+        // Zoomed far out, the view can span more cells than there are chunks; scan the chunks instead
+        if (maxX < minX || maxY < minY)
+            return;
+        if (static_cast<double>(maxX - minX + 1) * static_cast<double>(maxY - minY + 1) > static_cast<double>(m_chunks.size()))
+        {
+            for (const auto& chunk : m_chunks)
+            {
+                if (chunk.chunkX >= minX && chunk.chunkX <= maxX && chunk.chunkY >= minY && chunk.chunkY <= maxY)
+                    visible.push_back(&chunk);
+            }
+            return;
+        }
+
+        for (std::int64_t cy = minY; cy <= maxY; ++cy)
+        {
+            for (std::int64_t cx = minX; cx <= maxX; ++cx)
+            {
+                if (const LodChunk* found = chunk(static_cast<std::int32_t>(cx), static_cast<std::int32_t>(cy)))
+                    visible.push_back(found);
+            }
+        }
+    }
+
+    auto LodPyramid::buildChunk(LodChunk& chunk) const -> tl::expected<void, std::string>
+    {
+        const auto& renderData = *m_rasterizer->renderData();
+        const auto chunkWidth = static_cast<std::int32_t>(renderData.chunkSize * renderData.tileWidth);
+        const auto chunkHeight = static_cast<std::int32_t>(renderData.chunkSize * renderData.tileHeight);
+        chunk.bounds = {chunk.chunkX * chunkWidth, chunk.chunkY * chunkHeight, (chunk.chunkX + 1) * chunkWidth,
+                        (chunk.chunkY + 1) * chunkHeight};
+
+        RasterOptions options;
+        options.region = render::ViewRect{static_cast<float>(chunk.bounds.minX), static_cast<float>(chunk.bounds.minY),
+                                          static_cast<float>(chunkWidth), static_cast<float>(chunkHeight)};
+        options.time = m_options.time;
+        options.drawObjects = m_options.drawObjects;
+        options.threadCount = m_options.threadCount;
+        const auto full = m_rasterizer->render(options);
+        if (!full)
+            return tl::make_unexpected(full.error());
+
+        // Each level is filtered from the previous one, never re-drawn from tiles
+        std::vector<std::uint16_t> pixels = premultiplied(*full);
+        std::uint32_t width = full->width, height = full->height;
+        chunk.levels.clear();
+        chunk.levels.reserve(m_options.levelCount);
+        for (std::uint32_t level = 0; level < m_options.levelCount; ++level)
+        {
+            std::uint32_t halfWidth = 0, halfHeight = 0;
+            pixels = halve(pixels, width, height, halfWidth, halfHeight);
+            width = halfWidth;
+            height = halfHeight;
+            chunk.levels.push_back(straight(pixels, width, height));
+        }
+        return {};
+    }
+}
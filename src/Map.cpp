@@ -54,6 +54,18 @@ namespace tmx::map
         }
     }
 
+    auto Color::fromArgbString(const std::string& hex) -> tl::expected<Color, std::string>
+    {
+        auto color = fromString(hex);
+        if (!color || hex.size() - (hex.starts_with('#') ? 1 : 0) != 8)
+        {
+            return color;
+        }
+
+        // fromString read the digits as RRGGBBAA; the alpha came first
+        return Color{color->g, color->b, color->a, color->r};
+    }
+
     auto Properties::get(const std::string& name) const -> std::string
     {
         const auto it = std::ranges::find_if(properties,
@@ -98,4 +110,20 @@ namespace tmx::map
 
         return value == "true" || value == "1";
     }
+
+    auto Map::tilesetOf(const std::uint32_t gid) const -> const Tileset*
+    {
+        const std::uint32_t id = gid & GID_MASK;
+        if (id == 0)
+            return nullptr;
+        const auto it = std::find_if(tilesets.rbegin(), tilesets.rend(),
+                                     [id](const Tileset& tileset) { return tileset.firstgid <= id; });
+        return it == tilesets.rend() ? nullptr : &*it;
+    }
+
+    auto Map::tileShapes(const std::uint32_t gid) const -> std::span<const Object>
+    {
+        const Tileset* tileset = tilesetOf(gid);
+        return tileset ? tileset->tileShapes((gid & GID_MASK) - tileset->firstgid) : std::span<const Object>{};
+    }
 }
@@ -0,0 +1,317 @@
+#include <tmx/Navigation.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+
+namespace tmx::nav
+{
+    namespace
+    {
+        struct Direction
+        {
+            std::int32_t dx, dy;
+        };
+
+        constexpr std::array<Direction, 8> ALL_DIRECTIONS = {
+            {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+        auto sign(const std::int32_t value) -> std::int32_t
+        {
+            return (value > 0) - (value < 0);
+        }
+
+        // Exact cost of the cheapest unobstructed path between two cells, used as the heuristic and as the cost of
+        // straight or diagonal jumps
+        auto octile(const GridPoint& a, const GridPoint& b) -> std::uint32_t
+        {
+            const auto dx = static_cast<std::uint32_t>(std::abs(a.x - b.x));
+            const auto dy = static_cast<std::uint32_t>(std::abs(a.y - b.y));
+            return STRAIGHT_COST * (std::max(dx, dy) - std::min(dx, dy)) + DIAGONAL_COST * std::min(dx, dy);
+        }
+
+        // Heap order: lowest f on top, deepest first among equal f
+        constexpr auto openAfter = [](const auto& a, const auto& b)
+        {
+            return a.f != b.f ? a.f > b.f : a.g < b.g;
+        };
+
+        // Whether position lies in [first, first + 64)
+        auto inWindow(const std::int32_t position, const std::int32_t first) -> bool
+        {
+            const std::int64_t offset = static_cast<std::int64_t>(position) - first;
+            return offset >= 0 && offset < 64;
+        }
+    }
+
+    NavGrid::NavGrid(map::BitGrid walkable)
+        : m_rows(std::move(walkable)), m_columns(m_rows.transposed())
+    {
+    }
+
+    auto NavGrid::fromSolidity(const map::BitGrid& solid) -> NavGrid
+    {
+        return NavGrid(solid.inverted());
+    }
+
+    void NavGrid::setWalkable(const std::int32_t x, const std::int32_t y, const bool walkable)
+    {
+        m_rows.set(x, y, walkable);
+        m_columns.set(y, x, walkable);
+    }
+
+    Pathfinder::Pathfinder(const NavGrid& grid)
+        : m_grid(&grid), m_width(grid.rows().width())
+    {
+        const std::size_t cells = static_cast<std::size_t>(m_width) * grid.rows().height();
+        m_g.assign(cells, 0);
+        m_parent.assign(cells, NO_CELL);
+        m_seen.assign(cells, 0);
+        m_closed.assign(cells, 0);
+    }
+
+    auto Pathfinder::findPath(const GridPoint start, const GridPoint goal, std::vector<GridPoint>& path,
+                              const PathAlgorithm algorithm) -> PathResult
+    {
+        path.clear();
+        const std::uint32_t cost = algorithm == PathAlgorithm::JumpPoint ? search<true>(start, goal)
+                                                                         : search<false>(start, goal);
+        if (cost == NO_CELL)
+            return {};
+        appendPath(goal, path);
+        return {true, cost, 0, static_cast<std::uint32_t>(path.size())};
+    }
+
+    void Pathfinder::findPaths(std::span<const PathRequest> requests, PathBatch& batch, const PathAlgorithm algorithm)
+    {
+        batch.points.clear();
+        batch.results.clear();
+        for (const PathRequest& request : requests)
+        {
+            const std::uint32_t cost = algorithm == PathAlgorithm::JumpPoint
+                ? search<true>(request.start, request.goal)
+                : search<false>(request.start, request.goal);
+            PathResult result{};
+            result.first = static_cast<std::uint32_t>(batch.points.size());
+            if (cost != NO_CELL)
+            {
+                appendPath(request.goal, batch.points);
+                result.found = true;
+                result.cost = cost;
+                result.count = static_cast<std::uint32_t>(batch.points.size()) - result.first;
+            }
+            batch.results.push_back(result);
+        }
+    }
+
+    template <bool JUMP>
+    auto Pathfinder::search(const GridPoint start, const GridPoint goal) -> std::uint32_t
+    {
+        // A new generation invalidates the state of every cell at once
+        if (++m_generation == 0)
+        {
+            std::ranges::fill(m_seen, 0u);
+            std::ranges::fill(m_closed, 0u);
+            m_generation = 1;
+        }
+        m_open.clear();
+        m_expanded = 0;
+        if (!walkable(start.x, start.y) || !walkable(goal.x, goal.y))
+            return NO_CELL;
+
+        const std::uint32_t startCell = cellIndex(start);
+        m_g[startCell] = 0;
+        m_parent[startCell] = NO_CELL;
+        m_seen[startCell] = m_generation;
+        m_open.push_back({octile(start, goal), 0, startCell});
+
+        while (!m_open.empty())
+        {
+            std::ranges::pop_heap(m_open, openAfter);
+            const OpenEntry entry = m_open.back();
+            m_open.pop_back();
+            if (m_closed[entry.cell] == m_generation || entry.g != m_g[entry.cell])
+                continue; // Already expanded through a cheaper entry
+            m_closed[entry.cell] = m_generation;
+            ++m_expanded;
+
+            const GridPoint point = pointOf(entry.cell);
+            if (point == goal)
+                return entry.g;
+
+            if constexpr (!JUMP)
+            {
+                for (const auto [dx, dy] : ALL_DIRECTIONS)
+                {
+                    if (!walkable(point.x + dx, point.y + dy) ||
+                        (dx != 0 && dy != 0 && (!walkable(point.x + dx, point.y) || !walkable(point.x, point.y + dy))))
+                        continue;
+                    push(entry.cell, entry.g, {point.x + dx, point.y + dy}, goal);
+                }
+            }
+            else
+            {
+                // Prune the directions an optimal path through this cell cannot take, given where it came from
+                std::array<Direction, 8> directions{};
+                std::size_t directionCount = 0;
+                if (m_parent[entry.cell] == NO_CELL)
+                {
+                    directions = ALL_DIRECTIONS;
+                    directionCount = ALL_DIRECTIONS.size();
+                }
+                else
+                {
+                    const GridPoint parent = pointOf(m_parent[entry.cell]);
+                    const std::int32_t dx = sign(point.x - parent.x);
+                    const std::int32_t dy = sign(point.y - parent.y);
+                    if (dx != 0 && dy != 0)
+                    {
+                        directions[directionCount++] = {dx, dy};
+                        directions[directionCount++] = {dx, 0};
+                        directions[directionCount++] = {0, dy};
+                    }
+                    else if (dx != 0)
+                    {
+                        // Without corner cutting, openings beside a straight run are only reachable from here
+                        directions[directionCount++] = {dx, 0};
+                        directions[directionCount++] = {dx, 1};
+                        directions[directionCount++] = {dx, -1};
+                        directions[directionCount++] = {0, 1};
+                        directions[directionCount++] = {0, -1};
+                    }
+                    else
+                    {
+                        directions[directionCount++] = {0, dy};
+                        directions[directionCount++] = {1, dy};
+                        directions[directionCount++] = {-1, dy};
+                        directions[directionCount++] = {1, 0};
+                        directions[directionCount++] = {-1, 0};
+                    }
+                }
+
+                for (std::size_t i = 0; i < directionCount; ++i)
+                {
+                    if (const auto target = jump(point, directions[i].dx, directions[i].dy, goal))
+                        push(entry.cell, entry.g, *target, goal);
+                }
+            }
+        }
+        return NO_CELL;
+    }
+
+    void Pathfinder::push(const std::uint32_t cell, const std::uint32_t g, const GridPoint target, const GridPoint goal)
+    {
+        const std::uint32_t targetCell = cellIndex(target);
+        if (m_closed[targetCell] == m_generation)
+            return;
+        const std::uint32_t targetG = g + octile(pointOf(cell), target);
+        if (m_seen[targetCell] == m_generation && m_g[targetCell] <= targetG)
+            return;
+
+        m_g[targetCell] = targetG;
+        m_parent[targetCell] = cell;
+        m_seen[targetCell] = m_generation;
+        m_open.push_back({targetG + octile(target, goal), targetG, targetCell});
+        std::ranges::push_heap(m_open, openAfter);
+    }
+
+    auto Pathfinder::scan(const map::BitGrid& lines, const std::int32_t line, const std::int32_t position,
+                          const std::int32_t step, const std::int32_t goalPosition) const -> std::int32_t
+    {
+        // A cell of the run is a jump point if it is the goal, or if a neighbouring line opens up at it after being
+        // blocked at the cell before; the run ends at the first blocked cell
+        if (step > 0)
+        {
+            for (std::int32_t first = position;; first += 64)
+            {
+                const std::uint64_t open = lines.word(first, line);
+                const std::uint64_t forced = (lines.word(first, line - 1) & ~lines.word(first - 1, line - 1)) |
+                    (lines.word(first, line + 1) & ~lines.word(first - 1, line + 1));
+                const std::uint64_t goalBit = inWindow(goalPosition, first)
+                    ? std::uint64_t{1} << (goalPosition - first) : 0;
+                const int blocked = std::countr_zero(~open);
+                const int jumpPoint = std::countr_zero(forced | goalBit);
+                if (jumpPoint < blocked)
+                    return first + jumpPoint;
+                if (blocked < 64)
+                    return NO_JUMP;
+            }
+        }
+
+        for (std::int32_t last = position;; last -= 64)
+        {
+            // Same scan mirrored: bit 63 is the first cell, and the cell before is one bit higher
+            const std::int32_t first = last - 63;
+            const std::uint64_t open = lines.word(first, line);
+            const std::uint64_t forced = (lines.word(first, line - 1) & ~lines.word(first + 1, line - 1)) |
+                (lines.word(first, line + 1) & ~lines.word(first + 1, line + 1));
+            const std::uint64_t goalBit = inWindow(goalPosition, first) ? std::uint64_t{1} << (goalPosition - first) : 0;
+            const int blocked = std::countl_zero(~open);
+            const int jumpPoint = std::countl_zero(forced | goalBit);
+            if (jumpPoint < blocked)
+                return last - jumpPoint;
+            if (blocked < 64)
+                return NO_JUMP;
+        }
+    }
+
+    auto Pathfinder::jump(const GridPoint from, const std::int32_t dx, const std::int32_t dy, const GridPoint goal) const
+        -> std::optional<GridPoint>
+    {
+        const auto& rows = m_grid->rows();
+        const auto& columns = m_grid->columns();
+        if (dy == 0)
+        {
+            const std::int32_t x = scan(rows, from.y, from.x + dx, dx, goal.y == from.y ? goal.x : NO_JUMP);
+            return x == NO_JUMP ? std::nullopt : std::optional<GridPoint>({x, from.y});
+        }
+        if (dx == 0)
+        {
+            const std::int32_t y = scan(columns, from.x, from.y + dy, dy, goal.x == from.x ? goal.y : NO_JUMP);
+            return y == NO_JUMP ? std::nullopt : std::optional<GridPoint>({from.x, y});
+        }
+
+        // Diagonal: step until a straight scan from the current cell finds a jump point
+        GridPoint point = from;
+        for (;;)
+        {
+            if (!walkable(point.x + dx, point.y + dy) || !walkable(point.x + dx, point.y) ||
+                !walkable(point.x, point.y + dy))
+                return std::nullopt;
+            point = {point.x + dx, point.y + dy};
+            if (point == goal ||
+                scan(rows, point.y, point.x + dx, dx, goal.y == point.y ? goal.x : NO_JUMP) != NO_JUMP ||
+                scan(columns, point.x, point.y + dy, dy, goal.x == point.x ? goal.y : NO_JUMP) != NO_JUMP)
+                return point;
+        }
+    }
+
+    void Pathfinder::appendPath(const GridPoint goal, std::vector<GridPoint>& points) const
+    {
+        // Jump points are joined by straight or diagonal runs; count their cells, then fill them in from the goal
+        std::size_t count = 1;
+        for (std::uint32_t cell = cellIndex(goal); m_parent[cell] != NO_CELL; cell = m_parent[cell])
+        {
+            const GridPoint point = pointOf(cell);
+            const GridPoint parent = pointOf(m_parent[cell]);
+            count += static_cast<std::size_t>(std::max(std::abs(point.x - parent.x), std::abs(point.y - parent.y)));
+        }
+
+        const std::size_t first = points.size();
+        points.resize(first + count);
+        std::size_t index = first + count - 1;
+        GridPoint current = goal;
+        points[index] = current;
+        for (std::uint32_t cell = cellIndex(goal); m_parent[cell] != NO_CELL; cell = m_parent[cell])
+        {
+            const GridPoint parent = pointOf(m_parent[cell]);
+            const std::int32_t dx = sign(parent.x - current.x);
+            const std::int32_t dy = sign(parent.y - current.y);
+            while (current != parent)
+            {
+                current = {current.x + dx, current.y + dy};
+                points[--index] = current;
+            }
+        }
+    }
+}
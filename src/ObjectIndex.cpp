@@ -0,0 +1,193 @@
+#include <tmx/ObjectIndex.hpp>
+#include <cmath>
+
+namespace tmx::render
+{
+    namespace
+    {
+        // Cell of a coordinate along one axis, clamped to the grid; NaN lands in the first cell
+        auto cellCoordinate(const float value, const float origin, const float cellSize, const std::int32_t count)
+            -> std::int32_t
+        {
+            const double cell = std::floor((static_cast<double>(value) - origin) / cellSize);
+            if (!(cell >= 0.0))
+                return 0;
+            if (cell >= count - 1)
+                return count - 1;
+            return static_cast<std::int32_t>(cell);
+        }
+
+        void eraseSlot(std::vector<std::uint32_t>& slots, const std::uint32_t slot)
+        {
+            const auto it = std::find(slots.begin(), slots.end(), slot);
+            if (it == slots.end())
+                return;
+            *it = slots.back();
+            slots.pop_back();
+        }
+    }
+
+    ObjectIndex::ObjectIndex(const MapRenderData& renderData, const float cellSize)
+    {
+        build(renderData, cellSize);
+    }
+
+    void ObjectIndex::build(const MapRenderData& renderData, const float cellSize)
+    {
+        m_renderData = &renderData;
+        m_groupOffsets.assign(renderData.objectGroups.size() + 1, 0);
+        m_entries.clear();
+
+        // Bounds of every object, and of the map and all objects together
+        float minX = 0.0f, minY = 0.0f;
+        auto maxX = static_cast<float>(renderData.pixelWidth);
+        auto maxY = static_cast<float>(renderData.pixelHeight);
+        for (std::uint32_t groupIdx = 0; groupIdx < renderData.objectGroups.size(); ++groupIdx)
+        {
+            const auto& objects = renderData.objectGroups[groupIdx].objects;
+            for (std::uint32_t objectIdx = 0; objectIdx < objects.size(); ++objectIdx)
+            {
+                const ObjectBounds bounds = objectBounds(objects[objectIdx], renderData.objectPoints(objects[objectIdx]));
+                m_entries.push_back({bounds, {}, {groupIdx, objectIdx}});
+                if (std::isfinite(bounds.minX) && std::isfinite(bounds.minY) && std::isfinite(bounds.maxX) &&
+                    std::isfinite(bounds.maxY))
+                {
+                    minX = std::min(minX, bounds.minX);
+                    minY = std::min(minY, bounds.minY);
+                    maxX = std::max(maxX, bounds.maxX);
+                    maxY = std::max(maxY, bounds.maxY);
+                }
+            }
+            m_groupOffsets[groupIdx + 1] = static_cast<std::uint32_t>(m_entries.size());
+        }
+
+        // Cells four tiles wide by default, doubled until the grid fits in MAX_CELLS
+        m_cellSize = cellSize > 0.0f
+            ? cellSize
+            : 4.0f * static_cast<float>(std::max({renderData.tileWidth, renderData.tileHeight, 1u}));
+        m_originX = minX;
+        m_originY = minY;
+        for (;;)
+        {
+            const double columns = std::floor((static_cast<double>(maxX) - minX) / m_cellSize) + 1.0;
+            const double rows = std::floor((static_cast<double>(maxY) - minY) / m_cellSize) + 1.0;
+            if (columns * rows <= MAX_CELLS)
+            {
+                m_columns = static_cast<std::int32_t>(columns);
+                m_rows = static_cast<std::int32_t>(rows);
+                break;
+            }
+            m_cellSize *= 2.0f;
+        }
+
+        m_cells.assign(static_cast<std::size_t>(m_columns) * m_rows, {});
+        m_large.clear();
+        for (std::uint32_t slot = 0; slot < m_entries.size(); ++slot)
+            insert(slot);
+    }
+
+    void ObjectIndex::update(std::span<const ObjectRef> moved)
+    {
+        if (!m_renderData)
+            return;
+
+        for (const ObjectRef& ref : moved)
+        {
+            if (ref.objectGroupIndex + 1 >= m_groupOffsets.size() ||
+                ref.objectIndex >= m_groupOffsets[ref.objectGroupIndex + 1] - m_groupOffsets[ref.objectGroupIndex])
+                continue;
+
+            const std::uint32_t slot = m_groupOffsets[ref.objectGroupIndex] + ref.objectIndex;
+            Entry& entry = m_entries[slot];
+            const ObjectRenderInfo& object = m_renderData->objectGroups[ref.objectGroupIndex].objects[ref.objectIndex];
+            const ObjectBounds bounds = objectBounds(object, m_renderData->objectPoints(object));
+            const CellRect cells = cellsOf(bounds);
+            const std::uint32_t area = static_cast<std::uint32_t>(cells.maxX - cells.minX + 1) *
+                static_cast<std::uint32_t>(cells.maxY - cells.minY + 1);
+
+            // Objects keeping their cells, or staying in the large list, need no refiling
+            const bool large = entry.cells.minX == LARGE;
+            if ((large && area > MAX_OBJECT_CELLS) ||
+                (!large && cells.minX == entry.cells.minX && cells.minY == entry.cells.minY &&
+                 cells.maxX == entry.cells.maxX && cells.maxY == entry.cells.maxY))
+            {
+                entry.bounds = bounds;
+                continue;
+            }
+
+            remove(slot);
+            entry.bounds = bounds;
+            insert(slot);
+        }
+    }
+
+    void ObjectIndex::queryRect(const ViewRect& rect, std::vector<ObjectRef>& found) const
+    {
+        found.clear();
+        if (m_cells.empty())
+            return;
+        collect(cellsOf({rect.x, rect.y, rect.x + rect.width, rect.y + rect.height}),
+                [&](const ObjectBounds& bounds) { return bounds.intersects(rect); }, found);
+    }
+
+    void ObjectIndex::queryPoint(const float x, const float y, std::vector<ObjectRef>& found) const
+    {
+        found.clear();
+        if (m_cells.empty())
+            return;
+        collect(cellsOf({x, y, x, y}), [&](const ObjectBounds& bounds) { return bounds.contains(x, y); }, found);
+    }
+
+    void ObjectIndex::queryRadius(const float x, const float y, const float radius, std::vector<ObjectRef>& found) const
+    {
+        found.clear();
+        if (m_cells.empty() || !(radius >= 0.0f))
+            return;
+        collect(cellsOf({x - radius, y - radius, x + radius, y + radius}),
+                [&](const ObjectBounds& bounds) { return bounds.intersectsCircle(x, y, radius); }, found);
+    }
+
+    auto ObjectIndex::cellsOf(const ObjectBounds& bounds) const -> CellRect
+    {
+        return {cellCoordinate(bounds.minX, m_originX, m_cellSize, m_columns),
+                cellCoordinate(bounds.minY, m_originY, m_cellSize, m_rows),
+                cellCoordinate(bounds.maxX, m_originX, m_cellSize, m_columns),
+                cellCoordinate(bounds.maxY, m_originY, m_cellSize, m_rows)};
+    }
+
+    void ObjectIndex::insert(const std::uint32_t slot)
+    {
+        Entry& entry = m_entries[slot];
+        entry.cells = cellsOf(entry.bounds);
+        const std::uint32_t area = static_cast<std::uint32_t>(entry.cells.maxX - entry.cells.minX + 1) *
+            static_cast<std::uint32_t>(entry.cells.maxY - entry.cells.minY + 1);
+        if (area > MAX_OBJECT_CELLS)
+        {
+            entry.cells.minX = LARGE;
+            m_large.push_back(slot);
+            return;
+        }
+
+        for (std::int32_t y = entry.cells.minY; y <= entry.cells.maxY; ++y)
+        {
+            for (std::int32_t x = entry.cells.minX; x <= entry.cells.maxX; ++x)
+                m_cells[static_cast<std::size_t>(y) * m_columns + x].push_back(slot);
+        }
+    }
+
+    void ObjectIndex::remove(const std::uint32_t slot)
+    {
+        const Entry& entry = m_entries[slot];
+        if (entry.cells.minX == LARGE)
+        {
+            eraseSlot(m_large, slot);
+            return;
+        }
+
+        for (std::int32_t y = entry.cells.minY; y <= entry.cells.maxY; ++y)
+        {
+            for (std::int32_t x = entry.cells.minX; x <= entry.cells.maxX; ++x)
+                eraseSlot(m_cells[static_cast<std::size_t>(y) * m_columns + x], slot);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include "tmx/ObjectTable.hpp"
+
+namespace tmx::map
+{
+    auto ObjectTable::fromMap(const Map& map) -> ObjectTable
+    {
+        ObjectTable table;
+        std::size_t objectCount = 0;
+        for (const auto& group : map.objectgroups)
+            objectCount += group.objects.size();
+        table.reserve(objectCount, map.points.size());
+
+        for (const auto& group : map.objectgroups)
+        {
+            table.addGroup();
+            for (const auto& object : group.objects)
+                table.append(object, map.objectPoints(object));
+        }
+        return table;
+    }
+
+    void ObjectTable::addGroup()
+    {
+        if (m_groupStarts.empty())
+            m_groupStarts.push_back(size());
+        m_groupStarts.push_back(size());
+    }
+
+    auto ObjectTable::append(const Object& object, std::span<const Point> points) -> std::uint32_t
+    {
+        if (m_groupStarts.empty())
+            addGroup();
+
+        const std::uint32_t index = size();
+        m_ids.push_back(object.id);
+        m_x.push_back(object.x);
+        m_y.push_back(object.y);
+        m_widths.push_back(object.width);
+        m_heights.push_back(object.height);
+        m_rotations.push_back(object.rotation);
+        m_gids.push_back(object.gid);
+        m_shapes.push_back(object.shape);
+        m_visible.push_back(object.visible ? 1 : 0);
+
+        m_cold.push_back({object.name, object.type, static_cast<std::uint32_t>(m_points.size()),
+                          static_cast<std::uint32_t>(points.size()), object.properties});
+        m_points.insert(m_points.end(), points.begin(), points.end());
+
+        m_groupStarts.back() = size();
+        return index;
+    }
+
+    void ObjectTable::reserve(const std::size_t objectCount, const std::size_t pointCount)
+    {
+        m_ids.reserve(objectCount);
+        m_x.reserve(objectCount);
+        m_y.reserve(objectCount);
+        m_widths.reserve(objectCount);
+        m_heights.reserve(objectCount);
+        m_rotations.reserve(objectCount);
+        m_gids.reserve(objectCount);
+        m_shapes.reserve(objectCount);
+        m_visible.reserve(objectCount);
+        m_cold.reserve(objectCount);
+        m_points.reserve(pointCount);
+    }
+
+    void ObjectTable::clear()
+    {
+        m_ids.clear();
+        m_x.clear();
+        m_y.clear();
+        m_widths.clear();
+        m_heights.clear();
+        m_rotations.clear();
+        m_gids.clear();
+        m_shapes.clear();
+        m_visible.clear();
+        m_cold.clear();
+        m_points.clear();
+        m_groupStarts.clear();
+    }
+
+    auto ObjectTable::toObject(const std::uint32_t index) const -> Object
+    {
+        const auto& cold = m_cold[index];
+        Object object;
+        object.id = m_ids[index];
+        object.name = cold.name;
+        object.type = cold.type;
+        object.x = m_x[index];
+        object.y = m_y[index];
+        object.width = m_widths[index];
+        object.height = m_heights[index];
+        object.rotation = m_rotations[index];
+        object.visible = m_visible[index] != 0;
+        object.shape = m_shapes[index];
+        object.firstPoint = cold.firstPoint;
+        object.pointCount = cold.pointCount;
+        object.gid = m_gids[index];
+        object.properties = cold.properties;
+        return object;
+    }
+}
@@ -1,4 +1,6 @@
 #include "tmx/Parser.hpp"
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <sstream>
 #include <zlib.h>
@@ -7,6 +9,29 @@
 
 namespace tmx
 {
+    namespace
+    {
+        // Attributes shared by tile layers, object groups, image layers and groups
+        template <typename Layer>
+        void parseLayerAttributes(const pugi::xml_node& layerNode, Layer& layer)
+        {
+            layer.name = layerNode.attribute("name").as_string();
+            layer.visible = layerNode.attribute("visible").as_bool(true);
+            layer.opacity = layerNode.attribute("opacity").as_float(1.0f);
+            layer.offsetx = layerNode.attribute("offsetx").as_float(0.0f);
+            layer.offsety = layerNode.attribute("offsety").as_float(0.0f);
+            layer.parallaxx = layerNode.attribute("parallaxx").as_float(1.0f);
+            layer.parallaxy = layerNode.attribute("parallaxy").as_float(1.0f);
+            if (const auto tintAttr = layerNode.attribute("tintcolor"))
+            {
+                if (auto colorResult = map::Color::fromArgbString(tintAttr.as_string()))
+                {
+                    layer.tintcolor = *colorResult;
+                }
+            }
+        }
+    }
+
     auto Parser::parseFromFile(const std::filesystem::path& path) -> tl::expected<map::Map, std::string>
     {
         std::ifstream file(path);
@@ -36,7 +61,7 @@ namespace tmx
         return parseMap(mapNode, path.parent_path());
     }
 
-    auto Parser::parseFromString(const std::string& xml) -> tl::expected<map::Map, std::string>
+    auto Parser::parseFromString(const std::string& xml, const std::filesystem::path& basePath) -> tl::expected<map::Map, std::string>
     {
         pugi::xml_document doc;
         const pugi::xml_parse_result result = doc.load_string(xml.c_str());
@@ -52,7 +77,7 @@ namespace tmx
             return tl::make_unexpected("No 'map' element found in XML");
         }
 
-        return parseMap(mapNode, "");
+        return parseMap(mapNode, basePath);
     }
 
     auto Parser::parseMap(const pugi::xml_node& mapNode, const std::filesystem::path& basePath) -> tl::expected<map::Map, std::string>
@@ -68,6 +93,9 @@ namespace tmx
         map.height = mapNode.attribute("height").as_uint();
         map.tilewidth = mapNode.attribute("tilewidth").as_uint();
         map.tileheight = mapNode.attribute("tileheight").as_uint();
+        map.staggeraxis = parseStaggerAxis(mapNode.attribute("staggeraxis").as_string("y"));
+        map.staggerindex = parseStaggerIndex(mapNode.attribute("staggerindex").as_string("odd"));
+        map.hexsidelength = mapNode.attribute("hexsidelength").as_uint();
         map.infinite = mapNode.attribute("infinite").as_bool();
         map.nextlayerid = mapNode.attribute("nextlayerid").as_uint(1);
         map.nextobjectid = mapNode.attribute("nextobjectid").as_uint(1);
@@ -99,29 +127,81 @@ namespace tmx
             map.tilesets.push_back(*tilesetResult);
         }
 
-        // Parse layers
-        for (auto layerNode : mapNode.children("layer"))
+        // Parse tile, object and image layers in document order, descending into groups
+        if (auto layersResult = parseLayers(mapNode, map, -1); !layersResult)
         {
-            auto layerResult = parseLayer(layerNode);
-            if (!layerResult)
-            {
-                return tl::make_unexpected(layerResult.error());
-            }
-            map.layers.push_back(*layerResult);
+            return tl::make_unexpected(layersResult.error());
         }
 
-        // Parse objectgroups
-        for (auto objectGroupNode : mapNode.children("objectgroup"))
+        return map;
+    }
+
+    auto Parser::parseLayers(const pugi::xml_node& parentNode, map::Map& map, const std::int32_t group)
+        -> tl::expected<void, std::string>
+    {
+        for (auto node : parentNode.children())
         {
-            auto objectGroupResult = parseObjectGroup(objectGroupNode);
-            if (!objectGroupResult)
+            const std::string_view name = node.name();
+            if (name == "layer")
             {
-                return tl::make_unexpected(objectGroupResult.error());
+                auto layerResult = parseLayer(node);
+                if (!layerResult)
+                {
+                    return tl::make_unexpected(layerResult.error());
+                }
+                layerResult->group = group;
+                map.layerOrder.push_back({map::LayerKind::Tile, static_cast<std::uint32_t>(map.layers.size())});
+                map.layers.push_back(std::move(*layerResult));
+            }
+            else if (name == "objectgroup")
+            {
+                auto objectGroupResult = parseObjectGroup(node, map.points);
+                if (!objectGroupResult)
+                {
+                    return tl::make_unexpected(objectGroupResult.error());
+                }
+                objectGroupResult->group = group;
+                map.layerOrder.push_back({map::LayerKind::Object, static_cast<std::uint32_t>(map.objectgroups.size())});
+                map.objectgroups.push_back(std::move(*objectGroupResult));
+            }
+            else if (name == "imagelayer")
+            {
+                map::ImageLayer imageLayer;
+                parseLayerAttributes(node, imageLayer);
+                imageLayer.group = group;
+                imageLayer.repeatx = node.attribute("repeatx").as_bool(false);
+                imageLayer.repeaty = node.attribute("repeaty").as_bool(false);
+                if (const auto imageNode = node.child("image"))
+                {
+                    imageLayer.image = imageNode.attribute("source").as_string();
+                    imageLayer.imagewidth = imageNode.attribute("width").as_uint();
+                    imageLayer.imageheight = imageNode.attribute("height").as_uint();
+                }
+                if (const auto propertiesNode = node.child("properties"))
+                {
+                    imageLayer.properties = parseProperties(propertiesNode);
+                }
+                map.layerOrder.push_back({map::LayerKind::Image, static_cast<std::uint32_t>(map.imagelayers.size())});
+                map.imagelayers.push_back(std::move(imageLayer));
+            }
+            else if (name == "group")
+            {
+                map::Group groupLayer;
+                parseLayerAttributes(node, groupLayer);
+                groupLayer.group = group;
+                if (const auto propertiesNode = node.child("properties"))
+                {
+                    groupLayer.properties = parseProperties(propertiesNode);
+                }
+                const auto index = static_cast<std::int32_t>(map.groups.size());
+                map.groups.push_back(std::move(groupLayer));
+                if (auto groupResult = parseLayers(node, map, index); !groupResult)
+                {
+                    return groupResult;
+                }
             }
-            map.objectgroups.push_back(*objectGroupResult);
         }
-
-        return map;
+        return {};
     }
 
     auto Parser::parseTileset(const pugi::xml_node& tilesetNode, const std::filesystem::path& basePath) -> tl::expected<map::Tileset, std::string>
@@ -170,15 +250,10 @@ namespace tmx
             tileset.properties = parseProperties(propertiesNode);
         }
 
-        // Parse tiles (with animations or properties)
-        for (auto tileNode : tilesetNode.children("tile"))
+        // Parse tiles (with animations, properties or collision shapes)
+        if (auto tilesResult = parseTiles(tilesetNode, tileset); !tilesResult)
         {
-            auto tileResult = parseTile(tileNode);
-            if (!tileResult)
-            {
-                return tl::make_unexpected(tileResult.error());
-            }
-            tileset.tiles.push_back(*tileResult);
+            return tl::make_unexpected(tilesResult.error());
         }
 
         return tileset;
@@ -188,11 +263,9 @@ namespace tmx
     {
         map::Layer layer;
 
-        layer.name = layerNode.attribute("name").as_string();
+        parseLayerAttributes(layerNode, layer);
         layer.width = layerNode.attribute("width").as_uint();
         layer.height = layerNode.attribute("height").as_uint();
-        layer.visible = layerNode.attribute("visible").as_bool(true);
-        layer.opacity = layerNode.attribute("opacity").as_float(1.0f);
 
         // Parse properties
         if (const auto propertiesNode = layerNode.child("properties"))
@@ -232,13 +305,12 @@ namespace tmx
         return layer;
     }
 
-    auto Parser::parseObjectGroup(const pugi::xml_node& objectGroupNode) -> tl::expected<map::ObjectGroup, std::string>
+    auto Parser::parseObjectGroup(const pugi::xml_node& objectGroupNode, std::vector<map::Point>& points) -> tl::expected<map::ObjectGroup, std::string>
     {
         map::ObjectGroup objectGroup;
 
-        objectGroup.name = objectGroupNode.attribute("name").as_string();
-        objectGroup.visible = objectGroupNode.attribute("visible").as_bool(true);
-        objectGroup.opacity = objectGroupNode.attribute("opacity").as_float(1.0f);
+        parseLayerAttributes(objectGroupNode, objectGroup);
+        objectGroup.draworder = parseDrawOrder(objectGroupNode.attribute("draworder").as_string("topdown"));
 
         // Parse properties
         if (const auto propertiesNode = objectGroupNode.child("properties"))
@@ -249,7 +321,7 @@ namespace tmx
         // Parse objects
         for (auto objectNode : objectGroupNode.children("object"))
         {
-            auto objectResult = parseObject(objectNode);
+            auto objectResult = parseObject(objectNode, points);
             if (!objectResult)
             {
                 return tl::make_unexpected(objectResult.error());
@@ -260,7 +332,7 @@ namespace tmx
         return objectGroup;
     }
 
-    auto Parser::parseObject(const pugi::xml_node& objectNode) -> tl::expected<map::Object, std::string>
+    auto Parser::parseObject(const pugi::xml_node& objectNode, std::vector<map::Point>& points) -> tl::expected<map::Object, std::string>
     {
         map::Object object;
 
@@ -284,57 +356,16 @@ namespace tmx
         {
             object.shape = map::ObjectShape::Ellipse;
         }
-        else if (auto polygonNode = objectNode.child("polygon"))
+        else if (const auto shapeNode = objectNode.child("polygon") ? objectNode.child("polygon") : objectNode.child("polyline"))
         {
-            object.shape = map::ObjectShape::Polygon;
-            // Parse polygon points
-            std::string pointsStr = polygonNode.attribute("points").as_string();
-            std::stringstream ss(pointsStr);
-            std::string pair;
-            while (std::getline(ss, pair, ' '))
+            object.shape = std::string_view(shapeNode.name()) == "polygon" ? map::ObjectShape::Polygon : map::ObjectShape::Polyline;
+            object.firstPoint = static_cast<std::uint32_t>(points.size());
+            auto pointsResult = parsePoints(shapeNode.attribute("points").as_string(), points);
+            if (!pointsResult)
             {
-                size_t commaPos = pair.find(',');
-                if (commaPos != std::string::npos)
-                {
-                    try
-                    {
-                        map::Point point;
-                        point.x = std::stof(pair.substr(0, commaPos));
-                        point.y = std::stof(pair.substr(commaPos + 1));
-                        object.points.push_back(point);
-                    }
-                    catch (...)
-                    {
-                        return tl::make_unexpected("Failed to parse polygon points");
-                    }
-                }
-            }
-        }
-        else if (auto polylineNode = objectNode.child("polyline"))
-        {
-            object.shape = map::ObjectShape::Polyline;
-            // Parse polyline points
-            std::string pointsStr = polylineNode.attribute("points").as_string();
-            std::stringstream ss(pointsStr);
-            std::string pair;
-            while (std::getline(ss, pair, ' '))
-            {
-                size_t commaPos = pair.find(',');
-                if (commaPos != std::string::npos)
-                {
-                    try
-                    {
-                        map::Point point;
-                        point.x = std::stof(pair.substr(0, commaPos));
-                        point.y = std::stof(pair.substr(commaPos + 1));
-                        object.points.push_back(point);
-                    }
-                    catch (...)
-                    {
-                        return tl::make_unexpected("Failed to parse polyline points");
-                    }
-                }
+                return tl::make_unexpected("Object " + std::to_string(object.id) + ": " + pointsResult.error());
             }
+            object.pointCount = *pointsResult;
         }
         else if (objectNode.child("text"))
         {
@@ -355,6 +386,40 @@ namespace tmx
         return object;
     }
 
+    auto Parser::parsePoints(std::string_view text, std::vector<map::Point>& points) -> tl::expected<std::uint32_t, std::string>
+    {
+        const std::size_t first = points.size();
+        const char* cursor = text.data();
+        const char* const end = text.data() + text.size();
+        const auto skipSpace = [&]
+        {
+            while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+                ++cursor;
+        };
+        const auto fail = [&]
+        {
+            points.resize(first);
+            return tl::make_unexpected("Invalid point list at offset " + std::to_string(cursor - text.data()));
+        };
+
+        for (skipSpace(); cursor != end; skipSpace())
+        {
+            map::Point point;
+            auto [xEnd, xError] = std::from_chars(cursor, end, point.x);
+            if (xError != std::errc() || xEnd == end || *xEnd != ',')
+                return fail();
+            cursor = xEnd + 1;
+            auto [yEnd, yError] = std::from_chars(cursor, end, point.y);
+            if (yError != std::errc())
+                return fail();
+            cursor = yEnd;
+            if (cursor != end && *cursor != ' ' && *cursor != '\t' && *cursor != '\n' && *cursor != '\r')
+                return fail();
+            points.push_back(point);
+        }
+        return static_cast<std::uint32_t>(points.size() - first);
+    }
+
     auto Parser::parseProperties(const pugi::xml_node& propertiesNode) -> map::Properties
     {
         map::Properties properties;
@@ -388,17 +453,43 @@ namespace tmx
         return map::RenderOrder::RightDown;
     }
 
+    auto Parser::parseDrawOrder(const std::string& str) -> map::DrawOrder
+    {
+        if (str == "index") return map::DrawOrder::Index;
+        return map::DrawOrder::TopDown;
+    }
+
+    auto Parser::parseStaggerAxis(const std::string& str) -> map::StaggerAxis
+    {
+        if (str == "x") return map::StaggerAxis::X;
+        return map::StaggerAxis::Y;
+    }
+
+    auto Parser::parseStaggerIndex(const std::string& str) -> map::StaggerIndex
+    {
+        if (str == "even") return map::StaggerIndex::Even;
+        return map::StaggerIndex::Odd;
+    }
+
     auto Parser::parseData(const pugi::xml_node& dataNode, std::uint32_t width, std::uint32_t height)
         -> tl::expected<std::vector<std::uint32_t>, std::string>
+    {
+        return decodeTileData(dataNode.text().as_string(), dataNode.attribute("encoding").as_string(),
+                              dataNode.attribute("compression").as_string(), width, height);
+    }
+
+    auto Parser::decodeTileData(std::string_view text, std::string_view encodingName, std::string_view compressionName,
+                                std::uint32_t width, std::uint32_t height)
+        -> tl::expected<std::vector<std::uint32_t>, std::string>
     {
         std::vector<std::uint32_t> data;
-        std::string encoding = dataNode.attribute("encoding").as_string();
-        std::string compression = dataNode.attribute("compression").as_string();
+        const std::string encoding(encodingName);
+        const std::string compression(compressionName);
 
         if (encoding == "csv")
         {
             // Parse CSV data
-            std::string csvData = dataNode.text().as_string();
+            std::string csvData(text);
             std::stringstream ss(csvData);
             std::string cell;
 
@@ -417,7 +508,7 @@ namespace tmx
         else if (encoding == "base64")
         {
             // Parse base64 encoded data
-            std::string base64Data = dataNode.text().as_string();
+            std::string base64Data(text);
 
             // Remove whitespace
             std::erase_if(base64Data, ::isspace);
@@ -543,22 +634,15 @@ namespace tmx
         chunk.width = chunkNode.attribute("width").as_uint();
         chunk.height = chunkNode.attribute("height").as_uint();
 
-        // Parse CSV data from chunk text content
-        std::string csvData = chunkNode.text().as_string();
-        std::stringstream ss(csvData);
-        std::string cell;
-
-        while (std::getline(ss, cell, ','))
+        // Chunk text uses the encoding of the enclosing <data> element
+        const auto dataNode = chunkNode.parent();
+        auto dataResult = decodeTileData(chunkNode.text().as_string(), dataNode.attribute("encoding").as_string("csv"),
+                                         dataNode.attribute("compression").as_string(), chunk.width, chunk.height);
+        if (!dataResult)
         {
-            try
-            {
-                chunk.data.push_back(static_cast<std::uint32_t>(std::stoul(cell)));
-            }
-            catch (...)
-            {
-                return tl::make_unexpected("Failed to parse chunk CSV data");
-            }
+            return tl::make_unexpected("Failed to parse chunk data: " + dataResult.error());
         }
+        chunk.data = std::move(*dataResult);
 
         return chunk;
     }
@@ -611,25 +695,78 @@ namespace tmx
             tileset.properties = parseProperties(propertiesNode);
         }
 
-        // Parse tiles (with animations or properties)
+        // Parse tiles (with animations, properties or collision shapes)
+        if (auto tilesResult = parseTiles(tilesetNode, tileset); !tilesResult)
+        {
+            return tl::make_unexpected(tilesResult.error());
+        }
+
+        return tileset;
+    }
+
+    auto Parser::parseTiles(const pugi::xml_node& tilesetNode, map::Tileset& tileset) -> tl::expected<void, std::string>
+    {
+        // Shapes are parsed in document order; shapeTiles[i] is the tile owning shapes[i]
+        std::vector<std::uint32_t> shapeTiles;
         for (auto tileNode : tilesetNode.children("tile"))
         {
-            auto tileResult = parseTile(tileNode);
+            auto tileResult = parseTile(tileNode, tileset.shapes, tileset.shapePoints);
             if (!tileResult)
             {
                 return tl::make_unexpected(tileResult.error());
             }
-            tileset.tiles.push_back(*tileResult);
+            shapeTiles.resize(tileset.shapes.size(), tileResult->id);
+            tileset.tiles.push_back(std::move(*tileResult));
+        }
+        if (tileset.shapes.empty())
+        {
+            return {};
         }
 
-        return tileset;
+        // Index the shapes by local tile ID, reordering them with a counting sort if tiles were out of order
+        const std::uint32_t tileEnd = *std::ranges::max_element(shapeTiles) + 1;
+        tileset.shapeOffsets.assign(tileEnd + 1, 0);
+        for (const std::uint32_t tile : shapeTiles)
+        {
+            ++tileset.shapeOffsets[tile + 1];
+        }
+        for (std::uint32_t tile = 0; tile < tileEnd; ++tile)
+        {
+            tileset.shapeOffsets[tile + 1] += tileset.shapeOffsets[tile];
+        }
+        if (!std::ranges::is_sorted(shapeTiles))
+        {
+            std::vector<map::Object> sorted(tileset.shapes.size());
+            std::vector<std::uint32_t> next(tileset.shapeOffsets.begin(), tileset.shapeOffsets.end() - 1);
+            for (std::size_t i = 0; i < shapeTiles.size(); ++i)
+            {
+                sorted[next[shapeTiles[i]]++] = std::move(tileset.shapes[i]);
+            }
+            tileset.shapes = std::move(sorted);
+        }
+        return {};
     }
 
-    auto Parser::parseTile(const pugi::xml_node& tileNode) -> tl::expected<map::Tile, std::string>
+    auto Parser::parseTile(const pugi::xml_node& tileNode, std::vector<map::Object>& shapes,
+                           std::vector<map::Point>& points) -> tl::expected<map::Tile, std::string>
     {
         map::Tile tile{};
         tile.id = tileNode.attribute("id").as_uint();
 
+        // Parse collision shapes, which Tiled stores as an object group positioned within the tile
+        if (const auto objectGroupNode = tileNode.child("objectgroup"))
+        {
+            for (auto objectNode : objectGroupNode.children("object"))
+            {
+                auto shapeResult = parseObject(objectNode, points);
+                if (!shapeResult)
+                {
+                    return tl::make_unexpected("Tile " + std::to_string(tile.id) + ": " + shapeResult.error());
+                }
+                shapes.push_back(std::move(*shapeResult));
+            }
+        }
+
         // Parse properties
         if (const auto propertiesNode = tileNode.child("properties"))
         {
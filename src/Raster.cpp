@@ -0,0 +1,596 @@
+#include <tmx/Raster.hpp>
+#include <tmx/AnimationClock.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TMX_RASTER_SSE2 1
+#endif
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+namespace tmx::raster
+{
+    namespace
+    {
+        // Rows per band; bands are the unit of work handed to threads
+        constexpr std::uint32_t BAND_ROWS = 64;
+
+        // x / 255 rounded to nearest, exact for every product of two bytes
+        constexpr auto div255(const std::uint32_t x) -> std::uint32_t
+        {
+            const std::uint32_t rounded = x + 128;
+            return (rounded + (rounded >> 8)) >> 8;
+        }
+
+        void premultiply(Image& image)
+        {
+            for (std::size_t i = 0; i < image.pixels.size(); i += 4)
+            {
+                const std::uint32_t alpha = image.pixels[i + 3];
+                for (std::size_t c = 0; c < 3; ++c)
+                    image.pixels[i + c] = static_cast<std::uint8_t>(div255(image.pixels[i + c] * alpha));
+            }
+        }
+
+        void unpremultiply(Image& image)
+        {
+            for (std::size_t i = 0; i < image.pixels.size(); i += 4)
+            {
+                const std::uint32_t alpha = image.pixels[i + 3];
+                if (alpha == 255)
+                    continue;
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    image.pixels[i + c] = alpha == 0 ? 0 : static_cast<std::uint8_t>(
+                        std::min<std::uint32_t>((image.pixels[i + c] * 255u + alpha / 2) / alpha, 255));
+                }
+            }
+        }
+
+        auto resolveThreadCount(const std::uint32_t threadCount) -> std::uint32_t
+        {
+            return threadCount != 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        // Run fn(0) .. fn(count - 1) on up to threadCount threads, the calling thread included
+        template <typename Fn>
+        void parallelFor(const std::size_t count, const std::uint32_t threadCount, Fn&& fn)
+        {
+            const auto workers = std::min<std::size_t>(threadCount, count);
+            std::atomic<std::size_t> next{0};
+            auto work = [&]
+            {
+                for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                     i = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    fn(i);
+                }
+            };
+
+            std::vector<std::jthread> threads;
+            threads.reserve(workers > 1 ? workers - 1 : 0);
+            for (std::size_t t = 1; t < workers; ++t)
+                threads.emplace_back(work);
+            work();
+        }
+
+        // Half-open range of output pixels along one axis
+        struct PixelRange
+        {
+            std::int64_t begin, end;
+
+            [[nodiscard]] auto size() const -> std::int64_t { return std::max<std::int64_t>(end - begin, 0); }
+        };
+
+        // Output image being drawn; pixel centers are sampled, so every pixel shows exactly one map position
+        struct Canvas
+        {
+            std::uint8_t* pixels; // Premultiplied RGBA
+            std::uint32_t width, height;
+            double originX, originY; // Map position of the image's top-left corner
+            double scale; // Output pixels per map pixel
+
+            [[nodiscard]] auto mapX(const std::int64_t px) const -> double { return originX + (px + 0.5) / scale; }
+            [[nodiscard]] auto mapY(const std::int64_t py) const -> double { return originY + (py + 0.5) / scale; }
+
+            // Pixels whose centers lie in [start, start + size) of the map, clipped to [low, high)
+            [[nodiscard]] auto pixelsOf(const double start, const double size, const double origin,
+                                        const std::int64_t low, const std::int64_t high) const -> PixelRange
+            {
+                const auto begin = static_cast<std::int64_t>(std::ceil((start - origin) * scale - 0.5));
+                const auto end = static_cast<std::int64_t>(std::ceil((start + size - origin) * scale - 0.5));
+                return {std::clamp(begin, low, high), std::clamp(end, low, high)};
+            }
+
+            [[nodiscard]] auto row(const std::int64_t py) const -> std::uint8_t*
+            {
+                return pixels + static_cast<std::size_t>(py) * width * 4;
+            }
+        };
+
+        // Per-band buffers reused for every tile and object of the band
+        struct Scratch
+        {
+            std::vector<std::uint32_t> columns; // Source offset along the tile's local x axis, per output column
+            std::vector<std::uint8_t> pixels; // Gathered source pixels of one output row
+            std::vector<render::ChunkRange> ranges; // Chunks overlapping the band
+        };
+
+        // Tile object with its transform resolved once per render
+        struct PreparedObject
+        {
+            const Image* image;
+            std::uint32_t srcX, srcY, srcW, srcH;
+            std::uint8_t flipFlags;
+            std::uint32_t opacity; // 1/256 steps
+            double x, y; // Bottom-left corner, the rotation origin
+            double width, height;
+            double cos, sin;
+            double minX, minY, maxX, maxY; // Bounding box in map pixels
+        };
+
+        auto toOpacity(const float opacity) -> std::uint32_t
+        {
+            return static_cast<std::uint32_t>(std::lround(std::clamp(opacity, 0.0f, 1.0f) * 256.0f));
+        }
+
+        // Draw a tile at its destination moved by its layer's offset
+        void drawTile(const Canvas& canvas, const PixelRange& band, const render::TileRenderInfo& tile,
+                      const double offsetX, const double offsetY, const Image& image, const std::uint32_t srcX,
+                      const std::uint32_t srcY, Scratch& scratch)
+        {
+            if (tile.destW == 0 || tile.destH == 0 || tile.srcW == 0 || tile.srcH == 0 ||
+                srcX + tile.srcW > image.width || srcY + tile.srcH > image.height)
+            {
+                return;
+            }
+
+            const double destX = tile.destX + offsetX, destY = tile.destY + offsetY;
+            const PixelRange columns = canvas.pixelsOf(destX, tile.destW, canvas.originX, 0, canvas.width);
+            const PixelRange rows = canvas.pixelsOf(destY, tile.destH, canvas.originY, band.begin, band.end);
+            const auto count = static_cast<std::size_t>(columns.size());
+            if (count == 0 || rows.size() == 0)
+                return;
+
+            // Undo the vertical, horizontal, then diagonal flip to find the source pixel of each output pixel
+            const bool flipH = tile.flipFlags & render::TILE_FLIP_HORIZONTAL;
+            const bool flipV = tile.flipFlags & render::TILE_FLIP_VERTICAL;
+            const bool diagonal = tile.flipFlags & render::TILE_FLIP_DIAGONAL;
+            const std::int64_t lastX = tile.destW - 1, lastY = tile.destH - 1;
+
+            scratch.columns.resize(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const double mapX = canvas.mapX(columns.begin + static_cast<std::int64_t>(i));
+                std::int64_t lx = std::clamp<std::int64_t>(static_cast<std::int64_t>(std::floor(mapX - destX)), 0, lastX);
+                lx = flipH ? lastX - lx : lx;
+                scratch.columns[i] = static_cast<std::uint32_t>(lx * (diagonal ? tile.srcH : tile.srcW) / tile.destW);
+            }
+            const bool contiguous = !diagonal && scratch.columns.back() - scratch.columns.front() == count - 1 &&
+                scratch.columns.back() >= scratch.columns.front();
+
+            const std::uint32_t opacity = toOpacity(tile.opacity);
+            scratch.pixels.resize(count * 4);
+            for (std::int64_t py = rows.begin; py < rows.end; ++py)
+            {
+                std::int64_t ly = std::clamp<std::int64_t>(
+                    static_cast<std::int64_t>(std::floor(canvas.mapY(py) - destY)), 0, lastY);
+                ly = flipV ? lastY - ly : ly;
+
+                std::uint8_t* dst = canvas.row(py) + static_cast<std::size_t>(columns.begin) * 4;
+                if (!diagonal)
+                {
+                    const std::uint8_t* srcRow = image.pixel(srcX, srcY + static_cast<std::uint32_t>(ly * tile.srcH / tile.destH));
+                    if (contiguous)
+                    {
+                        blendRow(dst, srcRow + static_cast<std::size_t>(scratch.columns[0]) * 4, count, opacity);
+                        continue;
+                    }
+                    for (std::size_t i = 0; i < count; ++i)
+                        std::memcpy(&scratch.pixels[i * 4], srcRow + static_cast<std::size_t>(scratch.columns[i]) * 4, 4);
+                }
+                else
+                {
+                    const std::uint32_t sx = srcX + static_cast<std::uint32_t>(ly * tile.srcW / tile.destH);
+                    for (std::size_t i = 0; i < count; ++i)
+                        std::memcpy(&scratch.pixels[i * 4], image.pixel(sx, srcY + scratch.columns[i]), 4);
+                }
+                blendRow(dst, scratch.pixels.data(), count, opacity);
+            }
+        }
+
+        void drawObject(const Canvas& canvas, const PixelRange& band, const PreparedObject& object, Scratch& scratch)
+        {
+            const PixelRange columns = canvas.pixelsOf(object.minX, object.maxX - object.minX, canvas.originX, 0,
+                                                       canvas.width);
+            const PixelRange rows = canvas.pixelsOf(object.minY, object.maxY - object.minY, canvas.originY, band.begin,
+                                                    band.end);
+            const auto count = static_cast<std::size_t>(columns.size());
+            if (count == 0 || rows.size() == 0)
+                return;
+
+            scratch.pixels.resize(count * 4);
+            for (std::int64_t py = rows.begin; py < rows.end; ++py)
+            {
+                const double dy = canvas.mapY(py) - object.y;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    // Rotate back into the object's frame, where it spans [0, width) x [-height, 0)
+                    const double dx = canvas.mapX(columns.begin + static_cast<std::int64_t>(i)) - object.x;
+                    double s = (dx * object.cos + dy * object.sin) / object.width;
+                    double t = (dy * object.cos - dx * object.sin) / object.height + 1.0;
+                    std::uint8_t* out = &scratch.pixels[i * 4];
+                    if (s < 0.0 || s >= 1.0 || t < 0.0 || t >= 1.0)
+                    {
+                        std::memset(out, 0, 4);
+                        continue;
+                    }
+
+                    t = object.flipFlags & render::TILE_FLIP_VERTICAL ? 1.0 - t : t;
+                    s = object.flipFlags & render::TILE_FLIP_HORIZONTAL ? 1.0 - s : s;
+                    if (object.flipFlags & render::TILE_FLIP_DIAGONAL)
+                        std::swap(s, t);
+                    const auto sx = std::min(static_cast<std::uint32_t>(s * object.srcW), object.srcW - 1);
+                    const auto sy = std::min(static_cast<std::uint32_t>(t * object.srcH), object.srcH - 1);
+                    std::memcpy(out, object.image->pixel(object.srcX + sx, object.srcY + sy), 4);
+                }
+                blendRow(canvas.row(py) + static_cast<std::size_t>(columns.begin) * 4, scratch.pixels.data(), count,
+                         object.opacity);
+            }
+        }
+    }
+
+    auto drawnBounds(const render::LayerRenderData& layer, const render::RenderBounds& bounds) -> render::RenderBounds
+    {
+        const float offsetX = layer.transform.offsetX, offsetY = layer.transform.offsetY;
+        if (bounds.isEmpty() || (offsetX == 0.0f && offsetY == 0.0f))
+            return bounds;
+        return {static_cast<std::int32_t>(std::floor(bounds.minX + offsetX)),
+                static_cast<std::int32_t>(std::floor(bounds.minY + offsetY)),
+                static_cast<std::int32_t>(std::ceil(bounds.maxX + offsetX)),
+                static_cast<std::int32_t>(std::ceil(bounds.maxY + offsetY))};
+    }
+
+    auto loadImage(const std::string& path) -> tl::expected<Image, std::string>
+    {
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        if (!data)
+            return tl::make_unexpected("Failed to load image '" + path + "': " + stbi_failure_reason());
+
+        Image image;
+        image.width = static_cast<std::uint32_t>(width);
+        image.height = static_cast<std::uint32_t>(height);
+        image.pixels.assign(data, data + static_cast<std::size_t>(width) * height * 4);
+        stbi_image_free(data);
+        return image;
+    }
+
+    auto writePng(const Image& image, const std::string& path) -> tl::expected<void, std::string>
+    {
+        if (image.isEmpty() || image.pixels.size() != static_cast<std::size_t>(image.width) * image.height * 4)
+            return tl::make_unexpected("Cannot write an empty or malformed image to '" + path + "'");
+        if (!stbi_write_png(path.c_str(), static_cast<int>(image.width), static_cast<int>(image.height), 4,
+                            image.pixels.data(), static_cast<int>(image.width * 4)))
+        {
+            return tl::make_unexpected("Failed to write PNG '" + path + "'");
+        }
+        return {};
+    }
+
+    auto composeAtlas(const render::MapRenderData& renderData, const render::TextureAtlas& atlas)
+        -> tl::expected<std::vector<Image>, std::string>
+    {
+        // Load only the source images some page uses
+        std::vector<Image> sourceImages(atlas.sourceTilesets.size());
+        for (const auto& page : atlas.pages)
+        {
+            for (const auto& tile : page.tiles)
+            {
+                const auto& source = atlas.sourceTilesets[tile.tilesetIndex];
+                if (!sourceImages[tile.tilesetIndex].isEmpty() || source.imagePath.empty())
+                    continue;
+
+                auto image = loadImage(source.imagePath);
+                if (!image)
+                    return tl::make_unexpected("Tileset '" + source.name + "': " + image.error());
+                sourceImages[tile.tilesetIndex] = std::move(*image);
+            }
+        }
+
+        std::vector<Image> pages(atlas.pages.size());
+        const auto extrusion = static_cast<std::int64_t>(atlas.extrusion);
+        for (std::size_t pageIndex = 0; pageIndex < atlas.pages.size() && pageIndex < renderData.tilesets.size(); ++pageIndex)
+        {
+            const auto& pageInfo = renderData.tilesets[pageIndex];
+            auto& page = pages[pageIndex];
+            page.width = pageInfo.imageWidth;
+            page.height = pageInfo.imageHeight;
+            page.pixels.assign(static_cast<std::size_t>(page.width) * page.height * 4, 0);
+
+            const auto tileWidth = static_cast<std::int64_t>(pageInfo.tileWidth);
+            const auto tileHeight = static_cast<std::int64_t>(pageInfo.tileHeight);
+            const auto& tiles = atlas.pages[pageIndex].tiles;
+            for (std::uint32_t slot = 0; slot < tiles.size(); ++slot)
+            {
+                const auto& source = atlas.sourceTilesets[tiles[slot].tilesetIndex];
+                const Image& image = sourceImages[tiles[slot].tilesetIndex];
+                const std::uint32_t srcX = source.srcXOf(tiles[slot].tileId);
+                const std::uint32_t srcY = source.srcYOf(tiles[slot].tileId);
+                const std::int64_t dstX = pageInfo.srcXOf(slot);
+                const std::int64_t dstY = pageInfo.srcYOf(slot);
+
+                // Every pixel of the extruded square copies the nearest pixel of the tile
+                for (std::int64_t y = -extrusion; y < tileHeight + extrusion; ++y)
+                {
+                    const std::uint32_t sy = srcY + static_cast<std::uint32_t>(std::clamp<std::int64_t>(y, 0, tileHeight - 1));
+                    if (sy >= image.height)
+                        continue;
+
+                    std::uint8_t* out = page.pixels.data() + (static_cast<std::size_t>(dstY + y) * page.width + dstX) * 4;
+                    for (std::int64_t x = -extrusion; x < tileWidth + extrusion; ++x)
+                    {
+                        const std::uint32_t sx = srcX + static_cast<std::uint32_t>(std::clamp<std::int64_t>(x, 0, tileWidth - 1));
+                        if (sx < image.width)
+                            std::memcpy(out + x * 4, image.pixel(sx, sy), 4);
+                    }
+                }
+            }
+        }
+        return pages;
+    }
+
+    void blendRow(std::uint8_t* dst, const std::uint8_t* src, const std::size_t count, const std::uint32_t opacity)
+    {
+        std::size_t i = 0;
+#ifdef TMX_RASTER_SSE2
+        // Four pixels per step, widened to 16-bit lanes; same rounding as the scalar loop below
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i scale = _mm_set1_epi16(static_cast<short>(opacity));
+        const __m128i half = _mm_set1_epi16(128);
+        const __m128i full = _mm_set1_epi16(255);
+        auto blendHalf = [&](__m128i s, __m128i d)
+        {
+            s = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(s, scale), half), 8);
+            const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+            __m128i x = _mm_add_epi16(_mm_mullo_epi16(d, _mm_sub_epi16(full, alpha)), half);
+            x = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+            return _mm_add_epi16(s, x);
+        };
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            const __m128i low = blendHalf(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+            const __m128i high = blendHalf(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(low, high));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const std::uint8_t* s = src + i * 4;
+            std::uint8_t* d = dst + i * 4;
+            const std::uint32_t alpha = (s[3] * opacity + 128) >> 8;
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                const std::uint32_t value = c == 3 ? alpha : (s[c] * opacity + 128) >> 8;
+                d[c] = static_cast<std::uint8_t>(std::min<std::uint32_t>(value + div255(d[c] * (255 - alpha)), 255));
+            }
+        }
+    }
+
+    Rasterizer::Rasterizer(const render::MapRenderData& renderData)
+    {
+        reset(renderData);
+    }
+
+    void Rasterizer::reset(const render::MapRenderData& renderData)
+    {
+        m_renderData = &renderData;
+        m_tilesetImages.assign(renderData.tilesets.size(), {});
+    }
+
+    auto Rasterizer::loadTilesetImages() -> tl::expected<void, std::string>
+    {
+        if (!m_renderData)
+            return tl::make_unexpected("Rasterizer is not bound to render data");
+
+        for (std::uint32_t i = 0; i < m_renderData->tilesets.size(); ++i)
+        {
+            const auto& tileset = m_renderData->tilesets[i];
+            if (tileset.imagePath.empty())
+                continue;
+
+            auto image = loadImage(tileset.imagePath);
+            if (!image)
+                return tl::make_unexpected("Tileset '" + tileset.name + "': " + image.error());
+            premultiply(*image);
+            m_tilesetImages[i] = std::move(*image);
+        }
+        return {};
+    }
+
+    auto Rasterizer::setTilesetImage(const std::uint32_t tilesetIndex, const Image& image) -> bool
+    {
+        if (tilesetIndex >= m_tilesetImages.size())
+            return false;
+
+        m_tilesetImages[tilesetIndex] = image;
+        premultiply(m_tilesetImages[tilesetIndex]);
+        return true;
+    }
+
+    auto Rasterizer::render(const RasterOptions& options) const -> tl::expected<Image, std::string>
+    {
+        if (!m_renderData)
+            return tl::make_unexpected("Rasterizer is not bound to render data");
+        if (!(options.scale > 0.0f) || !std::isfinite(options.scale))
+            return tl::make_unexpected("Scale must be positive");
+
+        const auto& renderData = *m_renderData;
+        render::ViewRect region{0.0f, 0.0f, static_cast<float>(renderData.pixelWidth),
+                                static_cast<float>(renderData.pixelHeight)};
+        if (options.region)
+        {
+            region = *options.region;
+        }
+        else if (renderData.infinite)
+        {
+            // Infinite maps have no fixed size; draw everything their visible layers cover
+            render::RenderBounds bounds;
+            for (const auto& layer : renderData.layers)
+            {
+                if (layer.visible)
+                    bounds.merge(drawnBounds(layer, layer.bounds));
+            }
+            region = {static_cast<float>(bounds.minX), static_cast<float>(bounds.minY),
+                      static_cast<float>(bounds.maxX - bounds.minX), static_cast<float>(bounds.maxY - bounds.minY)};
+        }
+
+        const double width = std::ceil(static_cast<double>(region.width) * options.scale);
+        const double height = std::ceil(static_cast<double>(region.height) * options.scale);
+        if (!(width >= 1.0) || !(height >= 1.0))
+            return tl::make_unexpected("Nothing to draw: the region is empty");
+        if (width > MAX_IMAGE_SIZE || height > MAX_IMAGE_SIZE)
+        {
+            return tl::make_unexpected("Image of " + std::to_string(static_cast<std::uint64_t>(width)) + "x" +
+                                       std::to_string(static_cast<std::uint64_t>(height)) + " exceeds " +
+                                       std::to_string(MAX_IMAGE_SIZE) + " pixels per side");
+        }
+
+        Image image;
+        image.width = static_cast<std::uint32_t>(width);
+        image.height = static_cast<std::uint32_t>(height);
+        image.pixels.resize(static_cast<std::size_t>(image.width) * image.height * 4);
+        const Canvas canvas{image.pixels.data(), image.width, image.height, region.x, region.y, options.scale};
+
+        render::AnimationClock clock(renderData);
+        clock.setTime(options.time);
+
+        // Resolve every drawable tile object's transform once; bands only clip them
+        std::vector<PreparedObject> objects;
+        for (const auto& group : renderData.objectGroups)
+        {
+            if (!options.drawObjects || !group.visible)
+                continue;
+            for (const auto& object : group.objects)
+            {
+                if (!object.visible || object.tilesetIndex >= m_tilesetImages.size() ||
+                    m_tilesetImages[object.tilesetIndex].isEmpty() || object.srcW == 0 || object.srcH == 0)
+                {
+                    continue;
+                }
+
+                PreparedObject prepared{};
+                prepared.image = &m_tilesetImages[object.tilesetIndex];
+                prepared.srcX = object.srcX;
+                prepared.srcY = object.srcY;
+                if (const auto* info = renderData.gidInfo(object.gid);
+                    info && info->animationIndex != render::PackedTileRenderInfo::NO_ANIMATION)
+                {
+                    const auto& frame = clock.frame(object.tilesetIndex, info->animationIndex);
+                    prepared.srcX = frame.srcX;
+                    prepared.srcY = frame.srcY;
+                }
+                prepared.srcW = object.srcW;
+                prepared.srcH = object.srcH;
+                if (prepared.srcX + prepared.srcW > prepared.image->width ||
+                    prepared.srcY + prepared.srcH > prepared.image->height)
+                {
+                    continue;
+                }
+
+                prepared.flipFlags = object.flipFlags;
+                prepared.opacity = toOpacity(group.opacity);
+                prepared.x = object.x + static_cast<double>(group.transform.offsetX);
+                prepared.y = object.y + static_cast<double>(group.transform.offsetY);
+                prepared.width = object.width > 0.0f ? object.width : static_cast<double>(object.srcW);
+                prepared.height = object.height > 0.0f ? object.height : static_cast<double>(object.srcH);
+                const double radians = static_cast<double>(object.rotation) * 3.14159265358979323846 / 180.0;
+                prepared.cos = std::cos(radians);
+                prepared.sin = std::sin(radians);
+
+                // Bounding box of the rotated corners (0, 0), (w, 0), (w, -h), (0, -h)
+                prepared.minX = prepared.maxX = prepared.x;
+                prepared.minY = prepared.maxY = prepared.y;
+                for (const auto& [cx, cy] : {std::pair{prepared.width, 0.0}, std::pair{prepared.width, -prepared.height},
+                                            std::pair{0.0, -prepared.height}})
+                {
+                    const double px = prepared.x + cx * prepared.cos - cy * prepared.sin;
+                    const double py = prepared.y + cx * prepared.sin + cy * prepared.cos;
+                    prepared.minX = std::min(prepared.minX, px);
+                    prepared.maxX = std::max(prepared.maxX, px);
+                    prepared.minY = std::min(prepared.minY, py);
+                    prepared.maxY = std::max(prepared.maxY, py);
+                }
+                objects.push_back(prepared);
+            }
+        }
+
+        const std::uint32_t background[4] = {options.background >> 24, (options.background >> 16) & 0xFF,
+                                             (options.background >> 8) & 0xFF, options.background & 0xFF};
+        std::uint8_t fill[4];
+        for (std::size_t c = 0; c < 4; ++c)
+            fill[c] = static_cast<std::uint8_t>(c == 3 ? background[3] : div255(background[c] * background[3]));
+
+        const std::size_t bandCount = (image.height + BAND_ROWS - 1) / BAND_ROWS;
+        parallelFor(bandCount, resolveThreadCount(options.threadCount), [&](const std::size_t bandIndex)
+        {
+            const PixelRange band{static_cast<std::int64_t>(bandIndex * BAND_ROWS),
+                                  std::min<std::int64_t>((bandIndex + 1) * BAND_ROWS, image.height)};
+            for (std::int64_t py = band.begin; py < band.end; ++py)
+            {
+                std::uint8_t* row = canvas.row(py);
+                for (std::uint32_t px = 0; px < image.width; ++px)
+                    std::memcpy(row + static_cast<std::size_t>(px) * 4, fill, 4);
+            }
+
+            // Only chunks overlapping the band's rows are visited, in layer order. Each layer is searched with the
+            // band moved back by the offset it is drawn at, so culling and drawing agree.
+            Scratch scratch;
+            const render::ViewRect bandRect{region.x, static_cast<float>(canvas.originY + band.begin / canvas.scale),
+                                            region.width, static_cast<float>(band.size() / canvas.scale)};
+            for (std::uint32_t layerIdx = 0; layerIdx < renderData.layers.size(); ++layerIdx)
+            {
+                const auto& layer = renderData.layers[layerIdx];
+                if (layer.visible)
+                {
+                    renderData.queryLayer(layerIdx, {bandRect.x - layer.transform.offsetX,
+                                                     bandRect.y - layer.transform.offsetY, bandRect.width,
+                                                     bandRect.height}, scratch.ranges);
+                }
+            }
+            renderData.forEachTile(scratch.ranges, [&](const render::LayerRenderData& layer,
+                                                       const render::TileRenderInfo& tile)
+            {
+                if (tile.tilesetIndex >= m_tilesetImages.size() || m_tilesetImages[tile.tilesetIndex].isEmpty())
+                    return;
+                std::uint32_t srcX = tile.srcX, srcY = tile.srcY;
+                if (tile.isAnimated)
+                {
+                    const auto& frame = clock.frame(tile.tilesetIndex, tile.animationIndex);
+                    srcX = frame.srcX;
+                    srcY = frame.srcY;
+                }
+                drawTile(canvas, band, tile, layer.transform.offsetX, layer.transform.offsetY,
+                         m_tilesetImages[tile.tilesetIndex], srcX, srcY, scratch);
+            });
+
+            for (const auto& object : objects)
+                drawObject(canvas, band, object, scratch);
+        });
+
+        unpremultiply(image);
+        return image;
+    }
+}
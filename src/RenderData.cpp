@@ -1,9 +1,493 @@
 #include <tmx/RenderData.hpp>
+#include <tmx/ShapeGeometry.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
 
 namespace tmx::render
 {
-    auto MapRenderData::fromMap(const map::Map& map, const std::string& assetBasePath) -> MapRenderData
+    namespace
+    {
+        auto sameGrid(const TilesetRenderInfo& a, const TilesetRenderInfo& b) -> bool
+        {
+            return a.tileWidth == b.tileWidth && a.tileHeight == b.tileHeight && a.columns == b.columns &&
+                a.imageWidth == b.imageWidth && a.imageHeight == b.imageHeight && a.margin == b.margin &&
+                a.spacing == b.spacing;
+        }
+
+        auto samePath(const std::string& a, const std::string& b) -> bool
+        {
+            return !a.empty() && !b.empty() &&
+                std::filesystem::path(a).lexically_normal() == std::filesystem::path(b).lexically_normal();
+        }
+
+        auto sameAnimation(const TileAnimationInfo& a, const TileAnimationInfo& b) -> bool
+        {
+            return a.baseTileId == b.baseTileId && std::ranges::equal(a.frames, b.frames, [](const auto& x, const auto& y)
+            {
+                return x.tileId == y.tileId && x.duration == y.duration;
+            });
+        }
+
+        // FNV-1a hash of a file's bytes, or 0 if it cannot be read
+        auto hashFile(const std::string& path) -> std::uint64_t
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (path.empty() || !file)
+                return 0;
+
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            char buffer[16384];
+            while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+            {
+                for (std::streamsize i = 0; i < file.gcount(); ++i)
+                    hash = (hash ^ static_cast<std::uint8_t>(buffer[i])) * 0x100000001b3ull;
+            }
+            return hash == 0 ? 1 : hash;
+        }
+
+        // Order-preserving key of a chunk: sorts by chunkY, then chunkX, with negative coordinates first
+        auto chunkKey(const std::int32_t chunkX, const std::int32_t chunkY) -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkY) ^ 0x80000000u) << 32) |
+                (static_cast<std::uint32_t>(chunkX) ^ 0x80000000u);
+        }
+
+        // Screen bounding box of one cell
+        template <typename Projection>
+        auto cellBounds(const Projection& grid, const std::int32_t x, const std::int32_t y, const std::int32_t cellWidth,
+                        const std::int32_t cellHeight) -> RenderBounds
+        {
+            const ScreenPoint dest = grid.toScreen(x, y);
+            return {dest.x, dest.y, dest.x + cellWidth, dest.y + cellHeight};
+        }
+
+        // Screen bounding box of a rectangle of cells; its extremes lie on the corner cells, or on their neighbours
+        // where every other row or column is shifted
+        template <typename Projection>
+        auto cellRectBounds(const Projection& grid, const CellRect& cells, const std::int32_t cellWidth,
+                            const std::int32_t cellHeight) -> RenderBounds
+        {
+            const std::int32_t columns[] = {cells.minX, std::min(cells.minX + 1, cells.maxX - 1),
+                                            std::max(cells.maxX - 2, cells.minX), cells.maxX - 1};
+            const std::int32_t rows[] = {cells.minY, std::min(cells.minY + 1, cells.maxY - 1),
+                                         std::max(cells.maxY - 2, cells.minY), cells.maxY - 1};
+            RenderBounds bounds;
+            for (const std::int32_t y : rows)
+            {
+                for (const std::int32_t x : columns)
+                    bounds.merge(cellBounds(grid, x, y, cellWidth, cellHeight));
+            }
+            return bounds;
+        }
+
+        // Reorder tiles chunk by chunk (row-major within each chunk) and describe every non-empty chunk
+        template <typename Tile, typename Projection>
+        auto bucketTiles(std::vector<Tile>& tiles, const Projection& grid, const std::int32_t tileWidth,
+                         const std::int32_t tileHeight, const std::int32_t chunkSize) -> std::vector<SpatialChunk>
+        {
+            struct SortKey
+            {
+                std::uint64_t chunk;
+                std::uint64_t cell;
+                std::uint32_t index;
+            };
+
+            std::vector<SortKey> keys(tiles.size());
+            for (std::uint32_t i = 0; i < tiles.size(); ++i)
+            {
+                const CellPoint cell = grid.toCell({tiles[i].destX, tiles[i].destY});
+                keys[i] = {chunkKey(floorDiv(cell.x, chunkSize), floorDiv(cell.y, chunkSize)), chunkKey(cell.x, cell.y), i};
+            }
+            std::ranges::sort(keys, [](const SortKey& a, const SortKey& b)
+            {
+                return a.chunk != b.chunk ? a.chunk < b.chunk : a.cell != b.cell ? a.cell < b.cell : a.index < b.index;
+            });
+
+            std::vector<Tile> sorted;
+            sorted.reserve(tiles.size());
+            std::vector<SpatialChunk> chunks;
+            for (const auto& key : keys)
+            {
+                const Tile& tile = sorted.emplace_back(tiles[key.index]);
+                const RenderBounds tileBounds{tile.destX, tile.destY, tile.destX + tileWidth, tile.destY + tileHeight};
+                if (chunks.empty() || chunkKey(chunks.back().chunkX, chunks.back().chunkY) != key.chunk)
+                {
+                    const CellPoint cell = grid.toCell({tile.destX, tile.destY});
+                    chunks.push_back({floorDiv(cell.x, chunkSize), floorDiv(cell.y, chunkSize), tileBounds,
+                                      static_cast<std::uint32_t>(sorted.size() - 1), 0});
+                }
+                chunks.back().bounds.merge(tileBounds);
+                ++chunks.back().count;
+            }
+            tiles = std::move(sorted);
+            return chunks;
+        }
+
+        auto resolveThreadCount(const std::uint32_t threadCount) -> std::uint32_t
+        {
+            return threadCount != 0 ? threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        // Run fn(0) .. fn(count - 1) on up to threadCount threads, the calling thread included
+        template <typename Fn>
+        void parallelFor(const std::size_t count, const std::uint32_t threadCount, Fn&& fn)
+        {
+            const auto workers = std::min<std::size_t>(threadCount, count);
+            if (workers <= 1)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    fn(i);
+                return;
+            }
+
+            std::atomic<std::size_t> next{0};
+            auto work = [&]
+            {
+                for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                     i = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    fn(i);
+                }
+            };
+
+            std::vector<std::jthread> threads;
+            threads.reserve(workers - 1);
+            for (std::size_t t = 1; t < workers; ++t)
+                threads.emplace_back(work);
+            work();
+        }
+
+        // Position of a chunk in a layer's sorted chunk list, or where it would be inserted
+        auto findChunk(const std::vector<SpatialChunk>& chunks, const std::int32_t chunkX, const std::int32_t chunkY)
+            -> std::vector<SpatialChunk>::const_iterator
+        {
+            return std::ranges::lower_bound(chunks, chunkKey(chunkX, chunkY), {}, [](const SpatialChunk& chunk)
+            {
+                return chunkKey(chunk.chunkX, chunk.chunkY);
+            });
+        }
+
+        auto animationOf(const TileRenderInfo& tile) -> std::optional<AnimationRef>
+        {
+            if (!tile.isAnimated)
+                return std::nullopt;
+            return AnimationRef{tile.tilesetIndex, tile.animationIndex};
+        }
+
+        auto animationOf(const PackedTileRenderInfo& tile) -> std::optional<AnimationRef>
+        {
+            if (!tile.isAnimated())
+                return std::nullopt;
+            return AnimationRef{tile.tilesetIndex, tile.animationIndex};
+        }
+
+        auto animationLess(const AnimationRef& a, const AnimationRef& b) -> bool
+        {
+            return a.tilesetIndex != b.tilesetIndex ? a.tilesetIndex < b.tilesetIndex : a.animationIndex < b.animationIndex;
+        }
+
+        // Patch animatedGroups after tiles [first, first + oldCount) were replaced by `run`
+        template <typename Tile>
+        void relinkAnimatedTiles(LayerRenderData& layer, const std::uint32_t first, const std::uint32_t oldCount,
+                                 std::span<const Tile> run)
+        {
+            auto& indices = layer.animatedTileIndices;
+            const std::uint32_t end = first + oldCount;
+            const auto newCount = static_cast<std::uint32_t>(run.size());
+
+            // Drop the links of the replaced tiles and shift the links of the tiles after them
+            std::uint32_t write = 0;
+            for (auto& group : layer.animatedGroups)
+            {
+                const std::uint32_t groupStart = write;
+                for (std::uint32_t i = group.first; i < group.first + group.count; ++i)
+                {
+                    const std::uint32_t index = indices[i];
+                    if (index >= first && index < end)
+                        continue;
+                    indices[write++] = index >= end ? index - oldCount + newCount : index;
+                }
+                group.first = groupStart;
+                group.count = write - groupStart;
+            }
+            indices.resize(write);
+            std::erase_if(layer.animatedGroups, [](const AnimatedTileGroup& group) { return group.count == 0; });
+
+            // Link the new tiles, keeping groups sorted and each group in layer order
+            for (std::uint32_t k = 0; k < newCount; ++k)
+            {
+                const auto animation = animationOf(run[k]);
+                if (!animation)
+                    continue;
+
+                auto group = std::ranges::lower_bound(layer.animatedGroups, *animation, animationLess,
+                                                      &AnimatedTileGroup::animation);
+                if (group == layer.animatedGroups.end() || animationLess(*animation, group->animation))
+                {
+                    const auto at = group == layer.animatedGroups.end() ? static_cast<std::uint32_t>(indices.size())
+                                                                        : group->first;
+                    group = layer.animatedGroups.insert(group, {*animation, at, 0});
+                }
+
+                const auto groupBegin = indices.begin() + group->first;
+                indices.insert(std::upper_bound(groupBegin, groupBegin + group->count, first + k), first + k);
+                ++group->count;
+                for (auto next = group + 1; next != layer.animatedGroups.end(); ++next)
+                    ++next->first;
+            }
+        }
+
+        // Render info of an object or tile collision shape; its points are measured, triangulated and pooled
+        auto makeObjectInfo(MapRenderData& renderData, const map::Object& object, std::span<const map::Point> points)
+            -> ObjectRenderInfo
+        {
+            ObjectRenderInfo objectInfo;
+            objectInfo.id = object.id;
+            objectInfo.name = object.name;
+            objectInfo.type = object.type;
+            objectInfo.x = object.x;
+            objectInfo.y = object.y;
+            objectInfo.width = object.width;
+            objectInfo.height = object.height;
+            objectInfo.rotation = object.rotation;
+            objectInfo.visible = object.visible;
+            objectInfo.shape = object.shape;
+            objectInfo.gid = object.gid;
+
+            objectInfo.firstPoint = static_cast<std::uint32_t>(renderData.points.size());
+            objectInfo.pointCount = static_cast<std::uint32_t>(points.size());
+            renderData.points.insert(renderData.points.end(), points.begin(), points.end());
+            if (object.shape == map::ObjectShape::Polygon || object.shape == map::ObjectShape::Polyline)
+            {
+                const bool polygon = object.shape == map::ObjectShape::Polygon;
+                objectInfo.length = measurePath(points, polygon, renderData.pointDistances);
+                objectInfo.firstTriangle = static_cast<std::uint32_t>(renderData.triangles.size());
+                if (polygon)
+                    objectInfo.triangleCount = triangulatePolygon(points, renderData.triangles);
+            }
+            else
+            {
+                renderData.pointDistances.resize(renderData.points.size(), 0.0f);
+            }
+
+            // If this is a tile object (gid != 0), pre-calculate tile rendering info
+            if (const GidRenderInfo* gidInfo = renderData.gidInfo(object.gid))
+            {
+                const auto& tilesetInfo = renderData.tilesets[gidInfo->tilesetIndex];
+                objectInfo.tilesetIndex = gidInfo->tilesetIndex;
+                objectInfo.srcX = gidInfo->srcX;
+                objectInfo.srcY = gidInfo->srcY;
+                objectInfo.srcW = tilesetInfo.tileWidth;
+                objectInfo.srcH = tilesetInfo.tileHeight;
+                objectInfo.flipFlags = static_cast<std::uint8_t>(object.gid >> map::GID_FLAGS_SHIFT);
+            }
+
+            objectInfo.bounds = objectBounds(objectInfo, points);
+            return objectInfo;
+        }
+
+        // Image path relative to the asset base path, if one was given
+        auto resolveImagePath(const std::string& assetBasePath, const std::string& image) -> std::string
+        {
+            if (assetBasePath.empty() || image.empty())
+                return image;
+            return (std::filesystem::path(assetBasePath) / std::filesystem::path(image)).string();
+        }
+
+        auto multiplyChannel(const std::uint8_t a, const std::uint8_t b) -> std::uint8_t
+        {
+            return static_cast<std::uint8_t>((a * b + 127) / 255);
+        }
+
+        // Visibility, opacity and transform of a layer or group combined with those of its (already folded) group:
+        // hidden if either is hidden, opacities and tints multiply, offsets add, parallax factors multiply
+        template <typename Layer>
+        auto foldIntoGroup(const std::vector<GroupRenderData>& groups, const Layer& layer) -> GroupRenderData
+        {
+            GroupRenderData folded;
+            folded.name = layer.name;
+            folded.visible = layer.visible;
+            folded.opacity = layer.opacity;
+            folded.transform = {layer.offsetx, layer.offsety, layer.parallaxx, layer.parallaxy, layer.tintcolor};
+            folded.parent = layer.group;
+            if (layer.group < 0 || static_cast<std::size_t>(layer.group) >= groups.size())
+                return folded;
+
+            const auto& parent = groups[layer.group];
+            auto& transform = folded.transform;
+            folded.visible = folded.visible && parent.visible;
+            folded.opacity *= parent.opacity;
+            transform.offsetX += parent.transform.offsetX;
+            transform.offsetY += parent.transform.offsetY;
+            transform.parallaxX *= parent.transform.parallaxX;
+            transform.parallaxY *= parent.transform.parallaxY;
+            transform.tint = {multiplyChannel(transform.tint.r, parent.transform.tint.r),
+                              multiplyChannel(transform.tint.g, parent.transform.tint.g),
+                              multiplyChannel(transform.tint.b, parent.transform.tint.b),
+                              multiplyChannel(transform.tint.a, parent.transform.tint.a)};
+            return folded;
+        }
+    }
+
+    void TileAnimationInfo::buildTimeline()
+    {
+        timeline.clear();
+        frameEndTimes.clear();
+        frameEndTimes.reserve(frames.size());
+
+        // Prefix sums double as the fallback search table
+        totalDuration = 0;
+        timeQuantum = 0;
+        for (const auto& frame : frames)
+        {
+            totalDuration += frame.duration;
+            frameEndTimes.push_back(totalDuration);
+            timeQuantum = std::gcd(timeQuantum, frame.duration);
+        }
+
+        if (timeQuantum == 0)
+        {
+            timeQuantum = 1;
+            return;
+        }
+
+        // Frames always change on a multiple of the GCD, so one entry per quantum is exact
+        const std::uint32_t entries = totalDuration / timeQuantum;
+        if (entries > MAX_TIMELINE_ENTRIES || frames.size() > UINT16_MAX)
+            return;
+
+        timeline.reserve(entries);
+        for (std::uint32_t frameIdx = 0; frameIdx < frames.size(); ++frameIdx)
+        {
+            timeline.insert(timeline.end(), frames[frameIdx].duration / timeQuantum,
+                            static_cast<std::uint16_t>(frameIdx));
+        }
+    }
+
+    void LayerRenderData::indexAnimatedTiles()
+    {
+        animatedGroups.clear();
+        animatedTileIndices.clear();
+
+        // Both storages share the same (tileset, animation) key; NO_ANIMATION marks static packed tiles
+        std::vector<std::uint64_t> keys;
+        auto collect = [&](std::uint32_t index, bool isAnimated, std::uint32_t tilesetIndex, std::uint32_t animationIndex)
+        {
+            if (!isAnimated)
+                return;
+            animatedTileIndices.push_back(index);
+            keys.push_back((static_cast<std::uint64_t>(tilesetIndex) << 32) | animationIndex);
+        };
+
+        for (std::uint32_t i = 0; i < tiles.size(); ++i)
+            collect(i, tiles[i].isAnimated, tiles[i].tilesetIndex, tiles[i].animationIndex);
+        for (std::uint32_t i = 0; i < packedTiles.size(); ++i)
+            collect(i, packedTiles[i].isAnimated(), packedTiles[i].tilesetIndex, packedTiles[i].animationIndex);
+
+        // Stable sort keeps tiles of a group in layer order
+        std::vector<std::uint32_t> order(animatedTileIndices.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::ranges::stable_sort(order, {}, [&keys](std::uint32_t i) { return keys[i]; });
+
+        std::vector<std::uint32_t> sorted;
+        sorted.reserve(order.size());
+        for (std::uint32_t i = 0; i < order.size(); ++i)
+        {
+            const std::uint64_t key = keys[order[i]];
+            sorted.push_back(animatedTileIndices[order[i]]);
+
+            const AnimationRef ref{static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key)};
+            if (animatedGroups.empty() || animatedGroups.back().animation.tilesetIndex != ref.tilesetIndex ||
+                animatedGroups.back().animation.animationIndex != ref.animationIndex)
+            {
+                animatedGroups.push_back({ref, i, 0});
+            }
+            ++animatedGroups.back().count;
+        }
+        animatedTileIndices = std::move(sorted);
+    }
+
+    auto LayerRenderData::findAnimatedGroup(const AnimationRef& animation) const -> const AnimatedTileGroup*
+    {
+        const auto it = std::ranges::lower_bound(animatedGroups, animation, [](const AnimationRef& a, const AnimationRef& b)
+        {
+            return a.tilesetIndex != b.tilesetIndex ? a.tilesetIndex < b.tilesetIndex : a.animationIndex < b.animationIndex;
+        }, &AnimatedTileGroup::animation);
+
+        if (it == animatedGroups.end() || it->animation.tilesetIndex != animation.tilesetIndex ||
+            it->animation.animationIndex != animation.animationIndex)
+            return nullptr;
+        return &*it;
+    }
+
+    auto MapRenderData::unpack(const PackedTileRenderInfo& tile, const float opacity) const -> TileRenderInfo
+    {
+        const auto& tileset = tilesets[tile.tilesetIndex];
+        const std::uint32_t tileId = tile.tileId();
+
+        TileRenderInfo tileInfo{};
+        tileInfo.tileId = tileId;
+        tileInfo.srcX = tileset.srcXOf(tileId);
+        tileInfo.srcY = tileset.srcYOf(tileId);
+        tileInfo.srcW = tileset.tileWidth;
+        tileInfo.srcH = tileset.tileHeight;
+        tileInfo.destX = tile.destX;
+        tileInfo.destY = tile.destY;
+        tileInfo.destW = tileWidth;
+        tileInfo.destH = tileHeight;
+        tileInfo.tilesetIndex = tile.tilesetIndex;
+        tileInfo.opacity = opacity;
+        tileInfo.isAnimated = tile.isAnimated();
+        tileInfo.flipFlags = tile.flipFlags();
+        tileInfo.animationIndex = tile.isAnimated() ? tile.animationIndex : static_cast<std::uint32_t>(-1);
+        return tileInfo;
+    }
+
+    auto MapRenderData::makeTile(const GidRenderInfo& info, const ScreenPoint& dest, const std::uint32_t rawGid,
+                                 const float opacity) const -> TileRenderInfo
+    {
+        const auto& tileset = tilesets[info.tilesetIndex];
+
+        TileRenderInfo tileInfo{};
+        tileInfo.tileId = info.tileId;
+        tileInfo.srcX = info.srcX;
+        tileInfo.srcY = info.srcY;
+        tileInfo.srcW = tileset.tileWidth;
+        tileInfo.srcH = tileset.tileHeight;
+        tileInfo.destX = dest.x;
+        tileInfo.destY = dest.y;
+        tileInfo.destW = tileWidth;
+        tileInfo.destH = tileHeight;
+        tileInfo.tilesetIndex = info.tilesetIndex;
+        tileInfo.opacity = opacity;
+        tileInfo.isAnimated = info.animationIndex != PackedTileRenderInfo::NO_ANIMATION;
+        tileInfo.flipFlags = static_cast<std::uint8_t>(rawGid >> map::GID_FLAGS_SHIFT);
+        tileInfo.animationIndex = tileInfo.isAnimated ? info.animationIndex : static_cast<std::uint32_t>(-1);
+        return tileInfo;
+    }
+
+    auto MapRenderData::makePackedTile(const GidRenderInfo& info, const ScreenPoint& dest,
+                                       const std::uint32_t rawGid) const -> PackedTileRenderInfo
+    {
+        PackedTileRenderInfo tileInfo{};
+        tileInfo.destX = dest.x;
+        tileInfo.destY = dest.y;
+        tileInfo.tileIdAndFlags = info.tileId | (rawGid & map::GID_FLAGS_MASK);
+        tileInfo.tilesetIndex = info.tilesetIndex;
+        tileInfo.animationIndex = info.animationIndex;
+        return tileInfo;
+    }
+
+    auto MapRenderData::fromMap(const map::Map& map, const std::string& assetBasePath,
+                                const RenderBuildOptions& options) -> MapRenderData
     {
         MapRenderData renderData;
 
@@ -12,13 +496,26 @@ namespace tmx::render
         renderData.mapHeight = map.height;
         renderData.tileWidth = map.tilewidth;
         renderData.tileHeight = map.tileheight;
-        renderData.pixelWidth = map.width * map.tilewidth;
-        renderData.pixelHeight = map.height * map.tileheight;
+        renderData.projection = ProjectionParams::fromMap(map);
+        renderData.renderOrder = map.renderorder;
+        const ScreenPoint size = withProjection(renderData.projection, [&](const auto& grid)
+        {
+            return grid.mapSize(static_cast<std::int32_t>(map.width), static_cast<std::int32_t>(map.height));
+        });
+        renderData.pixelWidth = static_cast<std::uint32_t>(std::max(size.x, 0));
+        renderData.pixelHeight = static_cast<std::uint32_t>(std::max(size.y, 0));
+        renderData.infinite = map.infinite;
 
         // Process tileset
+        // Tilesets drawing the same image with the same grid share one render tileset; mapTilesets[i] is the render
+        // tileset of map tileset i and animationsOf[i] pairs each of its animated tiles with a render animation
         renderData.tilesets.reserve(map.tilesets.size());
-        for (const auto& tileset : map.tilesets)
+        std::vector<std::uint32_t> mapTilesets(map.tilesets.size());
+        std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>> animationsOf(map.tilesets.size());
+        std::vector<std::uint64_t> imageHashes;
+        for (std::uint32_t mapIdx = 0; mapIdx < map.tilesets.size(); ++mapIdx)
         {
+            const auto& tileset = map.tilesets[mapIdx];
             TilesetRenderInfo tilesetInfo;
             tilesetInfo.name = tileset.name;
             tilesetInfo.imageWidth = tileset.imagewidth;
@@ -30,16 +527,7 @@ namespace tmx::render
             tilesetInfo.tileCount = tileset.tilecount;
 
             // Resolve image path
-            if (!assetBasePath.empty() && !tileset.image.empty())
-            {
-                std::filesystem::path basePath(assetBasePath);
-                std::filesystem::path imagePath(tileset.image);
-                tilesetInfo.imagePath = (basePath / imagePath).string();
-            }
-            else
-            {
-                tilesetInfo.imagePath = tileset.image;
-            }
+            tilesetInfo.imagePath = resolveImagePath(assetBasePath, tileset.image);
 
             // Process animations
             for (const auto& tile : tileset.tiles)
@@ -48,7 +536,6 @@ namespace tmx::render
                 {
                     TileAnimationInfo animInfo;
                     animInfo.baseTileId = tile.id;
-                    animInfo.totalDuration = 0;
 
                     for (const auto& frame : tile.animation.frames)
                     {
@@ -57,284 +544,751 @@ namespace tmx::render
                         frameInfo.duration = frame.duration;
 
                         // Pre-calculate source position for this frame
-                        frameInfo.srcX = (frame.tileid % tileset.columns) * tileset.tilewidth;
-                        frameInfo.srcY = (frame.tileid / tileset.columns) * tileset.tileheight;
+                        frameInfo.srcX = tilesetInfo.srcXOf(frame.tileid);
+                        frameInfo.srcY = tilesetInfo.srcYOf(frame.tileid);
 
-                        animInfo.totalDuration += frame.duration;
                         animInfo.frames.push_back(frameInfo);
                     }
 
-                    // Build flattened time-to-frame-index lookup table
-                    // This eliminates the need for loop-based frame search at runtime
-                    animInfo.timeToFrameIndex.resize(animInfo.totalDuration);
-                    std::uint32_t currentTime = 0;
-                    for (std::uint32_t frameIdx = 0; frameIdx < animInfo.frames.size(); ++frameIdx)
-                    {
-                        const auto& frame = animInfo.frames[frameIdx];
-                        // Fill the lookup table for this frame's duration
-                        for (std::uint32_t t = 0; t < frame.duration; ++t)
-                        {
-                            if (currentTime + t < animInfo.totalDuration)
-                            {
-                                animInfo.timeToFrameIndex[currentTime + t] = frameIdx;
-                            }
-                        }
-                        currentTime += frame.duration;
-                    }
+                    // Build compact time-to-frame-index lookup
+                    animInfo.buildTimeline();
 
                     tilesetInfo.animations.push_back(std::move(animInfo));
                 }
             }
 
+            const std::uint64_t imageHash = options.hashTilesetImages ? hashFile(tilesetInfo.imagePath) : 0;
+            const auto duplicate = std::ranges::find_if(renderData.tilesets, [&](const TilesetRenderInfo& other)
+            {
+                const auto otherIdx = static_cast<std::size_t>(&other - renderData.tilesets.data());
+                return options.mergeDuplicateTilesets && sameGrid(tilesetInfo, other) &&
+                    (samePath(tilesetInfo.imagePath, other.imagePath) ||
+                     (imageHash != 0 && imageHash == imageHashes[otherIdx]));
+            });
+
+            // Merge into the earlier tileset: its animations are reused when identical and appended otherwise
+            if (duplicate != renderData.tilesets.end())
+            {
+                mapTilesets[mapIdx] = static_cast<std::uint32_t>(duplicate - renderData.tilesets.begin());
+                duplicate->tileCount = std::max(duplicate->tileCount, tilesetInfo.tileCount);
+                for (auto& animation : tilesetInfo.animations)
+                {
+                    auto same = std::ranges::find_if(duplicate->animations, [&](const TileAnimationInfo& other)
+                    {
+                        return sameAnimation(animation, other);
+                    });
+                    if (same == duplicate->animations.end())
+                    {
+                        duplicate->animations.push_back(animation);
+                        same = duplicate->animations.end() - 1;
+                    }
+                    animationsOf[mapIdx].emplace_back(animation.baseTileId,
+                                                      static_cast<std::uint32_t>(same - duplicate->animations.begin()));
+                }
+                continue;
+            }
+
+            mapTilesets[mapIdx] = static_cast<std::uint32_t>(renderData.tilesets.size());
+            for (std::uint32_t animIdx = 0; animIdx < tilesetInfo.animations.size(); ++animIdx)
+                animationsOf[mapIdx].emplace_back(tilesetInfo.animations[animIdx].baseTileId, animIdx);
+            imageHashes.push_back(imageHash);
             renderData.tilesets.push_back(std::move(tilesetInfo));
         }
 
+        // Build the GID lookup table once so that per-tile work is a single indexed load
+        if (!map.tilesets.empty())
+        {
+            const auto& last = map.tilesets.back();
+            renderData.gidTable.assign(last.firstgid + last.tilecount,
+                                       {0, 0, 0, GidRenderInfo::NO_TILESET, PackedTileRenderInfo::NO_ANIMATION});
+        }
+        for (std::uint32_t mapIdx = 0; mapIdx < map.tilesets.size(); ++mapIdx)
+        {
+            const std::uint32_t tilesetIdx = mapTilesets[mapIdx];
+            const auto& tilesetInfo = renderData.tilesets[tilesetIdx];
+            const std::uint32_t firstgid = map.tilesets[mapIdx].firstgid;
+
+            // A tileset owns every GID up to the next tileset's firstgid
+            const std::uint32_t end = mapIdx + 1 < map.tilesets.size()
+                                          ? map.tilesets[mapIdx + 1].firstgid
+                                          : static_cast<std::uint32_t>(renderData.gidTable.size());
+            for (std::uint32_t gid = std::max(firstgid, 1u); gid < end && gid < renderData.gidTable.size(); ++gid)
+            {
+                const std::uint32_t tileId = gid - firstgid;
+                renderData.gidTable[gid] = {tileId, tilesetInfo.srcXOf(tileId), tilesetInfo.srcYOf(tileId),
+                                            static_cast<std::uint16_t>(tilesetIdx), PackedTileRenderInfo::NO_ANIMATION};
+            }
+
+            for (const auto& [baseTileId, animIdx] : animationsOf[mapIdx])
+            {
+                const std::uint32_t gid = firstgid + baseTileId;
+                if (gid < end && gid < renderData.gidTable.size())
+                    renderData.gidTable[gid].animationIndex = static_cast<std::uint16_t>(animIdx);
+            }
+        }
+
+        // Collision shapes of tiles: one entry per GID, shared by every cell and tile object showing it
+        if (std::ranges::any_of(map.tilesets, [](const map::Tileset& tileset) { return !tileset.shapes.empty(); }))
+        {
+            renderData.gidShapeOffsets.assign(renderData.gidTable.size() + 1, 0);
+            for (std::uint32_t gid = 1; gid < renderData.gidTable.size(); ++gid)
+            {
+                renderData.gidShapeOffsets[gid] = static_cast<std::uint32_t>(renderData.tileShapes.size());
+                const map::Tileset* tileset = renderData.gidInfo(gid) ? map.tilesetOf(gid) : nullptr;
+                if (!tileset)
+                    continue;
+                for (const auto& shape : tileset->tileShapes(gid - tileset->firstgid))
+                    renderData.tileShapes.push_back(makeObjectInfo(renderData, shape, tileset->shapePointsOf(shape)));
+            }
+            renderData.gidShapeOffsets.back() = static_cast<std::uint32_t>(renderData.tileShapes.size());
+        }
+
+        // Fold group layers first: parents precede their children, so one pass suffices and layers built below
+        // read their effective visibility, opacity and transform from their group
+        renderData.groups.reserve(map.groups.size());
+        for (const auto& group : map.groups)
+            renderData.groups.push_back(foldIntoGroup(renderData.groups, group));
+
         // Process layers
-        renderData.layers.reserve(map.layers.size());
-        for (const auto& layer : map.layers)
+        renderData.chunkSize = std::max(options.chunkSize, 1u);
+        renderData.layers.resize(map.layers.size());
+
+        // Spread whole layers over the threads when there are enough of them, otherwise split each layer
+        const std::uint32_t threadCount = resolveThreadCount(options.threadCount);
+        const bool acrossLayers = map.layers.size() >= threadCount;
+        RenderBuildOptions layerOptions = options;
+        layerOptions.threadCount = acrossLayers ? 1 : threadCount;
+        parallelFor(map.layers.size(), acrossLayers ? threadCount : 1, [&](const std::size_t layerIdx)
+        {
+            renderData.layers[layerIdx] = renderData.buildLayer(map.layers[layerIdx], layerOptions);
+        });
+
+        // Process object groups; polygon and polyline points go to one pool, measured and triangulated once
+        renderData.objectGroups.reserve(map.objectgroups.size());
+        renderData.points.reserve(map.points.size());
+        renderData.pointDistances.reserve(map.points.size());
+        for (const auto& objectGroup : map.objectgroups)
         {
-            LayerRenderData layerData;
-            layerData.name = layer.name;
-            layerData.visible = layer.visible;
-            layerData.opacity = layer.opacity;
+            const auto folded = foldIntoGroup(renderData.groups, objectGroup);
+            ObjectGroupRenderData objectGroupData;
+            objectGroupData.name = objectGroup.name;
+            objectGroupData.visible = folded.visible;
+            objectGroupData.opacity = folded.opacity;
+            objectGroupData.drawOrder = objectGroup.draworder;
+            objectGroupData.transform = folded.transform;
 
-            // Check if this is an infinite map with chunks
-            if (!layer.chunks.empty())
+            // Process objects
+            objectGroupData.objects.reserve(objectGroup.objects.size());
+            for (const auto& object : objectGroup.objects)
             {
-                // Process chunks for infinite maps
-                for (const auto& chunk : layer.chunks)
+                objectGroupData.objects.push_back(makeObjectInfo(renderData, object, map.objectPoints(object)));
+            }
+
+            objectGroupData.objects.shrink_to_fit();
+            renderData.objectGroups.push_back(std::move(objectGroupData));
+        }
+
+        // Process image layers
+        renderData.imageLayers.reserve(map.imagelayers.size());
+        for (const auto& imageLayer : map.imagelayers)
+        {
+            const auto folded = foldIntoGroup(renderData.groups, imageLayer);
+            ImageLayerRenderData imageLayerData;
+            imageLayerData.name = imageLayer.name;
+            imageLayerData.imagePath = resolveImagePath(assetBasePath, imageLayer.image);
+            imageLayerData.imageWidth = imageLayer.imagewidth;
+            imageLayerData.imageHeight = imageLayer.imageheight;
+            imageLayerData.repeatX = imageLayer.repeatx;
+            imageLayerData.repeatY = imageLayer.repeaty;
+            imageLayerData.visible = folded.visible;
+            imageLayerData.opacity = folded.opacity;
+            imageLayerData.transform = folded.transform;
+            renderData.imageLayers.push_back(std::move(imageLayerData));
+        }
+
+        // Drawing order; maps assembled by hand have none, so draw tile layers, then object groups, then images
+        renderData.layerOrder = map.layerOrder;
+        if (renderData.layerOrder.empty())
+        {
+            for (std::uint32_t i = 0; i < map.layers.size(); ++i)
+                renderData.layerOrder.push_back({map::LayerKind::Tile, i});
+            for (std::uint32_t i = 0; i < map.objectgroups.size(); ++i)
+                renderData.layerOrder.push_back({map::LayerKind::Object, i});
+            for (std::uint32_t i = 0; i < map.imagelayers.size(); ++i)
+                renderData.layerOrder.push_back({map::LayerKind::Image, i});
+        }
+
+        return renderData;
+    }
+
+    auto MapRenderData::pointAlongPath(const ObjectRenderInfo& object, const float distance) const -> map::Point
+    {
+        const auto points = objectPoints(object);
+        const std::span<const float> distances =
+            points.empty() ? std::span<const float>{} : std::span(pointDistances).subspan(object.firstPoint, points.size());
+        const map::Point local = render::pointAlongPath(points, distances, object.length,
+                                                        object.shape == map::ObjectShape::Polygon, distance);
+        if (object.rotation == 0.0f)
+            return {object.x + local.x, object.y + local.y};
+
+        // Points are rotated clockwise about the object's position
+        const double radians = static_cast<double>(object.rotation) * std::numbers::pi / 180.0;
+        const double cosine = std::cos(radians), sine = std::sin(radians);
+        return {static_cast<float>(object.x + local.x * cosine - local.y * sine),
+                static_cast<float>(object.y + local.x * sine + local.y * cosine)};
+    }
+
+    auto MapRenderData::buildLayer(const map::Layer& layer, const RenderBuildOptions& options) const -> LayerRenderData
+    {
+        const auto chunkSize = static_cast<std::int32_t>(std::max(this->chunkSize, 1u));
+        const auto cellWidth = static_cast<std::int32_t>(std::max(tileWidth, 1u));
+        const auto cellHeight = static_cast<std::int32_t>(std::max(tileHeight, 1u));
+        const bool packed = options.tileStorage == TileStorage::Packed;
+        const bool indexed = options.tileStorage == TileStorage::Indexed;
+
+        LayerRenderData layerData;
+        layerData.name = layer.name;
+        const auto folded = foldIntoGroup(groups, layer);
+        layerData.visible = folded.visible;
+        layerData.opacity = folded.opacity;
+        layerData.transform = folded.transform;
+        layerData.storage = options.tileStorage;
+
+        if (indexed)
+        {
+            // Keep the raw GIDs in one block per spatial chunk; tiles are resolved through gidTable when visited
+            std::vector<std::uint64_t> usedChunks;
+            auto forEachCell = [&](auto&& cellVisitor)
+            {
+                if (!layer.chunks.empty())
                 {
-                    for (std::uint32_t cy = 0; cy < chunk.height; ++cy)
+                    for (const auto& chunk : layer.chunks)
                     {
-                        for (std::uint32_t cx = 0; cx < chunk.width; ++cx)
+                        const auto cells = std::min<std::size_t>(chunk.data.size(), chunk.width * chunk.height);
+                        for (std::uint32_t index = 0; index < cells; ++index)
                         {
-                            const std::uint32_t index = cy * chunk.width + cx;
-                            if (index >= chunk.data.size())
-                                continue;
-
-                            const std::uint32_t gid = chunk.data[index];
-                            if (gid == 0)
-                                continue; // Skip empty tiles
-
-                            // Calculate absolute tile position
-                            // chunk.x and chunk.y are in tile coordinates
-                            const std::int32_t x = chunk.x + static_cast<std::int32_t>(cx);
-                            const std::int32_t y = chunk.y + static_cast<std::int32_t>(cy);
-
-                            // Find which tileset this tile belongs to
-                            std::uint32_t tilesetIndex = 0;
-                            const map::Tileset* tileset = nullptr;
-
-                            for (std::uint32_t i = 0; i < map.tilesets.size(); ++i)
-                            {
-                                if (gid >= map.tilesets[i].firstgid)
-                                {
-                                    // Check if this is the right tileset
-                                    if (i + 1 >= map.tilesets.size() || gid < map.tilesets[i + 1].firstgid)
-                                    {
-                                        tilesetIndex = i;
-                                        tileset = &map.tilesets[i];
-                                        break;
-                                    }
-                                }
-                            }
-
-                            if (!tileset)
-                                continue; // Invalid tile
-
-                            // Calculate tile ID (subtract firstgid)
-                            const std::uint32_t tileId = gid - tileset->firstgid;
-
-                            // Pre-calculate source position in tileset
-                            const std::uint32_t tileX = (tileId % tileset->columns) * tileset->tilewidth;
-                            const std::uint32_t tileY = (tileId / tileset->columns) * tileset->tileheight;
-
-                            // Pre-calculate destination position on screen
-                            const std::int32_t destX = x * static_cast<std::int32_t>(map.tilewidth);
-                            const std::int32_t destY = y * static_cast<std::int32_t>(map.tileheight);
-
-                            // Create tile render info
-                            TileRenderInfo tileInfo{};
-                            tileInfo.tileId = tileId;
-                            tileInfo.srcX = tileX;
-                            tileInfo.srcY = tileY;
-                            tileInfo.srcW = tileset->tilewidth;
-                            tileInfo.srcH = tileset->tileheight;
-                            tileInfo.destX = destX;
-                            tileInfo.destY = destY;
-                            tileInfo.destW = map.tilewidth;
-                            tileInfo.destH = map.tileheight;
-                            tileInfo.tilesetIndex = tilesetIndex;
-                            tileInfo.opacity = layer.opacity;
-
-                            // Check if this tile has an animation
-                            tileInfo.isAnimated = false;
-                            tileInfo.animationIndex = static_cast<std::uint32_t>(-1);
-
-                            const auto& tilesetRenderInfo = renderData.tilesets[tilesetIndex];
-                            for (std::uint32_t animIdx = 0; animIdx < tilesetRenderInfo.animations.size(); ++animIdx)
-                            {
-                                if (tilesetRenderInfo.animations[animIdx].baseTileId == tileId)
-                                {
-                                    tileInfo.isAnimated = true;
-                                    tileInfo.animationIndex = animIdx;
-                                    break;
-                                }
-                            }
-
-                            layerData.tiles.push_back(std::move(tileInfo));
+                            cellVisitor(chunk.x + static_cast<std::int32_t>(index % chunk.width),
+                                        chunk.y + static_cast<std::int32_t>(index / chunk.width), chunk.data[index]);
                         }
                     }
                 }
+                else
+                {
+                    const auto cells = std::min<std::size_t>(layer.data.size(), layer.width * layer.height);
+                    for (std::uint32_t index = 0; index < cells; ++index)
+                    {
+                        cellVisitor(static_cast<std::int32_t>(index % layer.width),
+                                    static_cast<std::int32_t>(index / layer.width), layer.data[index]);
+                    }
+                }
+            };
+
+            forEachCell([&](const std::int32_t x, const std::int32_t y, const std::uint32_t rawGid)
+            {
+                if (gidInfo(rawGid))
+                    usedChunks.push_back(chunkKey(floorDiv(x, chunkSize), floorDiv(y, chunkSize)));
+            });
+            std::ranges::sort(usedChunks);
+            usedChunks.erase(std::unique(usedChunks.begin(), usedChunks.end()), usedChunks.end());
+
+            for (const std::uint64_t key : usedChunks)
+            {
+                const auto chunkX = static_cast<std::int32_t>(static_cast<std::uint32_t>(key) ^ 0x80000000u);
+                const auto chunkY = static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32) ^ 0x80000000u);
+                TileBlock block{chunkX * chunkSize, chunkY * chunkSize, static_cast<std::uint32_t>(chunkSize),
+                                static_cast<std::uint32_t>(chunkSize), static_cast<std::uint32_t>(layerData.gids.size())};
+
+                // Finite layers clip their edge blocks to the layer size
+                if (layer.chunks.empty())
+                {
+                    block.width = std::min<std::uint32_t>(block.width, layer.width - static_cast<std::uint32_t>(block.x));
+                    block.height = std::min<std::uint32_t>(block.height, layer.height - static_cast<std::uint32_t>(block.y));
+                }
+
+                layerData.chunks.push_back({chunkX, chunkY, {}, static_cast<std::uint32_t>(layerData.tileBlocks.size()), 1});
+                layerData.tileBlocks.push_back(block);
+                layerData.gids.resize(layerData.gids.size() + block.width * block.height, 0);
             }
+
+            withProjection(projection, [&](const auto& grid)
+            {
+                forEachCell([&](const std::int32_t x, const std::int32_t y, const std::uint32_t rawGid)
+                {
+                    if (!gidInfo(rawGid))
+                        return;
+
+                    const auto it = std::ranges::lower_bound(usedChunks, chunkKey(floorDiv(x, chunkSize), floorDiv(y, chunkSize)));
+                    const auto blockIndex = static_cast<std::size_t>(it - usedChunks.begin());
+                    const auto& block = layerData.tileBlocks[blockIndex];
+                    layerData.gids[block.offset + static_cast<std::uint32_t>(y - block.y) * block.width +
+                                   static_cast<std::uint32_t>(x - block.x)] = rawGid;
+                    layerData.chunks[blockIndex].bounds.merge(cellBounds(grid, x, y, cellWidth, cellHeight));
+                });
+            });
+        }
+        else if (packed)
+        {
+            withProjection(projection, [&](const auto& grid)
+            {
+                emitTiles(layer, layerData, layerData.packedTiles, resolveThreadCount(options.threadCount), grid);
+            });
+        }
+        else
+        {
+            withProjection(projection, [&](const auto& grid)
+            {
+                emitTiles(layer, layerData, layerData.tiles, resolveThreadCount(options.threadCount), grid);
+            });
+        }
+
+        for (const auto& chunk : layerData.chunks)
+            layerData.bounds.merge(chunk.bounds);
+
+        layerData.indexAnimatedTiles();
+        return layerData;
+    }
+
+    template <typename Tile, typename Projection>
+    void MapRenderData::emitTiles(const map::Layer& layer, LayerRenderData& layerData, std::vector<Tile>& tiles,
+                                  const std::uint32_t threadCount, const Projection& grid) const
+    {
+        const auto chunkSize = static_cast<std::int32_t>(std::max(this->chunkSize, 1u));
+        const auto cellWidth = static_cast<std::int32_t>(std::max(tileWidth, 1u));
+        const auto cellHeight = static_cast<std::int32_t>(std::max(tileHeight, 1u));
+
+        // Pre-calculate rendering information for one cell at tile coordinates (x, y)
+        auto makeAt = [&](const std::int32_t x, const std::int32_t y, const GidRenderInfo& info,
+                          const std::uint32_t rawGid) -> Tile
+        {
+            if constexpr (std::is_same_v<Tile, PackedTileRenderInfo>)
+                return makePackedTile(info, grid.toScreen(x, y), rawGid);
             else
+                return makeTile(info, grid.toScreen(x, y), rawGid, layerData.opacity);
+        };
+
+        // Work is split into bands; counting each band's tiles first and taking an exclusive prefix sum gives
+        // every band its output range, so bands fill one exactly-sized array in the serial order
+        if (!layer.chunks.empty())
+        {
+            // Infinite layers: one band per map chunk, then bucket the tiles into spatial chunks
+            const auto cellsOf = [](const map::Chunk& chunk)
+            {
+                return std::min<std::size_t>(chunk.data.size(), static_cast<std::size_t>(chunk.width) * chunk.height);
+            };
+
+            std::vector<std::uint32_t> offsets(layer.chunks.size() + 1, 0);
+            parallelFor(layer.chunks.size(), threadCount, [&](const std::size_t c)
             {
-                // Process regular tile data for finite maps
-                // Pre-calculate all tile rendering information
-                // Reserve space for worst case (all tiles non-empty)
-                layerData.tiles.reserve(layer.data.size());
+                const auto& chunk = layer.chunks[c];
+                offsets[c + 1] = static_cast<std::uint32_t>(std::count_if(
+                    chunk.data.begin(), chunk.data.begin() + static_cast<std::ptrdiff_t>(cellsOf(chunk)),
+                    [this](const std::uint32_t rawGid) { return gidInfo(rawGid) != nullptr; }));
+            });
+            std::inclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
 
-                for (std::uint32_t y = 0; y < layer.height; ++y)
+            tiles.resize(offsets.back());
+            parallelFor(layer.chunks.size(), threadCount, [&](const std::size_t c)
+            {
+                // chunk.x and chunk.y are in tile coordinates
+                const auto& chunk = layer.chunks[c];
+                std::uint32_t out = offsets[c];
+                for (std::uint32_t index = 0; index < cellsOf(chunk); ++index)
                 {
-                    for (std::uint32_t x = 0; x < layer.width; ++x)
+                    if (const GidRenderInfo* info = gidInfo(chunk.data[index]))
                     {
-                        const std::uint32_t index = y * layer.width + x;
-                        if (index >= layer.data.size())
-                            continue;
+                        tiles[out++] = makeAt(chunk.x + static_cast<std::int32_t>(index % chunk.width),
+                                              chunk.y + static_cast<std::int32_t>(index / chunk.width), *info,
+                                              chunk.data[index]);
+                    }
+                }
+            });
+            layerData.chunks = bucketTiles(tiles, grid, cellWidth, cellHeight, chunkSize);
+            return;
+        }
 
-                        const std::uint32_t gid = layer.data[index];
-                        if (gid == 0)
-                            continue; // Skip empty tiles
+        // Finite layers: one band per row of spatial chunks, written directly in bucketed order
+        const std::uint32_t size = static_cast<std::uint32_t>(chunkSize);
+        const std::uint32_t chunksX = (layer.width + size - 1) / size;
+        const std::uint32_t chunksY = (layer.height + size - 1) / size;
+        const std::size_t cells = std::min<std::size_t>(layer.data.size(), static_cast<std::size_t>(layer.width) * layer.height);
 
-                        // Find which tileset this tile belongs to
-                        std::uint32_t tilesetIndex = 0;
-                        const map::Tileset* tileset = nullptr;
+        // Visit the cells of one spatial chunk in row-major order
+        auto forEachCellOf = [&](const std::uint32_t chunkX, const std::uint32_t chunkY, auto&& cellVisitor)
+        {
+            const std::uint32_t endX = std::min(layer.width, (chunkX + 1) * size);
+            const std::uint32_t endY = std::min(layer.height, (chunkY + 1) * size);
+            for (std::uint32_t y = chunkY * size; y < endY; ++y)
+            {
+                for (std::uint32_t x = chunkX * size; x < endX; ++x)
+                {
+                    const std::size_t index = static_cast<std::size_t>(y) * layer.width + x;
+                    if (index < cells)
+                        cellVisitor(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y), layer.data[index]);
+                }
+            }
+        };
 
-                        for (std::uint32_t i = 0; i < map.tilesets.size(); ++i)
-                        {
-                            if (gid >= map.tilesets[i].firstgid)
-                            {
-                                // Check if this is the right tileset
-                                if (i + 1 >= map.tilesets.size() || gid < map.tilesets[i + 1].firstgid)
-                                {
-                                    tilesetIndex = i;
-                                    tileset = &map.tilesets[i];
-                                    break;
-                                }
-                            }
-                        }
+        std::vector<std::uint32_t> offsets(static_cast<std::size_t>(chunksX) * chunksY + 1, 0);
+        parallelFor(chunksY, threadCount, [&](const std::size_t chunkY)
+        {
+            for (std::uint32_t chunkX = 0; chunkX < chunksX; ++chunkX)
+            {
+                std::uint32_t count = 0;
+                forEachCellOf(chunkX, static_cast<std::uint32_t>(chunkY), [&](std::int32_t, std::int32_t, const std::uint32_t rawGid)
+                {
+                    count += gidInfo(rawGid) != nullptr ? 1 : 0;
+                });
+                offsets[chunkY * chunksX + chunkX + 1] = count;
+            }
+        });
+        std::inclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
 
-                        if (!tileset)
-                            continue; // Invalid tile
-
-                        // Calculate tile ID (subtract firstgid)
-                        const std::uint32_t tileId = gid - tileset->firstgid;
-
-                        // Pre-calculate source position in tileset
-                        const std::uint32_t tileX = (tileId % tileset->columns) * tileset->tilewidth;
-                        const std::uint32_t tileY = (tileId / tileset->columns) * tileset->tileheight;
-
-                        // Pre-calculate destination position on screen
-                        const std::uint32_t destX = x * map.tilewidth;
-                        const std::uint32_t destY = y * map.tileheight;
-
-                        // Create tile render info
-                        TileRenderInfo tileInfo{};
-                        tileInfo.tileId = tileId;
-                        tileInfo.srcX = tileX;
-                        tileInfo.srcY = tileY;
-                        tileInfo.srcW = tileset->tilewidth;
-                        tileInfo.srcH = tileset->tileheight;
-                        tileInfo.destX = destX;
-                        tileInfo.destY = destY;
-                        tileInfo.destW = map.tilewidth;
-                        tileInfo.destH = map.tileheight;
-                        tileInfo.tilesetIndex = tilesetIndex;
-                        tileInfo.opacity = layer.opacity;
-
-                        // Check if this tile has an animation
-                        tileInfo.isAnimated = false;
-                        tileInfo.animationIndex = static_cast<std::uint32_t>(-1);
-
-                        const auto& tilesetRenderInfo = renderData.tilesets[tilesetIndex];
-                        for (std::uint32_t animIdx = 0; animIdx < tilesetRenderInfo.animations.size(); ++animIdx)
-                        {
-                            if (tilesetRenderInfo.animations[animIdx].baseTileId == tileId)
-                            {
-                                tileInfo.isAnimated = true;
-                                tileInfo.animationIndex = animIdx;
-                                break;
-                            }
-                        }
+        tiles.resize(offsets.back());
+        std::vector<RenderBounds> bounds(static_cast<std::size_t>(chunksX) * chunksY);
+        parallelFor(chunksY, threadCount, [&](const std::size_t chunkY)
+        {
+            for (std::uint32_t chunkX = 0; chunkX < chunksX; ++chunkX)
+            {
+                const std::size_t chunkIndex = chunkY * chunksX + chunkX;
+                std::uint32_t out = offsets[chunkIndex];
+                forEachCellOf(chunkX, static_cast<std::uint32_t>(chunkY), [&](const std::int32_t x, const std::int32_t y,
+                                                                             const std::uint32_t rawGid)
+                {
+                    const GidRenderInfo* info = gidInfo(rawGid);
+                    if (!info)
+                        return; // Empty or invalid tile
 
-                        layerData.tiles.push_back(std::move(tileInfo));
-                    }
+                    tiles[out++] = makeAt(x, y, *info, rawGid);
+                    bounds[chunkIndex].merge(cellBounds(grid, x, y, cellWidth, cellHeight));
+                });
+            }
+        });
+
+        for (std::uint32_t chunkY = 0; chunkY < chunksY; ++chunkY)
+        {
+            for (std::uint32_t chunkX = 0; chunkX < chunksX; ++chunkX)
+            {
+                const std::size_t chunkIndex = static_cast<std::size_t>(chunkY) * chunksX + chunkX;
+                const std::uint32_t count = offsets[chunkIndex + 1] - offsets[chunkIndex];
+                if (count > 0)
+                {
+                    layerData.chunks.push_back({static_cast<std::int32_t>(chunkX), static_cast<std::int32_t>(chunkY),
+                                                bounds[chunkIndex], offsets[chunkIndex], count});
+                }
+            }
+        }
+    }
+
+    auto MapRenderData::cellsOf(const ViewRect& view) const -> CellRect
+    {
+        // Orthogonal chunks are squares on screen; other chunks' bounding boxes reach past their cells, so the view
+        // is first grown by the size of a chunk
+        return withProjection(projection, [&](const auto& grid)
+        {
+            float reachX = 0.0f, reachY = 0.0f;
+            if constexpr (!std::is_same_v<std::decay_t<decltype(grid)>, OrthogonalProjection>)
+            {
+                reachX = static_cast<float>(std::max(tileWidth, 1u) * chunkSize);
+                reachY = static_cast<float>(std::max(tileHeight, 1u) * chunkSize);
+            }
+            return grid.cellsOverlapping(view.x - reachX, view.y - reachY, view.x + view.width + reachX,
+                                         view.y + view.height + reachY);
+        });
+    }
+
+    void MapRenderData::queryChunks(const std::uint32_t layerIdx, const ViewRect& view, const CellRect& cells,
+                                    std::vector<ChunkRange>& ranges) const
+    {
+        const auto& layer = layers[layerIdx];
+        if (!layer.bounds.intersects(view))
+            return;
+
+        const auto size = static_cast<std::int32_t>(std::max(chunkSize, 1u));
+
+        // Chunk coordinates covered by the view, clamped to the layer so huge views stay cheap
+        const auto& chunks = layer.chunks;
+        const auto firstX = floorDiv(cells.minX, size);
+        const auto lastX = floorDiv(cells.maxX - 1, size);
+        const auto firstY = std::max(floorDiv(cells.minY, size), chunks.front().chunkY);
+        const auto lastY = std::min(floorDiv(cells.maxY - 1, size), chunks.back().chunkY);
+
+        auto begin = chunks.begin();
+        for (std::int32_t chunkY = firstY; chunkY <= lastY && begin != chunks.end(); ++chunkY)
+        {
+            // Chunks are sorted by row, so each row of the view is one binary search plus a linear walk
+            begin = std::lower_bound(begin, chunks.end(), chunkKey(firstX, chunkY),
+                                     [](const SpatialChunk& chunk, const std::uint64_t key)
+                                     {
+                                         return chunkKey(chunk.chunkX, chunk.chunkY) < key;
+                                     });
+            for (; begin != chunks.end() && begin->chunkY == chunkY && begin->chunkX <= lastX; ++begin)
+            {
+                if (!begin->bounds.intersects(view))
+                    continue;
+
+                const auto chunkIdx = static_cast<std::uint32_t>(begin - chunks.begin());
+                if (!ranges.empty() && ranges.back().layerIndex == layerIdx &&
+                    ranges.back().first + ranges.back().count == chunkIdx)
+                {
+                    ++ranges.back().count;
+                }
+                else
+                {
+                    ranges.push_back({layerIdx, chunkIdx, 1});
                 }
             }
+        }
+    }
+
+    void MapRenderData::query(const ViewRect& viewRect, std::vector<ChunkRange>& ranges) const
+    {
+        ranges.clear();
+        if (viewRect.width <= 0.0f || viewRect.height <= 0.0f)
+            return;
 
-            // Shrink to fit to save memory
-            layerData.tiles.shrink_to_fit();
-            renderData.layers.push_back(std::move(layerData));
+        const CellRect mapCells = cellsOf(viewRect);
+        for (std::uint32_t layerIdx = 0; layerIdx < layers.size(); ++layerIdx)
+        {
+            // Layers with an offset or parallax see the view moved into their own coordinates
+            const auto& transform = layers[layerIdx].transform;
+            const bool moved = transform.offsetX != 0.0f || transform.offsetY != 0.0f || transform.parallaxX != 1.0f ||
+                transform.parallaxY != 1.0f;
+            const ViewRect view = moved ? transform.toLayer(viewRect) : viewRect;
+            queryChunks(layerIdx, view, moved ? cellsOf(view) : mapCells, ranges);
         }
+    }
 
-        // Process object groups
-        renderData.objectGroups.reserve(map.objectgroups.size());
-        for (const auto& objectGroup : map.objectgroups)
+    void MapRenderData::queryLayer(const std::uint32_t layerIndex, const ViewRect& layerRect,
+                                   std::vector<ChunkRange>& ranges) const
+    {
+        if (layerIndex >= layers.size() || layerRect.width <= 0.0f || layerRect.height <= 0.0f)
+            return;
+        queryChunks(layerIndex, layerRect, cellsOf(layerRect), ranges);
+    }
+
+    auto MapRenderData::setTile(const std::uint32_t layerIndex, const std::int32_t x, const std::int32_t y,
+                                const std::uint32_t gid) -> bool
+    {
+        return fillRect(layerIndex, x, y, 1, 1, gid);
+    }
+
+    auto MapRenderData::fillRect(const std::uint32_t layerIndex, const std::int32_t x, const std::int32_t y,
+                                 const std::uint32_t width, const std::uint32_t height, const std::uint32_t gid) -> bool
+    {
+        if (layerIndex >= layers.size())
+            return false;
+
+        // Finite maps only have cells inside the map
+        std::int64_t minX = x, minY = y;
+        std::int64_t maxX = minX + width, maxY = minY + height;
+        if (!infinite)
         {
-            ObjectGroupRenderData objectGroupData;
-            objectGroupData.name = objectGroup.name;
-            objectGroupData.visible = objectGroup.visible;
-            objectGroupData.opacity = objectGroup.opacity;
+            minX = std::max<std::int64_t>(minX, 0);
+            minY = std::max<std::int64_t>(minY, 0);
+            maxX = std::min<std::int64_t>(maxX, mapWidth);
+            maxY = std::min<std::int64_t>(maxY, mapHeight);
+        }
+        maxX = std::min<std::int64_t>(maxX, INT32_MAX);
+        maxY = std::min<std::int64_t>(maxY, INT32_MAX);
+        if (minX >= maxX || minY >= maxY)
+            return false;
 
-            // Process objects
-            objectGroupData.objects.reserve(objectGroup.objects.size());
-            for (const auto& object : objectGroup.objects)
+        const CellRect rect{static_cast<std::int32_t>(minX), static_cast<std::int32_t>(minY),
+                            static_cast<std::int32_t>(maxX), static_cast<std::int32_t>(maxY)};
+        const auto size = static_cast<std::int32_t>(std::max(chunkSize, 1u));
+        for (std::int32_t chunkY = floorDiv(rect.minY, size); chunkY <= floorDiv(rect.maxY - 1, size); ++chunkY)
+        {
+            for (std::int32_t chunkX = floorDiv(rect.minX, size); chunkX <= floorDiv(rect.maxX - 1, size); ++chunkX)
+            {
+                const std::int64_t chunkMinX = static_cast<std::int64_t>(chunkX) * size;
+                const std::int64_t chunkMinY = static_cast<std::int64_t>(chunkY) * size;
+                const CellRect cells{
+                    static_cast<std::int32_t>(std::max<std::int64_t>(rect.minX, chunkMinX)),
+                    static_cast<std::int32_t>(std::max<std::int64_t>(rect.minY, chunkMinY)),
+                    static_cast<std::int32_t>(std::min<std::int64_t>(rect.maxX, chunkMinX + size)),
+                    static_cast<std::int32_t>(std::min<std::int64_t>(rect.maxY, chunkMinY + size))};
+                editChunk(layerIndex, chunkX, chunkY, cells, gid);
+            }
+        }
+
+        // Edits can empty or add chunks anywhere in the layer
+        auto& layer = layers[layerIndex];
+        layer.bounds = {};
+        for (const auto& chunk : layer.chunks)
+            layer.bounds.merge(chunk.bounds);
+        return true;
+    }
+
+    void MapRenderData::editChunk(const std::uint32_t layerIndex, const std::int32_t chunkX, const std::int32_t chunkY,
+                                  const CellRect& cells, const std::uint32_t gid)
+    {
+        auto& layer = layers[layerIndex];
+        const auto cellWidth = static_cast<std::int32_t>(std::max(tileWidth, 1u));
+        const auto cellHeight = static_cast<std::int32_t>(std::max(tileHeight, 1u));
+        RenderBounds bounds;
+        const bool edited = withProjection(projection, [&](const auto& grid)
+        {
+            bounds = cellRectBounds(grid, cells, cellWidth, cellHeight);
+            if (layer.storage == TileStorage::Packed)
+                return spliceChunk(layer, layer.packedTiles, chunkX, chunkY, cells, gid, grid);
+            if (layer.storage == TileStorage::Indexed)
+                return editIndexedChunk(layer, chunkX, chunkY, cells, gid, grid);
+            return spliceChunk(layer, layer.tiles, chunkX, chunkY, cells, gid, grid);
+        });
+        if (!edited)
+            return;
+
+        // Coalesce edits of the same chunk into one region
+        const auto region = std::ranges::find_if(dirtyRegions, [&](const DirtyRegion& dirty)
+        {
+            return dirty.layerIndex == layerIndex && dirty.chunkX == chunkX && dirty.chunkY == chunkY;
+        });
+        if (region != dirtyRegions.end())
+            region->bounds.merge(bounds);
+        else
+            dirtyRegions.push_back({layerIndex, chunkX, chunkY, bounds});
+    }
+
+    template <typename Tile, typename Projection>
+    auto MapRenderData::spliceChunk(LayerRenderData& layer, std::vector<Tile>& tiles, const std::int32_t chunkX,
+                                    const std::int32_t chunkY, const CellRect& cells, const std::uint32_t gid,
+                                    const Projection& grid) const -> bool
+    {
+        const auto cellWidth = static_cast<std::int32_t>(std::max(tileWidth, 1u));
+        const auto cellHeight = static_cast<std::int32_t>(std::max(tileHeight, 1u));
+        const GidRenderInfo* info = gidInfo(gid);
+
+        const auto found = findChunk(layer.chunks, chunkX, chunkY);
+        const auto chunkIndex = static_cast<std::size_t>(found - layer.chunks.begin());
+        const bool exists = found != layer.chunks.end() && found->chunkX == chunkX && found->chunkY == chunkY;
+        if (!exists && !info)
+            return false; // Clearing cells of a chunk without tiles
+
+        const std::uint32_t first = exists ? found->first
+                                  : found != layer.chunks.end() ? found->first
+                                  : static_cast<std::uint32_t>(tiles.size());
+        const std::uint32_t oldCount = exists ? found->count : 0;
+
+        // New run of the chunk: its tiles outside the edited cells, plus the edited cells, in row-major order
+        std::vector<Tile> run;
+        run.reserve(oldCount + static_cast<std::size_t>(cells.maxX - cells.minX) * (cells.maxY - cells.minY));
+        for (std::uint32_t i = first; i < first + oldCount; ++i)
+        {
+            const CellPoint cell = grid.toCell({tiles[i].destX, tiles[i].destY});
+            if (cell.x < cells.minX || cell.x >= cells.maxX || cell.y < cells.minY || cell.y >= cells.maxY)
+                run.push_back(tiles[i]);
+        }
+        if (info)
+        {
+            for (std::int32_t y = cells.minY; y < cells.maxY; ++y)
             {
-                ObjectRenderInfo objectInfo;
-                objectInfo.id = object.id;
-                objectInfo.name = object.name;
-                objectInfo.type = object.type;
-                objectInfo.x = object.x;
-                objectInfo.y = object.y;
-                objectInfo.width = object.width;
-                objectInfo.height = object.height;
-                objectInfo.rotation = object.rotation;
-                objectInfo.visible = object.visible;
-                objectInfo.shape = object.shape;
-                objectInfo.points = object.points;
-                objectInfo.gid = object.gid;
-
-                // If this is a tile object (gid != 0), pre-calculate tile rendering info
-                if (object.gid != 0)
+                for (std::int32_t x = cells.minX; x < cells.maxX; ++x)
                 {
-                    // Find which tileset this GID belongs to
-                    for (std::uint32_t tilesetIdx = 0; tilesetIdx < renderData.tilesets.size(); ++tilesetIdx)
-                    {
-                        const auto& tilesetInfo = renderData.tilesets[tilesetIdx];
-                        if (object.gid >= tilesetInfo.firstgid &&
-                            (tilesetIdx + 1 >= renderData.tilesets.size() ||
-                                object.gid < renderData.tilesets[tilesetIdx + 1].firstgid))
-                        {
-                            objectInfo.tilesetIndex = tilesetIdx;
-
-                            // Calculate tile ID and source position
-                            const std::uint32_t tileId = object.gid - tilesetInfo.firstgid;
-                            objectInfo.srcX = (tileId % tilesetInfo.columns) * tilesetInfo.tileWidth;
-                            objectInfo.srcY = (tileId / tilesetInfo.columns) * tilesetInfo.tileHeight;
-                            objectInfo.srcW = tilesetInfo.tileWidth;
-                            objectInfo.srcH = tilesetInfo.tileHeight;
-                            break;
-                        }
-                    }
+                    if constexpr (std::is_same_v<Tile, PackedTileRenderInfo>)
+                        run.push_back(makePackedTile(*info, grid.toScreen(x, y), gid));
+                    else
+                        run.push_back(makeTile(*info, grid.toScreen(x, y), gid, layer.opacity));
                 }
+            }
+        }
+        std::ranges::sort(run, {}, [&grid](const Tile& tile)
+        {
+            const CellPoint cell = grid.toCell({tile.destX, tile.destY});
+            return chunkKey(cell.x, cell.y);
+        });
+
+        // Splice the run in place of the old one; later tiles move by one memmove
+        const auto newCount = static_cast<std::uint32_t>(run.size());
+        const auto at = tiles.begin() + first;
+        if (newCount > oldCount)
+            tiles.insert(at + oldCount, newCount - oldCount, Tile{});
+        else if (newCount < oldCount)
+            tiles.erase(at + newCount, at + oldCount);
+        std::ranges::copy(run, tiles.begin() + first);
+        relinkAnimatedTiles(layer, first, oldCount, std::span<const Tile>(run));
 
-                objectGroupData.objects.push_back(std::move(objectInfo));
+        // Keep chunks sorted and contiguous
+        for (std::size_t i = chunkIndex + (exists ? 1 : 0); i < layer.chunks.size(); ++i)
+            layer.chunks[i].first = layer.chunks[i].first - oldCount + newCount;
+
+        if (newCount == 0)
+        {
+            layer.chunks.erase(layer.chunks.begin() + static_cast<std::ptrdiff_t>(chunkIndex));
+            return true;
+        }
+
+        RenderBounds bounds;
+        for (const auto& tile : run)
+            bounds.merge({tile.destX, tile.destY, tile.destX + cellWidth, tile.destY + cellHeight});
+        if (exists)
+        {
+            layer.chunks[chunkIndex].count = newCount;
+            layer.chunks[chunkIndex].bounds = bounds;
+        }
+        else
+        {
+            layer.chunks.insert(layer.chunks.begin() + static_cast<std::ptrdiff_t>(chunkIndex),
+                                {chunkX, chunkY, bounds, first, newCount});
+        }
+        return true;
+    }
+
+    template <typename Projection>
+    auto MapRenderData::editIndexedChunk(LayerRenderData& layer, const std::int32_t chunkX, const std::int32_t chunkY,
+                                         const CellRect& cells, const std::uint32_t gid, const Projection& grid) const
+        -> bool
+    {
+        const auto size = static_cast<std::int32_t>(std::max(chunkSize, 1u));
+        const auto cellWidth = static_cast<std::int32_t>(std::max(tileWidth, 1u));
+        const auto cellHeight = static_cast<std::int32_t>(std::max(tileHeight, 1u));
+        const std::uint32_t value = gidInfo(gid) ? gid : 0; // Blocks never hold GIDs outside every tileset
+
+        const auto found = findChunk(layer.chunks, chunkX, chunkY);
+        const auto chunkIndex = static_cast<std::size_t>(found - layer.chunks.begin());
+        if (found == layer.chunks.end() || found->chunkX != chunkX || found->chunkY != chunkY)
+        {
+            if (value == 0)
+                return false; // Clearing cells of a chunk without tiles
+
+            // Allocate a block for the chunk, clipped to finite maps like buildLayer does
+            TileBlock block{chunkX * size, chunkY * size, static_cast<std::uint32_t>(size),
+                            static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(layer.gids.size())};
+            if (!infinite)
+            {
+                block.width = std::min<std::uint32_t>(block.width, mapWidth - static_cast<std::uint32_t>(block.x));
+                block.height = std::min<std::uint32_t>(block.height, mapHeight - static_cast<std::uint32_t>(block.y));
             }
+            layer.chunks.insert(found, {chunkX, chunkY, {}, static_cast<std::uint32_t>(layer.tileBlocks.size()), 1});
+            layer.tileBlocks.push_back(block);
+            layer.gids.resize(layer.gids.size() + block.width * block.height, 0);
+        }
 
-            objectGroupData.objects.shrink_to_fit();
-            renderData.objectGroups.push_back(std::move(objectGroupData));
+        // Chunks of cleared blocks stay, with empty bounds, so their block can be reused
+        auto& chunk = layer.chunks[chunkIndex];
+        const auto& block = layer.tileBlocks[chunk.first];
+        std::uint32_t* cellsOfBlock = layer.gids.data() + block.offset;
+        const std::int32_t maxX = std::min(cells.maxX, block.x + static_cast<std::int32_t>(block.width));
+        const std::int32_t maxY = std::min(cells.maxY, block.y + static_cast<std::int32_t>(block.height));
+        for (std::int32_t y = std::max(cells.minY, block.y); y < maxY; ++y)
+        {
+            for (std::int32_t x = std::max(cells.minX, block.x); x < maxX; ++x)
+            {
+                cellsOfBlock[static_cast<std::uint32_t>(y - block.y) * block.width +
+                             static_cast<std::uint32_t>(x - block.x)] = value;
+            }
         }
 
-        return renderData;
+        chunk.bounds = {};
+        for (std::uint32_t y = 0; y < block.height; ++y)
+        {
+            for (std::uint32_t x = 0; x < block.width; ++x)
+            {
+                if (cellsOfBlock[y * block.width + x] == 0)
+                    continue;
+                chunk.bounds.merge(cellBounds(grid, block.x + static_cast<std::int32_t>(x),
+                                              block.y + static_cast<std::int32_t>(y), cellWidth, cellHeight));
+            }
+        }
+        return true;
     }
 }
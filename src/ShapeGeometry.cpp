@@ -0,0 +1,194 @@
+#include <tmx/ShapeGeometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+
+namespace tmx::render
+{
+    auto objectBounds(const ObjectRenderInfo& object, std::span<const map::Point> points) -> ObjectBounds
+    {
+        const double radians = static_cast<double>(object.rotation) * std::numbers::pi / 180.0;
+        const double cosine = object.rotation == 0.0f ? 1.0 : std::cos(radians);
+        const double sine = object.rotation == 0.0f ? 0.0 : std::sin(radians);
+
+        // Grow the box by points relative to (x, y), rotated clockwise about it
+        double minX = std::numeric_limits<double>::infinity(), minY = minX;
+        double maxX = -minX, maxY = -minX;
+        const auto add = [&](const double localX, const double localY, const double extentX, const double extentY)
+        {
+            const double x = object.x + localX * cosine - localY * sine;
+            const double y = object.y + localX * sine + localY * cosine;
+            minX = std::min(minX, x - extentX);
+            minY = std::min(minY, y - extentY);
+            maxX = std::max(maxX, x + extentX);
+            maxY = std::max(maxY, y + extentY);
+        };
+
+        if (object.shape == map::ObjectShape::Polygon || object.shape == map::ObjectShape::Polyline)
+        {
+            for (const auto& point : points)
+                add(point.x, point.y, 0.0, 0.0);
+            if (points.empty())
+                add(0.0, 0.0, 0.0, 0.0);
+        }
+        else if (object.shape == map::ObjectShape::Point)
+        {
+            add(0.0, 0.0, 0.0, 0.0);
+        }
+        else if (object.shape == map::ObjectShape::Ellipse && object.gid == 0)
+        {
+            // A rotated ellipse reaches sqrt((a cos)^2 + (b sin)^2) from its center horizontally, and likewise
+            // vertically with the terms swapped
+            const double a = object.width / 2.0;
+            const double b = object.height / 2.0;
+            add(a, b, std::hypot(a * cosine, b * sine), std::hypot(a * sine, b * cosine));
+        }
+        else
+        {
+            double width = object.width;
+            double height = object.height;
+            double top = 0.0;
+            if (object.gid != 0)
+            {
+                // Tile objects are anchored at their bottom-left corner
+                width = width > 0.0 ? width : object.srcW;
+                height = height > 0.0 ? height : object.srcH;
+                top = -height;
+            }
+            add(0.0, top, 0.0, 0.0);
+            add(width, top, 0.0, 0.0);
+            add(0.0, top + height, 0.0, 0.0);
+            add(width, top + height, 0.0, 0.0);
+        }
+
+        return {static_cast<float>(minX), static_cast<float>(minY), static_cast<float>(maxX), static_cast<float>(maxY)};
+    }
+
+    auto triangulatePolygon(std::span<const map::Point> polygon, std::vector<ShapeTriangle>& triangles)
+        -> std::uint32_t
+    {
+        const std::size_t first = triangles.size();
+        if (polygon.size() < 3)
+            return 0;
+
+        // Signed area gives the winding; corners turning the same way are convex
+        double area = 0.0;
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+        {
+            const auto& a = polygon[i];
+            const auto& b = polygon[(i + 1) % polygon.size()];
+            area += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+        }
+        if (area == 0.0)
+            return 0;
+        const double winding = area > 0.0 ? 1.0 : -1.0;
+        const auto turn = [&](const std::uint32_t a, const std::uint32_t b, const std::uint32_t c)
+        {
+            const auto& pa = polygon[a];
+            const auto& pb = polygon[b];
+            const auto& pc = polygon[c];
+            return ((static_cast<double>(pb.x) - pa.x) * (static_cast<double>(pc.y) - pa.y) -
+                    (static_cast<double>(pb.y) - pa.y) * (static_cast<double>(pc.x) - pa.x)) * winding;
+        };
+
+        std::vector<std::uint32_t> remaining(polygon.size());
+        std::iota(remaining.begin(), remaining.end(), 0u);
+
+        // Clip ears: convex corners whose triangle holds no other corner. A full pass without one (only possible
+        // for self-intersecting outlines) relaxes the test to any convex corner, then to any corner.
+        std::size_t i = 0;
+        std::size_t sinceClip = 0;
+        int relaxation = 0;
+        while (remaining.size() > 3)
+        {
+            const std::size_t count = remaining.size();
+            i %= count;
+            const std::uint32_t prev = remaining[(i + count - 1) % count];
+            const std::uint32_t current = remaining[i];
+            const std::uint32_t next = remaining[(i + 1) % count];
+            const double corner = turn(prev, current, next);
+
+            bool clip = corner == 0.0 || relaxation == 2; // Collinear corners go without a triangle
+            if (!clip && corner > 0.0)
+            {
+                clip = true;
+                for (std::size_t j = 0; j < count && relaxation == 0; ++j)
+                {
+                    const std::uint32_t other = remaining[j];
+                    if (other == prev || other == current || other == next)
+                        continue;
+                    if (turn(prev, current, other) >= 0.0 && turn(current, next, other) >= 0.0 &&
+                        turn(next, prev, other) >= 0.0)
+                        clip = false;
+                }
+            }
+
+            if (!clip)
+            {
+                ++i;
+                if (++sinceClip >= count)
+                {
+                    relaxation = std::min(relaxation + 1, 2);
+                    sinceClip = 0;
+                }
+                continue;
+            }
+            if (corner != 0.0)
+                triangles.push_back({prev, current, next});
+            remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(i));
+            sinceClip = 0;
+            relaxation = 0;
+        }
+        if (turn(remaining[0], remaining[1], remaining[2]) != 0.0)
+            triangles.push_back({remaining[0], remaining[1], remaining[2]});
+        return static_cast<std::uint32_t>(triangles.size() - first);
+    }
+
+    auto measurePath(std::span<const map::Point> points, const bool closed, std::vector<float>& distances) -> float
+    {
+        double length = 0.0;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            if (i > 0)
+                length += std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+            distances.push_back(static_cast<float>(length));
+        }
+        if (closed && points.size() > 1)
+            length += std::hypot(points.front().x - points.back().x, points.front().y - points.back().y);
+        return static_cast<float>(length);
+    }
+
+    auto pointAlongPath(std::span<const map::Point> points, std::span<const float> distances, const float length,
+                        const bool closed, float distance) -> map::Point
+    {
+        if (points.empty())
+            return {0.0f, 0.0f};
+        if (points.size() == 1 || distances.size() != points.size() || !(length > 0.0f))
+            return points.front();
+
+        if (closed)
+        {
+            distance = std::fmod(distance, length);
+            if (distance < 0.0f)
+                distance += length;
+        }
+        else
+        {
+            distance = std::clamp(distance, 0.0f, length);
+        }
+
+        // Segment holding the distance: from the last point at or before it to the next, or back to the first
+        const auto after = std::upper_bound(distances.begin(), distances.end(), distance);
+        const auto index = static_cast<std::size_t>(after - distances.begin()) - 1;
+        if (index + 1 == points.size() && !closed)
+            return points.back();
+        const map::Point& from = points[index];
+        const map::Point& to = index + 1 < points.size() ? points[index + 1] : points.front();
+        const float end = index + 1 < points.size() ? distances[index + 1] : length;
+        const float segment = end - distances[index];
+        const float t = segment > 0.0f ? std::clamp((distance - distances[index]) / segment, 0.0f, 1.0f) : 0.0f;
+        return {from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t};
+    }
+}
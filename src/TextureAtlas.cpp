@@ -0,0 +1,335 @@
+#include <tmx/TextureAtlas.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace tmx::render
+{
+    namespace
+    {
+        constexpr std::uint32_t NO_INDEX = 0xFFFFFFFF;
+
+        // Tiles of one source tileset selected for packing, with the tiles linked by animations joined together
+        struct SourceTiles
+        {
+            std::vector<std::uint8_t> included; // Indexed by tile ID
+            std::vector<std::uint32_t> parent; // Union-find forest over tile IDs
+        };
+
+        struct PageLayout
+        {
+            std::uint32_t tileWidth, tileHeight;
+            std::uint32_t maxColumns, maxRows;
+            std::vector<AtlasTile> tiles;
+        };
+
+        auto findRoot(std::vector<std::uint32_t>& parent, std::uint32_t id) -> std::uint32_t
+        {
+            while (parent[id] != id)
+            {
+                parent[id] = parent[parent[id]];
+                id = parent[id];
+            }
+            return id;
+        }
+
+        // Page width or height holding count tiles: padding, then count tiles each followed by extrusion and padding
+        auto pageExtent(const std::uint32_t count, const std::uint32_t tileSize, const AtlasOptions& options)
+            -> std::uint64_t
+        {
+            return options.padding + static_cast<std::uint64_t>(count) * (tileSize + 2 * options.extrusion + options.padding);
+        }
+
+        auto maxTilesAlong(const std::uint32_t tileSize, const AtlasOptions& options) -> std::uint32_t
+        {
+            const std::uint64_t pitch = pageExtent(1, tileSize, options) - options.padding;
+            return options.maxPageSize > options.padding
+                       ? static_cast<std::uint32_t>((options.maxPageSize - options.padding) / pitch)
+                       : 0;
+        }
+    }
+
+    auto packAtlas(MapRenderData& renderData, const AtlasOptions& options) -> tl::expected<TextureAtlas, std::string>
+    {
+        const auto& tilesets = renderData.tilesets;
+        std::vector<SourceTiles> sources(tilesets.size());
+        auto include = [&](const std::uint32_t tilesetIndex, const std::uint32_t tileId)
+        {
+            if (tilesetIndex >= sources.size())
+                return;
+            auto& included = sources[tilesetIndex].included;
+            if (tileId >= included.size())
+                included.resize(tileId + 1, 0);
+            included[tileId] = 1;
+        };
+
+        // Select the tiles: everything in the tilesets, or what the layers and tile objects draw
+        for (std::uint32_t tilesetIndex = 0; tilesetIndex < tilesets.size() && !options.usedTilesOnly; ++tilesetIndex)
+        {
+            for (std::uint32_t tileId = 0; tileId < tilesets[tilesetIndex].tileCount; ++tileId)
+                include(tilesetIndex, tileId);
+        }
+        for (const auto& layer : renderData.layers)
+        {
+            for (const auto& tile : layer.tiles)
+                include(tile.tilesetIndex, tile.tileId);
+            for (const auto& tile : layer.packedTiles)
+                include(tile.tilesetIndex, tile.tileId());
+            for (const std::uint32_t gid : layer.gids)
+            {
+                if (const GidRenderInfo* info = renderData.gidInfo(gid))
+                    include(info->tilesetIndex, info->tileId);
+            }
+        }
+        for (const auto& group : renderData.objectGroups)
+        {
+            for (const auto& object : group.objects)
+            {
+                if (const GidRenderInfo* info = renderData.gidInfo(object.gid))
+                    include(info->tilesetIndex, info->tileId);
+            }
+        }
+
+        // Animated tiles bring their frames, which may be animated themselves; all of them share a page
+        for (std::uint32_t tilesetIndex = 0; tilesetIndex < tilesets.size(); ++tilesetIndex)
+        {
+            const auto& animations = tilesets[tilesetIndex].animations;
+            auto& source = sources[tilesetIndex];
+            for (bool grown = true; grown;)
+            {
+                grown = false;
+                for (const auto& animation : animations)
+                {
+                    if (animation.baseTileId >= source.included.size() || !source.included[animation.baseTileId])
+                        continue;
+                    for (const auto& frame : animation.frames)
+                    {
+                        if (frame.tileId >= source.included.size() || !source.included[frame.tileId])
+                        {
+                            include(tilesetIndex, frame.tileId);
+                            grown = true;
+                        }
+                    }
+                }
+            }
+
+            source.parent.resize(source.included.size());
+            std::iota(source.parent.begin(), source.parent.end(), 0u);
+            for (const auto& animation : animations)
+            {
+                if (animation.baseTileId >= source.included.size() || !source.included[animation.baseTileId])
+                    continue;
+                for (const auto& frame : animation.frames)
+                    source.parent[findRoot(source.parent, frame.tileId)] = findRoot(source.parent, animation.baseTileId);
+            }
+        }
+
+        // Fill pages in tileset order, one page per tile size at a time; linked tiles are placed together
+        TextureAtlas atlas;
+        atlas.padding = options.padding;
+        atlas.extrusion = options.extrusion;
+        atlas.slots.resize(tilesets.size());
+        std::vector<PageLayout> pages;
+        std::vector<std::uint32_t> openPages; // Last page of each tile size
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> order; // (first tile of the linked group, tile ID)
+        for (std::uint32_t tilesetIndex = 0; tilesetIndex < tilesets.size(); ++tilesetIndex)
+        {
+            const auto& tileset = tilesets[tilesetIndex];
+            auto& source = sources[tilesetIndex];
+            auto& slots = atlas.slots[tilesetIndex];
+            slots.assign(source.included.size(), {});
+            if (std::ranges::find(source.included, 1) == source.included.end())
+                continue;
+
+            const std::uint32_t maxColumns = maxTilesAlong(tileset.tileWidth, options);
+            const std::uint32_t maxRows = maxTilesAlong(tileset.tileHeight, options);
+            if (tileset.columns == 0 || tileset.tileWidth == 0 || tileset.tileHeight == 0)
+                return tl::make_unexpected("Tileset '" + tileset.name + "' has no tile grid to pack");
+            if (maxColumns == 0 || maxRows == 0)
+            {
+                return tl::make_unexpected("Tiles of tileset '" + tileset.name + "' do not fit on a " +
+                                           std::to_string(options.maxPageSize) + " pixel atlas page");
+            }
+
+            std::vector<std::uint32_t> firstOfGroup(source.included.size(), NO_INDEX);
+            order.clear();
+            for (std::uint32_t tileId = 0; tileId < source.included.size(); ++tileId)
+            {
+                if (!source.included[tileId])
+                    continue;
+                std::uint32_t& first = firstOfGroup[findRoot(source.parent, tileId)];
+                first = std::min(first, tileId);
+                order.emplace_back(first, tileId);
+            }
+            std::ranges::sort(order);
+
+            for (std::size_t begin = 0; begin < order.size();)
+            {
+                std::size_t end = begin;
+                while (end < order.size() && order[end].first == order[begin].first)
+                    ++end;
+                const auto count = static_cast<std::uint32_t>(end - begin);
+                const std::uint64_t capacity = static_cast<std::uint64_t>(maxColumns) * maxRows;
+                if (count > capacity)
+                {
+                    return tl::make_unexpected("Animation of tile " + std::to_string(order[begin].first) +
+                                               " in tileset '" + tileset.name +
+                                               "' has more frames than fit on one atlas page");
+                }
+
+                auto open = std::ranges::find_if(openPages, [&](const std::uint32_t page)
+                {
+                    return pages[page].tileWidth == tileset.tileWidth && pages[page].tileHeight == tileset.tileHeight;
+                });
+                if (open == openPages.end() || pages[*open].tiles.size() + count > capacity)
+                {
+                    if (pages.size() + 1 >= GidRenderInfo::NO_TILESET)
+                        return tl::make_unexpected("Tiles need more atlas pages than a map can have tilesets");
+                    pages.push_back({tileset.tileWidth, tileset.tileHeight, maxColumns, maxRows, {}});
+                    if (open == openPages.end())
+                        open = openPages.insert(openPages.end(), 0);
+                    *open = static_cast<std::uint32_t>(pages.size() - 1);
+                }
+
+                auto& page = pages[*open];
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const std::uint32_t tileId = order[i].second;
+                    slots[tileId] = {*open, static_cast<std::uint32_t>(page.tiles.size())};
+                    page.tiles.push_back({tilesetIndex, tileId});
+                }
+                begin = end;
+            }
+        }
+
+        // Lay every page out as a grid close to square
+        std::vector<TilesetRenderInfo> pageTilesets(pages.size());
+        for (std::uint32_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex)
+        {
+            const auto& page = pages[pageIndex];
+            const auto count = static_cast<std::uint32_t>(page.tiles.size());
+            std::uint32_t columns = std::clamp(static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(count)))),
+                                               1u, page.maxColumns);
+            if ((count + columns - 1) / columns > page.maxRows)
+                columns = page.maxColumns;
+
+            auto& info = pageTilesets[pageIndex];
+            info.name = "atlas" + std::to_string(pageIndex);
+            info.firstgid = 0;
+            info.tileWidth = page.tileWidth;
+            info.tileHeight = page.tileHeight;
+            info.columns = columns;
+            info.tileCount = count;
+            info.margin = options.padding + options.extrusion;
+            info.spacing = options.padding + 2 * options.extrusion;
+            info.imageWidth = static_cast<std::uint32_t>(pageExtent(columns, page.tileWidth, options));
+            info.imageHeight = static_cast<std::uint32_t>(pageExtent((count + columns - 1) / columns, page.tileHeight, options));
+        }
+
+        // Move each animation to the page of its base tile
+        auto slotOf = [&](const std::uint32_t tilesetIndex, const std::uint32_t tileId) -> const AtlasSlot*
+        {
+            if (tilesetIndex >= atlas.slots.size() || tileId >= atlas.slots[tilesetIndex].size() ||
+                atlas.slots[tilesetIndex][tileId].page == AtlasSlot::NO_PAGE)
+                return nullptr;
+            return &atlas.slots[tilesetIndex][tileId];
+        };
+        std::vector<std::vector<std::uint32_t>> animationIndices(tilesets.size());
+        for (std::uint32_t tilesetIndex = 0; tilesetIndex < tilesets.size(); ++tilesetIndex)
+        {
+            const auto& animations = tilesets[tilesetIndex].animations;
+            animationIndices[tilesetIndex].assign(animations.size(), NO_INDEX);
+            for (std::uint32_t animIdx = 0; animIdx < animations.size(); ++animIdx)
+            {
+                const AtlasSlot* base = slotOf(tilesetIndex, animations[animIdx].baseTileId);
+                if (!base)
+                    continue;
+
+                auto& page = pageTilesets[base->page];
+                if (page.animations.size() >= PackedTileRenderInfo::NO_ANIMATION)
+                    return tl::make_unexpected("Atlas page " + page.name + " has too many animations");
+
+                TileAnimationInfo animation = animations[animIdx];
+                animation.baseTileId = base->slot;
+                for (auto& frame : animation.frames)
+                {
+                    frame.tileId = slotOf(tilesetIndex, frame.tileId)->slot;
+                    frame.srcX = page.srcXOf(frame.tileId);
+                    frame.srcY = page.srcYOf(frame.tileId);
+                }
+                animationIndices[tilesetIndex][animIdx] = static_cast<std::uint32_t>(page.animations.size());
+                page.animations.push_back(std::move(animation));
+            }
+        }
+
+        // Nothing can fail from here on: rewrite the render data
+        for (auto& entry : renderData.gidTable)
+        {
+            if (entry.tilesetIndex == GidRenderInfo::NO_TILESET)
+                continue;
+
+            const AtlasSlot* slot = slotOf(entry.tilesetIndex, entry.tileId);
+            if (!slot)
+            {
+                entry = {0, 0, 0, GidRenderInfo::NO_TILESET, PackedTileRenderInfo::NO_ANIMATION};
+                continue;
+            }
+            const auto& page = pageTilesets[slot->page];
+            const std::uint16_t animationIndex = entry.animationIndex == PackedTileRenderInfo::NO_ANIMATION
+                                                     ? PackedTileRenderInfo::NO_ANIMATION
+                                                     : static_cast<std::uint16_t>(
+                                                         animationIndices[entry.tilesetIndex][entry.animationIndex]);
+            entry = {slot->slot, page.srcXOf(slot->slot), page.srcYOf(slot->slot), static_cast<std::uint16_t>(slot->page),
+                     animationIndex};
+        }
+
+        for (auto& layer : renderData.layers)
+        {
+            for (auto& tile : layer.tiles)
+            {
+                const AtlasSlot* slot = slotOf(tile.tilesetIndex, tile.tileId);
+                if (!slot)
+                    continue;
+                if (tile.isAnimated)
+                    tile.animationIndex = animationIndices[tile.tilesetIndex][tile.animationIndex];
+                tile.tileId = slot->slot;
+                tile.srcX = pageTilesets[slot->page].srcXOf(slot->slot);
+                tile.srcY = pageTilesets[slot->page].srcYOf(slot->slot);
+                tile.tilesetIndex = slot->page;
+            }
+            for (auto& tile : layer.packedTiles)
+            {
+                const AtlasSlot* slot = slotOf(tile.tilesetIndex, tile.tileId());
+                if (!slot)
+                    continue;
+                if (tile.isAnimated())
+                    tile.animationIndex = static_cast<std::uint16_t>(animationIndices[tile.tilesetIndex][tile.animationIndex]);
+                tile.tileIdAndFlags = slot->slot | (tile.tileIdAndFlags & map::GID_FLAGS_MASK);
+                tile.tilesetIndex = static_cast<std::uint16_t>(slot->page);
+            }
+            layer.indexAnimatedTiles();
+        }
+
+        atlas.sourceTilesets = std::move(renderData.tilesets);
+        renderData.tilesets = std::move(pageTilesets);
+        atlas.pages.reserve(pages.size());
+        for (auto& page : pages)
+            atlas.pages.push_back({std::move(page.tiles)});
+
+        for (auto& group : renderData.objectGroups)
+        {
+            for (auto& object : group.objects)
+            {
+                if (object.tilesetIndex >= atlas.sourceTilesets.size())
+                    continue;
+
+                const GidRenderInfo* info = renderData.gidInfo(object.gid);
+                object.tilesetIndex = info ? info->tilesetIndex : static_cast<std::uint32_t>(-1);
+                object.srcX = info ? info->srcX : 0;
+                object.srcY = info ? info->srcY : 0;
+            }
+        }
+        return atlas;
+    }
+}
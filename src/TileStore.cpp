@@ -0,0 +1,151 @@
+#include "tmx/TileStore.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace tmx::map
+{
+    namespace
+    {
+        constexpr std::size_t MIN_BUCKETS = 16;
+    }
+
+    TileStore::TileStore(std::uint32_t chunkShift)
+        : m_chunkShift(std::clamp<std::uint32_t>(chunkShift, 1, 10)),
+          m_hashShift(64 - std::countr_zero(MIN_BUCKETS)),
+          m_buckets(MIN_BUCKETS, Bucket{0, NO_SLOT})
+    {
+    }
+
+    auto TileStore::fromLayer(const Layer& layer, std::uint32_t chunkShift) -> TileStore
+    {
+        TileStore store(chunkShift);
+
+        // Pre-size for the chunks the layer covers so loading never rehashes
+        const std::uint32_t size = store.chunkSize();
+        std::size_t estimate = 0;
+        if (layer.chunks.empty())
+        {
+            estimate = static_cast<std::size_t>((layer.width + size - 1) / size) * ((layer.height + size - 1) / size);
+        }
+        for (const auto& chunk : layer.chunks)
+        {
+            estimate += static_cast<std::size_t>((chunk.width + size - 1) / size + 1) * ((chunk.height + size - 1) / size + 1);
+        }
+        store.reserve(estimate);
+
+        auto copyCells = [&store](std::int32_t originX, std::int32_t originY, std::uint32_t width,
+                                  std::span<const std::uint32_t> cells)
+        {
+            if (width == 0)
+                return;
+            for (std::size_t i = 0; i < cells.size(); ++i)
+            {
+                if (cells[i] != 0)
+                {
+                    store.setTile(originX + static_cast<std::int32_t>(i % width),
+                                  originY + static_cast<std::int32_t>(i / width), cells[i]);
+                }
+            }
+        };
+
+        if (layer.chunks.empty())
+        {
+            copyCells(0, 0, layer.width, layer.data);
+        }
+        for (const auto& chunk : layer.chunks)
+        {
+            copyCells(chunk.x, chunk.y, chunk.width, chunk.data);
+        }
+        return store;
+    }
+
+    void TileStore::setTile(std::int32_t x, std::int32_t y, std::uint32_t gid)
+    {
+        const std::int32_t chunkX = x >> m_chunkShift;
+        const std::int32_t chunkY = y >> m_chunkShift;
+        std::uint32_t slot = findSlot(chunkKey(chunkX, chunkY));
+        if (slot == NO_SLOT)
+        {
+            if (gid == 0)
+                return;
+            slot = insertChunk(chunkX, chunkY);
+        }
+        m_cells[(static_cast<std::size_t>(slot) << (2 * m_chunkShift)) + cellIndex(x, y)] = gid;
+
+        if (gid == 0)
+            return;
+        if (m_bounds.isEmpty())
+        {
+            m_bounds = {x, y, x + 1, y + 1};
+            return;
+        }
+        m_bounds.minX = std::min(m_bounds.minX, x);
+        m_bounds.minY = std::min(m_bounds.minY, y);
+        m_bounds.maxX = std::max(m_bounds.maxX, x + 1);
+        m_bounds.maxY = std::max(m_bounds.maxY, y + 1);
+    }
+
+    auto TileStore::chunkAt(std::int32_t chunkX, std::int32_t chunkY) const -> std::span<const std::uint32_t>
+    {
+        const std::uint32_t slot = findSlot(chunkKey(chunkX, chunkY));
+        if (slot == NO_SLOT)
+            return {};
+        return {m_cells.data() + static_cast<std::size_t>(slot) * chunkArea(), chunkArea()};
+    }
+
+    void TileStore::reserve(std::size_t chunkCount)
+    {
+        m_chunkCoords.reserve(chunkCount);
+        m_cells.reserve(chunkCount * chunkArea());
+        const std::size_t bucketCount = std::bit_ceil(std::max(MIN_BUCKETS, chunkCount * 2));
+        if (bucketCount > m_buckets.size())
+            rehash(bucketCount);
+    }
+
+    void TileStore::clear()
+    {
+        std::ranges::fill(m_buckets, Bucket{0, NO_SLOT});
+        m_chunkCoords.clear();
+        m_cells.clear();
+        m_bounds = {};
+    }
+
+    auto TileStore::insertChunk(std::int32_t chunkX, std::int32_t chunkY) -> std::uint32_t
+    {
+        // Keep the table at most half full so probe sequences stay short
+        if ((m_chunkCoords.size() + 1) * 2 > m_buckets.size())
+            rehash(m_buckets.size() * 2);
+
+        const auto slot = static_cast<std::uint32_t>(m_chunkCoords.size());
+        m_chunkCoords.push_back({chunkX, chunkY});
+        m_cells.resize(m_cells.size() + chunkArea(), 0);
+
+        const std::uint64_t key = chunkKey(chunkX, chunkY);
+        const std::size_t mask = m_buckets.size() - 1;
+        std::size_t i = bucketOf(key);
+        while (m_buckets[i].slot != NO_SLOT)
+        {
+            i = (i + 1) & mask;
+        }
+        m_buckets[i] = {key, slot};
+        return slot;
+    }
+
+    void TileStore::rehash(std::size_t bucketCount)
+    {
+        m_buckets.assign(bucketCount, Bucket{0, NO_SLOT});
+        m_hashShift = 64 - static_cast<std::uint32_t>(std::countr_zero(bucketCount));
+
+        const std::size_t mask = bucketCount - 1;
+        for (std::uint32_t slot = 0; slot < m_chunkCoords.size(); ++slot)
+        {
+            const std::uint64_t key = chunkKey(m_chunkCoords[slot].x, m_chunkCoords[slot].y);
+            std::size_t i = bucketOf(key);
+            while (m_buckets[i].slot != NO_SLOT)
+            {
+                i = (i + 1) & mask;
+            }
+            m_buckets[i] = {key, slot};
+        }
+    }
+}
@@ -0,0 +1,322 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Reference lookup: walk the frames until the accumulated duration passes the time
+std::uint32_t referenceFrameIndex(const tmx::render::TileAnimationInfo& animation, std::uint32_t timeInCycle)
+{
+    std::uint32_t elapsed = 0;
+    for (std::uint32_t i = 0; i < animation.frames.size(); ++i)
+    {
+        elapsed += animation.frames[i].duration;
+        if (timeInCycle < elapsed)
+        {
+            return i;
+        }
+    }
+    return 0;
+}
+
+bool verifyAnimation(const tmx::render::TileAnimationInfo& animation, const std::string& label)
+{
+    for (std::uint32_t t = 0; t < animation.totalDuration; ++t)
+    {
+        const std::uint32_t expected = referenceFrameIndex(animation, t);
+        const std::uint32_t actual = animation.getFrameIndexAtTime(t);
+        if (expected != actual)
+        {
+            std::cerr << label << ": ERROR - Frame mismatch at " << t << "ms: expected " << expected
+                << ", got " << actual << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+tmx::render::TileAnimationInfo makeAnimation(const std::vector<std::uint32_t>& durations)
+{
+    tmx::render::TileAnimationInfo animation{};
+    for (std::uint32_t i = 0; i < durations.size(); ++i)
+    {
+        animation.frames.push_back({i, 0, 0, durations[i]});
+    }
+    animation.buildTimeline();
+    return animation;
+}
+
+bool verifyClock(const tmx::render::MapRenderData& renderData, const std::string& filename)
+{
+    bool success = true;
+
+    // Every published frame must match a direct lookup at the clock's time
+    auto matchesLookup = [&](const tmx::render::AnimationClock& clock, const std::string& label)
+    {
+        for (std::uint32_t ts = 0; ts < renderData.tilesets.size(); ++ts)
+        {
+            const auto& animations = renderData.tilesets[ts].animations;
+            if (clock.frames(ts).size() != animations.size())
+            {
+                std::cerr << filename << ": ERROR - " << label << ": wrong frame count for tileset " << ts << std::endl;
+                return false;
+            }
+            for (std::uint32_t a = 0; a < animations.size(); ++a)
+            {
+                const auto timeInCycle = static_cast<std::uint32_t>(clock.time() % animations[a].totalDuration);
+                const auto& expected = animations[a].frames[animations[a].getFrameIndexAtTime(timeInCycle)];
+                const auto& actual = clock.frame(ts, a);
+                if (actual.srcX != expected.srcX || actual.srcY != expected.srcY)
+                {
+                    std::cerr << filename << ": ERROR - " << label << ": frame mismatch at " << clock.time()
+                        << "ms" << std::endl;
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    tmx::render::AnimationClock clock(renderData);
+    success &= matchesLookup(clock, "initial");
+
+    for (int i = 0; i < 200; ++i)
+    {
+        clock.tick(16);
+    }
+    if (clock.time() != 3200)
+    {
+        std::cerr << filename << ": ERROR - Expected clock time 3200, got " << clock.time() << std::endl;
+        success = false;
+    }
+    success &= matchesLookup(clock, "ticked");
+
+    // Pausing freezes time
+    clock.setPaused(true);
+    clock.tick(1000);
+    if (clock.time() != 3200)
+    {
+        std::cerr << filename << ": ERROR - Paused clock advanced to " << clock.time() << std::endl;
+        success = false;
+    }
+    clock.setPaused(false);
+
+    // Half speed: 400 ticks of 16ms advance 3200ms
+    clock.setTimeScale(0.5f);
+    for (int i = 0; i < 400; ++i)
+    {
+        clock.tick(16);
+    }
+    if (clock.time() != 6400)
+    {
+        std::cerr << filename << ": ERROR - Expected scaled clock time 6400, got " << clock.time() << std::endl;
+        success = false;
+    }
+    success &= matchesLookup(clock, "scaled");
+
+    // Replaying the same ticks on a fresh clock is deterministic
+    tmx::render::AnimationClock replay(renderData);
+    replay.setTimeScale(1.37f);
+    clock.reset(renderData);
+    clock.setTimeScale(1.37f);
+    for (std::uint32_t i = 0; i < 1000; ++i)
+    {
+        clock.tick(i % 33);
+        replay.tick(i % 33);
+    }
+    if (clock.time() != replay.time())
+    {
+        std::cerr << filename << ": ERROR - Replay diverged" << std::endl;
+        success = false;
+    }
+
+    // Scales beyond the fixed-point range saturate instead of wrapping around
+    clock.setTimeScale(1.0e6f);
+    if (clock.timeScale() != tmx::render::AnimationClock::MAX_TIME_SCALE)
+    {
+        std::cerr << filename << ": ERROR - Time scale 1e6 became " << clock.timeScale() << std::endl;
+        success = false;
+    }
+
+    return success;
+}
+
+bool verifyChangeTracking(const tmx::render::MapRenderData& renderData, const std::string& filename)
+{
+    tmx::render::AnimationClock clock(renderData);
+    std::vector<std::uint32_t> previous;
+    auto snapshot = [&]()
+    {
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t ts = 0; ts < renderData.tilesets.size(); ++ts)
+        {
+            for (std::uint32_t a = 0; a < renderData.tilesets[ts].animations.size(); ++a)
+            {
+                indices.push_back(clock.frameIndex(ts, a));
+            }
+        }
+        return indices;
+    };
+    previous = snapshot();
+
+    for (std::uint32_t step = 0; step < 2500; ++step)
+    {
+        const auto expectedNext = clock.nextChangeTime();
+        const auto wait = clock.timeUntilNextChange();
+        if (!expectedNext || !wait || *wait != *expectedNext - clock.time())
+        {
+            std::cerr << filename << ": ERROR - Inconsistent next change time at " << clock.time() << "ms" << std::endl;
+            return false;
+        }
+
+        clock.tick(7);
+        const auto current = snapshot();
+        size_t differing = 0;
+        for (size_t i = 0; i < current.size(); ++i)
+        {
+            differing += current[i] != previous[i] ? 1 : 0;
+        }
+        if (differing != clock.changedAnimations().size())
+        {
+            std::cerr << filename << ": ERROR - Reported " << clock.changedAnimations().size()
+                << " changed animations, expected " << differing << " at " << clock.time() << "ms" << std::endl;
+            return false;
+        }
+        if (clock.time() < *expectedNext && differing != 0)
+        {
+            std::cerr << filename << ": ERROR - Frame changed before the announced time" << std::endl;
+            return false;
+        }
+        previous = current;
+    }
+
+    // Every animated tile belongs to exactly one group of its own animation
+    for (const auto& layer : renderData.layers)
+    {
+        size_t animatedCount = 0;
+        for (const auto& tile : layer.tiles)
+        {
+            animatedCount += tile.isAnimated ? 1 : 0;
+        }
+        if (animatedCount != layer.animatedTileIndices.size())
+        {
+            std::cerr << filename << ": ERROR - Layer '" << layer.name << "' indexes "
+                << layer.animatedTileIndices.size() << " of " << animatedCount << " animated tiles" << std::endl;
+            return false;
+        }
+        for (const auto& group : layer.animatedGroups)
+        {
+            if (layer.findAnimatedGroup(group.animation) != &group)
+            {
+                std::cerr << filename << ": ERROR - Group lookup failed in layer '" << layer.name << "'" << std::endl;
+                return false;
+            }
+            for (const std::uint32_t index : layer.animatedTilesOf(group))
+            {
+                const auto& tile = layer.tiles[index];
+                if (tile.tilesetIndex != group.animation.tilesetIndex ||
+                    tile.animationIndex != group.animation.animationIndex)
+                {
+                    std::cerr << filename << ": ERROR - Tile " << index << " in wrong group" << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// Animations whose frames all last 0ms still publish their first frame instead of the tileset's top-left tile
+bool verifyZeroDurationClock()
+{
+    tmx::render::MapRenderData renderData{};
+    tmx::render::TilesetRenderInfo tileset{};
+    auto animation = makeAnimation({0, 0});
+    animation.frames[0].srcX = 48;
+    animation.frames[0].srcY = 16;
+    tileset.animations.push_back(animation);
+    renderData.tilesets.push_back(tileset);
+
+    tmx::render::AnimationClock clock(renderData);
+    clock.tick(100);
+    clock.setTime(5000);
+    const auto& frame = clock.frame(0, 0);
+    if (frame.srcX != 48 || frame.srcY != 16 || clock.nextChangeTime())
+    {
+        std::cerr << "zero-duration clock: ERROR - Published frame (" << frame.srcX << ", " << frame.srcY
+            << ") instead of (48, 16)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing animation timelines: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    const auto renderData = tmx::render::createRenderData(*result);
+
+    bool success = true;
+    size_t animationCount = 0;
+    for (const auto& tileset : renderData.tilesets)
+    {
+        for (const auto& animation : tileset.animations)
+        {
+            ++animationCount;
+            success &= verifyAnimation(animation, filename);
+
+            // Maps in the test assets use regular frame durations and must hit the quantized table
+            if (animation.timeline.empty())
+            {
+                std::cerr << filename << ": ERROR - Expected a quantized timeline for tile "
+                    << animation.baseTileId << std::endl;
+                success = false;
+            }
+        }
+    }
+
+    if (animationCount == 0)
+    {
+        std::cerr << filename << ": ERROR - No animations found" << std::endl;
+        return 1;
+    }
+
+    success &= verifyClock(renderData, filename);
+    success &= verifyChangeTracking(renderData, filename);
+
+    // Irregular durations fall back to the prefix-sum search
+    const auto irregular = makeAnimation({1001, 997, 13, 0, 4999, 2});
+    if (!irregular.timeline.empty())
+    {
+        std::cerr << "irregular: ERROR - Expected prefix-sum fallback" << std::endl;
+        success = false;
+    }
+    success &= verifyAnimation(irregular, "irregular");
+
+    // Zero-duration frames are never displayed
+    success &= verifyAnimation(makeAnimation({100, 0, 50, 150}), "zero-duration");
+    success &= verifyZeroDurationClock();
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": " << animationCount << " animations verified" << std::endl;
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
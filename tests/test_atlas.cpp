@@ -0,0 +1,297 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+bool sameSource(const tmx::render::AtlasTile& tile, std::uint32_t tilesetIndex, std::uint32_t tileId)
+{
+    return tile.tilesetIndex == tilesetIndex && tile.tileId == tileId;
+}
+
+// Source rectangles must point at the slot holding the original tile, on the page the tile now names
+bool verifyPages(const tmx::render::MapRenderData& packed, const tmx::render::TextureAtlas& atlas,
+                 const tmx::render::AtlasOptions& options, const std::string& label)
+{
+    if (packed.tilesets.size() != atlas.pages.size())
+    {
+        std::cerr << label << ": ERROR - " << packed.tilesets.size() << " tilesets for " << atlas.pages.size()
+            << " atlas pages" << std::endl;
+        return false;
+    }
+    for (std::uint32_t pageIndex = 0; pageIndex < atlas.pages.size(); ++pageIndex)
+    {
+        const auto& page = packed.tilesets[pageIndex];
+        const auto& tiles = atlas.pages[pageIndex].tiles;
+        const std::uint32_t rows = (page.tileCount + page.columns - 1) / page.columns;
+        if (page.tileCount != tiles.size() || page.imageWidth > options.maxPageSize ||
+            page.imageHeight > options.maxPageSize || page.margin != options.padding + options.extrusion ||
+            page.spacing != options.padding + 2 * options.extrusion ||
+            page.imageWidth != options.padding + page.columns * (page.tileWidth + page.spacing) ||
+            page.imageHeight != options.padding + rows * (page.tileHeight + page.spacing))
+        {
+            std::cerr << label << ": ERROR - Page " << pageIndex << " is " << page.imageWidth << "x"
+                << page.imageHeight << " with " << page.columns << " columns for " << tiles.size() << " tiles"
+                << std::endl;
+            return false;
+        }
+
+        for (std::uint32_t slot = 0; slot < tiles.size(); ++slot)
+        {
+            const auto& source = atlas.sourceTilesets[tiles[slot].tilesetIndex];
+            const auto found = atlas.find(tiles[slot].tilesetIndex, tiles[slot].tileId);
+            if (!found || found->page != pageIndex || found->slot != slot || source.tileWidth != page.tileWidth ||
+                source.tileHeight != page.tileHeight)
+            {
+                std::cerr << label << ": ERROR - Slot " << slot << " of page " << pageIndex
+                    << " does not round-trip through find" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool verifyAnimation(const tmx::render::MapRenderData& original, const tmx::render::MapRenderData& packed,
+                     const tmx::render::TextureAtlas& atlas, std::uint32_t tilesetIndex, std::uint32_t animationIndex,
+                     std::uint32_t pageIndex, std::uint32_t pageAnimationIndex, const std::string& label)
+{
+    const auto& before = original.tilesets[tilesetIndex].animations[animationIndex];
+    const auto& page = packed.tilesets[pageIndex];
+    const auto& after = page.animations[pageAnimationIndex];
+    if (after.frames.size() != before.frames.size() || after.totalDuration != before.totalDuration ||
+        !sameSource(atlas.pages[pageIndex].tiles[after.baseTileId], tilesetIndex, before.baseTileId))
+    {
+        std::cerr << label << ": ERROR - Animation " << animationIndex << " of tileset " << tilesetIndex
+            << " changed when moved to page " << pageIndex << std::endl;
+        return false;
+    }
+    for (std::size_t i = 0; i < after.frames.size(); ++i)
+    {
+        const auto& frame = after.frames[i];
+        if (frame.duration != before.frames[i].duration ||
+            !sameSource(atlas.pages[pageIndex].tiles[frame.tileId], tilesetIndex, before.frames[i].tileId) ||
+            frame.srcX != page.srcXOf(frame.tileId) || frame.srcY != page.srcYOf(frame.tileId))
+        {
+            std::cerr << label << ": ERROR - Frame " << i << " of animation " << animationIndex << " of tileset "
+                << tilesetIndex << " points at the wrong slot" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every tile keeps its place, flips and animation while its source moves into the atlas
+bool verifyTiles(const tmx::render::MapRenderData& original, const tmx::render::MapRenderData& packed,
+                 const tmx::render::TextureAtlas& atlas, const std::string& label)
+{
+    for (std::size_t layerIndex = 0; layerIndex < original.layers.size(); ++layerIndex)
+    {
+        std::vector<tmx::render::TileRenderInfo> before, after;
+        original.forEachTile(original.layers[layerIndex], [&](const tmx::render::TileRenderInfo& tile) { before.push_back(tile); });
+        packed.forEachTile(packed.layers[layerIndex], [&](const tmx::render::TileRenderInfo& tile) { after.push_back(tile); });
+        if (before.size() != after.size())
+        {
+            std::cerr << label << ": ERROR - Layer " << layerIndex << " has " << after.size() << " tiles, expected "
+                << before.size() << std::endl;
+            return false;
+        }
+
+        std::size_t animatedCount = 0;
+        for (std::size_t i = 0; i < before.size(); ++i)
+        {
+            const auto& a = before[i];
+            const auto& b = after[i];
+            const auto& page = packed.tilesets[b.tilesetIndex];
+            if (a.destX != b.destX || a.destY != b.destY || a.flipFlags != b.flipFlags || a.isAnimated != b.isAnimated ||
+                a.srcW != b.srcW || a.srcH != b.srcH || b.srcX != page.srcXOf(b.tileId) || b.srcY != page.srcYOf(b.tileId) ||
+                !sameSource(atlas.pages[b.tilesetIndex].tiles[b.tileId], a.tilesetIndex, a.tileId))
+            {
+                std::cerr << label << ": ERROR - Tile at " << a.destX << "," << a.destY << " of layer " << layerIndex
+                    << " was not remapped to its atlas slot" << std::endl;
+                return false;
+            }
+            if (a.isAnimated)
+            {
+                ++animatedCount;
+                if (!verifyAnimation(original, packed, atlas, a.tilesetIndex, a.animationIndex, b.tilesetIndex,
+                                     b.animationIndex, label))
+                    return false;
+            }
+        }
+
+        // Animated groups are rebuilt against the pages
+        std::size_t grouped = 0;
+        for (const auto& group : packed.layers[layerIndex].animatedGroups)
+        {
+            grouped += group.count;
+            if (group.animation.tilesetIndex >= packed.tilesets.size() ||
+                group.animation.animationIndex >= packed.tilesets[group.animation.tilesetIndex].animations.size())
+            {
+                std::cerr << label << ": ERROR - Animated group of layer " << layerIndex << " names a missing animation"
+                    << std::endl;
+                return false;
+            }
+        }
+        if (packed.layers[layerIndex].storage != tmx::render::TileStorage::Indexed && grouped != animatedCount)
+        {
+            std::cerr << label << ": ERROR - Layer " << layerIndex << " groups " << grouped << " animated tiles, expected "
+                << animatedCount << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// GIDs resolve to the atlas slot of their tile, or to nothing when the tile was left out
+bool verifyGidTable(const tmx::render::MapRenderData& original, const tmx::render::MapRenderData& packed,
+                    const tmx::render::TextureAtlas& atlas, const std::string& label)
+{
+    for (std::uint32_t gid = 1; gid < original.gidTable.size(); ++gid)
+    {
+        const auto* before = original.gidInfo(gid);
+        const auto* after = packed.gidInfo(gid);
+        const auto slot = before ? atlas.find(before->tilesetIndex, before->tileId) : std::nullopt;
+        if (slot.has_value() != (after != nullptr) ||
+            (after && (after->tilesetIndex != slot->page || after->tileId != slot->slot ||
+                       after->srcX != packed.tilesets[slot->page].srcXOf(slot->slot) ||
+                       after->srcY != packed.tilesets[slot->page].srcYOf(slot->slot) ||
+                       (after->animationIndex == tmx::render::PackedTileRenderInfo::NO_ANIMATION) !=
+                       (before->animationIndex == tmx::render::PackedTileRenderInfo::NO_ANIMATION))))
+        {
+            std::cerr << label << ": ERROR - GID " << gid << " does not resolve to its atlas slot" << std::endl;
+            return false;
+        }
+        if (after && after->animationIndex != tmx::render::PackedTileRenderInfo::NO_ANIMATION &&
+            !verifyAnimation(original, packed, atlas, before->tilesetIndex, before->animationIndex, after->tilesetIndex,
+                             after->animationIndex, label))
+            return false;
+    }
+    return true;
+}
+
+bool verifyObjects(const tmx::render::MapRenderData& original, const tmx::render::MapRenderData& packed,
+                   const tmx::render::TextureAtlas& atlas, const std::string& label)
+{
+    for (std::size_t groupIndex = 0; groupIndex < original.objectGroups.size(); ++groupIndex)
+    {
+        const auto& before = original.objectGroups[groupIndex].objects;
+        const auto& after = packed.objectGroups[groupIndex].objects;
+        for (std::size_t i = 0; i < before.size(); ++i)
+        {
+            const auto* info = original.gidInfo(before[i].gid);
+            if (!info)
+                continue;
+
+            const auto slot = atlas.find(info->tilesetIndex, info->tileId);
+            if (!slot || after[i].tilesetIndex != slot->page || after[i].srcW != before[i].srcW ||
+                after[i].srcX != packed.tilesets[slot->page].srcXOf(slot->slot) ||
+                after[i].srcY != packed.tilesets[slot->page].srcYOf(slot->slot))
+            {
+                std::cerr << label << ": ERROR - Tile object " << before[i].id << " was not remapped" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Tiles placed after packing resolve through the rewritten GID table
+bool verifyEdit(tmx::render::MapRenderData packed, const std::string& label)
+{
+    std::uint32_t gid = 1;
+    while (gid < packed.gidTable.size() && !packed.gidInfo(gid))
+        ++gid;
+    if (packed.layers.empty() || !packed.setTile(0, 0, 0, gid))
+        return true;
+
+    bool found = false;
+    packed.forEachTile(packed.layers[0], [&](const tmx::render::TileRenderInfo& tile)
+    {
+        if (tile.destX == 0 && tile.destY == 0)
+        {
+            found = tile.tilesetIndex == packed.gidInfo(gid)->tilesetIndex && tile.srcX == packed.gidInfo(gid)->srcX &&
+                tile.srcY == packed.gidInfo(gid)->srcY;
+        }
+    });
+    if (!found)
+    {
+        std::cerr << label << ": ERROR - Tile set after packing does not use the atlas" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool verifyErrors(const tmx::render::MapRenderData& original, const std::string& label)
+{
+    if (original.tilesets.empty())
+        return true;
+
+    auto renderData = original;
+    const tmx::render::AtlasOptions tooSmall{.maxPageSize = original.tilesets[0].tileWidth};
+    if (tmx::render::packAtlas(renderData, tooSmall) || renderData.tilesets.size() != original.tilesets.size() ||
+        renderData.tilesets[0].name != original.tilesets[0].name)
+    {
+        std::cerr << label << ": ERROR - Packing into pages smaller than a tile did not fail cleanly" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing texture atlas: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                               tmx::render::TileStorage::Indexed})
+    {
+        const auto original = tmx::render::createRenderData(*result, "", {.tileStorage = storage});
+        for (const auto& options : {tmx::render::AtlasOptions{},
+                                    tmx::render::AtlasOptions{.usedTilesOnly = true, .padding = 2, .extrusion = 0},
+                                    tmx::render::AtlasOptions{.usedTilesOnly = true, .maxPageSize = 256}})
+        {
+            const std::string label = filename + " (storage " + std::to_string(static_cast<int>(storage)) +
+                (options.usedTilesOnly ? ", used tiles" : ", all tiles") + ", " +
+                std::to_string(options.maxPageSize) + "px pages)";
+            auto packed = original;
+            const auto atlas = tmx::render::packAtlas(packed, options);
+            if (!atlas)
+            {
+                std::cerr << label << ": ERROR - " << atlas.error() << std::endl;
+                success = false;
+                continue;
+            }
+            if (storage == tmx::render::TileStorage::Full)
+                std::cout << label << ": " << atlas->pages.size() << " pages" << std::endl;
+
+            success &= verifyPages(packed, *atlas, options, label);
+            success &= verifyTiles(original, packed, *atlas, label);
+            success &= verifyGidTable(original, packed, *atlas, label);
+            success &= verifyObjects(original, packed, *atlas, label);
+            success &= verifyEdit(packed, label);
+        }
+        success &= verifyErrors(original, filename);
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
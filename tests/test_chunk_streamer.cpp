@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using TileKey = std::tuple<std::uint32_t, std::int32_t, std::int32_t, std::uint32_t, std::uint32_t, std::uint32_t>;
+
+auto tileKey(std::uint32_t layerIndex, const tmx::render::TileRenderInfo& tile) -> TileKey
+{
+    return {layerIndex, tile.destX, tile.destY, tile.tilesetIndex, tile.tileId, tile.flipFlags};
+}
+
+bool overlaps(const tmx::render::TileRenderInfo& tile, const tmx::render::ViewRect& view)
+{
+    const auto left = static_cast<float>(tile.destX);
+    const auto top = static_cast<float>(tile.destY);
+    return left < view.x + view.width && view.x < left + static_cast<float>(tile.destW) &&
+        top < view.y + view.height && view.y < top + static_cast<float>(tile.destH);
+}
+
+// The index must describe exactly the chunks the regular parser reads
+bool verifyIndex(const tmx::map::Map& map, const tmx::render::ChunkStreamer& streamer, const std::string& filename)
+{
+    const auto index = streamer.chunkIndex();
+    if (index.size() != map.layers.size() || streamer.map().layers.size() != map.layers.size())
+    {
+        std::cerr << filename << ": ERROR - Indexed " << index.size() << " layers, expected " << map.layers.size()
+            << std::endl;
+        return false;
+    }
+
+    for (size_t l = 0; l < map.layers.size(); ++l)
+    {
+        const auto& chunks = map.layers[l].chunks;
+        if (index[l].chunks.size() != chunks.size() || !streamer.map().layers[l].chunks.empty())
+        {
+            std::cerr << filename << ": ERROR - Layer '" << map.layers[l].name << "' indexed "
+                << index[l].chunks.size() << " chunks, expected " << chunks.size() << std::endl;
+            return false;
+        }
+        for (const auto& chunk : chunks)
+        {
+            const bool found = std::ranges::any_of(index[l].chunks, [&](const tmx::render::ChunkIndexEntry& entry)
+            {
+                return entry.x == chunk.x && entry.y == chunk.y && entry.width == chunk.width &&
+                    entry.height == chunk.height && entry.length > 0;
+            });
+            if (!found)
+            {
+                std::cerr << filename << ": ERROR - Chunk " << chunk.x << "," << chunk.y << " of layer '"
+                    << map.layers[l].name << "' not indexed" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if (streamer.map().tilesets.size() != map.tilesets.size())
+    {
+        std::cerr << filename << ": ERROR - Tilesets lost while indexing" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// After loading, the streamed chunks must show exactly the tiles the full render data has in the view
+bool verifyViews(const tmx::render::MapRenderData& full, tmx::render::ChunkStreamer& streamer, const std::string& filename)
+{
+    const std::vector<tmx::render::ViewRect> views = {
+        {0.0f, 0.0f, 160.0f, 120.0f},
+        {-300.0f, -200.0f, 250.0f, 180.0f},
+        {-10000.0f, -10000.0f, 20000.0f, 20000.0f},
+        {37.5f, -61.25f, 33.0f, 17.0f},
+        {50000.0f, 50000.0f, 100.0f, 100.0f},
+    };
+
+    std::vector<const tmx::render::StreamedChunk*> visible;
+    for (const auto& view : views)
+    {
+        streamer.update(view);
+        streamer.waitUntilIdle();
+        streamer.visibleChunks(view, visible);
+
+        std::vector<TileKey> expected;
+        for (std::uint32_t l = 0; l < full.layers.size(); ++l)
+        {
+            for (const auto& tile : full.layers[l].tiles)
+            {
+                if (overlaps(tile, view))
+                    expected.push_back(tileKey(l, tile));
+            }
+        }
+
+        std::vector<TileKey> actual;
+        std::uint32_t previousLayer = 0;
+        for (const auto* chunk : visible)
+        {
+            if (chunk->layerIndex < previousLayer)
+            {
+                std::cerr << filename << ": ERROR - Visible chunks are not in layer order" << std::endl;
+                return false;
+            }
+            previousLayer = chunk->layerIndex;
+            streamer.renderData().forEachTile(chunk->layer, [&](const tmx::render::TileRenderInfo& tile)
+            {
+                if (overlaps(tile, view))
+                    actual.push_back(tileKey(chunk->layerIndex, tile));
+            });
+        }
+
+        std::ranges::sort(expected);
+        std::ranges::sort(actual);
+        if (expected != actual)
+        {
+            std::cerr << filename << ": ERROR - View at " << view.x << "," << view.y << " streamed " << actual.size()
+                << " tiles, expected " << expected.size() << std::endl;
+            return false;
+        }
+    }
+
+    if (!streamer.error().empty())
+    {
+        std::cerr << filename << ": ERROR - " << streamer.error() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Chunks beyond the eviction radius are dropped, and the budget evicts chunks the view no longer needs
+bool verifyEviction(const std::string& filename)
+{
+    auto streamerResult = tmx::render::ChunkStreamer::open(filename, "", {.loadRadius = 0.0f, .evictRadius = 0.0f});
+    if (!streamerResult)
+    {
+        std::cerr << filename << ": ERROR - " << streamerResult.error() << std::endl;
+        return false;
+    }
+    auto& streamer = **streamerResult;
+
+    const tmx::render::ViewRect everything{-10000.0f, -10000.0f, 20000.0f, 20000.0f};
+    streamer.update(everything);
+    streamer.waitUntilIdle();
+    const size_t allChunks = streamer.residentCount();
+
+    const tmx::render::ViewRect corner{-10000.0f, -10000.0f, 1.0f, 1.0f};
+    streamer.update(corner);
+    if (streamer.residentCount() != 0 || streamer.memoryUsage() != 0)
+    {
+        std::cerr << filename << ": ERROR - " << streamer.residentCount() << " chunks outside the radius kept"
+            << std::endl;
+        return false;
+    }
+
+    auto budgetResult = tmx::render::ChunkStreamer::open(filename, "",
+                                                         {.loadRadius = 0.0f, .evictRadius = 1e9f, .memoryBudget = 0});
+    if (!budgetResult)
+    {
+        std::cerr << filename << ": ERROR - " << budgetResult.error() << std::endl;
+        return false;
+    }
+    auto& budgeted = **budgetResult;
+    budgeted.update(everything);
+    budgeted.waitUntilIdle();
+    budgeted.update(everything);
+    if (budgeted.residentCount() != allChunks)
+    {
+        std::cerr << filename << ": ERROR - Chunks needed by the view were evicted" << std::endl;
+        return false;
+    }
+    budgeted.update(corner);
+    if (budgeted.residentCount() != 0)
+    {
+        std::cerr << filename << ": ERROR - Budget did not evict unused chunks" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Parallax layers are loaded and evicted around the same view, so chunks stay resident while the view stands still
+bool verifyParallax()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "tmx_test_chunk_streamer";
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "parallax.tmx";
+    std::string csv = "1";
+    for (int i = 1; i < 16 * 16; ++i)
+        csv += ",0";
+    {
+        // At half speed, a camera at x=10000 sees the layer around x=5000: the chunk at tile 304 (4864-5120)
+        std::ofstream file(path);
+        file << R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" renderorder="right-down" width="16" height="16" tilewidth="16"
+     tileheight="16" infinite="1">
+ <tileset firstgid="1" name="t" tilewidth="16" tileheight="16" tilecount="4" columns="2">
+  <image source="t.png" width="32" height="32"/>
+ </tileset>
+ <layer id="1" name="far" width="16" height="16" parallaxx="0.5" offsety="-32">
+  <data encoding="csv">
+   <chunk x="0" y="0" width="16" height="16">)" << csv << R"(</chunk>
+   <chunk x="304" y="0" width="16" height="16">)" << csv << R"(</chunk>
+  </data>
+ </layer>
+</map>
+)";
+    }
+
+    bool success = true;
+    auto streamerResult = tmx::render::ChunkStreamer::open(path, "", {.loadRadius = 0.0f, .evictRadius = 0.0f});
+    if (!streamerResult)
+    {
+        std::cerr << "parallax: ERROR - " << streamerResult.error() << std::endl;
+        success = false;
+    }
+    else
+    {
+        auto& streamer = **streamerResult;
+        const tmx::render::ViewRect view{10000.0f, 0.0f, 160.0f, 120.0f};
+        streamer.update(view);
+        streamer.waitUntilIdle();
+        const size_t loaded = streamer.residentCount();
+        streamer.update(view);
+        if (loaded != 1 || streamer.residentCount() != loaded)
+        {
+            std::cerr << "parallax: ERROR - " << loaded << " chunks loaded, " << streamer.residentCount()
+                << " kept by the next update, expected 1" << std::endl;
+            success = false;
+        }
+    }
+    std::filesystem::remove_all(directory);
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing chunk streaming: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    auto streamerResult = tmx::render::ChunkStreamer::open(filename);
+    if (!streamerResult)
+    {
+        std::cerr << filename << ": FAILED - " << streamerResult.error() << std::endl;
+        return 1;
+    }
+
+    const auto& map = *result;
+    const auto full = tmx::render::createRenderData(map);
+
+    bool success = true;
+    success &= verifyIndex(map, **streamerResult, filename);
+    success &= verifyViews(full, **streamerResult, filename);
+    success &= verifyEviction(filename);
+    success &= verifyParallax();
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using Cell = std::pair<std::int32_t, std::int32_t>;
+
+// Solid cells found directly from the layers, for comparison with the baked rectangles
+auto solidCells(const tmx::map::Map& map, const std::vector<bool>& solidLayers, const std::string& property)
+    -> std::map<Cell, bool>
+{
+    std::map<Cell, bool> cells;
+    for (std::size_t l = 0; l < map.layers.size(); ++l)
+    {
+        const auto& layer = map.layers[l];
+        if (!layer.visible)
+            continue;
+        const auto isSolid = [&](std::uint32_t gid)
+        {
+            gid &= tmx::map::GID_MASK;
+            if (gid == 0)
+                return false;
+            if (solidLayers[l])
+                return true;
+            for (const auto& tileset : map.tilesets)
+            {
+                for (const auto& tile : tileset.tiles)
+                {
+                    if (tileset.firstgid + tile.id == gid && tile.properties.getBool(property))
+                        return true;
+                }
+            }
+            return false;
+        };
+
+        for (std::uint32_t i = 0; i < layer.data.size(); ++i)
+        {
+            if (isSolid(layer.data[i]))
+                cells[{static_cast<std::int32_t>(i % layer.width), static_cast<std::int32_t>(i / layer.width)}] = true;
+        }
+        for (const auto& chunk : layer.chunks)
+        {
+            for (std::uint32_t i = 0; i < chunk.data.size(); ++i)
+            {
+                if (isSolid(chunk.data[i]))
+                    cells[{chunk.x + static_cast<std::int32_t>(i % chunk.width),
+                           chunk.y + static_cast<std::int32_t>(i / chunk.width)}] = true;
+            }
+        }
+    }
+    return cells;
+}
+
+// Rectangles must cover every solid cell exactly once and nothing else
+bool verifyCoverage(const tmx::map::CollisionMap& collision, const std::map<Cell, bool>& expected,
+                    const std::string& label)
+{
+    std::map<Cell, int> covered;
+    for (const auto& rect : collision.rects)
+    {
+        if (rect.width <= 0 || rect.height <= 0)
+        {
+            std::cerr << label << ": ERROR - Empty rectangle at (" << rect.x << ", " << rect.y << ")" << std::endl;
+            return false;
+        }
+        for (std::int32_t y = rect.y; y < rect.y + rect.height; ++y)
+        {
+            for (std::int32_t x = rect.x; x < rect.x + rect.width; ++x)
+                ++covered[{x, y}];
+        }
+    }
+
+    for (const auto& [cell, count] : covered)
+    {
+        if (count != 1 || !expected.contains(cell))
+        {
+            std::cerr << label << ": ERROR - Cell (" << cell.first << ", " << cell.second << ") is covered " << count
+                << " times" << (expected.contains(cell) ? "" : " but is not solid") << std::endl;
+            return false;
+        }
+    }
+    if (covered.size() != expected.size() || collision.solidTileCount != expected.size())
+    {
+        std::cerr << label << ": ERROR - " << covered.size() << " cells covered, " << expected.size() << " are solid"
+            << std::endl;
+        return false;
+    }
+
+    // Greedy rows: a rectangle never has a solid cell just to its right on its top row that a rectangle starting
+    // later took, i.e. every run is as wide as it can be
+    for (const auto& rect : collision.rects)
+    {
+        const Cell right{rect.x + rect.width, rect.y};
+        if (!expected.contains(right))
+            continue;
+        const bool takenEarlier = std::ranges::any_of(collision.rects, [&](const auto& other)
+        {
+            return (other.y < rect.y || (other.y == rect.y && other.x < rect.x)) && right.first >= other.x &&
+                right.first < other.x + other.width && right.second >= other.y && right.second < other.y + other.height;
+        });
+        if (!takenEarlier)
+        {
+            std::cerr << label << ": ERROR - Rectangle at (" << rect.x << ", " << rect.y << ") stops short"
+                << std::endl;
+            return false;
+        }
+    }
+
+    const auto boxes = collision.boxes();
+    if (!collision.rects.empty() &&
+        (boxes.front().minX != static_cast<float>(collision.rects.front().x * static_cast<std::int32_t>(collision.tileWidth)) ||
+         boxes.front().maxY != static_cast<float>((collision.rects.front().y + collision.rects.front().height) *
+                                                  static_cast<std::int32_t>(collision.tileHeight))))
+    {
+        std::cerr << label << ": ERROR - Pixel boxes do not match the rectangles" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// The same tiles stored as finite data give the same rectangles, shifted by the data's origin
+bool verifyFiniteCopy(const tmx::map::Map& map, const std::vector<std::uint8_t>& solidLayers,
+                      const tmx::map::CollisionMap& collision, const std::string& label)
+{
+    if (collision.bounds.isEmpty())
+        return true;
+
+    auto finite = map;
+    const auto& bounds = collision.bounds;
+    for (auto& layer : finite.layers)
+    {
+        if (layer.chunks.empty())
+            continue;
+        layer.width = static_cast<std::uint32_t>(bounds.maxX - bounds.minX);
+        layer.height = static_cast<std::uint32_t>(bounds.maxY - bounds.minY);
+        layer.data.assign(static_cast<std::size_t>(layer.width) * layer.height, 0);
+        for (const auto& chunk : layer.chunks)
+        {
+            for (std::uint32_t i = 0; i < chunk.data.size(); ++i)
+            {
+                const std::int32_t x = chunk.x + static_cast<std::int32_t>(i % chunk.width) - bounds.minX;
+                const std::int32_t y = chunk.y + static_cast<std::int32_t>(i / chunk.width) - bounds.minY;
+                if (x >= 0 && y >= 0 && x < static_cast<std::int32_t>(layer.width) &&
+                    y < static_cast<std::int32_t>(layer.height))
+                    layer.data[static_cast<std::size_t>(y) * layer.width + x] = chunk.data[i];
+            }
+        }
+        layer.chunks.clear();
+    }
+
+    const auto copy = tmx::map::bakeCollision(finite, solidLayers);
+    const bool same = std::ranges::equal(collision.rects, copy.rects, [&](const auto& a, const auto& b)
+    {
+        return a.x == b.x + bounds.minX && a.y == b.y + bounds.minY && a.width == b.width && a.height == b.height;
+    });
+    if (!same)
+    {
+        std::cerr << label << ": ERROR - Finite data gives different rectangles than chunks" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing collision baking: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    auto map = *result;
+
+    // Mark every third tile of each tileset solid through a tile property
+    for (auto& tileset : map.tilesets)
+    {
+        for (std::uint32_t id = 0; id < tileset.tilecount; id += 3)
+        {
+            auto tile = std::ranges::find(tileset.tiles, id, &tmx::map::Tile::id);
+            if (tile == tileset.tiles.end())
+            {
+                tileset.tiles.push_back({id, {}, {}});
+                tile = tileset.tiles.end() - 1;
+            }
+            tile->properties.properties.push_back({"solid", "true", "bool"});
+        }
+    }
+
+    const std::vector<bool> noLayers(map.layers.size(), false);
+    const std::vector<bool> allLayers(map.layers.size(), true);
+    const auto isWall = [&](const tmx::map::Layer& layer) { return layer.name == "Walls" || map.layers.size() == 1; };
+    std::vector<bool> walls(map.layers.size(), false);
+    std::vector<std::uint8_t> wallFlags(map.layers.size(), 0);
+    for (std::size_t l = 0; l < map.layers.size(); ++l)
+    {
+        walls[l] = isWall(map.layers[l]);
+        wallFlags[l] = walls[l] ? 1 : 0;
+    }
+
+    // Tile property only
+    const auto byProperty = tmx::map::bakeCollision(map);
+    success &= verifyCoverage(byProperty, solidCells(map, noLayers, "solid"), filename + " (property)");
+
+    // A layer predicate together with the property
+    const auto byLayer = tmx::map::bakeCollision(map, isWall);
+    success &= verifyCoverage(byLayer, solidCells(map, walls, "solid"), filename + " (solid layer)");
+
+    // Every tile solid: large areas must merge into far fewer rectangles than tiles
+    const auto everything = tmx::map::bakeCollision(*result, [](const tmx::map::Layer&) { return true; });
+    success &= verifyCoverage(everything, solidCells(*result, allLayers, "solid"), filename + " (all layers)");
+    std::cout << filename << ": " << everything.solidTileCount << " solid tiles in " << everything.rects.size()
+        << " rectangles; walls and property: " << byLayer.solidTileCount << " tiles in " << byLayer.rects.size()
+        << std::endl;
+    if (everything.rects.size() * 4 > everything.solidTileCount)
+    {
+        std::cerr << filename << ": ERROR - Solid tiles were barely merged" << std::endl;
+        success = false;
+    }
+
+    // Chunks and finite data agree
+    success &= verifyFiniteCopy(map, wallFlags, byLayer, filename);
+
+    // No property and no solid layer: nothing; hidden layers only count when asked
+    const auto none = tmx::map::bakeCollision(*result, tmx::map::CollisionOptions{.solidProperty = ""});
+    auto hidden = *result;
+    for (auto& layer : hidden.layers)
+        layer.visible = false;
+    const auto hiddenSkipped = tmx::map::bakeCollision(hidden, [](const tmx::map::Layer&) { return true; });
+    const auto hiddenIncluded = tmx::map::bakeCollision(hidden, [](const tmx::map::Layer&) { return true; },
+                                                        {.includeHidden = true});
+    if (!none.rects.empty() || !none.bounds.isEmpty() || !hiddenSkipped.rects.empty() ||
+        hiddenIncluded.solidTileCount != everything.solidTileCount)
+    {
+        std::cerr << filename << ": ERROR - Empty or hidden input was not handled" << std::endl;
+        success = false;
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
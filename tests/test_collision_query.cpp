@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::map::CollisionBox;
+using tmx::map::CollisionQuery;
+
+constexpr float EPSILON = CollisionQuery::CONTACT_EPSILON;
+
+// Fraction at which the segment enters the closed box of every solid cell, minimum over all of them
+auto referenceRaycast(const CollisionQuery& query, const tmx::map::Ray& ray) -> float
+{
+    const float x = ray.x / query.tileWidth(), y = ray.y / query.tileHeight();
+    const float dx = ray.dx / query.tileWidth(), dy = ray.dy / query.tileHeight();
+    const auto& bounds = query.solid().bounds();
+    float best = std::numeric_limits<float>::infinity();
+    for (std::int32_t cy = bounds.minY; cy < bounds.maxY; ++cy)
+    {
+        for (std::int32_t cx = bounds.minX; cx < bounds.maxX; ++cx)
+        {
+            if (!query.solid().get(cx, cy))
+                continue;
+            float enter = 0.0f, exit = 1.0f;
+            const auto clip = [&](const float origin, const float delta, const float c0, const float c1)
+            {
+                if (delta == 0.0f)
+                {
+                    if (origin < c0 || origin > c1)
+                        exit = -1.0f;
+                    return;
+                }
+                float t0 = (c0 - origin) / delta, t1 = (c1 - origin) / delta;
+                if (t0 > t1)
+                    std::swap(t0, t1);
+                enter = std::max(enter, t0);
+                exit = std::min(exit, t1);
+            };
+            clip(x, dx, static_cast<float>(cx), static_cast<float>(cx + 1));
+            clip(y, dy, static_cast<float>(cy), static_cast<float>(cy + 1));
+            if (enter <= exit)
+                best = std::min(best, enter);
+        }
+    }
+    return best;
+}
+
+// Depth by which a box overlaps the deepest solid cell, on its shallower axis
+auto penetration(const CollisionQuery& query, const CollisionBox& box) -> float
+{
+    float deepest = 0.0f;
+    const auto& bounds = query.solid().bounds();
+    for (std::int32_t cy = bounds.minY; cy < bounds.maxY; ++cy)
+    {
+        for (std::int32_t cx = bounds.minX; cx < bounds.maxX; ++cx)
+        {
+            if (!query.solid().get(cx, cy))
+                continue;
+            const float x0 = static_cast<float>(cx) * query.tileWidth(), y0 = static_cast<float>(cy) * query.tileHeight();
+            const float overlapX = std::min(box.maxX, x0 + query.tileWidth()) - std::max(box.minX, x0);
+            const float overlapY = std::min(box.maxY, y0 + query.tileHeight()) - std::max(box.minY, y0);
+            deepest = std::max(deepest, std::min(overlapX, overlapY));
+        }
+    }
+    return deepest;
+}
+
+auto pixelBounds(const CollisionQuery& query) -> CollisionBox
+{
+    const auto& bounds = query.solid().bounds();
+    return {static_cast<float>(bounds.minX) * query.tileWidth(), static_cast<float>(bounds.minY) * query.tileHeight(),
+            static_cast<float>(bounds.maxX) * query.tileWidth(), static_cast<float>(bounds.maxY) * query.tileHeight()};
+}
+
+// Rays agree with the reference, and batches agree bit for bit with single rays
+bool verifyRays(const CollisionQuery& query, std::uint32_t seed, const std::string& label)
+{
+    const auto area = pixelBounds(query);
+    const float marginX = query.tileWidth() * 3.0f, marginY = query.tileHeight() * 3.0f;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(area.minX - marginX, area.maxX + marginX);
+    std::uniform_real_distribution<float> y(area.minY - marginY, area.maxY + marginY);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    std::vector<tmx::map::Ray> rays;
+    for (int i = 0; i < 1003; ++i)
+    {
+        tmx::map::Ray ray{x(rng), y(rng), 0.0f, 0.0f};
+        switch (kind(rng))
+        {
+        case 0: ray.dx = x(rng) - ray.x; break; // Horizontal
+        case 1: ray.dy = y(rng) - ray.y; break; // Vertical
+        case 2: break; // Empty
+        case 3: ray.dx = ray.dy = (x(rng) - ray.x) * 0.5f; break; // Diagonal
+        default: ray.dx = x(rng) - ray.x; ray.dy = y(rng) - ray.y; break;
+        }
+        rays.push_back(ray);
+    }
+
+    std::size_t hitCount = 0;
+    for (const auto& ray : rays)
+    {
+        const auto hit = query.raycast(ray);
+        const float expected = referenceRaycast(query, ray);
+        const bool expectedHit = expected <= 1.0f;
+        if (hit.hit != expectedHit || (hit.hit && std::abs(hit.fraction - expected) > 1e-4f))
+        {
+            std::cerr << label << ": ERROR - Ray (" << ray.x << ", " << ray.y << ") + (" << ray.dx << ", " << ray.dy
+                << ") hit at " << (hit.hit ? hit.fraction : -1.0f) << ", expected " << (expectedHit ? expected : -1.0f)
+                << std::endl;
+            return false;
+        }
+        if (hit.hit && !query.solid().get(hit.tileX, hit.tileY))
+        {
+            std::cerr << label << ": ERROR - Ray reports a free cell as hit" << std::endl;
+            return false;
+        }
+        // The normal points out of the side the ray came through
+        if (hit.hit && hit.fraction > 0.0f &&
+            (std::abs(hit.normalX) + std::abs(hit.normalY) != 1 || hit.normalX * ray.dx > 0.0f || hit.normalY * ray.dy > 0.0f))
+        {
+            std::cerr << label << ": ERROR - Ray normal (" << hit.normalX << ", " << hit.normalY << ") is wrong" << std::endl;
+            return false;
+        }
+        hitCount += hit.hit ? 1 : 0;
+        if (query.lineOfSight(ray.x, ray.y, ray.x + ray.dx, ray.y + ray.dy) == hit.hit)
+        {
+            std::cerr << label << ": ERROR - Line of sight disagrees with the raycast" << std::endl;
+            return false;
+        }
+    }
+
+    // Every batch length, so lanes run out at every point
+    for (const std::size_t count : {rays.size(), std::size_t{0}, std::size_t{1}, std::size_t{5}, std::size_t{6}})
+    {
+        std::vector<tmx::map::RayHit> hits(count);
+        query.raycast(std::span(rays).first(count), hits);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto single = query.raycast(rays[i]);
+            if (std::memcmp(&single.fraction, &hits[i].fraction, sizeof(float)) != 0 || single.hit != hits[i].hit ||
+                single.tileX != hits[i].tileX || single.tileY != hits[i].tileY || single.normalX != hits[i].normalX ||
+                single.normalY != hits[i].normalY)
+            {
+                std::cerr << label << ": ERROR - Batched ray " << i << " differs from a single raycast" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::cout << label << ": " << hitCount << " of " << rays.size() << " rays hit" << std::endl;
+    return true;
+}
+
+// Queries without any solid cell miss everything, single and batched alike
+bool verifyEmptyGrid(const CollisionQuery& query, const std::string& label)
+{
+    std::vector<tmx::map::Ray> rays;
+    for (int i = 0; i < 9; ++i)
+    {
+        const float step = static_cast<float>(i % 3 - 1);
+        rays.push_back({5.5f * query.tileWidth(), -2.5f * query.tileHeight(), (step - 1.0f) * query.tileWidth() * 4.0f,
+                        (1.0f - step) * query.tileHeight() * 4.0f});
+    }
+    std::vector<tmx::map::RayHit> hits(rays.size(), {true, 0.0f, 0, 0, 0, 0});
+    query.raycast(rays, hits);
+    for (std::size_t i = 0; i < rays.size(); ++i)
+    {
+        if (hits[i].hit || query.raycast(rays[i]).hit)
+        {
+            std::cerr << label << ": ERROR - Ray " << i << " hit an empty grid" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sweeps stop where the box touches its first wall, and moving boxes never sink into walls
+bool verifyBoxes(const CollisionQuery& query, std::uint32_t seed, const std::string& label)
+{
+    const auto area = pixelBounds(query);
+    const float tw = query.tileWidth(), th = query.tileHeight();
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(area.minX - tw, area.maxX + tw);
+    std::uniform_real_distribution<float> y(area.minY - th, area.maxY + th);
+    std::uniform_real_distribution<float> size(0.2f, 1.8f);
+    std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+
+    const auto shifted = [](const CollisionBox& box, const float dx, const float dy)
+    {
+        return CollisionBox{box.minX + dx, box.minY + dy, box.maxX + dx, box.maxY + dy};
+    };
+
+    std::size_t sweeps = 0, hits = 0;
+    for (int attempt = 0; attempt < 2000 && sweeps < 300; ++attempt)
+    {
+        const float bx = x(rng), by = y(rng);
+        const CollisionBox box{bx, by, bx + size(rng) * tw, by + size(rng) * th};
+        if (penetration(query, box) > 0.0f)
+            continue;
+        const float dx = step(rng) * tw, dy = attempt % 5 == 0 ? 0.0f : step(rng) * th;
+        const auto hit = query.sweep(box, dx, dy);
+        ++sweeps;
+
+        // Nothing is crossed on the way
+        for (int sample = 1; sample <= 32; ++sample)
+        {
+            const float f = hit.fraction * static_cast<float>(sample) / 32.0f;
+            if (penetration(query, shifted(box, dx * f, dy * f)) > 2.0f * EPSILON)
+            {
+                std::cerr << label << ": ERROR - Sweep passes through a wall before fraction " << hit.fraction << std::endl;
+                return false;
+            }
+        }
+        if (!hit.hit)
+        {
+            if (hit.fraction != 1.0f)
+            {
+                std::cerr << label << ": ERROR - Sweep without a hit stops early" << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        // Pushing on a little further sinks into the cell that was hit
+        ++hits;
+        const float length = std::hypot(dx, dy);
+        const float f = hit.fraction + 0.05f / length;
+        const auto pushed = shifted(box, dx * f, dy * f);
+        const float cx = static_cast<float>(hit.tileX) * tw, cy = static_cast<float>(hit.tileY) * th;
+        if (!query.solid().get(hit.tileX, hit.tileY) || pushed.maxX <= cx || pushed.minX >= cx + tw ||
+            pushed.maxY <= cy || pushed.minY >= cy + th)
+        {
+            std::cerr << label << ": ERROR - Sweep hit (" << hit.tileX << ", " << hit.tileY << ") at " << hit.fraction
+                << " is not where the box stops" << std::endl;
+            return false;
+        }
+    }
+
+    // A box wandering about: every move keeps it out of the walls, and unblocked moves go all the way
+    std::size_t blocked = 0;
+    for (int walker = 0; walker < 20; ++walker)
+    {
+        CollisionBox box{};
+        bool placed = false;
+        for (int attempt = 0; attempt < 500 && !placed; ++attempt)
+        {
+            const float bx = x(rng), by = y(rng);
+            box = {bx, by, bx + 0.8f * tw, by + 0.9f * th};
+            placed = penetration(query, box) == 0.0f;
+        }
+        if (!placed)
+            continue;
+
+        for (int frame = 0; frame < 100; ++frame)
+        {
+            const float dx = step(rng) * tw * 0.5f, dy = step(rng) * th * 0.5f;
+            const auto moved = query.move(box, dx, dy);
+            box = shifted(box, moved.dx, moved.dy);
+            if (penetration(query, box) > 4.0f * EPSILON)
+            {
+                std::cerr << label << ": ERROR - Moving box sank into a wall" << std::endl;
+                return false;
+            }
+            if ((!moved.blockedX && std::abs(moved.dx - dx) > EPSILON) || (!moved.blockedY && std::abs(moved.dy - dy) > EPSILON))
+            {
+                std::cerr << label << ": ERROR - Unblocked move was shortened" << std::endl;
+                return false;
+            }
+            blocked += moved.blockedX || moved.blockedY ? 1 : 0;
+        }
+    }
+
+    std::cout << label << ": " << hits << " of " << sweeps << " sweeps hit, " << blocked << " moves blocked" << std::endl;
+    return true;
+}
+
+bool verifyLayerGrid(const tmx::map::Layer& layer, const tmx::map::BitGrid& solid, const std::string& label)
+{
+    std::size_t tiles = 0;
+    const auto check = [&](const std::int32_t x, const std::int32_t y, const std::uint32_t gid)
+    {
+        tiles += gid != 0 ? 1 : 0;
+        return solid.get(x, y) == (gid != 0);
+    };
+    bool match = true;
+    for (std::size_t i = 0; i < layer.data.size(); ++i)
+        match &= check(static_cast<std::int32_t>(i % layer.width), static_cast<std::int32_t>(i / layer.width), layer.data[i]);
+    for (const auto& chunk : layer.chunks)
+    {
+        for (std::size_t i = 0; i < chunk.data.size(); ++i)
+            match &= check(chunk.x + static_cast<std::int32_t>(i % chunk.width),
+                           chunk.y + static_cast<std::int32_t>(i / chunk.width), chunk.data[i]);
+    }
+    if (!match || solid.count() != tiles)
+    {
+        std::cerr << label << ": ERROR - Layer bitmap differs from the layer's tiles" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing collision queries: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    const auto& map = *result;
+    bool success = true;
+    std::uint32_t seed = 1;
+    for (const auto& layer : map.layers)
+    {
+        const auto query = CollisionQuery::fromLayer(map, layer);
+        const std::string label = filename + " [" + layer.name + "]";
+        success &= verifyLayerGrid(layer, query.solid(), label);
+        if (query.solid().count() == 0)
+            continue;
+        success &= verifyRays(query, seed++, label);
+        success &= verifyBoxes(query, seed++, label);
+    }
+
+    // Random walls on a grid wider than one word, with a negative origin and non-square tiles
+    tmx::map::BitGrid walls({-70, -9, 80, 40});
+    std::mt19937 rng(42);
+    std::bernoulli_distribution wall(0.2);
+    for (std::int32_t y = -9; y < 40; ++y)
+    {
+        for (std::int32_t x = -70; x < 80; ++x)
+            walls.set(x, y, wall(rng));
+    }
+    const CollisionQuery synthetic(walls, 12, 20);
+    success &= verifyRays(synthetic, 100, "synthetic");
+    success &= verifyBoxes(synthetic, 101, "synthetic");
+    success &= verifyEmptyGrid(CollisionQuery(), "empty");
+    success &= verifyEmptyGrid(CollisionQuery(tmx::map::BitGrid(), 16, 16), "empty 16x16");
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
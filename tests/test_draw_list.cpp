@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+// Screen position of a tile object's anchor; isometric maps measure both object axes along the cell axes in units of
+// tileHeight, with the top corner of cell (0, 0) at x = mapHeight * tileWidth / 2
+auto objectAnchor(const tmx::render::MapRenderData& renderData, const tmx::render::ObjectRenderInfo& object)
+    -> tmx::map::Point
+{
+    const auto& projection = renderData.projection;
+    if (projection.orientation != tmx::map::Orientation::Isometric)
+        return {object.x, object.y};
+    const float tileWidth = static_cast<float>(projection.tileWidth);
+    const float tileHeight = static_cast<float>(projection.tileHeight);
+    const float topCornerX = static_cast<float>(projection.mapHeight) * tileWidth / 2;
+    return {topCornerX + (object.x - object.y) / tileHeight * tileWidth / 2, (object.x + object.y) / 2};
+}
+
+// Everything the draw order depends on, read back through the list's own accessors
+struct Entry
+{
+    std::uint32_t band;
+    bool indexOrdered; // Object of a group with DrawOrder::Index
+    std::int64_t depth, x;
+    std::uint32_t source, index;
+    std::uint32_t id; // Tile id or object id, to compare lists built from different storages
+    std::uint32_t tilesetIndex;
+};
+
+auto entriesOf(const tmx::render::DrawList& list) -> std::vector<Entry>
+{
+    const auto& renderData = *list.renderData();
+    std::vector<Entry> entries;
+    list.forEachItem([&]<typename Info>(const Info& info)
+    {
+        const auto& item = list.items()[entries.size()];
+        const auto& source = list.sources()[item.source];
+        Entry entry{source.band, false, 0, 0, item.source, item.index, 0, info.tilesetIndex};
+        if constexpr (std::is_same_v<Info, tmx::render::TileRenderInfo>)
+        {
+            entry.depth = info.destY + static_cast<std::int64_t>(renderData.tileHeight);
+            entry.x = info.destX;
+            entry.id = info.tileId;
+        }
+        else
+        {
+            entry.indexOrdered = renderData.objectGroups[source.index].drawOrder == tmx::map::DrawOrder::Index;
+            const auto anchor = objectAnchor(renderData, info);
+            entry.depth = static_cast<std::int64_t>(std::floor(anchor.y));
+            entry.x = static_cast<std::int64_t>(std::floor(anchor.x));
+            entry.id = info.id;
+        }
+        entries.push_back(entry);
+    });
+    return entries;
+}
+
+// Reference order, written from the render order's definition rather than from the key layout
+auto drawsBefore(const Entry& a, const Entry& b, tmx::map::RenderOrder order) -> bool
+{
+    const bool up = order == tmx::map::RenderOrder::RightUp || order == tmx::map::RenderOrder::LeftUp;
+    const bool left = order == tmx::map::RenderOrder::LeftDown || order == tmx::map::RenderOrder::LeftUp;
+    if (a.band != b.band)
+        return a.band < b.band;
+    if (a.indexOrdered != b.indexOrdered)
+        return b.indexOrdered;
+    if (!a.indexOrdered && a.depth != b.depth)
+        return up ? a.depth > b.depth : a.depth < b.depth;
+    if (!a.indexOrdered && a.x != b.x)
+        return left ? a.x > b.x : a.x < b.x;
+    if (a.source != b.source)
+        return a.source < b.source;
+    return a.index < b.index;
+}
+
+// Number of items a complete list holds
+auto expectedCount(const tmx::render::MapRenderData& renderData, const tmx::render::DrawList& list) -> std::size_t
+{
+    std::size_t count = 0;
+    for (const auto& source : list.sources())
+    {
+        if (source.kind == tmx::render::DrawSourceKind::ObjectGroup)
+        {
+            const auto& group = renderData.objectGroups[source.index];
+            if (group.visible)
+            {
+                count += std::ranges::count_if(group.objects, [&](const auto& object)
+                {
+                    return object.tilesetIndex < renderData.tilesets.size();
+                });
+            }
+            continue;
+        }
+
+        const auto& layer = renderData.layers[source.index];
+        if (layer.visible)
+        {
+            renderData.forEachTile(layer, [&](const tmx::render::TileRenderInfo&) { ++count; });
+        }
+    }
+    return count;
+}
+
+bool verifyOrder(const tmx::render::MapRenderData& renderData, const tmx::render::DrawList& list,
+                 const std::string& label)
+{
+    const auto entries = entriesOf(list);
+    const std::size_t expected = expectedCount(renderData, list);
+    if (entries.size() != expected || list.items().size() != expected)
+    {
+        std::cerr << label << ": ERROR - " << entries.size() << " items drawn, expected " << expected << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 1; i < entries.size(); ++i)
+    {
+        if (!drawsBefore(entries[i - 1], entries[i], renderData.renderOrder))
+        {
+            std::cerr << label << ": ERROR - Item " << i << " (source " << entries[i].source << ", index "
+                << entries[i].index << ") is drawn too late" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameEntries(const std::vector<Entry>& a, const std::vector<Entry>& b)
+{
+    return std::ranges::equal(a, b, [](const Entry& x, const Entry& y)
+    {
+        return x.band == y.band && x.depth == y.depth && x.x == y.x && x.source == y.source && x.id == y.id &&
+            x.tilesetIndex == y.tilesetIndex;
+    });
+}
+
+bool sameItems(const tmx::render::DrawList& a, const tmx::render::DrawList& b)
+{
+    return std::ranges::equal(a.items(), b.items(), [](const auto& x, const auto& y)
+    {
+        return x.key == y.key && x.source == y.source && x.index == y.index;
+    });
+}
+
+// Adds a group of tile objects scattered over the map, drawn with the topmost layer
+void addObjects(tmx::render::MapRenderData& renderData, std::uint32_t count, tmx::map::DrawOrder drawOrder)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> x(-32.0f, static_cast<float>(renderData.pixelWidth) + 32.0f);
+    std::uniform_real_distribution<float> y(-32.0f, static_cast<float>(renderData.pixelHeight) + 32.0f);
+
+    tmx::render::ObjectGroupRenderData group{};
+    group.name = "actors";
+    group.visible = true;
+    group.opacity = 1.0f;
+    group.drawOrder = drawOrder;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        tmx::render::ObjectRenderInfo object{};
+        object.id = 1000 + i;
+        object.x = x(rng);
+        object.y = y(rng);
+        object.visible = i % 5 != 0;
+        object.shape = tmx::map::ObjectShape::Rectangle;
+        object.gid = renderData.tilesets.front().firstgid;
+        object.tilesetIndex = i % 7 == 0 ? static_cast<std::uint32_t>(-1) : 0; // Some plain rectangles
+        group.objects.push_back(object);
+    }
+    renderData.objectGroups.push_back(std::move(group));
+}
+
+// Moving objects one at a time or many at once must give the list a fresh build gives
+bool verifyUpdate(tmx::render::MapRenderData renderData, const std::string& label)
+{
+    addObjects(renderData, 200, tmx::map::DrawOrder::TopDown);
+    const auto groupIndex = static_cast<std::uint32_t>(renderData.objectGroups.size() - 1);
+    auto& objects = renderData.objectGroups[groupIndex].objects;
+
+    tmx::render::DrawList list(renderData);
+    list.build();
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> step(-48.0f, 48.0f);
+    for (const std::uint32_t movedCount : {1u, 3u, 5u, 150u})
+    {
+        std::vector<tmx::render::ObjectRef> moved;
+        for (std::uint32_t i = 0; i < movedCount; ++i)
+        {
+            const auto objectIndex = static_cast<std::uint32_t>(rng() % objects.size());
+            objects[objectIndex].x += step(rng);
+            objects[objectIndex].y += step(rng);
+            moved.push_back({groupIndex, objectIndex});
+        }
+        moved.push_back({groupIndex, static_cast<std::uint32_t>(objects.size())}); // Out of range: ignored
+        moved.push_back({groupIndex + 1, 0});
+        list.update(moved);
+
+        tmx::render::DrawList fresh(renderData);
+        fresh.build();
+        if (!sameItems(list, fresh) || !verifyOrder(renderData, list, label + " after update"))
+        {
+            std::cerr << label << ": ERROR - Moving " << movedCount << " objects differs from a fresh build"
+                << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Index-ordered objects follow the depth-sorted items of their band in object order
+bool verifyIndexOrder(tmx::render::MapRenderData renderData, const std::string& label)
+{
+    addObjects(renderData, 50, tmx::map::DrawOrder::Index);
+    const auto groupIndex = static_cast<std::uint32_t>(renderData.objectGroups.size() - 1);
+    tmx::render::DrawList list(renderData);
+    list.build();
+    if (!verifyOrder(renderData, list, label + " (index draw order)"))
+        return false;
+
+    const auto& items = list.items();
+    const auto firstObject = std::ranges::find_if(items, [&](const auto& item)
+    {
+        const auto& source = list.sources()[item.source];
+        return source.kind == tmx::render::DrawSourceKind::ObjectGroup && source.index == groupIndex;
+    });
+    std::uint32_t previous = 0;
+    for (auto it = firstObject; it != items.end(); ++it)
+    {
+        const auto& source = list.sources()[it->source];
+        if (source.kind != tmx::render::DrawSourceKind::ObjectGroup || source.index != groupIndex ||
+            (it != firstObject && it->index <= previous))
+        {
+            std::cerr << label << ": ERROR - Index-ordered objects are not drawn last, in object order" << std::endl;
+            return false;
+        }
+        previous = it->index;
+    }
+
+    // Moving an index-ordered object changes nothing
+    auto before = std::vector(items.begin(), items.end());
+    renderData.objectGroups[groupIndex].objects[3].y += 500.0f;
+    const tmx::render::ObjectRef moved{groupIndex, 3};
+    list.update({&moved, 1});
+    if (!std::ranges::equal(before, list.items(), [](const auto& x, const auto& y)
+    {
+        return x.key == y.key && x.source == y.source && x.index == y.index;
+    }))
+    {
+        std::cerr << label << ": ERROR - Moving an index-ordered object reordered the list" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Caller-provided bands: everything in one band, duplicates and missing layers dropped
+bool verifySources(const tmx::render::MapRenderData& renderData, const std::string& label)
+{
+    std::vector<tmx::render::DrawSource> sources;
+    for (std::uint32_t i = 0; i < renderData.layers.size(); ++i)
+        sources.push_back({tmx::render::DrawSourceKind::TileLayer, i, 0});
+    for (std::uint32_t i = 0; i < renderData.objectGroups.size(); ++i)
+        sources.push_back({tmx::render::DrawSourceKind::ObjectGroup, i, 1000});
+    sources.push_back({tmx::render::DrawSourceKind::TileLayer, 0, 3});
+    sources.push_back({tmx::render::DrawSourceKind::TileLayer, static_cast<std::uint32_t>(renderData.layers.size()), 0});
+
+    tmx::render::DrawList list(renderData);
+    list.build(sources);
+    const std::size_t expectedSources = renderData.layers.size() + renderData.objectGroups.size();
+    if (list.sources().size() != expectedSources ||
+        std::ranges::any_of(list.sources(), [](const auto& source) { return source.band > tmx::render::DrawList::MAX_BAND; }))
+    {
+        std::cerr << label << ": ERROR - " << list.sources().size() << " sources kept, expected " << expectedSources
+            << std::endl;
+        return false;
+    }
+    if (!verifyOrder(renderData, list, label + " (custom sources)"))
+        return false;
+
+    tmx::render::DrawList empty;
+    empty.build();
+    empty.update({});
+    if (!empty.items().empty())
+    {
+        std::cerr << label << ": ERROR - A list without render data has items" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool verifyParsing()
+{
+    const auto parsed = tmx::Parser::parseFromString(R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" renderorder="left-up" width="2" height="2" tilewidth="16"
+     tileheight="16" infinite="0">
+ <layer id="1" name="Ground" width="2" height="2">
+  <data encoding="csv">0,0,0,0</data>
+ </layer>
+ <objectgroup id="2" name="Indexed" draworder="index"/>
+ <objectgroup id="3" name="Sorted"/>
+</map>)");
+    if (!parsed || parsed->renderorder != tmx::map::RenderOrder::LeftUp || parsed->objectgroups.size() != 2 ||
+        parsed->objectgroups[0].draworder != tmx::map::DrawOrder::Index ||
+        parsed->objectgroups[1].draworder != tmx::map::DrawOrder::TopDown)
+    {
+        std::cerr << "ERROR - Draw order attributes were not parsed" << std::endl;
+        return false;
+    }
+
+    const auto renderData = tmx::render::createRenderData(*parsed);
+    if (renderData.renderOrder != tmx::map::RenderOrder::LeftUp ||
+        renderData.objectGroups[0].drawOrder != tmx::map::DrawOrder::Index)
+    {
+        std::cerr << "ERROR - Draw order attributes were not copied to the render data" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Isometric tile objects are sorted by their projected position, not by their raw object coordinates
+bool verifyIsometric()
+{
+    const auto parsed = tmx::Parser::parseFromString(R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="isometric" renderorder="right-down" width="4" height="4" tilewidth="32"
+     tileheight="16" infinite="0">
+ <tileset firstgid="1" name="Blocks" tilewidth="32" tileheight="16" tilecount="4" columns="2">
+  <image source="blocks.png" width="64" height="32"/>
+ </tileset>
+ <layer id="1" name="Ground" width="4" height="4">
+  <data encoding="csv">1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1</data>
+ </layer>
+ <objectgroup id="2" name="Actors">
+  <object id="3" gid="2" x="40" y="8" width="32" height="16"/>
+ </objectgroup>
+</map>)");
+    if (!parsed)
+    {
+        std::cerr << "isometric: ERROR - Parse error: " << parsed.error() << std::endl;
+        return false;
+    }
+
+    const auto renderData = tmx::render::createRenderData(*parsed);
+    tmx::render::DrawList list(renderData);
+    list.build();
+    if (!verifyOrder(renderData, list, "isometric"))
+        return false;
+
+    // The anchor lands on screen at y = 24: after the three cells whose bottom corner is at y <= 24, although its
+    // raw y of 8 is above every tile's bottom corner
+    const auto object = std::ranges::find_if(list.items(), [&](const auto& item)
+    {
+        return list.sources()[item.source].kind == tmx::render::DrawSourceKind::ObjectGroup;
+    });
+    if (object == list.items().end() || object - list.items().begin() != 3)
+    {
+        std::cerr << "isometric: ERROR - Tile object is not drawn after the first three cells" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing draw lists: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = verifyParsing();
+    success &= verifyIsometric();
+    for (const auto order : {tmx::map::RenderOrder::RightDown, tmx::map::RenderOrder::RightUp,
+                             tmx::map::RenderOrder::LeftDown, tmx::map::RenderOrder::LeftUp})
+    {
+        std::vector<Entry> reference;
+        for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                                   tmx::render::TileStorage::Indexed})
+        {
+            const std::string label = filename + " (render order " + std::to_string(static_cast<int>(order)) +
+                ", storage " + std::to_string(static_cast<int>(storage)) + ")";
+            auto renderData = tmx::render::createRenderData(*result, "", {.tileStorage = storage});
+            renderData.renderOrder = order;
+
+            tmx::render::DrawList list(renderData);
+            list.build();
+            success &= verifyOrder(renderData, list, label);
+            if (storage == tmx::render::TileStorage::Full)
+            {
+                reference = entriesOf(list);
+                if (order == tmx::map::RenderOrder::RightDown)
+                    std::cout << label << ": " << reference.size() << " items" << std::endl;
+            }
+            else if (!sameEntries(reference, entriesOf(list)))
+            {
+                std::cerr << label << ": ERROR - Drawing order differs from full storage" << std::endl;
+                success = false;
+            }
+
+            success &= verifyUpdate(renderData, label);
+            success &= verifyIndexOrder(renderData, label);
+            success &= verifySources(renderData, label);
+        }
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
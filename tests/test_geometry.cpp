@@ -0,0 +1,349 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::render::GeometryBatch;
+using tmx::render::GeometryVertex;
+
+// Caller-side storage sized with measure(), the way a renderer keeps it between frames
+struct Geometry
+{
+    std::vector<GeometryVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::vector<GeometryBatch> batches;
+
+    void resize(const tmx::render::GeometryCounts& counts)
+    {
+        vertices.assign(counts.vertexCount, {});
+        indices.assign(counts.indexCount, 0);
+        batches.assign(counts.batchCount, {});
+    }
+
+    [[nodiscard]] auto buffers() -> tmx::render::GeometryBuffers { return {vertices, indices, batches}; }
+};
+
+bool near(float a, float b)
+{
+    return std::fabs(a - b) < 1e-4f;
+}
+
+// Texture coordinate of a source corner, normalized by the tileset image size
+auto sourceCorner(const tmx::render::TileRenderInfo& tile, const tmx::render::TilesetRenderInfo& tileset,
+                  std::uint32_t srcX, std::uint32_t srcY, int cornerS, int cornerT) -> std::pair<float, float>
+{
+    return {static_cast<float>(srcX + cornerS * tile.srcW) / static_cast<float>(tileset.imageWidth),
+            static_cast<float>(srcY + cornerT * tile.srcH) / static_cast<float>(tileset.imageHeight)};
+}
+
+// Every quad must sit at the tile's destination, and its corners must be a permutation of the source corners
+bool verifyQuad(const tmx::render::MapRenderData& renderData, const tmx::render::TileRenderInfo& tile,
+                const GeometryVertex* quad, std::uint32_t srcX, std::uint32_t srcY, const std::string& label)
+{
+    const auto& tileset = renderData.tilesets[tile.tilesetIndex];
+    const float left = static_cast<float>(tile.destX), top = static_cast<float>(tile.destY);
+    const float right = left + static_cast<float>(tile.destW), bottom = top + static_cast<float>(tile.destH);
+    const float positions[4][2] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+
+    int seenCorners = 0;
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        const auto& vertex = quad[corner];
+        if (!near(vertex.x, positions[corner][0]) || !near(vertex.y, positions[corner][1]) ||
+            !near(vertex.a, tile.opacity) || !near(vertex.r, 1.0f))
+        {
+            std::cerr << label << ": ERROR - Quad of tile at " << tile.destX << "," << tile.destY
+                << " has a wrong position or color" << std::endl;
+            return false;
+        }
+        for (int source = 0; source < 4; ++source)
+        {
+            const auto [u, v] = sourceCorner(tile, tileset, srcX, srcY, source & 1, source >> 1);
+            if (near(vertex.u, u) && near(vertex.v, v))
+                seenCorners |= 1 << source;
+        }
+    }
+    if (seenCorners != 0xF)
+    {
+        std::cerr << label << ": ERROR - Texture coordinates of tile at " << tile.destX << "," << tile.destY
+            << " do not cover its source rectangle" << std::endl;
+        return false;
+    }
+
+    // Without flips, the corners map straight through
+    if (tile.flipFlags == 0)
+    {
+        const auto [u, v] = sourceCorner(tile, tileset, srcX, srcY, 0, 0);
+        if (!near(quad[0].u, u) || !near(quad[0].v, v))
+        {
+            std::cerr << label << ": ERROR - Unflipped tile at " << tile.destX << "," << tile.destY
+                << " has rotated texture coordinates" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// The emitted geometry of every layer must match forEachTile, quad for quad, in batch order
+bool verifyLayers(const tmx::render::MapRenderData& renderData, const tmx::render::AnimationClock* clock,
+                  const std::string& label)
+{
+    tmx::render::GeometryEmitter emitter(renderData);
+    Geometry geometry;
+    tmx::render::GeometryOptions options;
+    options.animationClock = clock;
+
+    for (const auto& layer : renderData.layers)
+    {
+        const auto counts = emitter.measure(layer);
+        geometry.resize(counts);
+        const auto written = emitter.emit(layer, geometry.buffers(), options);
+        if (!written || written->vertexCount != counts.vertexCount || written->indexCount != counts.indexCount ||
+            written->batchCount != counts.batchCount)
+        {
+            std::cerr << label << ": ERROR - Layer '" << layer.name << "' emitted different counts than measured"
+                << std::endl;
+            return false;
+        }
+
+        // Tiles of each tileset in layer order, as the batches must hold them
+        std::vector<std::vector<tmx::render::TileRenderInfo>> expected(renderData.tilesets.size());
+        std::size_t tileCount = 0;
+        renderData.forEachTile(layer, [&](const tmx::render::TileRenderInfo& tile)
+        {
+            expected[tile.tilesetIndex].push_back(tile);
+            ++tileCount;
+        });
+
+        std::size_t usedTilesets = 0;
+        for (const auto& tiles : expected)
+            usedTilesets += tiles.empty() ? 0 : 1;
+        if (counts.vertexCount != tileCount * 4 || counts.indexCount != tileCount * 6 || counts.batchCount != usedTilesets)
+        {
+            std::cerr << label << ": ERROR - Layer '" << layer.name << "' has " << tileCount << " tiles in "
+                << usedTilesets << " tilesets, emitter counted " << counts.vertexCount << " vertices and "
+                << counts.batchCount << " batches" << std::endl;
+            return false;
+        }
+
+        std::uint32_t nextVertex = 0;
+        for (const auto& batch : geometry.batches)
+        {
+            const auto& tiles = expected[batch.tilesetIndex];
+            if (batch.layerIndex != GeometryBatch::NO_LAYER || batch.firstVertex != nextVertex ||
+                batch.vertexCount != tiles.size() * 4 || batch.indexCount != tiles.size() * 6)
+            {
+                std::cerr << label << ": ERROR - Batch of tileset " << batch.tilesetIndex << " in layer '"
+                    << layer.name << "' has a wrong range" << std::endl;
+                return false;
+            }
+            nextVertex += batch.vertexCount;
+
+            for (std::uint32_t i = 0; i < batch.indexCount; ++i)
+            {
+                const std::uint32_t index = geometry.indices[batch.firstIndex + i];
+                if (index >= batch.vertexCount || index / 4 != i / 6)
+                {
+                    std::cerr << label << ": ERROR - Index " << index << " escapes its quad in layer '" << layer.name
+                        << "'" << std::endl;
+                    return false;
+                }
+            }
+
+            for (std::size_t q = 0; q < tiles.size(); ++q)
+            {
+                const auto& tile = tiles[q];
+                std::uint32_t srcX = tile.srcX, srcY = tile.srcY;
+                if (tile.isAnimated && clock)
+                {
+                    srcX = clock->frame(tile.tilesetIndex, tile.animationIndex).srcX;
+                    srcY = clock->frame(tile.tilesetIndex, tile.animationIndex).srcY;
+                }
+                if (!verifyQuad(renderData, tile, &geometry.vertices[batch.firstVertex + q * 4], srcX, srcY, label))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Flip flags permute the texture coordinates exactly as Tiled draws the tile
+bool verifyFlips(const tmx::map::Map& map, const std::string& label)
+{
+    auto renderData = tmx::render::createRenderData(map);
+    if (renderData.layers.empty() || renderData.tilesets.empty())
+        return true;
+
+    const auto& tileset = renderData.tilesets[0];
+    const std::uint32_t gid = tileset.firstgid + 1;
+    constexpr std::uint32_t H = tmx::map::FLIPPED_HORIZONTALLY_FLAG;
+    constexpr std::uint32_t D = tmx::map::FLIPPED_DIAGONALLY_FLAG;
+
+    // Expected source corner (s, t) of the top-left vertex for each flag combination
+    struct Case
+    {
+        std::uint32_t flags;
+        int s, t;
+    };
+    const Case cases[] = {{0, 0, 0}, {H, 1, 0}, {H | D, 0, 1}};
+
+    tmx::render::GeometryEmitter emitter(renderData);
+    Geometry geometry;
+    for (const auto& c : cases)
+    {
+        renderData.setTile(0, 0, 0, gid | c.flags);
+        const auto counts = emitter.measure(renderData.layers[0]);
+        geometry.resize(counts);
+        if (!emitter.emit(renderData.layers[0], geometry.buffers()))
+        {
+            std::cerr << label << ": ERROR - Emitting the flipped tile failed" << std::endl;
+            return false;
+        }
+
+        bool found = false;
+        for (std::size_t v = 0; v < geometry.vertices.size(); v += 4)
+        {
+            if (!near(geometry.vertices[v].x, 0.0f) || !near(geometry.vertices[v].y, 0.0f))
+                continue;
+            found = true;
+            const std::uint32_t tileId = gid - tileset.firstgid;
+            const float u = static_cast<float>(tileset.srcXOf(tileId) + c.s * tileset.tileWidth) /
+                static_cast<float>(tileset.imageWidth);
+            const float vv = static_cast<float>(tileset.srcYOf(tileId) + c.t * tileset.tileHeight) /
+                static_cast<float>(tileset.imageHeight);
+            if (!near(geometry.vertices[v].u, u) || !near(geometry.vertices[v].v, vv))
+            {
+                std::cerr << label << ": ERROR - Flip flags 0x" << std::hex << c.flags << std::dec
+                    << " give top-left texture coordinate " << geometry.vertices[v].u << "," << geometry.vertices[v].v
+                    << ", expected " << u << "," << vv << std::endl;
+                return false;
+            }
+        }
+        if (!found)
+        {
+            std::cerr << label << ": ERROR - No quad emitted for the edited cell" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Query results emit every visible layer, tagged with its index; short buffers are rejected untouched
+bool verifyRanges(const tmx::render::MapRenderData& renderData, const std::string& label)
+{
+    tmx::render::GeometryEmitter emitter(renderData);
+    tmx::render::RenderBounds all;
+    for (const auto& layer : renderData.layers)
+        all.merge(layer.bounds);
+
+    const auto ranges = renderData.query({static_cast<float>(all.minX), static_cast<float>(all.minY),
+                                          static_cast<float>(all.maxX - all.minX),
+                                          static_cast<float>(all.maxY - all.minY)});
+    std::size_t tileCount = 0;
+    renderData.forEachTile(ranges, [&](const tmx::render::LayerRenderData& layer, const tmx::render::TileRenderInfo&)
+    {
+        tileCount += layer.visible ? 1 : 0;
+    });
+
+    Geometry geometry;
+    const auto counts = emitter.measure(ranges);
+    if (counts.vertexCount != tileCount * 4)
+    {
+        std::cerr << label << ": ERROR - Query geometry has " << counts.vertexCount << " vertices, expected "
+            << tileCount * 4 << std::endl;
+        return false;
+    }
+
+    // One vertex short: the emitter must fail without writing anything
+    if (counts.vertexCount > 0)
+    {
+        geometry.resize(counts);
+        geometry.vertices.pop_back();
+        geometry.batches[0].layerIndex = 12345;
+        if (emitter.emit(ranges, geometry.buffers()) || geometry.batches[0].layerIndex != 12345)
+        {
+            std::cerr << label << ": ERROR - Emitting into short buffers did not fail cleanly" << std::endl;
+            return false;
+        }
+    }
+
+    geometry.resize(counts);
+    tmx::render::GeometryOptions options;
+    options.originX = 100.0f;
+    options.originY = -50.0f;
+    if (!emitter.emit(ranges, geometry.buffers(), options))
+    {
+        std::cerr << label << ": ERROR - Emitting the query result failed" << std::endl;
+        return false;
+    }
+
+    std::uint32_t previousLayer = 0;
+    for (const auto& batch : geometry.batches)
+    {
+        if (batch.layerIndex >= renderData.layers.size() || batch.layerIndex < previousLayer ||
+            !renderData.layers[batch.layerIndex].visible)
+        {
+            std::cerr << label << ": ERROR - Batch has layer index " << batch.layerIndex << std::endl;
+            return false;
+        }
+        previousLayer = batch.layerIndex;
+
+        // The origin shifts every vertex of the batch
+        for (std::uint32_t v = batch.firstVertex; v < batch.firstVertex + batch.vertexCount; ++v)
+        {
+            const auto& vertex = geometry.vertices[v];
+            if (vertex.x + options.originX < static_cast<float>(all.minX) - 0.5f ||
+                vertex.y + options.originY > static_cast<float>(all.maxY) + 0.5f)
+            {
+                std::cerr << label << ": ERROR - Vertex outside the map after removing the origin" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing geometry emitter: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    const auto& map = *result;
+    bool success = true;
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                               tmx::render::TileStorage::Indexed})
+    {
+        tmx::render::RenderBuildOptions options;
+        options.tileStorage = storage;
+        const auto renderData = tmx::render::createRenderData(map, "", options);
+
+        tmx::render::AnimationClock clock(renderData);
+        clock.tick(1234);
+        success &= verifyLayers(renderData, nullptr, filename);
+        success &= verifyLayers(renderData, &clock, filename);
+        success &= verifyRanges(renderData, filename);
+    }
+    success &= verifyFlips(map, filename);
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
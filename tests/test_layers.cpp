@@ -0,0 +1,243 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::map::LayerKind;
+
+// Nested groups, each kind of layer, and offsets, parallax factors and tints at several levels
+const std::string LAYERS = R"(
+ <layer id="1" name="ground" width="4" height="4">
+  <data encoding="csv">1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1</data>
+ </layer>
+ <group id="2" name="world" offsetx="10" offsety="5" opacity="0.5" tintcolor="#ff8080">
+  <layer id="3" name="walls" width="4" height="4" offsetx="2" opacity="0.5" parallaxx="0.5">
+   <data encoding="csv">2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0</data>
+  </layer>
+  <group id="4" name="hidden" visible="0" parallaxy="2">
+   <objectgroup id="5" name="spawns">
+    <object id="1" x="0" y="0" width="8" height="8"/>
+   </objectgroup>
+  </group>
+  <imagelayer id="6" name="sky" offsety="-3" repeatx="1" tintcolor="#80ff0000">
+   <image source="sky.png" width="320" height="240"/>
+  </imagelayer>
+ </group>
+ <objectgroup id="7" name="top"/>
+)";
+
+const std::string TILESET =
+    R"(<tileset firstgid="1" name="tiles" tilewidth="16" tileheight="16" tilecount="16" columns="4">
+  <image source="tiles.png" width="64" height="64"/>
+ </tileset>)";
+
+auto makeMap(const std::string& body, const bool infinite) -> std::string
+{
+    return R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" renderorder="right-down" width="4" height="4" tilewidth="16"
+     tileheight="16" infinite=")" + std::string(infinite ? "1" : "0") + R"(" nextlayerid="8" nextobjectid="2">
+ )" + TILESET + body + "\n</map>";
+}
+
+bool near(const float a, const float b)
+{
+    return std::abs(a - b) < 1e-4f;
+}
+
+// Groups and layers keep the document's nesting and order
+bool verifyParse(const tmx::map::Map& map)
+{
+    const std::vector<tmx::map::LayerRef> order = {
+        {LayerKind::Tile, 0}, {LayerKind::Tile, 1}, {LayerKind::Object, 0}, {LayerKind::Image, 0}, {LayerKind::Object, 1}};
+    bool sameOrder = map.layerOrder.size() == order.size();
+    for (std::size_t i = 0; sameOrder && i < order.size(); ++i)
+        sameOrder = map.layerOrder[i].kind == order[i].kind && map.layerOrder[i].index == order[i].index;
+    if (!sameOrder || map.groups.size() != 2 || map.imagelayers.size() != 1)
+    {
+        std::cerr << "parse: ERROR - Layers were not read in document order" << std::endl;
+        return false;
+    }
+    if (map.layers[0].group != -1 || map.layers[1].group != 0 || map.groups[0].group != -1 ||
+        map.groups[1].group != 0 || map.objectgroups[0].group != 1 || map.imagelayers[0].group != 0 ||
+        map.objectgroups[1].group != -1)
+    {
+        std::cerr << "parse: ERROR - Layers were not assigned to their groups" << std::endl;
+        return false;
+    }
+    const auto& world = map.groups[0];
+    const auto& sky = map.imagelayers[0];
+    if (world.offsetx != 10.0f || world.offsety != 5.0f || world.tintcolor.g != 128 || map.layers[1].parallaxx != 0.5f ||
+        map.layers[1].parallaxy != 1.0f || map.groups[1].visible || sky.image != "sky.png" || sky.imagewidth != 320 ||
+        !sky.repeatx || sky.repeaty || sky.offsety != -3.0f || sky.tintcolor.r != 255 || sky.tintcolor.g != 0 ||
+        sky.tintcolor.b != 0 || sky.tintcolor.a != 128)
+    {
+        std::cerr << "parse: ERROR - Layer attributes were not parsed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Render data carries each layer's values with those of its groups folded in
+bool verifyFlattened(const tmx::render::MapRenderData& renderData)
+{
+    const auto& walls = renderData.layers[1];
+    const auto& spawns = renderData.objectGroups[0];
+    const auto& sky = renderData.imageLayers[0];
+    if (!walls.visible || !near(walls.opacity, 0.25f) || walls.transform.offsetX != 12.0f ||
+        walls.transform.offsetY != 5.0f || walls.transform.parallaxX != 0.5f || walls.transform.tint.r != 255 ||
+        walls.transform.tint.g != 128 || !renderData.layers[0].transform.isIdentity())
+    {
+        std::cerr << "flatten: ERROR - Tile layer did not inherit its group" << std::endl;
+        return false;
+    }
+    float tileOpacity = 0.0f;
+    renderData.forEachTile(walls, [&](const tmx::render::TileRenderInfo& tile) { tileOpacity = tile.opacity; });
+    if (!near(tileOpacity, 0.25f))
+    {
+        std::cerr << "flatten: ERROR - Tiles were baked with opacity " << tileOpacity << " instead of 0.25" << std::endl;
+        return false;
+    }
+    if (spawns.visible || renderData.groups[1].visible || spawns.transform.parallaxY != 2.0f ||
+        spawns.transform.offsetX != 10.0f || !near(spawns.opacity, 0.5f) || !renderData.objectGroups[1].visible ||
+        !renderData.objectGroups[1].transform.isIdentity())
+    {
+        std::cerr << "flatten: ERROR - Hidden group did not hide its object group" << std::endl;
+        return false;
+    }
+    if (!sky.visible || sky.transform.offsetY != 2.0f || !near(sky.opacity, 0.5f) || !sky.repeatX ||
+        sky.transform.tint.a != 128 ||
+        sky.imagePath != (std::filesystem::path("assets") / "sky.png").string() || renderData.layerOrder.size() != 5)
+    {
+        std::cerr << "flatten: ERROR - Image layer did not inherit its group" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Queries and emitted geometry place each layer by its offset and parallax
+bool verifyPlacement(const tmx::render::MapRenderData& renderData)
+{
+    // Without the transform the wall tile at (0, 0)-(16, 16) is far left of this view
+    const auto ranges = renderData.query({50.0f, 0.0f, 10.0f, 10.0f});
+    bool wallsFound = false;
+    for (const auto& range : ranges)
+        wallsFound |= range.layerIndex == 1;
+    if (!wallsFound)
+    {
+        std::cerr << "placement: ERROR - Query did not move the view into the layer" << std::endl;
+        return false;
+    }
+
+    tmx::render::GeometryEmitter emitter(renderData);
+    std::vector<tmx::render::GeometryVertex> vertices(4);
+    std::vector<std::uint32_t> indices(6);
+    std::vector<tmx::render::GeometryBatch> batches(1);
+    const auto counts = emitter.emit(renderData.layers[1], {vertices, indices, batches}, {.originX = 20.0f});
+    const auto& corner = vertices[0];
+    if (!counts || counts->vertexCount != 4 || corner.x != 2.0f || corner.y != 5.0f || corner.r != 1.0f ||
+        !near(corner.g, 128.0f / 255.0f) || !near(corner.a, 0.25f))
+    {
+        std::cerr << "placement: ERROR - Quad at (" << corner.x << ", " << corner.y << ") instead of (2, 5)"
+            << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// The chunk streamer indexes chunked layers nested in groups
+bool verifyStreaming()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "tmx_test_layers";
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "grouped.tmx";
+    std::string csv = "2";
+    for (int i = 1; i < 16 * 16; ++i)
+        csv += ",0";
+    {
+        std::ofstream file(path);
+        file << makeMap(R"(
+ <group id="2" name="world" offsetx="100">
+  <layer id="3" name="walls" width="16" height="16">
+   <data encoding="csv"><chunk x="0" y="0" width="16" height="16">)" + csv + R"(</chunk></data>
+  </layer>
+ </group>)", true);
+    }
+
+    auto streamerResult = tmx::render::ChunkStreamer::open(path);
+    bool success = true;
+    if (!streamerResult)
+    {
+        std::cerr << "streaming: ERROR - " << streamerResult.error() << std::endl;
+        success = false;
+    }
+    else
+    {
+        // The chunk covers x 0-256 of the layer, 100-356 on screen; the view only reaches it through the offset
+        auto& streamer = **streamerResult;
+        const tmx::render::ViewRect view{300.0f, 0.0f, 8.0f, 8.0f};
+        std::vector<const tmx::render::StreamedChunk*> visible;
+        streamer.update(view);
+        streamer.waitUntilIdle();
+        streamer.visibleChunks(view, visible);
+        if (visible.size() != 1 || visible[0]->layer.transform.offsetX != 100.0f || visible[0]->layer.tiles.size() != 1)
+        {
+            std::cerr << "streaming: ERROR - " << visible.size() << " chunks visible instead of the grouped one"
+                << std::endl;
+            success = false;
+        }
+    }
+    std::filesystem::remove_all(directory);
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing group and image layers: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Every layer of the file is drawn exactly once
+    bool success = true;
+    const auto renderData = tmx::render::createRenderData(*result);
+    if (result->layerOrder.size() != result->layers.size() + result->objectgroups.size() + result->imagelayers.size() ||
+        renderData.layerOrder.size() != result->layerOrder.size())
+    {
+        std::cerr << filename << ": ERROR - Layer order does not cover every layer" << std::endl;
+        success = false;
+    }
+
+    auto layered = tmx::Parser::parseFromString(makeMap(LAYERS, false));
+    if (!layered)
+    {
+        std::cerr << "layers: ERROR - Parse error: " << layered.error() << std::endl;
+        return 1;
+    }
+    success &= verifyParse(*layered);
+    const auto layeredData = tmx::render::createRenderData(*layered, "assets");
+    success &= verifyFlattened(layeredData);
+    success &= verifyPlacement(layeredData);
+    success &= verifyStreaming();
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
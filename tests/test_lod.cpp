@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+#include <tmx/LodPyramid.hpp>
+
+auto floorDiv(const std::int32_t value, const std::int32_t divisor) -> std::int32_t
+{
+    return value / divisor - (value % divisor != 0 && value < 0 ? 1 : 0);
+}
+
+// Every chunk square tiles are drawn into, offsets included, has a pyramid entry and nothing else does
+bool verifyChunkSet(const tmx::render::MapRenderData& renderData, const tmx::raster::LodPyramid& pyramid,
+                    const std::string& label)
+{
+    const auto chunkWidth = static_cast<std::int32_t>(renderData.chunkSize * renderData.tileWidth);
+    const auto chunkHeight = static_cast<std::int32_t>(renderData.chunkSize * renderData.tileHeight);
+    std::set<std::pair<std::int32_t, std::int32_t>> expected;
+    for (const auto& layer : renderData.layers)
+    {
+        for (const auto& chunk : layer.chunks)
+        {
+            const auto bounds = tmx::raster::drawnBounds(layer, chunk.bounds);
+            if (bounds.isEmpty())
+                continue;
+            for (std::int32_t y = floorDiv(bounds.minY, chunkHeight); y <= floorDiv(bounds.maxY - 1, chunkHeight); ++y)
+            {
+                for (std::int32_t x = floorDiv(bounds.minX, chunkWidth); x <= floorDiv(bounds.maxX - 1, chunkWidth); ++x)
+                    expected.emplace(x, y);
+            }
+        }
+    }
+
+    std::set<std::pair<std::int32_t, std::int32_t>> actual;
+    for (const auto& chunk : pyramid.chunks())
+        actual.emplace(chunk.chunkX, chunk.chunkY);
+    if (actual != expected)
+    {
+        std::cerr << label << ": ERROR - Pyramid has " << actual.size() << " chunks, expected " << expected.size()
+            << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Level sizes halve, and level 0 is the 2x2 average of the full-resolution chunk
+bool verifyLevels(const tmx::render::MapRenderData& renderData, const tmx::raster::Rasterizer& rasterizer,
+                  const tmx::raster::LodPyramid& pyramid, const std::string& label)
+{
+    const std::uint32_t chunkWidth = renderData.chunkSize * renderData.tileWidth;
+    const std::uint32_t chunkHeight = renderData.chunkSize * renderData.tileHeight;
+    for (const auto& chunk : pyramid.chunks())
+    {
+        if (chunk.levels.size() != pyramid.levelCount())
+        {
+            std::cerr << label << ": ERROR - Chunk has " << chunk.levels.size() << " levels" << std::endl;
+            return false;
+        }
+        for (std::uint32_t level = 0; level < chunk.levels.size(); ++level)
+        {
+            const std::uint32_t divisor = 2u << level;
+            if (chunk.levels[level].width != std::max((chunkWidth + divisor - 1) / divisor, 1u) ||
+                chunk.levels[level].height != std::max((chunkHeight + divisor - 1) / divisor, 1u))
+            {
+                std::cerr << label << ": ERROR - Level " << level << " is " << chunk.levels[level].width << "x"
+                    << chunk.levels[level].height << std::endl;
+                return false;
+            }
+        }
+
+        tmx::raster::RasterOptions options;
+        options.region = tmx::render::ViewRect{static_cast<float>(chunk.bounds.minX),
+                                               static_cast<float>(chunk.bounds.minY),
+                                               static_cast<float>(chunkWidth), static_cast<float>(chunkHeight)};
+        const auto full = rasterizer.render(options);
+        if (!full)
+        {
+            std::cerr << label << ": ERROR - Render failed: " << full.error() << std::endl;
+            return false;
+        }
+
+        // Opaque blocks average to their straight colors
+        const auto& level0 = chunk.levels[0];
+        for (std::uint32_t y = 0; y + 1 < full->height; y += 2)
+        {
+            for (std::uint32_t x = 0; x + 1 < full->width; x += 2)
+            {
+                const std::uint8_t* block[4] = {full->pixel(x, y), full->pixel(x + 1, y), full->pixel(x, y + 1),
+                                                full->pixel(x + 1, y + 1)};
+                if (std::ranges::any_of(block, [](const std::uint8_t* p) { return p[3] != 255; }))
+                    continue;
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    const int average = (block[0][c] + block[1][c] + block[2][c] + block[3][c] + 2) / 4;
+                    if (std::abs(average - level0.pixel(x / 2, y / 2)[c]) > 1)
+                    {
+                        std::cerr << label << ": ERROR - Level 0 of chunk " << chunk.chunkX << "," << chunk.chunkY
+                            << " pixel " << x / 2 << "," << y / 2 << " is not the average of its block" << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool samePyramids(const tmx::raster::LodPyramid& a, const tmx::raster::LodPyramid& b, const std::string& label)
+{
+    if (a.chunks().size() != b.chunks().size())
+    {
+        std::cerr << label << ": ERROR - Updated pyramid has " << a.chunks().size() << " chunks, rebuilt one has "
+            << b.chunks().size() << std::endl;
+        return false;
+    }
+    for (const auto& chunk : a.chunks())
+    {
+        const auto* other = b.chunk(chunk.chunkX, chunk.chunkY);
+        if (!other || other->levels.size() != chunk.levels.size())
+        {
+            std::cerr << label << ": ERROR - Chunk " << chunk.chunkX << "," << chunk.chunkY << " is missing" << std::endl;
+            return false;
+        }
+        for (std::size_t level = 0; level < chunk.levels.size(); ++level)
+        {
+            if (chunk.levels[level].pixels != other->levels[level].pixels)
+            {
+                std::cerr << label << ": ERROR - Chunk " << chunk.chunkX << "," << chunk.chunkY << " level " << level
+                    << " differs from a full rebuild" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Updating from dirty regions must give the same pyramid as building it again
+bool verifyUpdate(tmx::render::MapRenderData renderData, const std::string& label)
+{
+    tmx::raster::Rasterizer rasterizer(renderData);
+    if (!rasterizer.loadTilesetImages())
+        return false;
+    tmx::raster::LodPyramid pyramid(rasterizer, {3});
+    if (!pyramid.build() || renderData.layers.empty() || renderData.layers[0].chunks.empty())
+        return true;
+
+    // Edit one chunk, clear another on every layer, and paint a tile into a chunk far outside the map
+    const auto size = static_cast<std::int32_t>(renderData.chunkSize);
+    const std::vector<tmx::render::SpatialChunk> chunks = renderData.layers[0].chunks;
+    const auto first = chunks[0];
+    const std::uint32_t gid = renderData.tilesets[0].firstgid;
+    renderData.dirtyRegions.clear();
+    renderData.fillRect(0, first.chunkX * size + 1, first.chunkY * size + 1, 3, 2, gid);
+    if (chunks.size() > 1)
+    {
+        const auto second = chunks[1];
+        for (std::uint32_t layer = 0; layer < renderData.layers.size(); ++layer)
+            renderData.fillRect(layer, second.chunkX * size, second.chunkY * size, size, size, 0);
+    }
+    if (renderData.infinite)
+        renderData.setTile(0, 40 * size, -7 * size, gid);
+
+    const auto changed = pyramid.update(renderData.dirtyRegions);
+    if (!changed || *changed == 0)
+    {
+        std::cerr << label << ": ERROR - Update did not redraw any chunk" << std::endl;
+        return false;
+    }
+
+    tmx::raster::LodPyramid rebuilt(rasterizer, {3});
+    if (!rebuilt.build())
+        return false;
+    return verifyChunkSet(renderData, pyramid, label + " (updated)") && samePyramids(pyramid, rebuilt, label);
+}
+
+bool verifyQueries(const tmx::render::MapRenderData& renderData, const tmx::raster::LodPyramid& pyramid,
+                   const std::string& label)
+{
+    if (pyramid.levelForZoom(1.0f) || pyramid.levelForZoom(0.51f) || pyramid.levelForZoom(0.5f) != 0u ||
+        pyramid.levelForZoom(0.3f) != 0u || pyramid.levelForZoom(0.25f) != 1u ||
+        pyramid.levelForZoom(0.001f) != pyramid.levelCount() - 1)
+    {
+        std::cerr << label << ": ERROR - Wrong level for a zoom" << std::endl;
+        return false;
+    }
+
+    std::vector<const tmx::raster::LodChunk*> visible;
+    const float chunkWidth = static_cast<float>(renderData.chunkSize * renderData.tileWidth);
+    for (const auto& view : {tmx::render::ViewRect{0.0f, 0.0f, 10.0f, 10.0f},
+                             tmx::render::ViewRect{-chunkWidth * 2, -chunkWidth, chunkWidth * 3.5f, chunkWidth * 2},
+                             tmx::render::ViewRect{-1.0e7f, -1.0e7f, 2.0e7f, 2.0e7f}})
+    {
+        pyramid.query(view, visible);
+        std::size_t expected = 0;
+        for (const auto& chunk : pyramid.chunks())
+            expected += chunk.bounds.intersects(view) ? 1 : 0;
+        if (visible.size() != expected ||
+            std::ranges::any_of(visible, [&](const auto* chunk) { return !chunk->bounds.intersects(view); }))
+        {
+            std::cerr << label << ": ERROR - Query returned " << visible.size() << " chunks, expected " << expected
+                << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing LOD pyramid: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Small chunks give the pyramid several of them even on small maps
+    tmx::render::RenderBuildOptions buildOptions;
+    buildOptions.chunkSize = 4;
+    const auto renderData = tmx::render::createRenderData(
+        *result, std::filesystem::path(filename).parent_path().string(), buildOptions);
+    tmx::raster::Rasterizer rasterizer(renderData);
+    if (auto loaded = rasterizer.loadTilesetImages(); !loaded)
+    {
+        std::cerr << filename << ": FAILED - " << loaded.error() << std::endl;
+        return 1;
+    }
+
+    tmx::raster::LodPyramid pyramid(rasterizer);
+    if (auto built = pyramid.build(); !built)
+    {
+        std::cerr << filename << ": FAILED - " << built.error() << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    success &= verifyChunkSet(renderData, pyramid, filename);
+    success &= verifyLevels(renderData, rasterizer, pyramid, filename);
+    success &= verifyQueries(renderData, pyramid, filename);
+    success &= verifyUpdate(renderData, filename);
+
+    // A layer drawn half a chunk away spills into the neighbouring squares
+    auto moved = renderData;
+    moved.layers[0].transform.offsetX = static_cast<float>(renderData.chunkSize * renderData.tileWidth) / 2.0f + 3.0f;
+    moved.layers[0].transform.offsetY = -5.0f;
+    tmx::raster::Rasterizer movedRasterizer(moved);
+    tmx::raster::LodPyramid movedPyramid(movedRasterizer);
+    if (movedRasterizer.loadTilesetImages() && movedPyramid.build())
+    {
+        success &= verifyChunkSet(moved, movedPyramid, filename + " (offset)");
+        success &= verifyLevels(moved, movedRasterizer, movedPyramid, filename + " (offset)");
+        success &= verifyUpdate(moved, filename + " (offset)");
+    }
+    else
+    {
+        std::cerr << filename << ": ERROR - Pyramid of an offset layer could not be built" << std::endl;
+        success = false;
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
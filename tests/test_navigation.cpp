@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::nav::GridPoint;
+
+// Plain Dijkstra over every cell, as the reference for path costs
+auto referenceCost(const tmx::nav::NavGrid& grid, GridPoint start, GridPoint goal) -> std::int64_t
+{
+    if (!grid.isWalkable(start.x, start.y) || !grid.isWalkable(goal.x, goal.y))
+        return -1;
+
+    const auto& bounds = grid.bounds();
+    const auto width = static_cast<std::int64_t>(bounds.maxX - bounds.minX);
+    const auto index = [&](GridPoint p) { return (p.y - bounds.minY) * width + (p.x - bounds.minX); };
+    std::vector<std::int64_t> cost(static_cast<std::size_t>(width * (bounds.maxY - bounds.minY)), -1);
+    using Entry = std::pair<std::int64_t, std::int64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+    cost[index(start)] = 0;
+    open.push({0, index(start)});
+    while (!open.empty())
+    {
+        const auto [c, i] = open.top();
+        open.pop();
+        if (c != cost[i])
+            continue;
+        const GridPoint p{bounds.minX + static_cast<std::int32_t>(i % width), bounds.minY + static_cast<std::int32_t>(i / width)};
+        if (p == goal)
+            return c;
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if ((dx == 0 && dy == 0) || !grid.isWalkable(p.x + dx, p.y + dy))
+                    continue;
+                if (dx != 0 && dy != 0 && (!grid.isWalkable(p.x + dx, p.y) || !grid.isWalkable(p.x, p.y + dy)))
+                    continue;
+                const std::int64_t next = index({p.x + dx, p.y + dy});
+                const std::int64_t nextCost = c + (dx != 0 && dy != 0 ? tmx::nav::DIAGONAL_COST : tmx::nav::STRAIGHT_COST);
+                if (cost[next] < 0 || nextCost < cost[next])
+                {
+                    cost[next] = nextCost;
+                    open.push({nextCost, next});
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// A path must join start to goal through walkable cells, one legal step at a time, for its stated cost
+bool verifyPath(const tmx::nav::NavGrid& grid, std::span<const GridPoint> path, const tmx::nav::PathResult& result,
+                GridPoint start, GridPoint goal, const std::string& label)
+{
+    if (path.size() != result.count || path.empty() || path.front() != start || path.back() != goal)
+    {
+        std::cerr << label << ": ERROR - Path does not run from start to goal" << std::endl;
+        return false;
+    }
+
+    std::uint32_t cost = 0;
+    for (std::size_t i = 0; i < path.size(); ++i)
+    {
+        if (!grid.isWalkable(path[i].x, path[i].y))
+        {
+            std::cerr << label << ": ERROR - Path crosses blocked cell (" << path[i].x << ", " << path[i].y << ")"
+                << std::endl;
+            return false;
+        }
+        if (i == 0)
+            continue;
+        const std::int32_t dx = path[i].x - path[i - 1].x;
+        const std::int32_t dy = path[i].y - path[i - 1].y;
+        if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0) ||
+            (dx != 0 && dy != 0 &&
+             (!grid.isWalkable(path[i - 1].x + dx, path[i - 1].y) || !grid.isWalkable(path[i - 1].x, path[i - 1].y + dy))))
+        {
+            std::cerr << label << ": ERROR - Illegal step at cell " << i << std::endl;
+            return false;
+        }
+        cost += dx != 0 && dy != 0 ? tmx::nav::DIAGONAL_COST : tmx::nav::STRAIGHT_COST;
+    }
+    if (cost != result.cost)
+    {
+        std::cerr << label << ": ERROR - Path costs " << cost << ", reported " << result.cost << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A* and JPS find paths of the reference cost between random cells, singly and in a batch
+bool verifySearches(const tmx::nav::NavGrid& grid, int queries, std::uint32_t seed, const std::string& label)
+{
+    const auto& bounds = grid.bounds();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::int32_t> x(bounds.minX - 1, bounds.maxX);
+    std::uniform_int_distribution<std::int32_t> y(bounds.minY - 1, bounds.maxY);
+
+    // Mostly walkable endpoints, with a few blocked or outside ones
+    std::vector<tmx::nav::PathRequest> requests;
+    while (requests.size() < static_cast<std::size_t>(queries))
+    {
+        const GridPoint start{x(rng), y(rng)}, goal{x(rng), y(rng)};
+        if ((grid.isWalkable(start.x, start.y) && grid.isWalkable(goal.x, goal.y)) || requests.size() % 10 == 0)
+            requests.push_back({start, goal});
+    }
+    requests.push_back({requests.front().start, requests.front().start});
+
+    tmx::nav::Pathfinder pathfinder(grid);
+    std::vector<GridPoint> path;
+    std::uint64_t aStarExpanded = 0, jumpExpanded = 0;
+    std::size_t found = 0;
+    for (const auto& [start, goal] : requests)
+    {
+        const std::int64_t expected = referenceCost(grid, start, goal);
+        for (const auto algorithm : {tmx::nav::PathAlgorithm::AStar, tmx::nav::PathAlgorithm::JumpPoint})
+        {
+            const std::string name = label + (algorithm == tmx::nav::PathAlgorithm::AStar ? " A*" : " JPS") + " (" +
+                std::to_string(start.x) + ", " + std::to_string(start.y) + ") -> (" + std::to_string(goal.x) + ", " +
+                std::to_string(goal.y) + ")";
+            const auto result = pathfinder.findPath(start, goal, path, algorithm);
+            (algorithm == tmx::nav::PathAlgorithm::AStar ? aStarExpanded : jumpExpanded) += pathfinder.expandedCount();
+            if (result.found != (expected >= 0) || (result.found && result.cost != expected))
+            {
+                std::cerr << name << ": ERROR - Cost " << (result.found ? std::to_string(result.cost) : "none")
+                    << ", expected " << expected << std::endl;
+                return false;
+            }
+            if (result.found && !verifyPath(grid, path, result, start, goal, name))
+                return false;
+            if (!result.found && !path.empty())
+            {
+                std::cerr << name << ": ERROR - No path found but cells returned" << std::endl;
+                return false;
+            }
+        }
+        found += expected >= 0 ? 1 : 0;
+    }
+
+    // The batch gives every request the result of a single search
+    tmx::nav::PathBatch batch;
+    pathfinder.findPaths(requests, batch);
+    if (batch.results.size() != requests.size())
+    {
+        std::cerr << label << ": ERROR - " << batch.results.size() << " batch results" << std::endl;
+        return false;
+    }
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const auto single = pathfinder.findPath(requests[i].start, requests[i].goal, path);
+        const auto& result = batch.results[i];
+        if (result.found != single.found || result.cost != single.cost || !std::ranges::equal(batch.path(i), path))
+        {
+            std::cerr << label << ": ERROR - Batch request " << i << " differs from a single search" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << label << ": " << found << " of " << requests.size() << " paths found, " << aStarExpanded
+        << " cells expanded by A*, " << jumpExpanded << " by JPS" << std::endl;
+    return true;
+}
+
+// Random obstacles, wall lines with gaps and open rooms, on a grid wider than one word with a negative origin
+auto syntheticGrid(std::int32_t width, std::int32_t height, double density, std::uint32_t seed) -> tmx::nav::NavGrid
+{
+    tmx::map::BitGrid walkable({-37, -20, -37 + width, -20 + height});
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution blocked(density);
+    for (std::int32_t y = -20; y < -20 + height; ++y)
+    {
+        for (std::int32_t x = -37; x < -37 + width; ++x)
+        {
+            const bool wall = (x % 17 == 0 && y % 9 != 0) || (y % 13 == 0 && x % 11 != 3);
+            walkable.set(x, y, !wall && !blocked(rng));
+        }
+    }
+    return tmx::nav::NavGrid(std::move(walkable));
+}
+
+bool verifyGrid(const tmx::map::Map& map, const tmx::nav::NavGrid& grid, const std::vector<std::uint8_t>& blocking,
+                const std::string& label)
+{
+    const auto solid = tmx::map::bakeSolidity(map, blocking);
+    const auto& bounds = grid.bounds();
+    if (bounds.minX != solid.bounds().minX || bounds.maxY != solid.bounds().maxY)
+    {
+        std::cerr << label << ": ERROR - Grid bounds differ from the map's" << std::endl;
+        return false;
+    }
+    for (std::int32_t y = bounds.minY - 1; y <= bounds.maxY; ++y)
+    {
+        for (std::int32_t x = bounds.minX - 1; x <= bounds.maxX; ++x)
+        {
+            const bool expected = bounds.contains(x, y) && !solid.get(x, y);
+            if (grid.isWalkable(x, y) != expected || grid.columns().get(y, x) != expected)
+            {
+                std::cerr << label << ": ERROR - Cell (" << x << ", " << y << ") walkability is wrong" << std::endl;
+                return false;
+            }
+        }
+    }
+    if (grid.rows().count() + solid.count() != static_cast<std::size_t>(bounds.maxX - bounds.minX) * (bounds.maxY - bounds.minY))
+    {
+        std::cerr << label << ": ERROR - Walkable and solid cells do not partition the grid" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Doors: blocking a cell of a path reroutes it, opening it again restores the path
+bool verifyEdits(tmx::nav::NavGrid grid, const std::string& label)
+{
+    tmx::nav::Pathfinder pathfinder(grid);
+    std::vector<GridPoint> path;
+    const auto& bounds = grid.bounds();
+    for (std::int32_t y = bounds.minY; y < bounds.maxY; ++y)
+    {
+        for (std::int32_t x = bounds.minX; x < bounds.maxX; ++x)
+        {
+            if (!grid.isWalkable(x, y))
+                continue;
+            const GridPoint start{x, y};
+            const GridPoint goal{bounds.maxX - 1 - (x - bounds.minX), bounds.maxY - 1 - (y - bounds.minY)};
+            const auto before = pathfinder.findPath(start, goal, path);
+            if (!before.found || path.size() < 3)
+                continue;
+
+            const GridPoint door = path[path.size() / 2];
+            grid.setWalkable(door.x, door.y, false);
+            const auto blocked = pathfinder.findPath(start, goal, path);
+            const bool avoided = !blocked.found || std::ranges::find(path, door) == path.end();
+            const std::int64_t expected = referenceCost(grid, start, goal);
+            grid.setWalkable(door.x, door.y, true);
+            const auto after = pathfinder.findPath(start, goal, path);
+            if (!avoided || blocked.cost < before.cost || blocked.found != (expected >= 0) ||
+                (blocked.found && blocked.cost != expected) || after.cost != before.cost)
+            {
+                std::cerr << label << ": ERROR - Closing and opening a door was not taken into account" << std::endl;
+                return false;
+            }
+            return true;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing navigation: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Walls block, and so does every fourth tile through the solid property
+    auto map = *result;
+    for (auto& tileset : map.tilesets)
+    {
+        for (std::uint32_t id = 0; id < tileset.tilecount; id += 4)
+        {
+            auto tile = std::ranges::find(tileset.tiles, id, &tmx::map::Tile::id);
+            if (tile == tileset.tiles.end())
+            {
+                tileset.tiles.push_back({id, {}, {}});
+                tile = tileset.tiles.end() - 1;
+            }
+            tile->properties.properties.push_back({"solid", "true", "bool"});
+        }
+    }
+    std::vector<std::uint8_t> blocking(map.layers.size(), 0);
+    for (std::size_t l = 0; l < map.layers.size(); ++l)
+        blocking[l] = map.layers[l].name == "Walls" ? 1 : 0;
+
+    const auto grid = tmx::nav::NavGrid::fromMap(map, [](const tmx::map::Layer& layer) { return layer.name == "Walls"; });
+    bool success = verifyGrid(map, grid, blocking, filename);
+    success &= verifySearches(grid, 300, 1, filename);
+    success &= verifyEdits(grid, filename);
+
+    // Larger synthetic grids exercise scans across word boundaries
+    for (const double density : {0.0, 0.1, 0.3, 0.45})
+    {
+        const auto synthetic = syntheticGrid(150, 90, density, static_cast<std::uint32_t>(density * 100));
+        success &= verifySearches(synthetic, 150, 7, "synthetic " + std::to_string(density));
+    }
+    success &= verifyEdits(syntheticGrid(150, 90, 0.1, 5), "synthetic edits");
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
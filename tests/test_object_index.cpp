@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+auto sameRef(const tmx::render::ObjectRef& a, const tmx::render::ObjectRef& b) -> bool
+{
+    return a.objectGroupIndex == b.objectGroupIndex && a.objectIndex == b.objectIndex;
+}
+
+auto refLess(const tmx::render::ObjectRef& a, const tmx::render::ObjectRef& b) -> bool
+{
+    return a.objectGroupIndex != b.objectGroupIndex ? a.objectGroupIndex < b.objectGroupIndex
+                                                    : a.objectIndex < b.objectIndex;
+}
+
+auto near(float a, float b) -> bool
+{
+    return std::abs(a - b) <= 1e-3f * std::max(1.0f, std::abs(b));
+}
+
+auto sameBounds(const tmx::render::ObjectBounds& a, const tmx::render::ObjectBounds& b) -> bool
+{
+    return near(a.minX, b.minX) && near(a.minY, b.minY) && near(a.maxX, b.maxX) && near(a.maxY, b.maxY);
+}
+
+auto makeObject(tmx::map::ObjectShape shape, float x, float y, float width, float height, float rotation)
+    -> tmx::render::ObjectRenderInfo
+{
+    tmx::render::ObjectRenderInfo object{};
+    object.x = x;
+    object.y = y;
+    object.width = width;
+    object.height = height;
+    object.rotation = rotation;
+    object.visible = true;
+    object.shape = shape;
+    object.gid = 0;
+    return object;
+}
+
+// Bounds of each shape, checked against values worked out by hand
+bool verifyBounds()
+{
+    using tmx::map::ObjectShape;
+    struct Case
+    {
+        const char* name;
+        tmx::render::ObjectRenderInfo object;
+        tmx::render::ObjectBounds expected;
+    };
+
+    auto polygon = makeObject(ObjectShape::Polygon, 100, 50, 0, 0, 90);
+    const std::vector<tmx::map::Point> polygonPoints = {{0, 0}, {20, 0}, {20, 10}};
+    polygon.pointCount = static_cast<std::uint32_t>(polygonPoints.size());
+    auto tile = makeObject(ObjectShape::Rectangle, 10, 40, 0, 0, 0);
+    tile.gid = 1;
+    tile.srcW = 16;
+    tile.srcH = 24;
+    auto rotatedTile = makeObject(ObjectShape::Rectangle, 10, 40, 32, 16, 90);
+    rotatedTile.gid = 1;
+
+    // A rotated circle keeps its size: only its center moves
+    const float cx = 10.0f * std::cos(0.5235988f) - 10.0f * std::sin(0.5235988f);
+    const float cy = 10.0f * std::sin(0.5235988f) + 10.0f * std::cos(0.5235988f);
+
+    const std::vector<Case> cases = {
+        {"rectangle", makeObject(ObjectShape::Rectangle, 10, 20, 30, 40, 0), {10, 20, 40, 60}},
+        {"rotated rectangle", makeObject(ObjectShape::Rectangle, 10, 20, 30, 40, 90), {-30, 20, 10, 50}},
+        {"diamond", makeObject(ObjectShape::Rectangle, 0, 0, 10, 10, 45), {-7.0711f, 0, 7.0711f, 14.1421f}},
+        {"ellipse", makeObject(ObjectShape::Ellipse, 0, 0, 40, 20, 0), {0, 0, 40, 20}},
+        {"rotated ellipse", makeObject(ObjectShape::Ellipse, 0, 0, 40, 20, 90), {-20, 0, 0, 40}},
+        {"tilted circle", makeObject(ObjectShape::Ellipse, 0, 0, 20, 20, 30), {cx - 10, cy - 10, cx + 10, cy + 10}},
+        {"point", makeObject(ObjectShape::Point, 7, 9, 0, 0, 0), {7, 9, 7, 9}},
+        {"polygon", polygon, {90, 50, 100, 70}},
+        {"tile object", tile, {10, 16, 26, 40}},
+        {"rotated tile object", rotatedTile, {10, 40, 26, 72}},
+    };
+
+    bool success = true;
+    for (const auto& [name, object, expected] : cases)
+    {
+        const auto bounds = tmx::render::objectBounds(
+            object, object.shape == ObjectShape::Polygon ? std::span(polygonPoints) : std::span<const tmx::map::Point>{});
+        if (sameBounds(bounds, expected))
+            continue;
+        std::cerr << "ERROR - Bounds of the " << name << " are (" << bounds.minX << ", " << bounds.minY << ") - ("
+            << bounds.maxX << ", " << bounds.maxY << ")" << std::endl;
+        success = false;
+    }
+    return success;
+}
+
+// Adds a group of objects of every shape, some rotated and a few much larger than the grid cells
+void addObjects(tmx::render::MapRenderData& renderData, std::uint32_t count)
+{
+    std::mt19937 rng(3);
+    const float width = static_cast<float>(std::max(renderData.pixelWidth, 64u));
+    const float height = static_cast<float>(std::max(renderData.pixelHeight, 64u));
+    std::uniform_real_distribution<float> x(-64.0f, width + 64.0f);
+    std::uniform_real_distribution<float> y(-64.0f, height + 64.0f);
+    std::uniform_real_distribution<float> size(0.0f, 48.0f);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+
+    tmx::render::ObjectGroupRenderData group{};
+    group.name = "entities";
+    group.visible = true;
+    group.opacity = 1.0f;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const auto shape = static_cast<tmx::map::ObjectShape>(i % 5);
+        auto object = makeObject(shape, x(rng), y(rng), size(rng), size(rng), i % 3 == 0 ? angle(rng) : 0.0f);
+        if (i % 50 == 0)
+        {
+            object.width = 4000.0f;
+            object.height = 2000.0f;
+        }
+        if (shape == tmx::map::ObjectShape::Polygon || shape == tmx::map::ObjectShape::Polyline)
+        {
+            object.firstPoint = static_cast<std::uint32_t>(renderData.points.size());
+            object.pointCount = 4;
+            for (int p = 0; p < 4; ++p)
+                renderData.points.push_back({size(rng) - 24.0f, size(rng) - 24.0f});
+            renderData.pointDistances.resize(renderData.points.size(), 0.0f);
+        }
+        if (i % 11 == 0)
+        {
+            object.gid = 1;
+            object.srcW = renderData.tileWidth;
+            object.srcH = renderData.tileHeight;
+        }
+        object.id = 1000 + i;
+        group.objects.push_back(std::move(object));
+    }
+    renderData.objectGroups.push_back(std::move(group));
+}
+
+// Every query matches a scan over all objects
+template <typename Predicate>
+bool compareQuery(const tmx::render::MapRenderData& renderData, std::vector<tmx::render::ObjectRef> found,
+                  Predicate&& predicate, const std::string& label)
+{
+    std::vector<tmx::render::ObjectRef> expected;
+    for (std::uint32_t g = 0; g < renderData.objectGroups.size(); ++g)
+    {
+        for (std::uint32_t i = 0; i < renderData.objectGroups[g].objects.size(); ++i)
+        {
+            const auto& object = renderData.objectGroups[g].objects[i];
+            if (predicate(tmx::render::objectBounds(object, renderData.objectPoints(object))))
+                expected.push_back({g, i});
+        }
+    }
+
+    std::ranges::sort(found, refLess);
+    if (!std::ranges::equal(found, expected, sameRef))
+    {
+        std::cerr << label << ": ERROR - Found " << found.size() << " objects, a scan finds " << expected.size()
+            << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool verifyQueries(const tmx::render::MapRenderData& renderData, const tmx::render::ObjectIndex& index,
+                   const std::string& label)
+{
+    std::mt19937 rng(17);
+    const float width = static_cast<float>(std::max(renderData.pixelWidth, 64u));
+    const float height = static_cast<float>(std::max(renderData.pixelHeight, 64u));
+    std::uniform_real_distribution<float> x(-128.0f, width + 128.0f);
+    std::uniform_real_distribution<float> y(-128.0f, height + 128.0f);
+    std::uniform_real_distribution<float> extent(0.0f, 256.0f);
+
+    std::vector<tmx::render::ObjectRef> found;
+    for (int q = 0; q < 200; ++q)
+    {
+        const tmx::render::ViewRect rect{x(rng), y(rng), extent(rng), extent(rng)};
+        index.queryRect(rect, found);
+        if (!compareQuery(renderData, found, [&](const auto& bounds) { return bounds.intersects(rect); },
+                          label + " rect query"))
+            return false;
+
+        const float px = x(rng), py = y(rng);
+        index.queryPoint(px, py, found);
+        if (!compareQuery(renderData, found, [&](const auto& bounds) { return bounds.contains(px, py); },
+                          label + " point query"))
+            return false;
+
+        const float radius = extent(rng) / 2;
+        index.queryRadius(px, py, radius, found);
+        if (!compareQuery(renderData, found, [&](const auto& bounds) { return bounds.intersectsCircle(px, py, radius); },
+                          label + " radius query"))
+            return false;
+    }
+
+    // Queries far outside the map still see objects filed under the border cells
+    const auto everything = index.queryRect({-1e6f, -1e6f, 2e6f, 2e6f});
+    if (everything.size() != index.objectCount())
+    {
+        std::cerr << label << ": ERROR - A query covering everything found " << everything.size() << " of "
+            << index.objectCount() << " objects" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Objects moved, resized and moved far away are found where they are now
+bool verifyUpdate(tmx::render::MapRenderData renderData, const std::string& label)
+{
+    addObjects(renderData, 400);
+    tmx::render::ObjectIndex index(renderData);
+    if (index.largeObjectCount() == 0)
+    {
+        std::cerr << label << ": ERROR - No object is larger than the grid cells" << std::endl;
+        return false;
+    }
+
+    const auto groupIndex = static_cast<std::uint32_t>(renderData.objectGroups.size() - 1);
+    auto& objects = renderData.objectGroups[groupIndex].objects;
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        std::vector<tmx::render::ObjectRef> moved;
+        for (int i = 0; i < 25; ++i)
+        {
+            const auto objectIndex = static_cast<std::uint32_t>(rng() % objects.size());
+            auto& object = objects[objectIndex];
+            object.x += step(rng);
+            object.y += step(rng);
+            if (i == 0)
+                object.width = object.width > 1000.0f ? 8.0f : 6000.0f; // In and out of the large list
+            if (i == 1)
+                object.x += frame % 2 == 0 ? 1e5f : -1e5f; // Past the edge of the grid and back
+            moved.push_back({groupIndex, objectIndex});
+        }
+        moved.push_back({groupIndex + 1, 0}); // Invalid: ignored
+        index.update(moved);
+
+        for (const auto& ref : moved)
+        {
+            if (ref.objectGroupIndex == groupIndex &&
+                !sameBounds(index.bounds(ref), tmx::render::objectBounds(objects[ref.objectIndex],
+                                                                      renderData.objectPoints(objects[ref.objectIndex]))))
+            {
+                std::cerr << label << ": ERROR - Bounds of a moved object were not updated" << std::endl;
+                return false;
+            }
+        }
+        if (!verifyQueries(renderData, index, label + " (frame " + std::to_string(frame) + ")"))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing object index: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = verifyBounds();
+    const auto renderData = tmx::render::createRenderData(*result);
+
+    // The map's own objects
+    const tmx::render::ObjectIndex index(renderData);
+    std::size_t objectCount = 0;
+    for (const auto& group : renderData.objectGroups)
+        objectCount += group.objects.size();
+    std::cout << filename << ": " << objectCount << " objects, " << index.cellSize() << "px cells" << std::endl;
+    if (index.objectCount() != objectCount)
+    {
+        std::cerr << filename << ": ERROR - " << index.objectCount() << " objects indexed" << std::endl;
+        success = false;
+    }
+    success &= verifyQueries(renderData, index, filename);
+
+    // Synthetic objects of every shape, with default and custom cell sizes
+    auto populated = renderData;
+    addObjects(populated, 1000);
+    for (const float cellSize : {0.0f, 8.0f, 200.0f})
+    {
+        const tmx::render::ObjectIndex synthetic(populated, cellSize);
+        success &= verifyQueries(populated, synthetic, filename + " (" + std::to_string(cellSize) + "px cells)");
+    }
+    success &= verifyUpdate(renderData, filename);
+
+    // An index that was never built finds nothing
+    const tmx::render::ObjectIndex empty;
+    if (!empty.queryRect({0, 0, 100, 100}).empty() || !empty.queryRadius(0, 0, 10).empty())
+    {
+        std::cerr << "ERROR - An empty index found objects" << std::endl;
+        success = false;
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::map::ObjectTable;
+
+static_assert(std::forward_iterator<ObjectTable::ConstIterator>);
+static_assert(std::forward_iterator<ObjectTable::Iterator>);
+
+// Every field of a view matches the object it was copied from
+bool sameObject(const ObjectTable::ConstView& view, const tmx::map::Object& object,
+                std::span<const tmx::map::Point> points)
+{
+    if (view.id() != object.id || view.name() != object.name || view.type() != object.type || view.x() != object.x ||
+        view.y() != object.y || view.width() != object.width || view.height() != object.height ||
+        view.rotation() != object.rotation || view.visible() != object.visible || view.shape() != object.shape ||
+        view.gid() != object.gid || view.points().size() != points.size() ||
+        view.properties().properties.size() != object.properties.properties.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        if (view.points()[i].x != points[i].x || view.points()[i].y != points[i].y)
+            return false;
+    }
+    return true;
+}
+
+// The table holds every object of the map, group by group, and copies back out unchanged
+bool verifyMap(const tmx::map::Map& map, const std::string& label)
+{
+    const auto table = ObjectTable::fromMap(map);
+    if (table.groupCount() != map.objectgroups.size())
+    {
+        std::cerr << label << ": ERROR - " << table.groupCount() << " groups instead of " << map.objectgroups.size()
+            << std::endl;
+        return false;
+    }
+
+    std::uint32_t index = 0;
+    for (std::uint32_t g = 0; g < map.objectgroups.size(); ++g)
+    {
+        const auto& objects = map.objectgroups[g].objects;
+        if (table.groupBegin(g) != index || std::ranges::distance(table.group(g)) != std::ssize(objects))
+        {
+            std::cerr << label << ": ERROR - Group " << g << " does not cover its objects" << std::endl;
+            return false;
+        }
+        for (const auto view : table.group(g))
+        {
+            const auto& object = objects[view.index() - table.groupBegin(g)];
+            if (!sameObject(view, object, map.objectPoints(object)))
+            {
+                std::cerr << label << ": ERROR - Object " << object.id << " was not copied exactly" << std::endl;
+                return false;
+            }
+            const auto copy = view.toObject();
+            if (!sameObject(view, copy, table.pointPool().subspan(copy.firstPoint, copy.pointCount)))
+            {
+                std::cerr << label << ": ERROR - Object " << object.id << " did not copy back out" << std::endl;
+                return false;
+            }
+            ++index;
+        }
+    }
+    if (index != table.size() || table.xs().size() != table.size() || table.visibility().size() != table.size())
+    {
+        std::cerr << label << ": ERROR - Table holds " << table.size() << " objects, expected " << index << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Objects appended by hand, edited through views and seen through the field arrays
+bool verifySynthetic()
+{
+    ObjectTable table;
+    const std::vector<tmx::map::Point> outline = {{0, 0}, {8, 0}, {8, 8}};
+    for (std::uint32_t i = 0; i < 100; ++i)
+    {
+        if (i == 40)
+            table.addGroup();
+        tmx::map::Object object{};
+        object.id = i + 1;
+        object.name = "object" + std::to_string(i);
+        object.x = static_cast<float>(i);
+        object.y = static_cast<float>(2 * i);
+        object.shape = i % 2 == 0 ? tmx::map::ObjectShape::Polygon : tmx::map::ObjectShape::Rectangle;
+        table.append(object, i % 2 == 0 ? std::span(outline) : std::span<const tmx::map::Point>{});
+    }
+    table.addGroup(); // Empty trailing group
+
+    bool success = true;
+    if (table.groupCount() != 3 || table.groupEnd(0) != 40 || table.groupBegin(1) != 40 || table.groupEnd(1) != 100 ||
+        !table.group(2).empty() || table.pointPool().size() != 150)
+    {
+        std::cerr << "synthetic: ERROR - Groups or point pool have the wrong extent" << std::endl;
+        success = false;
+    }
+
+    for (auto view : table)
+    {
+        view.x() += 10.0f;
+        view.setVisible(view.index() % 3 != 0);
+    }
+    table[5].name() = "renamed";
+    float sum = 0.0f;
+    for (const float x : table.xs())
+        sum += x;
+    if (sum != 4950.0f + 1000.0f || table.visibility()[3] != 0 || table.visibility()[4] != 1 ||
+        std::as_const(table)[5].name() != "renamed" || table.points(4).size() != 3 || !table.points(5).empty())
+    {
+        std::cerr << "synthetic: ERROR - Edits through views were not seen by the field arrays" << std::endl;
+        success = false;
+    }
+
+    table.clear();
+    if (!table.empty() || table.groupCount() != 0 || table.begin() != table.end())
+    {
+        std::cerr << "synthetic: ERROR - Cleared table is not empty" << std::endl;
+        success = false;
+    }
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing object table: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = verifyMap(*result, filename);
+    success &= verifySynthetic();
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using TileKey = std::tuple<std::int32_t, std::int32_t, std::uint32_t, std::uint32_t, std::uint8_t>;
+
+// Top-left corner of a cell's bounding box, computed the way Tiled's renderers do
+std::pair<std::int32_t, std::int32_t> referenceCorner(const tmx::map::Map& map, const std::int32_t x, const std::int32_t y)
+{
+    const auto tileWidth = static_cast<std::int32_t>(map.tilewidth);
+    const auto tileHeight = static_cast<std::int32_t>(map.tileheight);
+    if (map.orientation == tmx::map::Orientation::Isometric)
+    {
+        const std::int32_t originX = static_cast<std::int32_t>(map.height) * (tileWidth / 2);
+        return {(x - y) * (tileWidth / 2) + originX - tileWidth / 2, (x + y) * (tileHeight / 2)};
+    }
+    if (map.orientation == tmx::map::Orientation::Staggered || map.orientation == tmx::map::Orientation::Hexagonal)
+    {
+        const bool staggerX = map.staggeraxis == tmx::map::StaggerAxis::X;
+        const bool staggerEven = map.staggerindex == tmx::map::StaggerIndex::Even;
+        const std::int32_t width = tileWidth & ~1;
+        const std::int32_t height = tileHeight & ~1;
+        const std::int32_t side = map.orientation == tmx::map::Orientation::Hexagonal
+            ? static_cast<std::int32_t>(map.hexsidelength) : 0;
+        const std::int32_t sideLengthX = staggerX ? side : 0;
+        const std::int32_t sideLengthY = staggerX ? 0 : side;
+        const std::int32_t columnWidth = (width - sideLengthX) / 2 + sideLengthX;
+        const std::int32_t rowHeight = (height - sideLengthY) / 2 + sideLengthY;
+        if (staggerX)
+        {
+            const bool shifted = ((x & 1) != 0) != staggerEven;
+            return {x * columnWidth, y * (height + sideLengthY) + (shifted ? rowHeight : 0)};
+        }
+        const bool shifted = ((y & 1) != 0) != staggerEven;
+        return {x * (width + sideLengthX) + (shifted ? columnWidth : 0), y * rowHeight};
+    }
+    return {x * tileWidth, y * tileHeight};
+}
+
+// Size of the map on screen, as Tiled's renderers compute it
+std::pair<std::uint32_t, std::uint32_t> referenceSize(const tmx::map::Map& map)
+{
+    const std::uint32_t tileWidth = map.tilewidth, tileHeight = map.tileheight;
+    if (map.orientation == tmx::map::Orientation::Isometric)
+        return {(map.width + map.height) * (tileWidth / 2), (map.width + map.height) * (tileHeight / 2)};
+    if (map.orientation == tmx::map::Orientation::Staggered || map.orientation == tmx::map::Orientation::Hexagonal)
+    {
+        const bool staggerX = map.staggeraxis == tmx::map::StaggerAxis::X;
+        const std::uint32_t width = tileWidth & ~1u;
+        const std::uint32_t height = tileHeight & ~1u;
+        const std::uint32_t side = map.orientation == tmx::map::Orientation::Hexagonal ? map.hexsidelength : 0;
+        const std::uint32_t sideLengthX = staggerX ? side : 0;
+        const std::uint32_t sideLengthY = staggerX ? 0 : side;
+        const std::uint32_t sideOffsetX = (width - sideLengthX) / 2;
+        const std::uint32_t sideOffsetY = (height - sideLengthY) / 2;
+        if (staggerX)
+        {
+            return {map.width * (sideOffsetX + sideLengthX) + sideOffsetX,
+                    map.height * (height + sideLengthY) + (map.width > 1 ? sideOffsetY : 0)};
+        }
+        return {map.width * (width + sideLengthX) + (map.height > 1 ? sideOffsetX : 0),
+                map.height * (sideOffsetY + sideLengthY) + sideOffsetY};
+    }
+    return {map.width * tileWidth, map.height * tileHeight};
+}
+
+// Visit every cell of a parsed layer with its tile coordinates and a reference to its GID
+template <typename Visitor>
+void forEachCell(tmx::map::Layer& layer, Visitor&& visitor)
+{
+    if (!layer.chunks.empty())
+    {
+        for (auto& chunk : layer.chunks)
+        {
+            for (std::uint32_t i = 0; i < chunk.data.size() && i < chunk.width * chunk.height; ++i)
+            {
+                visitor(chunk.x + static_cast<std::int32_t>(i % chunk.width),
+                        chunk.y + static_cast<std::int32_t>(i / chunk.width), chunk.data[i]);
+            }
+        }
+        return;
+    }
+    for (std::uint32_t i = 0; i < layer.data.size() && i < layer.width * layer.height; ++i)
+    {
+        visitor(static_cast<std::int32_t>(i % layer.width), static_cast<std::int32_t>(i / layer.width), layer.data[i]);
+    }
+}
+
+std::vector<TileKey> expectedTiles(tmx::map::Map& map, const tmx::render::MapRenderData& renderData,
+                                   const std::size_t layerIndex)
+{
+    std::vector<TileKey> tiles;
+    forEachCell(map.layers[layerIndex], [&](const std::int32_t x, const std::int32_t y, const std::uint32_t gid)
+    {
+        if (const auto* info = renderData.gidInfo(gid))
+        {
+            const auto [destX, destY] = referenceCorner(map, x, y);
+            tiles.emplace_back(destX, destY, info->tileId, info->tilesetIndex,
+                               static_cast<std::uint8_t>(gid >> tmx::map::GID_FLAGS_SHIFT));
+        }
+    });
+    std::ranges::sort(tiles);
+    return tiles;
+}
+
+std::vector<TileKey> actualTiles(const tmx::render::MapRenderData& renderData, const tmx::render::LayerRenderData& layer)
+{
+    std::vector<TileKey> tiles;
+    renderData.forEachTile(layer, [&](const tmx::render::TileRenderInfo& tile)
+    {
+        tiles.emplace_back(tile.destX, tile.destY, tile.tileId, tile.tilesetIndex, tile.flipFlags);
+    });
+    std::ranges::sort(tiles);
+    return tiles;
+}
+
+// Chunks are sorted, their bounds hold exactly their tiles, and the layer bounds hold every chunk
+bool verifyBounds(const tmx::render::MapRenderData& renderData, const std::string& label)
+{
+    for (const auto& layer : renderData.layers)
+    {
+        tmx::render::RenderBounds layerBounds;
+        for (std::size_t c = 0; c < layer.chunks.size(); ++c)
+        {
+            const auto& chunk = layer.chunks[c];
+            if (c > 0 && std::pair(layer.chunks[c - 1].chunkY, layer.chunks[c - 1].chunkX) >=
+                std::pair(chunk.chunkY, chunk.chunkX))
+            {
+                std::cerr << label << ": ERROR - Chunks of layer '" << layer.name << "' are not sorted" << std::endl;
+                return false;
+            }
+
+            tmx::render::RenderBounds bounds;
+            renderData.forEachTile(layer, chunk, [&](const tmx::render::TileRenderInfo& tile)
+            {
+                bounds.merge({tile.destX, tile.destY, tile.destX + static_cast<std::int32_t>(tile.destW),
+                              tile.destY + static_cast<std::int32_t>(tile.destH)});
+            });
+            if (bounds.minX != chunk.bounds.minX || bounds.minY != chunk.bounds.minY ||
+                bounds.maxX != chunk.bounds.maxX || bounds.maxY != chunk.bounds.maxY)
+            {
+                std::cerr << label << ": ERROR - Chunk " << chunk.chunkX << "," << chunk.chunkY << " of layer '"
+                    << layer.name << "' has wrong bounds" << std::endl;
+                return false;
+            }
+            layerBounds.merge(bounds);
+        }
+        if (layerBounds.minX != layer.bounds.minX || layerBounds.minY != layer.bounds.minY ||
+            layerBounds.maxX != layer.bounds.maxX || layerBounds.maxY != layer.bounds.maxY)
+        {
+            std::cerr << label << ": ERROR - Layer '" << layer.name << "' has wrong bounds" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every tile sits where Tiled draws it, and the map size matches Tiled's
+bool verifyPositions(tmx::map::Map& map, const tmx::render::MapRenderData& renderData, const std::string& label)
+{
+    const auto [width, height] = referenceSize(map);
+    if (renderData.pixelWidth != width || renderData.pixelHeight != height)
+    {
+        std::cerr << label << ": ERROR - Map is " << renderData.pixelWidth << "x" << renderData.pixelHeight
+            << " pixels, expected " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    for (std::size_t l = 0; l < renderData.layers.size(); ++l)
+    {
+        if (actualTiles(renderData, renderData.layers[l]) != expectedTiles(map, renderData, l))
+        {
+            std::cerr << label << ": ERROR - Tiles of layer '" << renderData.layers[l].name
+                << "' are not where Tiled draws them" << std::endl;
+            return false;
+        }
+    }
+    return verifyBounds(renderData, label);
+}
+
+// Queries return exactly the chunks whose bounds overlap the view
+bool verifyQueries(const tmx::render::MapRenderData& renderData, const std::string& label)
+{
+    tmx::render::RenderBounds world;
+    for (const auto& layer : renderData.layers)
+        world.merge(layer.bounds);
+    if (world.isEmpty())
+        return true;
+
+    std::mt19937 random(41);
+    std::uniform_real_distribution<float> x(static_cast<float>(world.minX) - 64.0f, static_cast<float>(world.maxX) + 64.0f);
+    std::uniform_real_distribution<float> y(static_cast<float>(world.minY) - 64.0f, static_cast<float>(world.maxY) + 64.0f);
+    std::uniform_real_distribution<float> size(1.0f, 400.0f);
+
+    std::vector<tmx::render::ViewRect> views{
+        {static_cast<float>(world.minX), static_cast<float>(world.minY), static_cast<float>(world.maxX - world.minX),
+         static_cast<float>(world.maxY - world.minY)},
+        {-1.0e7f, -1.0e7f, 2.0e7f, 2.0e7f}};
+    for (int i = 0; i < 200; ++i)
+        views.push_back({x(random), y(random), size(random), size(random)});
+
+    std::vector<tmx::render::ChunkRange> ranges;
+    for (const auto& view : views)
+    {
+        renderData.query(view, ranges);
+        std::set<std::pair<std::uint32_t, std::uint32_t>> actual;
+        for (const auto& range : ranges)
+        {
+            for (std::uint32_t i = range.first; i < range.first + range.count; ++i)
+                actual.emplace(range.layerIndex, i);
+        }
+
+        std::set<std::pair<std::uint32_t, std::uint32_t>> expected;
+        for (std::uint32_t l = 0; l < renderData.layers.size(); ++l)
+        {
+            for (std::uint32_t i = 0; i < renderData.layers[l].chunks.size(); ++i)
+            {
+                if (renderData.layers[l].chunks[i].bounds.intersects(view))
+                    expected.emplace(l, i);
+            }
+        }
+        if (actual != expected)
+        {
+            std::cerr << label << ": ERROR - Query " << view.x << "," << view.y << " " << view.width << "x"
+                << view.height << " returned " << actual.size() << " chunks, expected " << expected.size() << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Painting and clearing cells places them like a rebuild from the edited map, with matching dirty regions
+bool verifyEdits(tmx::map::Map map, tmx::render::MapRenderData renderData, const std::string& label)
+{
+    if (renderData.layers.empty() || renderData.tilesets.empty() || renderData.layers[0].chunks.empty())
+        return true;
+
+    // A 3x2 rectangle near the first tile of layer 0, inside its map chunk on infinite maps
+    std::int32_t originX = 0, originY = 0;
+    if (!map.layers[0].chunks.empty())
+    {
+        originX = map.layers[0].chunks[0].x;
+        originY = map.layers[0].chunks[0].y;
+    }
+    const std::uint32_t paint = renderData.tilesets[0].firstgid | tmx::map::FLIPPED_HORIZONTALLY_FLAG;
+    struct Edit
+    {
+        std::int32_t x, y;
+        std::uint32_t width, height, gid;
+    };
+    for (const Edit& edit : {Edit{originX + 1, originY + 1, 3, 2, paint}, Edit{originX, originY + 2, 2, 2, 0}})
+    {
+        renderData.dirtyRegions.clear();
+        if (!renderData.fillRect(0, edit.x, edit.y, edit.width, edit.height, edit.gid))
+        {
+            std::cerr << label << ": ERROR - fillRect failed" << std::endl;
+            return false;
+        }
+
+        forEachCell(map.layers[0], [&](const std::int32_t x, const std::int32_t y, std::uint32_t& gid)
+        {
+            if (x >= edit.x && x < edit.x + static_cast<std::int32_t>(edit.width) && y >= edit.y &&
+                y < edit.y + static_cast<std::int32_t>(edit.height))
+            {
+                gid = edit.gid;
+                const auto [destX, destY] = referenceCorner(map, x, y);
+                const bool covered = std::ranges::any_of(renderData.dirtyRegions, [&](const auto& region)
+                {
+                    return region.bounds.minX <= destX && region.bounds.minY <= destY &&
+                        destX + static_cast<std::int32_t>(map.tilewidth) <= region.bounds.maxX &&
+                        destY + static_cast<std::int32_t>(map.tileheight) <= region.bounds.maxY;
+                });
+                if (!covered)
+                {
+                    std::cerr << label << ": ERROR - No dirty region covers cell " << x << "," << y << std::endl;
+                    gid = ~0u;
+                }
+            }
+        });
+
+        if (actualTiles(renderData, renderData.layers[0]) != expectedTiles(map, renderData, 0))
+        {
+            std::cerr << label << ": ERROR - Edited tiles are not where Tiled draws them" << std::endl;
+            return false;
+        }
+    }
+    return verifyBounds(renderData, label + " (edited)") && verifyQueries(renderData, label + " (edited)");
+}
+
+// The stagger and hexagon attributes of the <map> element are parsed
+bool verifyParsing()
+{
+    const auto parsed = tmx::Parser::parseFromString(R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="hexagonal" renderorder="right-down" width="2" height="2" tilewidth="32"
+     tileheight="28" infinite="0" hexsidelength="14" staggeraxis="x" staggerindex="even">
+ <layer id="1" name="Ground" width="2" height="2">
+  <data encoding="csv">0,0,0,0</data>
+ </layer>
+</map>)");
+    if (!parsed || parsed->orientation != tmx::map::Orientation::Hexagonal ||
+        parsed->staggeraxis != tmx::map::StaggerAxis::X || parsed->staggerindex != tmx::map::StaggerIndex::Even ||
+        parsed->hexsidelength != 14)
+    {
+        std::cerr << "ERROR - Stagger attributes were not parsed" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing projections: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    struct Variant
+    {
+        const char* name;
+        tmx::map::Orientation orientation;
+        tmx::map::StaggerAxis axis;
+        tmx::map::StaggerIndex index;
+        std::uint32_t sideLength;
+    };
+    using tmx::map::Orientation;
+    using tmx::map::StaggerAxis;
+    using tmx::map::StaggerIndex;
+    const std::uint32_t side = result->tilewidth / 2;
+    const Variant variants[] = {
+        {"orthogonal", Orientation::Orthogonal, StaggerAxis::Y, StaggerIndex::Odd, 0},
+        {"isometric", Orientation::Isometric, StaggerAxis::Y, StaggerIndex::Odd, 0},
+        {"staggered x even", Orientation::Staggered, StaggerAxis::X, StaggerIndex::Even, side},
+        {"staggered y odd", Orientation::Staggered, StaggerAxis::Y, StaggerIndex::Odd, 0},
+        {"hexagonal x odd", Orientation::Hexagonal, StaggerAxis::X, StaggerIndex::Odd, side},
+        {"hexagonal y even", Orientation::Hexagonal, StaggerAxis::Y, StaggerIndex::Even, side + 1}};
+
+    bool success = verifyParsing();
+    for (const auto& variant : variants)
+    {
+        auto map = *result;
+        map.orientation = variant.orientation;
+        map.staggeraxis = variant.axis;
+        map.staggerindex = variant.index;
+        map.hexsidelength = variant.sideLength;
+
+        for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                                   tmx::render::TileStorage::Indexed})
+        {
+            tmx::render::RenderBuildOptions options;
+            options.tileStorage = storage;
+            options.chunkSize = 4;
+            const auto renderData = tmx::render::createRenderData(map, "", options);
+            const std::string label = filename + " (" + variant.name + ", storage " +
+                std::to_string(static_cast<int>(storage)) + ")";
+            success &= verifyPositions(map, renderData, label);
+            success &= verifyQueries(renderData, label);
+            success &= verifyEdits(map, renderData, label);
+        }
+    }
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+#include <tmx/Raster.hpp>
+
+// Straightforward per-channel "source over" on premultiplied pixels, the arithmetic blendRow must reproduce
+void referenceBlend(std::uint8_t* dst, const std::uint8_t* src, std::size_t count, std::uint32_t opacity)
+{
+    for (std::size_t i = 0; i < count * 4; i += 4)
+    {
+        const std::uint32_t alpha = (src[i + 3] * opacity + 128) >> 8;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            const std::uint32_t value = c == 3 ? alpha : (src[i + c] * opacity + 128) >> 8;
+            const std::uint32_t product = dst[i + c] * (255 - alpha) + 128;
+            dst[i + c] = static_cast<std::uint8_t>(std::min<std::uint32_t>(value + ((product + (product >> 8)) >> 8), 255));
+        }
+    }
+}
+
+bool verifyBlendRow(const std::string& label)
+{
+    std::mt19937 rng(37);
+    std::uniform_int_distribution<std::uint32_t> byte(0, 255);
+    for (const std::uint32_t opacity : {0u, 1u, 77u, 128u, 255u, 256u})
+    {
+        for (std::size_t count = 0; count < 40; ++count)
+        {
+            std::vector<std::uint8_t> src(count * 4), dst(count * 4);
+            for (std::size_t i = 0; i < src.size(); i += 4)
+            {
+                // Premultiplied: no color channel exceeds alpha
+                src[i + 3] = static_cast<std::uint8_t>(i % 12 == 0 ? 255 : byte(rng));
+                dst[i + 3] = static_cast<std::uint8_t>(byte(rng));
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    src[i + c] = static_cast<std::uint8_t>(byte(rng) * src[i + 3] / 255);
+                    dst[i + c] = static_cast<std::uint8_t>(byte(rng) * dst[i + 3] / 255);
+                }
+            }
+
+            auto expected = dst;
+            referenceBlend(expected.data(), src.data(), count, opacity);
+            tmx::raster::blendRow(dst.data(), src.data(), count, opacity);
+            if (dst != expected)
+            {
+                std::cerr << label << ": ERROR - blendRow differs from the reference for " << count
+                    << " pixels at opacity " << opacity << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Images match when no channel of any pixel differs by more than the tolerance
+bool compareImages(const tmx::raster::Image& actual, const tmx::raster::Image& expected, std::uint32_t tolerance,
+                   const std::string& label)
+{
+    if (actual.width != expected.width || actual.height != expected.height)
+    {
+        std::cerr << label << ": ERROR - Image is " << actual.width << "x" << actual.height << ", expected "
+            << expected.width << "x" << expected.height << std::endl;
+        return false;
+    }
+
+    std::uint32_t maxDifference = 0;
+    std::size_t differing = 0;
+    for (std::size_t i = 0; i < actual.pixels.size(); i += 4)
+    {
+        std::uint32_t difference = 0;
+        for (std::size_t c = 0; c < 4; ++c)
+            difference = std::max<std::uint32_t>(difference, std::abs(actual.pixels[i + c] - expected.pixels[i + c]));
+        maxDifference = std::max(maxDifference, difference);
+        differing += difference > 0 ? 1 : 0;
+    }
+    if (maxDifference > tolerance)
+    {
+        std::cerr << label << ": ERROR - " << differing << " pixels differ, by up to " << maxDifference << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// The drawn map must match the golden image, whatever the number of threads
+bool verifyGolden(const tmx::raster::Rasterizer& rasterizer, const tmx::raster::RasterOptions& options,
+                  const std::string& goldenPath, const std::string& label)
+{
+    const auto image = rasterizer.render(options);
+    if (!image)
+    {
+        std::cerr << label << ": ERROR - Render failed: " << image.error() << std::endl;
+        return false;
+    }
+
+    // Regenerate the golden image after an intended change of the output
+    if (std::getenv("TMX_UPDATE_GOLDEN"))
+    {
+        if (auto written = tmx::raster::writePng(*image, goldenPath); !written)
+        {
+            std::cerr << label << ": ERROR - " << written.error() << std::endl;
+            return false;
+        }
+        std::cout << "Updated " << goldenPath << std::endl;
+    }
+
+    const auto golden = tmx::raster::loadImage(goldenPath);
+    if (!golden)
+    {
+        std::cerr << label << ": ERROR - " << golden.error() << std::endl;
+        return false;
+    }
+    if (!compareImages(*image, *golden, 1, label + " (golden)"))
+        return false;
+
+    for (const std::uint32_t threads : {3u, 0u})
+    {
+        auto threaded = options;
+        threaded.threadCount = threads;
+        const auto parallel = rasterizer.render(threaded);
+        if (!parallel || parallel->pixels != image->pixels)
+        {
+            std::cerr << label << ": ERROR - Rendering with " << threads << " threads changed the image" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tile objects are placed from their bottom-left corner and rotate and flip around it like in Tiled
+bool verifyTileObjects(tmx::render::MapRenderData renderData, const tmx::raster::Image& tilesetImage,
+                       const std::string& label)
+{
+    const auto& tileset = renderData.tilesets[0];
+    const std::uint32_t w = tileset.tileWidth, h = tileset.tileHeight;
+    for (auto& layer : renderData.layers)
+        layer.visible = false;
+    renderData.objectGroups.clear();
+
+    struct Case
+    {
+        float rotation;
+        std::uint32_t flags;
+    };
+    for (const Case& c : {Case{0.0f, 0}, Case{90.0f, 0}, Case{0.0f, tmx::map::FLIPPED_HORIZONTALLY_FLAG}})
+    {
+        tmx::render::ObjectRenderInfo object{};
+        object.x = 1000.0f;
+        object.y = 2000.0f;
+        object.width = static_cast<float>(w);
+        object.height = static_cast<float>(h);
+        object.rotation = c.rotation;
+        object.visible = true;
+        object.gid = (tileset.firstgid + 1) | c.flags;
+        object.tilesetIndex = 0;
+        object.srcX = tileset.srcXOf(1);
+        object.srcY = tileset.srcYOf(1);
+        object.srcW = w;
+        object.srcH = h;
+        object.flipFlags = static_cast<std::uint8_t>(object.gid >> tmx::map::GID_FLAGS_SHIFT);
+
+        renderData.objectGroups.assign(1, {"objects", true, 1.0f, {object}});
+        tmx::raster::Rasterizer rasterizer(renderData);
+        rasterizer.setTilesetImage(0, tilesetImage);
+
+        tmx::raster::RasterOptions options;
+        const auto width = static_cast<float>(w), height = static_cast<float>(h);
+        options.region = c.rotation == 0.0f ? tmx::render::ViewRect{1000.0f, 2000.0f - height, width, height}
+                                            : tmx::render::ViewRect{1000.0f, 2000.0f, height, width};
+        const auto image = rasterizer.render(options);
+        if (!image)
+        {
+            std::cerr << label << ": ERROR - Render failed: " << image.error() << std::endl;
+            return false;
+        }
+
+        for (std::uint32_t y = 0; y < image->height; ++y)
+        {
+            for (std::uint32_t x = 0; x < image->width; ++x)
+            {
+                // Source pixel of the tile shown at (x, y)
+                std::uint32_t sx = x, sy = y;
+                if (c.rotation != 0.0f)
+                {
+                    sx = y;
+                    sy = h - 1 - x;
+                }
+                else if (c.flags != 0)
+                {
+                    sx = w - 1 - x;
+                }
+
+                const std::uint8_t* expected = tilesetImage.pixel(object.srcX + sx, object.srcY + sy);
+                const std::uint8_t* actual = image->pixel(x, y);
+                if (expected[3] == 255 && std::memcmp(expected, actual, 4) != 0)
+                {
+                    std::cerr << label << ": ERROR - Tile object (rotation " << c.rotation << ", flags 0x" << std::hex
+                        << c.flags << std::dec << ") pixel " << x << "," << y << " does not match the tileset"
+                        << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Layers drawn at an offset look the same as the unmoved map seen through a region moved by that offset
+bool verifyLayerOffset(tmx::render::MapRenderData renderData, const tmx::raster::Image& tilesetImage,
+                       const tmx::raster::RasterOptions& options, const std::string& label)
+{
+    auto unmoved = options;
+    unmoved.drawObjects = false;
+    tmx::render::RenderBounds bounds;
+    for (const auto& layer : renderData.layers)
+        bounds.merge(layer.bounds);
+    unmoved.region = tmx::render::ViewRect{static_cast<float>(bounds.minX), static_cast<float>(bounds.minY),
+                                           static_cast<float>(bounds.maxX - bounds.minX),
+                                           static_cast<float>(bounds.maxY - bounds.minY)};
+    tmx::raster::Rasterizer rasterizer(renderData);
+    rasterizer.setTilesetImage(0, tilesetImage);
+    const auto expected = rasterizer.render(unmoved);
+
+    // Parallax only matters relative to a camera, and the rasterizer's camera sits at the map origin
+    for (auto& layer : renderData.layers)
+        layer.transform = {37.0f, -21.0f, 0.5f, 2.0f, layer.transform.tint};
+    rasterizer.reset(renderData);
+    rasterizer.setTilesetImage(0, tilesetImage);
+    auto moved = unmoved;
+    moved.region->x += 37.0f;
+    moved.region->y -= 21.0f;
+    for (const std::uint32_t threads : {1u, 3u})
+    {
+        moved.threadCount = threads;
+        const auto image = rasterizer.render(moved);
+        if (!expected || !image || !compareImages(*image, *expected, 0, label + " (layer offset)"))
+            return false;
+    }
+    return true;
+}
+
+// Drawing from atlas pages must give the same image as drawing from the tilesets, and edges must be extruded
+bool verifyAtlas(const tmx::render::MapRenderData& renderData, const tmx::raster::Image& expected,
+                 const tmx::raster::RasterOptions& options, const std::string& label)
+{
+    auto packed = renderData;
+    const auto atlas = tmx::render::packAtlas(packed, {.usedTilesOnly = true, .padding = 1, .extrusion = 2});
+    if (!atlas)
+    {
+        std::cerr << label << ": ERROR - " << atlas.error() << std::endl;
+        return false;
+    }
+    const auto pages = tmx::raster::composeAtlas(packed, *atlas);
+    if (!pages || pages->size() != packed.tilesets.size())
+    {
+        std::cerr << label << ": ERROR - Atlas pages could not be drawn" << std::endl;
+        return false;
+    }
+
+    tmx::raster::Rasterizer rasterizer(packed);
+    for (std::uint32_t i = 0; i < pages->size(); ++i)
+        rasterizer.setTilesetImage(i, (*pages)[i]);
+    const auto image = rasterizer.render(options);
+    if (!image || !compareImages(*image, expected, 0, label + " (atlas)"))
+        return false;
+
+    // The pixels around the first tile of each page repeat its edges, and the padding beyond stays transparent
+    for (std::uint32_t i = 0; i < pages->size(); ++i)
+    {
+        const auto& page = packed.tilesets[i];
+        const auto& pixels = (*pages)[i];
+        const std::uint32_t x = page.srcXOf(0), y = page.srcYOf(0);
+        const std::uint32_t right = x + page.tileWidth - 1, bottom = y + page.tileHeight - 1;
+        if (std::memcmp(pixels.pixel(x - 2, y), pixels.pixel(x, y), 4) != 0 ||
+            std::memcmp(pixels.pixel(x - 1, y - 1), pixels.pixel(x, y), 4) != 0 ||
+            std::memcmp(pixels.pixel(right + 2, bottom), pixels.pixel(right, bottom), 4) != 0 ||
+            std::memcmp(pixels.pixel(right, bottom + 1), pixels.pixel(right, bottom), 4) != 0 ||
+            pixels.pixel(0, 0)[3] != 0 || pixels.pixel(right + 3, y)[3] != 0)
+        {
+            std::cerr << label << ": ERROR - Atlas page " << i << " is not extruded and padded" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool verifyErrors(const tmx::raster::Rasterizer& rasterizer, const std::string& label)
+{
+    tmx::raster::RasterOptions zeroScale;
+    zeroScale.scale = 0.0f;
+    tmx::raster::RasterOptions emptyRegion;
+    emptyRegion.region = tmx::render::ViewRect{0.0f, 0.0f, 0.0f, 10.0f};
+    tmx::raster::RasterOptions oversized;
+    oversized.region = tmx::render::ViewRect{0.0f, 0.0f, 1.0e6f, 10.0f};
+
+    if (rasterizer.render(zeroScale) || rasterizer.render(emptyRegion) || rasterizer.render(oversized) ||
+        tmx::raster::Rasterizer{}.render())
+    {
+        std::cerr << label << ": ERROR - Invalid render options were accepted" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file> <golden_png> [time_ms] [scale]" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    const std::string goldenPath = argv[2];
+    std::cout << "Testing rasterizer: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    const auto renderData =
+        tmx::render::createRenderData(*result, std::filesystem::path(filename).parent_path().string());
+    tmx::raster::Rasterizer rasterizer(renderData);
+    if (auto loaded = rasterizer.loadTilesetImages(); !loaded)
+    {
+        std::cerr << filename << ": FAILED - " << loaded.error() << std::endl;
+        return 1;
+    }
+
+    tmx::raster::RasterOptions options;
+    options.time = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+    options.scale = argc > 4 ? std::strtof(argv[4], nullptr) : 1.0f;
+    options.background = 0x202020FF;
+
+    bool success = true;
+    success &= verifyBlendRow(filename);
+    success &= verifyGolden(rasterizer, options, goldenPath, filename);
+    if (const auto image = rasterizer.render(options))
+        success &= verifyAtlas(renderData, *image, options, filename);
+    if (const auto tilesetImage = tmx::raster::loadImage(renderData.tilesets[0].imagePath))
+    {
+        success &= verifyTileObjects(renderData, *tilesetImage, filename);
+        success &= verifyLayerOffset(renderData, *tilesetImage, options, filename);
+    }
+    success &= verifyErrors(rasterizer, filename);
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
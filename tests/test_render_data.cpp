@@ -0,0 +1,658 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+bool sameTile(const tmx::render::TileRenderInfo& a, const tmx::render::TileRenderInfo& b)
+{
+    return a.tileId == b.tileId && a.srcX == b.srcX && a.srcY == b.srcY && a.srcW == b.srcW && a.srcH == b.srcH &&
+        a.destX == b.destX && a.destY == b.destY && a.destW == b.destW && a.destH == b.destH &&
+        a.tilesetIndex == b.tilesetIndex && a.opacity == b.opacity && a.isAnimated == b.isAnimated &&
+        a.flipFlags == b.flipFlags && a.animationIndex == b.animationIndex;
+}
+
+// Packed storage must describe exactly the same tiles as full storage
+bool verifyPackedStorage(const tmx::map::Map& map, const tmx::render::MapRenderData& full, const std::string& filename)
+{
+    const auto packed = tmx::render::createRenderData(map, "", {.tileStorage = tmx::render::TileStorage::Packed});
+
+    for (size_t l = 0; l < full.layers.size(); ++l)
+    {
+        const auto& fullLayer = full.layers[l];
+        const auto& packedLayer = packed.layers[l];
+
+        if (!packedLayer.tiles.empty() || packedLayer.packedTiles.size() != fullLayer.tiles.size())
+        {
+            std::cerr << filename << ": ERROR - Layer '" << fullLayer.name << "' packed " << packedLayer.packedTiles.size()
+                << " tiles, expected " << fullLayer.tiles.size() << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < fullLayer.tiles.size(); ++i)
+        {
+            if (!sameTile(packed.unpack(packedLayer.packedTiles[i], packedLayer.opacity), fullLayer.tiles[i]))
+            {
+                std::cerr << filename << ": ERROR - Packed tile " << i << " of layer '" << fullLayer.name
+                    << "' differs" << std::endl;
+                return false;
+            }
+        }
+
+        if (packedLayer.animatedTileIndices != fullLayer.animatedTileIndices ||
+            packedLayer.animatedGroups.size() != fullLayer.animatedGroups.size())
+        {
+            std::cerr << filename << ": ERROR - Animated tile index differs for layer '" << fullLayer.name << "'"
+                << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Indexed storage visited on the fly must yield the same tiles, in the same order, as full storage
+bool verifyIndexedStorage(const tmx::map::Map& map, const tmx::render::MapRenderData& full, const std::string& filename)
+{
+    const auto indexed = tmx::render::createRenderData(map, "", {.tileStorage = tmx::render::TileStorage::Indexed});
+
+    for (size_t l = 0; l < full.layers.size(); ++l)
+    {
+        const auto& fullLayer = full.layers[l];
+        const auto& indexedLayer = indexed.layers[l];
+        if (!indexedLayer.tiles.empty() || !indexedLayer.packedTiles.empty() || indexedLayer.tileBlocks.size() != indexedLayer.chunks.size())
+        {
+            std::cerr << filename << ": ERROR - Layer '" << fullLayer.name << "' is not index-only" << std::endl;
+            return false;
+        }
+
+        size_t visited = 0;
+        bool same = true;
+        indexed.forEachTile(indexedLayer, [&](const tmx::render::TileRenderInfo& tile)
+        {
+            same = same && visited < fullLayer.tiles.size() && sameTile(tile, fullLayer.tiles[visited]);
+            ++visited;
+        });
+
+        if (!same || visited != fullLayer.tiles.size())
+        {
+            std::cerr << filename << ": ERROR - Indexed layer '" << fullLayer.name << "' visited " << visited
+                << " tiles, expected " << fullLayer.tiles.size() << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Flip flags in the GID must not change the resolved tile, only its flip bits
+bool verifyFlipFlags(tmx::map::Map map, const tmx::render::MapRenderData& full, const std::string& filename)
+{
+    // Flip the first non-empty cell of every layer and remember where it is
+    std::vector<std::pair<std::int32_t, std::int32_t>> flippedCells(map.layers.size(), {-1, -1});
+    for (size_t l = 0; l < map.layers.size(); ++l)
+    {
+        auto& layer = map.layers[l];
+        auto& cells = layer.chunks.empty() ? layer.data : layer.chunks.front().data;
+        const std::int32_t originX = layer.chunks.empty() ? 0 : layer.chunks.front().x;
+        const std::int32_t originY = layer.chunks.empty() ? 0 : layer.chunks.front().y;
+        const std::uint32_t width = layer.chunks.empty() ? layer.width : layer.chunks.front().width;
+        for (std::uint32_t i = 0; i < cells.size(); ++i)
+        {
+            if (cells[i] != 0)
+            {
+                cells[i] |= tmx::map::FLIPPED_HORIZONTALLY_FLAG | tmx::map::FLIPPED_DIAGONALLY_FLAG;
+                flippedCells[l] = {originX + static_cast<std::int32_t>(i % width),
+                                   originY + static_cast<std::int32_t>(i / width)};
+                break;
+            }
+        }
+    }
+
+    const auto flipped = tmx::render::createRenderData(map);
+    for (size_t l = 0; l < flipped.layers.size(); ++l)
+    {
+        const auto& tiles = flipped.layers[l].tiles;
+        if (tiles.size() != full.layers[l].tiles.size())
+        {
+            std::cerr << filename << ": ERROR - Flipping changed the tile count of layer '" << flipped.layers[l].name
+                << "'" << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < tiles.size(); ++i)
+        {
+            auto expected = full.layers[l].tiles[i];
+            if (expected.destX == flippedCells[l].first * static_cast<std::int32_t>(full.tileWidth) &&
+                expected.destY == flippedCells[l].second * static_cast<std::int32_t>(full.tileHeight))
+            {
+                expected.flipFlags = tmx::render::TILE_FLIP_HORIZONTAL | tmx::render::TILE_FLIP_DIAGONAL;
+            }
+            if (!sameTile(tiles[i], expected))
+            {
+                std::cerr << filename << ": ERROR - Flipped tile resolved incorrectly in layer '"
+                    << flipped.layers[l].name << "'" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool overlaps(const tmx::render::TileRenderInfo& tile, const tmx::render::ViewRect& view)
+{
+    const auto left = static_cast<float>(tile.destX);
+    const auto top = static_cast<float>(tile.destY);
+    return left < view.x + view.width && view.x < left + static_cast<float>(tile.destW) &&
+        top < view.y + view.height && view.y < top + static_cast<float>(tile.destH);
+}
+
+// Chunks must partition each layer, and a view query must find every tile overlapping the view
+bool verifySpatialChunks(const tmx::map::Map& map, const tmx::render::MapRenderData& full, const std::string& filename)
+{
+    for (const auto& layer : full.layers)
+    {
+        std::uint32_t next = 0;
+        for (size_t c = 0; c < layer.chunks.size(); ++c)
+        {
+            const auto& chunk = layer.chunks[c];
+            if (chunk.first != next || chunk.count == 0 ||
+                (c > 0 && std::pair(layer.chunks[c - 1].chunkY, layer.chunks[c - 1].chunkX) >=
+                          std::pair(chunk.chunkY, chunk.chunkX)))
+            {
+                std::cerr << filename << ": ERROR - Chunks of layer '" << layer.name << "' are not sorted and contiguous"
+                    << std::endl;
+                return false;
+            }
+            for (std::uint32_t i = chunk.first; i < chunk.first + chunk.count; ++i)
+            {
+                const auto& tile = layer.tiles[i];
+                const auto chunkPixelsX = static_cast<std::int32_t>(full.tileWidth * full.chunkSize);
+                const auto chunkPixelsY = static_cast<std::int32_t>(full.tileHeight * full.chunkSize);
+                if (tile.destX < chunk.bounds.minX || tile.destY < chunk.bounds.minY ||
+                    tile.destX + static_cast<std::int32_t>(tile.destW) > chunk.bounds.maxX ||
+                    tile.destY + static_cast<std::int32_t>(tile.destH) > chunk.bounds.maxY ||
+                    tile.destX < chunk.chunkX * chunkPixelsX || tile.destX >= (chunk.chunkX + 1) * chunkPixelsX ||
+                    tile.destY < chunk.chunkY * chunkPixelsY || tile.destY >= (chunk.chunkY + 1) * chunkPixelsY)
+                {
+                    std::cerr << filename << ": ERROR - Tile " << i << " outside its chunk in layer '" << layer.name
+                        << "'" << std::endl;
+                    return false;
+                }
+            }
+            next += chunk.count;
+        }
+        if (next != layer.tiles.size())
+        {
+            std::cerr << filename << ": ERROR - Chunks of layer '" << layer.name << "' cover " << next << " of "
+                << layer.tiles.size() << " tiles" << std::endl;
+            return false;
+        }
+    }
+
+    // Small chunks exercise views spanning many chunks on the small test maps
+    const auto small = tmx::render::createRenderData(map, "", {.chunkSize = 3});
+    const auto indexed = tmx::render::createRenderData(map, "", {.tileStorage = tmx::render::TileStorage::Indexed,
+                                                                 .chunkSize = 3});
+    const std::vector<tmx::render::ViewRect> views = {
+        {0.0f, 0.0f, 64.0f, 48.0f},
+        {-100.0f, -100.0f, 150.5f, 170.25f},
+        {37.0f, 21.0f, 1.0f, 1.0f},
+        {-10000.0f, -10000.0f, 20000.0f, 20000.0f},
+        {5000.0f, 5000.0f, 10.0f, 10.0f},
+    };
+
+    std::vector<tmx::render::ChunkRange> ranges;
+    for (const auto* renderData : {&full, &small, &indexed})
+    {
+        for (const auto& view : views)
+        {
+            renderData->query(view, ranges);
+
+            size_t expected = 0;
+            for (const auto& layer : full.layers)
+            {
+                for (const auto& tile : layer.tiles)
+                {
+                    expected += overlaps(tile, view) ? 1 : 0;
+                }
+            }
+
+            // Chunks may overhang the view, but every overlapping tile must be in a returned chunk
+            size_t found = 0;
+            renderData->forEachTile(ranges, [&](const tmx::render::LayerRenderData&, const tmx::render::TileRenderInfo& tile)
+            {
+                found += overlaps(tile, view) ? 1 : 0;
+            });
+
+            if (found != expected)
+            {
+                std::cerr << filename << ": ERROR - Query at " << view.x << "," << view.y << " found " << found
+                    << " overlapping tiles, expected " << expected << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Layer holding the cells of a tile store, one map chunk per store chunk
+tmx::map::Layer layerOf(const tmx::map::Layer& original, const tmx::map::TileStore& store)
+{
+    tmx::map::Layer layer{};
+    layer.name = original.name;
+    layer.visible = original.visible;
+    layer.opacity = original.opacity;
+    store.forEachChunk([&](std::int32_t chunkX, std::int32_t chunkY, std::span<const std::uint32_t> cells)
+    {
+        tmx::map::Chunk chunk{};
+        chunk.x = chunkX * static_cast<std::int32_t>(store.chunkSize());
+        chunk.y = chunkY * static_cast<std::int32_t>(store.chunkSize());
+        chunk.width = store.chunkSize();
+        chunk.height = store.chunkSize();
+        chunk.data.assign(cells.begin(), cells.end());
+        layer.chunks.push_back(std::move(chunk));
+    });
+    return layer;
+}
+
+bool sameLayer(const tmx::render::MapRenderData& renderData, const tmx::render::LayerRenderData& edited,
+               const tmx::render::LayerRenderData& rebuilt)
+{
+    std::vector<tmx::render::TileRenderInfo> editedTiles, rebuiltTiles;
+    renderData.forEachTile(edited, [&](const tmx::render::TileRenderInfo& tile) { editedTiles.push_back(tile); });
+    renderData.forEachTile(rebuilt, [&](const tmx::render::TileRenderInfo& tile) { rebuiltTiles.push_back(tile); });
+    if (editedTiles.size() != rebuiltTiles.size())
+        return false;
+    for (size_t i = 0; i < editedTiles.size(); ++i)
+    {
+        if (!sameTile(editedTiles[i], rebuiltTiles[i]))
+            return false;
+    }
+
+    if (edited.bounds.minX != rebuilt.bounds.minX || edited.bounds.minY != rebuilt.bounds.minY ||
+        edited.bounds.maxX != rebuilt.bounds.maxX || edited.bounds.maxY != rebuilt.bounds.maxY ||
+        edited.animatedTileIndices != rebuilt.animatedTileIndices ||
+        edited.animatedGroups.size() != rebuilt.animatedGroups.size())
+        return false;
+    for (size_t g = 0; g < edited.animatedGroups.size(); ++g)
+    {
+        const auto& a = edited.animatedGroups[g];
+        const auto& b = rebuilt.animatedGroups[g];
+        if (a.animation.tilesetIndex != b.animation.tilesetIndex ||
+            a.animation.animationIndex != b.animation.animationIndex || a.first != b.first || a.count != b.count)
+            return false;
+    }
+
+    // Indexed layers keep the chunks of cleared blocks; every other chunk must match a fresh build
+    std::vector<tmx::render::SpatialChunk> chunks;
+    std::ranges::copy_if(edited.chunks, std::back_inserter(chunks),
+                         [](const tmx::render::SpatialChunk& chunk) { return !chunk.bounds.isEmpty(); });
+    if (chunks.size() != rebuilt.chunks.size())
+        return false;
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+        const auto& a = chunks[c];
+        const auto& b = rebuilt.chunks[c];
+        const bool sameRun = edited.storage == tmx::render::TileStorage::Indexed || (a.first == b.first && a.count == b.count);
+        if (a.chunkX != b.chunkX || a.chunkY != b.chunkY || !sameRun || a.bounds.minX != b.bounds.minX ||
+            a.bounds.minY != b.bounds.minY || a.bounds.maxX != b.bounds.maxX || a.bounds.maxY != b.bounds.maxY)
+            return false;
+    }
+    return true;
+}
+
+// Edits in place must leave every layer exactly as rebuilding it from the edited cells would
+bool verifyEdits(const tmx::map::Map& map, const std::string& filename)
+{
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                               tmx::render::TileStorage::Indexed})
+    {
+        auto renderData = tmx::render::createRenderData(map, "", {.tileStorage = storage, .chunkSize = 4});
+        const auto gidCount = static_cast<std::uint32_t>(renderData.gidTable.size());
+
+        std::mt19937 rng(static_cast<std::uint32_t>(storage) + 1);
+        for (std::uint32_t l = 0; l < map.layers.size(); ++l)
+        {
+            auto store = tmx::map::TileStore::fromLayer(map.layers[l]);
+            const auto extent = store.bounds();
+            std::uniform_int_distribution<std::int32_t> column(extent.minX - 6, extent.maxX + 6);
+            std::uniform_int_distribution<std::int32_t> row(extent.minY - 6, extent.maxY + 6);
+            std::uniform_int_distribution<std::uint32_t> gid(0, gidCount + 2);
+            std::uniform_int_distribution<std::uint32_t> size(1, 9);
+
+            renderData.dirtyRegions.clear();
+            for (int edit = 0; edit < 300; ++edit)
+            {
+                const std::int32_t x = column(rng), y = row(rng);
+                std::uint32_t value = edit % 3 == 0 ? 0 : gid(rng);
+                if (value != 0 && edit % 5 == 0)
+                    value |= tmx::map::FLIPPED_HORIZONTALLY_FLAG;
+                const std::uint32_t width = edit % 4 == 0 ? size(rng) : 1;
+                const std::uint32_t height = edit % 4 == 0 ? size(rng) : 1;
+
+                if (width == 1 && height == 1)
+                    renderData.setTile(l, x, y, value);
+                else
+                    renderData.fillRect(l, x, y, width, height, value);
+
+                for (std::int32_t cy = y; cy < y + static_cast<std::int32_t>(height); ++cy)
+                {
+                    for (std::int32_t cx = x; cx < x + static_cast<std::int32_t>(width); ++cx)
+                    {
+                        if (map.infinite || (cx >= 0 && cy >= 0 && cx < static_cast<std::int32_t>(map.width) &&
+                                             cy < static_cast<std::int32_t>(map.height)))
+                        {
+                            store.setTile(cx, cy, value);
+                        }
+                    }
+                }
+            }
+
+            if (!sameLayer(renderData, renderData.layers[l], renderData.buildLayer(layerOf(map.layers[l], store),
+                                                                                   {.tileStorage = storage})))
+            {
+                std::cerr << filename << ": ERROR - Edited layer '" << map.layers[l].name
+                    << "' differs from a rebuild (storage " << static_cast<int>(storage) << ")" << std::endl;
+                return false;
+            }
+
+            // Every chunk now holding tiles that differ from the original must be reported dirty
+            const auto original = tmx::map::TileStore::fromLayer(map.layers[l]);
+            bool reported = true;
+            store.forEachChunk([&](std::int32_t chunkX, std::int32_t chunkY, std::span<const std::uint32_t> cells)
+            {
+                for (std::uint32_t i = 0; i < cells.size(); ++i)
+                {
+                    const std::int32_t x = chunkX * static_cast<std::int32_t>(store.chunkSize()) +
+                        static_cast<std::int32_t>(i % store.chunkSize());
+                    const std::int32_t y = chunkY * static_cast<std::int32_t>(store.chunkSize()) +
+                        static_cast<std::int32_t>(i / store.chunkSize());
+                    if (cells[i] == original.tileAt(x, y))
+                        continue;
+                    const tmx::render::ViewRect cell{static_cast<float>(x) * static_cast<float>(renderData.tileWidth),
+                                                     static_cast<float>(y) * static_cast<float>(renderData.tileHeight),
+                                                     1.0f, 1.0f};
+                    reported = reported && std::ranges::any_of(renderData.dirtyRegions,
+                                                               [&](const tmx::render::DirtyRegion& region)
+                    {
+                        return region.layerIndex == l && region.bounds.intersects(cell);
+                    });
+                }
+            });
+            if (!reported)
+            {
+                std::cerr << filename << ": ERROR - Edited cells of layer '" << map.layers[l].name
+                    << "' missing from the dirty regions" << std::endl;
+                return false;
+            }
+        }
+
+        if (renderData.setTile(static_cast<std::uint32_t>(renderData.layers.size()), 0, 0, 1) ||
+            (!map.infinite && renderData.fillRect(0, -10, -10, 5, 5, 1)))
+        {
+            std::cerr << filename << ": ERROR - Edit outside the map accepted" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameBounds(const tmx::render::RenderBounds& a, const tmx::render::RenderBounds& b)
+{
+    return a.minX == b.minX && a.minY == b.minY && a.maxX == b.maxX && a.maxY == b.maxY;
+}
+
+bool identicalLayers(const tmx::render::LayerRenderData& a, const tmx::render::LayerRenderData& b)
+{
+    if (a.tiles.size() != b.tiles.size() || a.packedTiles.size() != b.packedTiles.size() || a.gids != b.gids ||
+        a.tileBlocks.size() != b.tileBlocks.size() || a.chunks.size() != b.chunks.size() ||
+        !sameBounds(a.bounds, b.bounds) || a.animatedTileIndices != b.animatedTileIndices ||
+        a.animatedGroups.size() != b.animatedGroups.size())
+        return false;
+
+    for (size_t i = 0; i < a.tiles.size(); ++i)
+    {
+        if (!sameTile(a.tiles[i], b.tiles[i]))
+            return false;
+    }
+    for (size_t i = 0; i < a.packedTiles.size(); ++i)
+    {
+        const auto& x = a.packedTiles[i];
+        const auto& y = b.packedTiles[i];
+        if (x.destX != y.destX || x.destY != y.destY || x.tileIdAndFlags != y.tileIdAndFlags ||
+            x.tilesetIndex != y.tilesetIndex || x.animationIndex != y.animationIndex)
+            return false;
+    }
+    for (size_t i = 0; i < a.tileBlocks.size(); ++i)
+    {
+        const auto& x = a.tileBlocks[i];
+        const auto& y = b.tileBlocks[i];
+        if (x.x != y.x || x.y != y.y || x.width != y.width || x.height != y.height || x.offset != y.offset)
+            return false;
+    }
+    for (size_t i = 0; i < a.chunks.size(); ++i)
+    {
+        const auto& x = a.chunks[i];
+        const auto& y = b.chunks[i];
+        if (x.chunkX != y.chunkX || x.chunkY != y.chunkY || x.first != y.first || x.count != y.count ||
+            !sameBounds(x.bounds, y.bounds))
+            return false;
+    }
+    for (size_t g = 0; g < a.animatedGroups.size(); ++g)
+    {
+        const auto& x = a.animatedGroups[g];
+        const auto& y = b.animatedGroups[g];
+        if (x.animation.tilesetIndex != y.animation.tilesetIndex ||
+            x.animation.animationIndex != y.animation.animationIndex || x.first != y.first || x.count != y.count)
+            return false;
+    }
+    return true;
+}
+
+// Parallel builds must be identical to the serial build, whatever the thread count
+bool verifyParallelBuild(const tmx::map::Map& map, const std::string& filename)
+{
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                               tmx::render::TileStorage::Indexed})
+    {
+        for (const std::uint32_t chunkSize : {3u, tmx::render::DEFAULT_CHUNK_SIZE})
+        {
+            const auto serial = tmx::render::createRenderData(map, "", {.tileStorage = storage, .chunkSize = chunkSize});
+            for (const std::uint32_t threadCount : {0u, 2u, 5u, 64u})
+            {
+                const auto parallel = tmx::render::createRenderData(
+                    map, "", {.tileStorage = storage, .chunkSize = chunkSize, .threadCount = threadCount});
+                for (size_t l = 0; l < serial.layers.size(); ++l)
+                {
+                    if (!identicalLayers(serial.layers[l], parallel.layers[l]))
+                    {
+                        std::cerr << filename << ": ERROR - Layer '" << serial.layers[l].name << "' built with "
+                            << threadCount << " threads differs from the serial build" << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    // A finite layer rewritten as chunks takes the bucketing path and must come out the same
+    for (const auto& layer : map.layers)
+    {
+        if (!layer.chunks.empty())
+            continue;
+
+        const auto renderData = tmx::render::createRenderData(map, "", {.chunkSize = 3});
+        auto chunked = layer;
+        chunked.chunks.push_back({0, 0, layer.width, layer.height, layer.data});
+        chunked.data.clear();
+        const auto* finite = &renderData.layers[static_cast<size_t>(&layer - map.layers.data())];
+        if (!identicalLayers(*finite, renderData.buildLayer(chunked)))
+        {
+            std::cerr << filename << ": ERROR - Finite layer '" << layer.name << "' differs from its chunked form"
+                << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Tilesets drawing the same image with the same grid share one render tileset without changing any tile
+bool verifyDuplicateTilesets(tmx::map::Map map, const std::string& filename)
+{
+    if (map.tilesets.empty())
+        return true;
+
+    // Declare the first tileset once more and move the first layer's tiles of it over to the copy
+    const auto& first = map.tilesets.front();
+    const auto& last = map.tilesets.back();
+    auto copy = first;
+    copy.name = first.name + " (copy)";
+    copy.firstgid = last.firstgid + last.tilecount;
+    const std::uint32_t firstEnd = map.tilesets.size() > 1 ? map.tilesets[1].firstgid : first.firstgid + first.tilecount;
+    auto retarget = [&](std::vector<std::uint32_t>& cells)
+    {
+        for (auto& cell : cells)
+        {
+            const std::uint32_t gid = cell & tmx::map::GID_MASK;
+            if (gid >= first.firstgid && gid < firstEnd)
+                cell = (gid - first.firstgid + copy.firstgid) | (cell & tmx::map::GID_FLAGS_MASK);
+        }
+    };
+    if (!map.layers.empty())
+    {
+        retarget(map.layers[0].data);
+        for (auto& chunk : map.layers[0].chunks)
+            retarget(chunk.data);
+    }
+    map.tilesets.push_back(copy);
+
+    std::set<std::tuple<std::string, std::uint32_t, std::uint32_t, std::uint32_t>> distinct;
+    for (const auto& tileset : map.tilesets)
+        distinct.emplace(tileset.image, tileset.tilewidth, tileset.tileheight, tileset.columns);
+
+    const auto merged = tmx::render::createRenderData(map);
+    const auto separate = tmx::render::createRenderData(map, "", {.mergeDuplicateTilesets = false});
+    const auto hashed = tmx::render::createRenderData(map, std::filesystem::path(filename).parent_path().string(),
+                                                      {.hashTilesetImages = true});
+    if (merged.tilesets.size() != distinct.size() || separate.tilesets.size() != map.tilesets.size() ||
+        hashed.tilesets.size() != distinct.size() ||
+        merged.tilesets[0].animations.size() != separate.tilesets[0].animations.size())
+    {
+        std::cerr << filename << ": ERROR - " << map.tilesets.size() << " tilesets with " << distinct.size()
+            << " distinct images were merged into " << merged.tilesets.size() << std::endl;
+        return false;
+    }
+
+    auto sameFrames = [&](const tmx::render::TileRenderInfo& a, const tmx::render::TileRenderInfo& b)
+    {
+        const auto& x = merged.tilesets[a.tilesetIndex].animations[a.animationIndex].frames;
+        const auto& y = separate.tilesets[b.tilesetIndex].animations[b.animationIndex].frames;
+        return std::ranges::equal(x, y, [](const auto& f, const auto& g)
+        {
+            return f.tileId == g.tileId && f.duration == g.duration && f.srcX == g.srcX && f.srcY == g.srcY;
+        });
+    };
+    for (size_t l = 0; l < merged.layers.size(); ++l)
+    {
+        std::vector<tmx::render::TileRenderInfo> a, b;
+        merged.forEachTile(merged.layers[l], [&](const tmx::render::TileRenderInfo& tile) { a.push_back(tile); });
+        separate.forEachTile(separate.layers[l], [&](const tmx::render::TileRenderInfo& tile) { b.push_back(tile); });
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            auto expected = b[i];
+            expected.tilesetIndex = a[i].tilesetIndex;
+            expected.animationIndex = a[i].animationIndex;
+            if (!sameTile(a[i], expected) ||
+                merged.tilesets[a[i].tilesetIndex].imagePath != separate.tilesets[b[i].tilesetIndex].imagePath ||
+                (a[i].isAnimated && !sameFrames(a[i], b[i])))
+            {
+                std::cerr << filename << ": ERROR - Merging tilesets changed a tile of layer '" << merged.layers[l].name
+                    << "'" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// An image-collection tileset (columns="0") must not break the GID table, placed or not
+bool verifyImageCollection(tmx::map::Map map, const std::string& filename)
+{
+    const std::uint32_t firstgid = map.tilesets.empty()
+                                       ? 1
+                                       : map.tilesets.back().firstgid + map.tilesets.back().tilecount;
+    tmx::map::Tileset collection{};
+    collection.firstgid = firstgid;
+    collection.name = "image collection";
+    collection.tilewidth = map.tilewidth;
+    collection.tileheight = map.tileheight;
+    collection.tilecount = 4;
+    collection.columns = 0;
+    map.tilesets.push_back(collection);
+    if (!map.layers.empty() && !map.layers[0].data.empty())
+        map.layers[0].data[0] = firstgid + 3;
+
+    for (const auto storage : {tmx::render::TileStorage::Full, tmx::render::TileStorage::Packed,
+                               tmx::render::TileStorage::Indexed})
+    {
+        const auto renderData = tmx::render::createRenderData(map, "", {.tileStorage = storage});
+        const auto* info = renderData.gidInfo(firstgid + 3);
+        if (!info || info->tileId != 3 || info->srcX != 0 || info->srcY != 0)
+        {
+            std::cerr << filename << ": ERROR - Image-collection tile has no source rectangle" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing render data: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    const auto& map = *result;
+    const auto renderData = tmx::render::createRenderData(map);
+
+    bool success = true;
+    success &= verifyPackedStorage(map, renderData, filename);
+    success &= verifyIndexedStorage(map, renderData, filename);
+    success &= verifyFlipFlags(map, renderData, filename);
+    success &= verifySpatialChunks(map, renderData, filename);
+    success &= verifyEdits(map, filename);
+    success &= verifyParallelBuild(map, filename);
+    success &= verifyDuplicateTilesets(map, filename);
+    success &= verifyImageCollection(map, filename);
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
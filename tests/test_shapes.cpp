@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+using tmx::map::Point;
+
+constexpr float EPSILON = 1e-3f;
+
+bool near(const float a, const float b, const float tolerance = EPSILON)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0f, std::abs(b));
+}
+
+// Twice the signed area of an outline, positive when clockwise on screen (y down)
+auto signedArea(std::span<const Point> outline) -> double
+{
+    double area = 0.0;
+    for (std::size_t i = 0, j = outline.size() - 1; i < outline.size(); j = i++)
+        area += static_cast<double>(outline[j].x) * outline[i].y - static_cast<double>(outline[i].x) * outline[j].y;
+    return area;
+}
+
+auto inside(std::span<const Point> outline, const double x, const double y) -> bool
+{
+    bool result = false;
+    for (std::size_t i = 0, j = outline.size() - 1; i < outline.size(); j = i++)
+    {
+        const auto& a = outline[i];
+        const auto& b = outline[j];
+        if ((a.y > y) != (b.y > y) && x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)
+            result = !result;
+    }
+    return result;
+}
+
+// Valid lists are parsed exactly; invalid ones are reported and leave the pool as it was
+bool verifyParsePoints()
+{
+    bool success = true;
+    std::vector<Point> pool = {{-1, -1}};
+    const auto parsed = tmx::Parser::parsePoints(" 0,0 1.5,-2\n\t3e1,4  ", pool);
+    if (!parsed || *parsed != 3 || pool.size() != 4 || pool[2].x != 1.5f || pool[2].y != -2.0f ||
+        pool[3].x != 30.0f || pool[3].y != 4.0f)
+    {
+        std::cerr << "ERROR - Valid point list was not parsed as expected" << std::endl;
+        success = false;
+    }
+
+    const auto empty = tmx::Parser::parsePoints("  ", pool);
+    if (!empty || *empty != 0 || pool.size() != 4)
+    {
+        std::cerr << "ERROR - Empty point list should add no points" << std::endl;
+        success = false;
+    }
+
+    for (const char* text : {"1,2 3", "1;2", "1,2,3", "1,2x 3,4", "a,b", "1, 2", "4,5 ,6"})
+    {
+        if (tmx::Parser::parsePoints(text, pool) || pool.size() != 4)
+        {
+            std::cerr << "ERROR - Invalid point list \"" << text << "\" was accepted or changed the pool" << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+// Polygon and polyline objects land in the shared pool, and render data measures and triangulates them
+bool verifyMapShapes()
+{
+    const std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" renderorder="right-down" width="4" height="4" tilewidth="16" tileheight="16" infinite="0" nextlayerid="2" nextobjectid="5">
+ <objectgroup id="1" name="shapes">
+  <object id="1" x="10" y="20"><polygon points="0,0 40,0 40,30 20,10 0,30"/></object>
+  <object id="2" x="100" y="50" rotation="90"><polyline points="0,0 10,0 10,10"/></object>
+  <object id="3" x="5" y="5" width="8" height="8"/>
+  <object id="4" x="0" y="0"><polygon points="0,0 10,0 10,10 0,10"/></object>
+ </objectgroup>
+</map>)";
+
+    auto result = tmx::Parser::parseFromString(xml);
+    if (!result)
+    {
+        std::cerr << "ERROR - Inline map failed to parse: " << result.error() << std::endl;
+        return false;
+    }
+    const auto& map = *result;
+    const auto& objects = map.objectgroups.at(0).objects;
+    bool success = true;
+    if (map.points.size() != 12 || objects[0].pointCount != 5 || objects[1].firstPoint != 5 ||
+        objects[1].pointCount != 3 || objects[2].pointCount != 0 || map.objectPoints(objects[3])[2].x != 10.0f)
+    {
+        std::cerr << "ERROR - Object points were not pooled in document order" << std::endl;
+        success = false;
+    }
+    if (objects[0].shape != tmx::map::ObjectShape::Polygon || objects[1].shape != tmx::map::ObjectShape::Polyline)
+    {
+        std::cerr << "ERROR - Polygon and polyline shapes were mixed up" << std::endl;
+        success = false;
+    }
+
+    const auto bad = tmx::Parser::parseFromString(
+        std::string(xml).replace(xml.find("10,0 10,10\""), 10, "10,0 10;10"));
+    if (bad)
+    {
+        std::cerr << "ERROR - Malformed polyline was accepted" << std::endl;
+        success = false;
+    }
+
+    const auto renderData = tmx::render::createRenderData(map);
+    const auto& rendered = renderData.objectGroups.at(0).objects;
+    for (const auto& object : rendered)
+    {
+        const auto bounds = tmx::render::objectBounds(object, renderData.objectPoints(object));
+        if (bounds.minX != object.bounds.minX || bounds.minY != object.bounds.minY ||
+            bounds.maxX != object.bounds.maxX || bounds.maxY != object.bounds.maxY)
+        {
+            std::cerr << "ERROR - Precomputed bounds of object " << object.id << " are out of date" << std::endl;
+            success = false;
+        }
+    }
+
+    if (rendered[0].triangleCount != 3 || renderData.objectTriangles(rendered[3]).size() != 2 ||
+        rendered[1].triangleCount != 0)
+    {
+        std::cerr << "ERROR - Polygons were not triangulated once each" << std::endl;
+        success = false;
+    }
+    if (!near(rendered[1].length, 20.0f) || !near(rendered[3].length, 40.0f))
+    {
+        std::cerr << "ERROR - Path lengths are " << rendered[1].length << " and " << rendered[3].length << std::endl;
+        success = false;
+    }
+
+    // Polylines clamp, polygons wrap, and the rotation is applied about the object's position
+    struct Case
+    {
+        std::size_t object;
+        float distance;
+        Point expected;
+    };
+    const std::vector<Case> cases = {
+        {1, 0.0f, {100, 50}},  {1, 15.0f, {95, 60}},  {1, -5.0f, {100, 50}}, {1, 50.0f, {90, 60}},
+        {3, 45.0f, {5, 0}},    {3, -5.0f, {0, 5}},    {3, 25.0f, {5, 10}},   {0, 40.0f, {50, 20}},
+    };
+    for (const auto& [index, distance, expected] : cases)
+    {
+        const auto point = renderData.pointAlongPath(rendered[index], distance);
+        if (!near(point.x, expected.x) || !near(point.y, expected.y))
+        {
+            std::cerr << "ERROR - Point at " << distance << " along object " << rendered[index].id << " is ("
+                << point.x << ", " << point.y << "), expected (" << expected.x << ", " << expected.y << ")"
+                << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+// Triangles cover the outline exactly: same total area, same winding, all inside it
+bool verifyTriangulation(std::span<const Point> outline, const std::string& label, const bool simple = true)
+{
+    std::vector<tmx::render::ShapeTriangle> triangles = {{9, 9, 9}};
+    const auto count = tmx::render::triangulatePolygon(outline, triangles);
+    if (triangles.size() != count + 1 || count > outline.size() - 2)
+    {
+        std::cerr << label << ": ERROR - " << count << " triangles for " << outline.size() << " points" << std::endl;
+        return false;
+    }
+
+    const double area = signedArea(outline);
+    double total = 0.0;
+    for (std::size_t i = 1; i < triangles.size(); ++i)
+    {
+        const auto& [a, b, c] = triangles[i];
+        if (a >= outline.size() || b >= outline.size() || c >= outline.size())
+        {
+            std::cerr << label << ": ERROR - Triangle index out of range" << std::endl;
+            return false;
+        }
+        const Point corners[] = {outline[a], outline[b], outline[c]};
+        const double triangleArea = signedArea(corners);
+        if (triangleArea * area < 0.0)
+        {
+            std::cerr << label << ": ERROR - Triangle " << i - 1 << " has the wrong winding" << std::endl;
+            return false;
+        }
+        const double cx = (corners[0].x + corners[1].x + corners[2].x) / 3.0;
+        const double cy = (corners[0].y + corners[1].y + corners[2].y) / 3.0;
+        if (simple && std::abs(triangleArea) > 1e-6 && !inside(outline, cx, cy))
+        {
+            std::cerr << label << ": ERROR - Triangle " << i - 1 << " lies outside the outline" << std::endl;
+            return false;
+        }
+        total += triangleArea;
+    }
+    if (simple && std::abs(total - area) > 1e-4 * std::max(1.0, std::abs(area)))
+    {
+        std::cerr << label << ": ERROR - Triangles cover " << total / 2 << " instead of " << area / 2 << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool verifyTriangulations()
+{
+    bool success = true;
+    const std::vector<Point> square = {{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+    const std::vector<Point> collinear = {{0, 0}, {5, 0}, {10, 0}, {10, 10}, {0, 10}};
+    const std::vector<Point> comb = {{0, 0}, {30, 0}, {30, 20}, {25, 5}, {20, 20}, {15, 5}, {10, 20}, {5, 5}, {0, 20}};
+    const std::vector<Point> bowtie = {{0, 0}, {10, 10}, {10, 0}, {0, 10}};
+    success &= verifyTriangulation(square, "square");
+    success &= verifyTriangulation(collinear, "collinear");
+    success &= verifyTriangulation(comb, "comb");
+    success &= verifyTriangulation(std::vector<Point>(comb.rbegin(), comb.rend()), "reversed comb");
+    success &= verifyTriangulation(bowtie, "bowtie", false);
+    success &= verifyTriangulation(std::vector<Point>{{0, 0}, {1, 1}}, "degenerate");
+
+    // Random star-shaped outlines, deeply concave, in both windings
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> radius(5.0f, 100.0f);
+    std::uniform_real_distribution<float> jitter(0.1f, 0.9f);
+    for (int polygon = 0; polygon < 200; ++polygon)
+    {
+        const std::size_t count = 3 + rng() % 40;
+        std::vector<Point> outline;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double angle = (static_cast<double>(i) + jitter(rng)) * 2.0 * std::numbers::pi / count;
+            const float r = radius(rng);
+            outline.push_back({static_cast<float>(r * std::cos(angle)), static_cast<float>(r * std::sin(angle))});
+        }
+        if (polygon % 2 == 1)
+            std::reverse(outline.begin(), outline.end());
+        const std::string label = "star " + std::to_string(polygon);
+        success &= verifyTriangulation(outline, label);
+
+        std::vector<tmx::render::ShapeTriangle> triangles;
+        if (tmx::render::triangulatePolygon(outline, triangles) != count - 2)
+        {
+            std::cerr << label << ": ERROR - Expected " << count - 2 << " triangles" << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing object shapes: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Every object of the file references a valid range of the pool and gets bounds matching objectBounds
+    const auto& map = *result;
+    const auto renderData = tmx::render::createRenderData(map);
+    bool success = renderData.points.size() == map.points.size() &&
+        renderData.pointDistances.size() == renderData.points.size();
+    for (const auto& group : renderData.objectGroups)
+    {
+        for (const auto& object : group.objects)
+        {
+            const auto bounds = tmx::render::objectBounds(object, renderData.objectPoints(object));
+            if (renderData.objectPoints(object).size() != object.pointCount || bounds.minX != object.bounds.minX ||
+                bounds.maxY != object.bounds.maxY)
+            {
+                std::cerr << filename << ": ERROR - Object " << object.id << " has stale shape data" << std::endl;
+                success = false;
+            }
+        }
+    }
+
+    success &= verifyParsePoints();
+    success &= verifyMapShapes();
+    success &= verifyTriangulations();
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
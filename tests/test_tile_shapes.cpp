@@ -0,0 +1,193 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tmx/tmx.hpp>
+
+constexpr std::uint32_t LAYER_SIZE = 100; // Cells per side of the synthetic layer
+
+// Tiles 5 and 2 have shapes, out of ID order; tile 3 has only a property
+const std::string TILES = R"(
+  <tile id="5">
+   <objectgroup draworder="index" id="2">
+    <object id="1" x="2" y="4"><polygon points="0,0 12,0 12,8 6,5 0,8"/></object>
+    <object id="2" x="0" y="10" width="16" height="6"><ellipse/></object>
+   </objectgroup>
+  </tile>
+  <tile id="3">
+   <properties><property name="solid" type="bool" value="true"/></properties>
+  </tile>
+  <tile id="2">
+   <objectgroup draworder="index" id="2">
+    <object id="1" x="0" y="0" width="16" height="8"/>
+   </objectgroup>
+  </tile>
+)";
+
+// A map whose single layer repeats the tiles with shapes across LAYER_SIZE x LAYER_SIZE cells
+auto makeMap(const std::string& tileset) -> std::string
+{
+    std::string csv;
+    for (std::uint32_t i = 0; i < LAYER_SIZE * LAYER_SIZE; ++i)
+    {
+        static constexpr std::uint32_t GIDS[] = {0, 3, 6, 0x80000006, 4, 1};
+        csv += std::to_string(GIDS[i % 6]) + (i + 1 < LAYER_SIZE * LAYER_SIZE ? "," : "");
+    }
+    const std::string size = std::to_string(LAYER_SIZE);
+    return R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" renderorder="right-down" width=")" + size + R"(" height=")" + size +
+        R"(" tilewidth="16" tileheight="16" infinite="0" nextlayerid="2" nextobjectid="1">
+)" + tileset + R"(
+ <layer id="1" name="ground" width=")" + size + R"(" height=")" + size + R"(">
+  <data encoding="csv">)" + csv + R"(</data>
+ </layer>
+</map>)";
+}
+
+bool verifyShapes(const tmx::map::Map& map, const std::string& label)
+{
+    const auto& tileset = map.tilesets.at(0);
+    const auto tile2 = map.tileShapes(3);
+    const auto tile5 = map.tileShapes(6 | tmx::map::FLIPPED_HORIZONTALLY_FLAG);
+    if (tile2.size() != 1 || tile5.size() != 2 || !map.tileShapes(4).empty() || !map.tileShapes(1).empty() ||
+        !map.tileShapes(0).empty() || !map.tileShapes(500).empty() || tileset.shapes.size() != 3)
+    {
+        std::cerr << label << ": ERROR - Shapes were not indexed by local tile ID" << std::endl;
+        return false;
+    }
+    if (tile2[0].shape != tmx::map::ObjectShape::Rectangle || tile2[0].width != 16.0f ||
+        tile5[0].shape != tmx::map::ObjectShape::Polygon || tile5[1].shape != tmx::map::ObjectShape::Ellipse ||
+        tileset.shapePointsOf(tile5[0]).size() != 5 || tileset.shapePointsOf(tile5[0])[3].x != 6.0f)
+    {
+        std::cerr << label << ": ERROR - Shape fields were not parsed" << std::endl;
+        return false;
+    }
+    if (!map.points.empty())
+    {
+        std::cerr << label << ": ERROR - Tile shape points leaked into the map's object point pool" << std::endl;
+        return false;
+    }
+
+    // Ten thousand cells share the shapes of their GIDs instead of copying them
+    const auto renderData = tmx::render::createRenderData(map);
+    if (renderData.tileShapes.size() != 3 || renderData.points.size() != 5)
+    {
+        std::cerr << label << ": ERROR - Render data holds " << renderData.tileShapes.size() << " shapes and "
+            << renderData.points.size() << " points instead of 3 and 5" << std::endl;
+        return false;
+    }
+    const auto shapes = renderData.gidShapes(6);
+    if (shapes.size() != 2 || renderData.gidShapes(0x80000006).data() != shapes.data() ||
+        renderData.gidShapes(3).size() != 1 || !renderData.gidShapes(4).empty() || !renderData.gidShapes(9999).empty())
+    {
+        std::cerr << label << ": ERROR - GID shape lookups are not shared" << std::endl;
+        return false;
+    }
+    const auto& polygon = shapes[0];
+    const auto bounds = tmx::render::objectBounds(polygon, renderData.objectPoints(polygon));
+    if (polygon.triangleCount != 3 || renderData.objectTriangles(polygon).size() != 3 || bounds.minX != 2.0f ||
+        bounds.maxY != 12.0f || polygon.bounds.maxX != bounds.maxX || polygon.length <= 0.0f)
+    {
+        std::cerr << label << ": ERROR - Tile shapes were not measured and triangulated" << std::endl;
+        return false;
+    }
+
+    // Collision: shapes make tiles solid only when asked to
+    const auto withShapes =
+        tmx::map::bakeCollision(map, tmx::map::CollisionOptions{.solidProperty = "", .solidShapes = true});
+    const auto withProperty = tmx::map::bakeCollision(map, tmx::map::CollisionOptions{});
+    std::size_t shaped = 0, marked = 0; // Cells showing GIDs 3 and 6, and GID 4 (the solid property)
+    for (std::size_t i = 0; i < LAYER_SIZE * LAYER_SIZE; ++i)
+    {
+        shaped += i % 6 >= 1 && i % 6 <= 3 ? 1 : 0;
+        marked += i % 6 == 4 ? 1 : 0;
+    }
+    if (withShapes.solidTileCount != shaped || withProperty.solidTileCount != marked)
+    {
+        std::cerr << label << ": ERROR - " << withShapes.solidTileCount << " cells solid from shapes (expected "
+            << shaped << "), " << withProperty.solidTileCount << " from the property" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing tile collision shapes: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    // Tilesets of the file without per-tile object groups have no shapes
+    bool success = true;
+    const auto renderData = tmx::render::createRenderData(*result);
+    for (const auto& tileset : result->tilesets)
+    {
+        if (!tileset.shapes.empty() || !tileset.shapeOffsets.empty() || !renderData.tileShapes.empty())
+        {
+            std::cerr << filename << ": ERROR - Tileset " << tileset.name << " has unexpected shapes" << std::endl;
+            success = false;
+        }
+    }
+
+    // Inline tileset
+    const std::string inlineTileset =
+        R"(<tileset firstgid="1" name="shapes" tilewidth="16" tileheight="16" tilecount="8" columns="4">)" + TILES +
+        "</tileset>";
+    auto inlineMap = tmx::Parser::parseFromString(makeMap(inlineTileset));
+    if (!inlineMap)
+    {
+        std::cerr << "inline: ERROR - Parse error: " << inlineMap.error() << std::endl;
+        return 1;
+    }
+    success &= verifyShapes(*inlineMap, "inline");
+
+    // External .tsx tileset, as Tiled writes it
+    const auto directory = std::filesystem::temp_directory_path() / "tmx_test_tile_shapes";
+    std::filesystem::create_directories(directory);
+    {
+        std::ofstream tsx(directory / "shapes.tsx");
+        tsx << R"(<?xml version="1.0" encoding="UTF-8"?>
+<tileset version="1.10" name="shapes" tilewidth="16" tileheight="16" tilecount="8" columns="4">)" << TILES
+            << "</tileset>\n";
+    }
+    auto externalMap = tmx::Parser::parseFromString(makeMap(R"(<tileset firstgid="1" source="shapes.tsx"/>)"),
+                                                    directory);
+    if (!externalMap)
+    {
+        std::cerr << "external: ERROR - Parse error: " << externalMap.error() << std::endl;
+        return 1;
+    }
+    success &= verifyShapes(*externalMap, "external");
+
+    // A malformed shape names its tile
+    std::string broken = inlineTileset;
+    broken.replace(broken.find("12,8 6,5"), 8, "12,8 6;5");
+    const auto brokenMap = tmx::Parser::parseFromString(makeMap(broken));
+    if (brokenMap || brokenMap.error().find("Tile 5") == std::string::npos)
+    {
+        std::cerr << "broken: ERROR - Malformed tile shape was not reported" << std::endl;
+        success = false;
+    }
+    std::filesystem::remove_all(directory);
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}
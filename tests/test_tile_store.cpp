@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <tmx/tmx.hpp>
+
+// Every cell of the layer's data or chunks must be found at its position, and nothing outside them
+bool verifyLayer(const tmx::map::Layer& layer, const tmx::map::TileStore& store, const std::string& filename)
+{
+    std::int32_t minX = 0, minY = 0, maxX = static_cast<std::int32_t>(layer.width);
+    std::int32_t maxY = static_cast<std::int32_t>(layer.height);
+    std::size_t nonEmpty = 0;
+
+    auto check = [&](std::int32_t originX, std::int32_t originY, std::uint32_t width, const std::vector<std::uint32_t>& cells)
+    {
+        for (std::size_t i = 0; i < cells.size(); ++i)
+        {
+            const std::int32_t x = originX + static_cast<std::int32_t>(i % width);
+            const std::int32_t y = originY + static_cast<std::int32_t>(i / width);
+            nonEmpty += cells[i] != 0 ? 1 : 0;
+            if (store.tileAt(x, y) != cells[i])
+            {
+                std::cerr << filename << ": ERROR - Layer '" << layer.name << "' cell " << x << "," << y << " is "
+                    << store.tileAt(x, y) << ", expected " << cells[i] << std::endl;
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (layer.chunks.empty() && !check(0, 0, layer.width, layer.data))
+        return false;
+    for (const auto& chunk : layer.chunks)
+    {
+        if (!check(chunk.x, chunk.y, chunk.width, chunk.data))
+            return false;
+        minX = std::min(minX, chunk.x);
+        minY = std::min(minY, chunk.y);
+        maxX = std::max(maxX, chunk.x + static_cast<std::int32_t>(chunk.width));
+        maxY = std::max(maxY, chunk.y + static_cast<std::int32_t>(chunk.height));
+    }
+
+    // Cells around the layer are empty, and the bounds lie within the layer
+    const auto& bounds = store.bounds();
+    if (nonEmpty > 0 && (bounds.minX < minX || bounds.minY < minY || bounds.maxX > maxX || bounds.maxY > maxY))
+    {
+        std::cerr << filename << ": ERROR - Bounds of layer '" << layer.name << "' exceed the layer" << std::endl;
+        return false;
+    }
+    for (std::int32_t x = minX - 40; x < maxX + 40; ++x)
+    {
+        if (store.tileAt(x, minY - 1) != 0 || store.tileAt(x, maxY) != 0 || store.tileAt(x, -1000000) != 0)
+        {
+            std::cerr << filename << ": ERROR - Layer '" << layer.name << "' has tiles outside its data" << std::endl;
+            return false;
+        }
+    }
+
+    std::size_t stored = 0;
+    store.forEachChunk([&](std::int32_t, std::int32_t, std::span<const std::uint32_t> cells)
+    {
+        for (const std::uint32_t gid : cells)
+        {
+            stored += gid != 0 ? 1 : 0;
+        }
+    });
+    if (stored != nonEmpty)
+    {
+        std::cerr << filename << ": ERROR - Layer '" << layer.name << "' stores " << stored << " tiles, expected "
+            << nonEmpty << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Random writes, including negative and far-away coordinates, must read back like a reference map
+bool verifyWrites(const std::string& filename)
+{
+    for (const std::uint32_t shift : {1u, 4u, 6u})
+    {
+        tmx::map::TileStore store(shift);
+        std::unordered_map<std::uint64_t, std::uint32_t> reference;
+        auto key = [](std::int32_t x, std::int32_t y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+        };
+
+        std::mt19937 rng(shift);
+        std::uniform_int_distribution<std::int32_t> near(-300, 300);
+        std::uniform_int_distribution<std::int32_t> far(-2000000000, 2000000000);
+        std::uniform_int_distribution<std::uint32_t> gid(0, 50);
+        for (int i = 0; i < 20000; ++i)
+        {
+            const bool isFar = i % 10 == 0;
+            const std::int32_t x = isFar ? far(rng) : near(rng);
+            const std::int32_t y = isFar ? far(rng) : near(rng);
+            std::uint32_t value = gid(rng);
+            if (value != 0 && i % 7 == 0)
+                value |= tmx::map::FLIPPED_VERTICALLY_FLAG;
+            store.setTile(x, y, value);
+            reference[key(x, y)] = value;
+        }
+
+        for (const auto& [k, value] : reference)
+        {
+            const auto x = static_cast<std::int32_t>(static_cast<std::uint32_t>(k));
+            const auto y = static_cast<std::int32_t>(static_cast<std::uint32_t>(k >> 32));
+            if (store.tileAt(x, y) != value)
+            {
+                std::cerr << filename << ": ERROR - Cell " << x << "," << y << " reads " << store.tileAt(x, y)
+                    << ", expected " << value << " (chunk shift " << shift << ")" << std::endl;
+                return false;
+            }
+        }
+        for (int i = 0; i < 20000; ++i)
+        {
+            const std::int32_t x = near(rng), y = near(rng);
+            const auto it = reference.find(key(x, y));
+            if (store.tileAt(x, y) != (it == reference.end() ? 0 : it->second))
+            {
+                std::cerr << filename << ": ERROR - Unwritten cell " << x << "," << y << " is not empty" << std::endl;
+                return false;
+            }
+        }
+
+        // Clearing a cell never allocates
+        const std::size_t chunks = store.chunkCount();
+        store.setTile(2100000000, -2100000000, 0);
+        if (store.chunkCount() != chunks || !store.chunkAt(2100000000 >> shift, -2100000000 >> shift).empty())
+        {
+            std::cerr << filename << ": ERROR - Clearing an empty cell allocated a chunk" << std::endl;
+            return false;
+        }
+
+        store.clear();
+        if (store.chunkCount() != 0 || !store.bounds().isEmpty() || store.tileAt(0, 0) != 0)
+        {
+            std::cerr << filename << ": ERROR - clear() left tiles behind" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tmx_file>" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    std::cout << "Testing tile store: " << filename << std::endl;
+
+    auto result = tmx::Parser::parseFromFile(filename);
+    if (!result)
+    {
+        std::cerr << filename << ": FAILED - Parse error: " << result.error() << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    for (const auto& layer : result->layers)
+    {
+        for (const std::uint32_t shift : {2u, tmx::map::TileStore::DEFAULT_CHUNK_SHIFT, 5u})
+        {
+            success &= verifyLayer(layer, tmx::map::TileStore::fromLayer(layer, shift), filename);
+        }
+    }
+    success &= verifyWrites(filename);
+
+    if (!success)
+    {
+        return 1;
+    }
+
+    std::cout << filename << ": PASSED - All checks successful" << std::endl;
+    return 0;
+}